@@ -0,0 +1,739 @@
+/**
+ * @file rtnet_bench.c
+ * @brief Microbenchmark harness and stack benchmark cases
+ * @version 1.0.0
+ * @date 2026-10-14
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/bench/rtnet_bench.c
+ *
+ * Cases use the public API and the checksum kernels only, so they build
+ * unchanged for a target. Frames are fed through RTNET_ProcessRxPacket
+ * from the same peer the host tests use.
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include "rtnet_bench.h"
+#include "rtnet_checksum.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+/* ==================== CONSTANTS ==================== */
+
+#define BENCH_ETH_LEN           14U
+#define BENCH_L4_OFFSET         (BENCH_ETH_LEN + 40U)
+#define BENCH_LINE_LEN          256U
+#define BENCH_PARAM_LEN         64U
+#define BENCH_ROUTE_PROBES      64U     /* Destinations cycled by route lookups */
+#define BENCH_UDP_PORT          7000U
+#define BENCH_PEER_PORT         80U
+#define BENCH_PEER_ISS          5000U
+
+/* Neighbors cycled by uncached sends: enough to miss the destination cache */
+#define BENCH_NEIGHBORS         ((RTNET_MAX_NEIGHBOR_CACHE < (2U * RTNET_DEST_CACHE_SIZE)) ? \
+                                 RTNET_MAX_NEIGHBOR_CACHE : (2U * RTNET_DEST_CACHE_SIZE))
+
+/* Same addressing as the host test suite */
+static const RTNET_IPv6Addr_t BENCH_ADDR_LOCAL = {
+    .addr = {0xFE, 0x80, 0, 0, 0, 0, 0, 0, 0x02, 0x00, 0x5E, 0xFF, 0xFE, 0x00, 0x53, 0x00}
+};
+
+static const RTNET_MACAddr_t BENCH_MAC_LOCAL = {
+    .addr = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55}
+};
+
+static const RTNET_MACAddr_t BENCH_MAC_PEER = {
+    .addr = {0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0x00}
+};
+
+/* ==================== HARNESS ==================== */
+
+static RTNET_BenchConfig_t g_bench_config;
+static bool g_bench_configured = false;
+static uint16_t g_bench_reported = 0U;
+
+/* Keeps results of pure computations alive */
+static volatile uint32_t g_bench_sink = 0U;
+
+RTNET_Error_t RTNET_Bench_Configure(const RTNET_BenchConfig_t* config)
+{
+    if ((config == NULL) || (config->cycles_per_us == 0U) || (config->repeats == 0U) ||
+        (config->repeats > RTNET_BENCH_MAX_REPEATS) || (config->emit == NULL)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    g_bench_config = *config;
+    g_bench_configured = true;
+    return RTNET_OK;
+}
+
+/**
+ * @brief Ticks taken by one batch
+ * @note A single wrap of the 32-bit counter is absorbed by the subtraction
+ */
+static uint32_t bench_time_batch(RTNET_BenchFunc_t fn, void* arg, uint32_t iterations)
+{
+    const uint32_t start = RTNET_GetCycleCount();
+    fn(arg, iterations);
+    return RTNET_GetCycleCount() - start;
+}
+
+/**
+ * @brief Picoseconds per operation of a batch
+ */
+static uint64_t bench_ps_per_op(uint32_t cycles, uint32_t iterations)
+{
+    return ((uint64_t)cycles * 1000000ULL) /
+           ((uint64_t)g_bench_config.cycles_per_us * iterations);
+}
+
+/**
+ * @brief Append "key":ns.fff for a picosecond value
+ */
+static int bench_put_ns(char* out, size_t max, const char* key, uint64_t ps)
+{
+    return snprintf(out, max, ",\"%s\":%" PRIu64 ".%03" PRIu64, key,
+                    ps / 1000U, ps % 1000U);
+}
+
+RTNET_Error_t RTNET_Bench_Run(const char* name, const char* param,
+                               RTNET_BenchFunc_t fn, void* arg,
+                               uint32_t frame_bytes, RTNET_BenchResult_t* result)
+{
+    if (!g_bench_configured || (name == NULL) || (param == NULL) || (fn == NULL)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    RTNET_BenchResult_t res = {0U, 0U, 0U};
+    if ((g_bench_config.filter != NULL) && (strstr(name, g_bench_config.filter) == NULL)) {
+        if (result != NULL) {
+            *result = res;
+        }
+        return RTNET_OK;
+    }
+
+    /* Calibrate: double the batch until it lasts min_batch_us (also warms up) */
+    const uint64_t min_cycles = (uint64_t)g_bench_config.min_batch_us *
+                                g_bench_config.cycles_per_us;
+    uint32_t iterations = 1U;
+    while ((bench_time_batch(fn, arg, iterations) < min_cycles) &&
+           (iterations < RTNET_BENCH_MAX_ITERATIONS)) {
+        iterations *= 2U;
+    }
+
+    /* Timed batches, insertion-sorted for the median */
+    uint64_t samples[RTNET_BENCH_MAX_REPEATS];
+    for (uint8_t r = 0U; r < g_bench_config.repeats; r++) {
+        const uint64_t ps = bench_ps_per_op(bench_time_batch(fn, arg, iterations), iterations);
+        uint8_t pos = r;
+        while ((pos > 0U) && (samples[pos - 1U] > ps)) {
+            samples[pos] = samples[pos - 1U];
+            pos--;
+        }
+        samples[pos] = ps;
+    }
+
+    res.iterations = iterations;
+    res.best_ps = samples[0];
+    res.median_ps = samples[g_bench_config.repeats / 2U];
+    if (result != NULL) {
+        *result = res;
+    }
+
+    char line[BENCH_LINE_LEN];
+    int len = snprintf(line, sizeof(line), "{\"bench\":\"%s\",\"param\":\"%s\",\"iterations\":%" PRIu32,
+                       name, param, iterations);
+    len += bench_put_ns(&line[len], sizeof(line) - (size_t)len, "ns_per_op", res.best_ps);
+    len += bench_put_ns(&line[len], sizeof(line) - (size_t)len, "ns_per_op_median", res.median_ps);
+
+    const uint64_t best = (res.best_ps != 0U) ? res.best_ps : 1U;
+    len += snprintf(&line[len], sizeof(line) - (size_t)len, ",\"ops_per_s\":%" PRIu64,
+                    (uint64_t)(1000000000000ULL / best));
+    if (frame_bytes != 0U) {
+        /* bytes/ps x 1e6 = MB/s, three decimals */
+        const uint64_t milli_mbps = ((uint64_t)frame_bytes * 1000000000ULL) / best;
+        len += snprintf(&line[len], sizeof(line) - (size_t)len,
+                        ",\"frame_bytes\":%" PRIu32 ",\"mbytes_per_s\":%" PRIu64 ".%03" PRIu64,
+                        frame_bytes, milli_mbps / 1000U, milli_mbps % 1000U);
+    }
+    (void)snprintf(&line[len], sizeof(line) - (size_t)len, "}");
+
+    g_bench_config.emit(line);
+    g_bench_reported++;
+    return RTNET_OK;
+}
+
+/* ==================== FRAME HELPERS ==================== */
+
+/**
+ * @brief Peer address fe80::1:<index> (one neighbor per index)
+ */
+static RTNET_IPv6Addr_t bench_peer(uint8_t index)
+{
+    RTNET_IPv6Addr_t addr = {.addr = {0xFE, 0x80, [13] = 0x01U, [15] = index}};
+    return addr;
+}
+
+/**
+ * @brief Complete Ethernet + IPv6 header around an upper-layer message
+ * @param frame Frame with the message already at BENCH_L4_OFFSET
+ * @param src Sender (MAC derived from the last address byte)
+ * @param l4_len Upper-layer length
+ * @param next_header Upper-layer protocol
+ * @param csum_offset Checksum field inside the upper-layer header
+ * @return Frame length
+ */
+static uint16_t bench_frame(uint8_t* frame, const RTNET_IPv6Addr_t* src, uint16_t l4_len,
+                            uint8_t next_header, uint16_t csum_offset)
+{
+    memcpy(&frame[0], BENCH_MAC_LOCAL.addr, RTNET_MAC_ADDR_LEN);
+    memcpy(&frame[6], BENCH_MAC_PEER.addr, RTNET_MAC_ADDR_LEN);
+    frame[11] = src->addr[15];
+    frame[12] = 0x86U; frame[13] = 0xDDU;
+
+    frame[14] = 0x60U; frame[15] = 0U; frame[16] = 0U; frame[17] = 0U;
+    frame[18] = (uint8_t)(l4_len >> 8U);
+    frame[19] = (uint8_t)l4_len;
+    frame[20] = next_header;
+    frame[21] = 255U;                               /* Valid for ND as well */
+    memcpy(&frame[22], src->addr, RTNET_IPV6_ADDR_LEN);
+    memcpy(&frame[38], BENCH_ADDR_LOCAL.addr, RTNET_IPV6_ADDR_LEN);
+
+    uint8_t* l4 = &frame[BENCH_L4_OFFSET];
+    l4[csum_offset] = 0U;
+    l4[csum_offset + 1U] = 0U;
+    uint32_t sum = RTNET_ChecksumPartial(&frame[22], 32U, 0U) + l4_len + next_header;
+    const uint16_t csum = RTNET_ChecksumFinish(RTNET_ChecksumPartial(l4, l4_len, sum));
+    l4[csum_offset] = (uint8_t)(csum >> 8U);
+    l4[csum_offset + 1U] = (uint8_t)csum;
+
+    return (uint16_t)(BENCH_L4_OFFSET + l4_len);
+}
+
+/**
+ * @brief Neighbor Solicitation from a peer (creates a STALE neighbor entry)
+ */
+static uint16_t bench_ns_frame(uint8_t* frame, uint8_t peer)
+{
+    const RTNET_IPv6Addr_t src = bench_peer(peer);
+    uint8_t* icmp = &frame[BENCH_L4_OFFSET];
+
+    memset(icmp, 0, 32U);
+    icmp[0] = 135U;
+    memcpy(&icmp[8], BENCH_ADDR_LOCAL.addr, RTNET_IPV6_ADDR_LEN);
+    icmp[24] = 1U;                                  /* Source link-layer address */
+    icmp[25] = 1U;
+    memcpy(&icmp[26], BENCH_MAC_PEER.addr, RTNET_MAC_ADDR_LEN);
+    icmp[31] = peer;
+
+    return bench_frame(frame, &src, 32U, 58U, 2U);
+}
+
+/**
+ * @brief UDP datagram from peer 0 to a local port
+ */
+static uint16_t bench_udp_frame(uint8_t* frame, uint16_t dst_port, uint16_t payload_len)
+{
+    const RTNET_IPv6Addr_t src = bench_peer(0U);
+    uint8_t* udp = &frame[BENCH_L4_OFFSET];
+    const uint16_t udp_len = (uint16_t)(8U + payload_len);
+
+    udp[0] = (uint8_t)(BENCH_PEER_PORT >> 8U); udp[1] = (uint8_t)BENCH_PEER_PORT;
+    udp[2] = (uint8_t)(dst_port >> 8U);        udp[3] = (uint8_t)dst_port;
+    udp[4] = (uint8_t)(udp_len >> 8U);         udp[5] = (uint8_t)udp_len;
+    memset(&udp[8], 0x5A, payload_len);
+
+    return bench_frame(frame, &src, udp_len, 17U, 6U);
+}
+
+/**
+ * @brief Stack with BENCH_NEIGHBORS resolved link-local neighbors
+ */
+static void bench_setup(void)
+{
+    static uint8_t frame[128];
+
+    (void)RTNET_Initialize(&BENCH_ADDR_LOCAL, &BENCH_MAC_LOCAL);
+    for (uint8_t i = 0U; i < BENCH_NEIGHBORS; i++) {
+        (void)RTNET_ProcessRxPacket(frame, bench_ns_frame(frame, i));
+    }
+}
+
+/**
+ * @brief xorshift32 (deterministic case data)
+ */
+static uint32_t bench_rand(uint32_t* state)
+{
+    *state ^= *state << 13U;
+    *state ^= *state >> 17U;
+    *state ^= *state << 5U;
+    return *state;
+}
+
+/* ==================== CHECKSUM ==================== */
+
+typedef struct {
+    RTNET_ChecksumKernel_t kernel;  /* NULL = RTNET_ChecksumPartial */
+    const uint8_t* data;
+    uint16_t length;
+} BenchChecksum_t;
+
+static void bench_checksum(void* arg, uint32_t iterations)
+{
+    const BenchChecksum_t* c = (const BenchChecksum_t*)arg;
+    uint32_t sum = 0U;
+
+    for (uint32_t i = 0U; i < iterations; i++) {
+        sum += (c->kernel != NULL) ? c->kernel(c->data, c->length)
+                                   : RTNET_ChecksumPartial(c->data, c->length, 0U);
+    }
+    g_bench_sink = sum;
+}
+
+static void bench_run_checksum(void)
+{
+    static uint8_t data[1500U + 8U];
+    static const uint16_t sizes[] = {20U, 64U, 256U, 576U, 1500U};
+    char param[BENCH_PARAM_LEN];
+
+    for (uint16_t i = 0U; i < sizeof(data); i++) {
+        data[i] = (uint8_t)((i * 31U) + 7U);
+    }
+
+    for (uint8_t s = 0U; s < (sizeof(sizes) / sizeof(sizes[0])); s++) {
+        for (uint8_t align = 0U; align < 3U; align++) {
+            BenchChecksum_t c = {NULL, &data[align], sizes[s]};
+            (void)snprintf(param, sizeof(param), "kernel=active,len=%u,align=%u",
+                           (unsigned)sizes[s], (unsigned)align);
+            (void)RTNET_Bench_Run("checksum", param, bench_checksum, &c, sizes[s], NULL);
+        }
+    }
+
+    const RTNET_ChecksumKernelInfo_t* kernels = NULL;
+    const uint8_t count = RTNET_ChecksumGetKernels(&kernels);
+    for (uint8_t k = 0U; k < count; k++) {
+        for (uint8_t align = 0U; align < 2U; align++) {
+            BenchChecksum_t c = {kernels[k].sum, &data[align], 1500U};
+            (void)snprintf(param, sizeof(param), "kernel=%s,len=1500,align=%u",
+                           kernels[k].name, (unsigned)align);
+            (void)RTNET_Bench_Run("checksum", param, bench_checksum, &c, 1500U, NULL);
+        }
+    }
+}
+
+/* ==================== ROUTE AND NEIGHBOR LOOKUP ==================== */
+
+typedef struct {
+    bool linear;
+    RTNET_IPv6Addr_t probes[BENCH_ROUTE_PROBES];
+} BenchRoute_t;
+
+static void bench_route_lookup(void* arg, uint32_t iterations)
+{
+    const BenchRoute_t* c = (const BenchRoute_t*)arg;
+    RTNET_RouteEntry_t route;
+    uint32_t hits = 0U;
+
+    for (uint32_t i = 0U; i < iterations; i++) {
+        const RTNET_IPv6Addr_t* dest = &c->probes[i % BENCH_ROUTE_PROBES];
+        const RTNET_Error_t err = c->linear ? RTNET_LookupRouteLinear(dest, &route)
+                                            : RTNET_LookupRoute(dest, &route);
+        hits += (err == RTNET_OK) ? 1U : 0U;
+    }
+    g_bench_sink = hits;
+}
+
+static void bench_run_route(void)
+{
+    static BenchRoute_t c;
+    static const uint16_t sizes[] = {1U, 8U, RTNET_MAX_ROUTING_ENTRIES};
+    char param[BENCH_PARAM_LEN];
+
+    for (uint8_t s = 0U; s < (sizeof(sizes) / sizeof(sizes[0])); s++) {
+        if ((sizes[s] > RTNET_MAX_ROUTING_ENTRIES) || ((s > 0U) && (sizes[s] == sizes[s - 1U]))) {
+            continue;
+        }
+
+        /* Slot 0 is the link-local route; the rest share a /16 so the trie
+         * splits deep. Probes hit installed prefixes with random host bits. */
+        bench_setup();
+        uint32_t seed = 0x2545F491U;
+        RTNET_IPv6Addr_t prefixes[RTNET_MAX_ROUTING_ENTRIES];
+        prefixes[0] = BENCH_ADDR_LOCAL;
+        for (uint16_t i = 1U; i < sizes[s]; i++) {
+            for (uint8_t b = 0U; b < RTNET_IPV6_ADDR_LEN; b++) {
+                prefixes[i].addr[b] = (uint8_t)bench_rand(&seed);
+            }
+            prefixes[i].addr[0] = 0x20U;
+            prefixes[i].addr[1] = 0x01U;
+            (void)RTNET_AddRoute(&prefixes[i], (uint8_t)(16U + (bench_rand(&seed) % 113U)),
+                                 NULL, 1U);
+        }
+        for (uint16_t p = 0U; p < BENCH_ROUTE_PROBES; p++) {
+            c.probes[p] = prefixes[p % sizes[s]];
+            c.probes[p].addr[15] ^= (uint8_t)bench_rand(&seed);
+        }
+
+        for (uint8_t impl = 0U; impl < 2U; impl++) {
+            c.linear = (impl != 0U);
+            (void)snprintf(param, sizeof(param), "routes=%u,impl=%s", (unsigned)sizes[s],
+                           c.linear ? "linear" : "indexed");
+            (void)RTNET_Bench_Run("route_lookup", param, bench_route_lookup, &c, 0U, NULL);
+        }
+    }
+}
+
+typedef struct {
+    uint8_t count;          /* Neighbors cycled */
+    uint8_t first;          /* First peer index (>= BENCH_NEIGHBORS = miss) */
+} BenchNeighbor_t;
+
+static void bench_nd_lookup(void* arg, uint32_t iterations)
+{
+    const BenchNeighbor_t* c = (const BenchNeighbor_t*)arg;
+    RTNET_MACAddr_t mac;
+    uint32_t hits = 0U;
+
+    for (uint32_t i = 0U; i < iterations; i++) {
+        const RTNET_IPv6Addr_t addr = bench_peer((uint8_t)(c->first + (i % c->count)));
+        hits += (RTNET_LookupNeighbor(&addr, &mac) == RTNET_OK) ? 1U : 0U;
+    }
+    g_bench_sink = hits;
+}
+
+static void bench_run_neighbor(void)
+{
+    const BenchNeighbor_t setups[] = {
+        {1U, 0U}, {BENCH_NEIGHBORS, 0U}, {1U, BENCH_NEIGHBORS}
+    };
+    static const char* const params[] = {"neighbors=1,hit", "neighbors=all,hit", "miss"};
+
+    bench_setup();
+    for (uint8_t i = 0U; i < 3U; i++) {
+        BenchNeighbor_t c = setups[i];
+        (void)RTNET_Bench_Run("nd_lookup", params[i], bench_nd_lookup, &c, 0U, NULL);
+    }
+}
+
+/* ==================== BUFFERS ==================== */
+
+static void bench_rx_alloc(void* arg, uint32_t iterations)
+{
+    (void)arg;
+    for (uint32_t i = 0U; i < iterations; i++) {
+        (void)RTNET_FreeRxBuffer(RTNET_AllocRxBuffer());
+    }
+}
+
+static void bench_tx_alloc(void* arg, uint32_t iterations)
+{
+    const uint16_t payload_len = *(const uint16_t*)arg;
+    for (uint32_t i = 0U; i < iterations; i++) {
+        (void)RTNET_FreeTxBuffer(RTNET_UDP_AllocBuffer(payload_len, RTNET_QOS_NORMAL));
+    }
+}
+
+static void bench_run_buffers(void)
+{
+    bench_setup();
+    (void)RTNET_Bench_Run("buffer_alloc_free", "pool=rx", bench_rx_alloc, NULL, 0U, NULL);
+
+    uint16_t small = 32U;
+    uint16_t large = 1024U;
+    (void)RTNET_Bench_Run("buffer_alloc_free", "pool=tx,payload=32", bench_tx_alloc,
+                          &small, 0U, NULL);
+    (void)RTNET_Bench_Run("buffer_alloc_free", "pool=tx,payload=1024", bench_tx_alloc,
+                          &large, 0U, NULL);
+}
+
+/* ==================== RX DEMUX ==================== */
+
+typedef struct {
+    uint8_t frame[RTNET_BUFFER_SIZE];
+    uint16_t length;
+} BenchRx_t;
+
+static void bench_udp_handler(const RTNET_RxView_t* view)
+{
+    g_bench_sink += view->payload_len;
+}
+
+static void bench_rx(void* arg, uint32_t iterations)
+{
+    const BenchRx_t* c = (const BenchRx_t*)arg;
+    for (uint32_t i = 0U; i < iterations; i++) {
+        (void)RTNET_ProcessRxPacket(c->frame, c->length);
+    }
+}
+
+static void bench_run_rx(void)
+{
+    static BenchRx_t c;
+    static const uint16_t sizes[] = {64U, 1024U};
+    char param[BENCH_PARAM_LEN];
+    uint8_t socket_id = 0U;
+
+    bench_setup();
+    (void)RTNET_UDP_Bind(BENCH_UDP_PORT, bench_udp_handler, &socket_id);
+
+    for (uint8_t s = 0U; s < (sizeof(sizes) / sizeof(sizes[0])); s++) {
+        c.length = bench_udp_frame(c.frame, BENCH_UDP_PORT, sizes[s]);
+        (void)snprintf(param, sizeof(param), "socket=bound,payload=%u", (unsigned)sizes[s]);
+        (void)RTNET_Bench_Run("rx_udp", param, bench_rx, &c, c.length, NULL);
+    }
+
+    c.length = bench_udp_frame(c.frame, (uint16_t)(BENCH_UDP_PORT + 1U), 64U);
+    (void)RTNET_Bench_Run("rx_udp", "socket=none,payload=64", bench_rx, &c, c.length, NULL);
+
+    /* Echo request: ICMPv6 demux plus the reply build */
+    const RTNET_IPv6Addr_t src = bench_peer(0U);
+    uint8_t* icmp = &c.frame[BENCH_L4_OFFSET];
+    memset(icmp, 0x5A, 64U);
+    icmp[0] = 128U;
+    icmp[1] = 0U;
+    c.length = bench_frame(c.frame, &src, 64U, 58U, 2U);
+    const RTNET_ICMPv6RateLimit_t unlimited = {0U, 0U, 0U, 0U};
+    (void)RTNET_SetICMPv6RateLimit(RTNET_ICMPV6_LIMIT_ECHO, &unlimited);
+    (void)RTNET_Bench_Run("rx_icmpv6_echo", "payload=60", bench_rx, &c, c.length, NULL);
+
+    /* Over budget: dropped before the checksum pass */
+    const RTNET_ICMPv6RateLimit_t exhausted = {1U, 1U, 1U, 1U};
+    (void)RTNET_SetICMPv6RateLimit(RTNET_ICMPV6_LIMIT_ECHO, &exhausted);
+    (void)RTNET_ProcessRxPacket(c.frame, c.length);
+    (void)RTNET_Bench_Run("rx_icmpv6_echo", "payload=60,rate_limited", bench_rx, &c, c.length,
+                          NULL);
+
+    (void)RTNET_UDP_Unbind(socket_id);
+}
+
+/* ==================== TX BUILD ==================== */
+
+typedef struct {
+    uint8_t payload[1024];
+    uint16_t length;
+    uint8_t destinations;   /* Neighbors cycled, 1 = destination cache hit */
+} BenchUdpTx_t;
+
+static void bench_udp_send(void* arg, uint32_t iterations)
+{
+    const BenchUdpTx_t* c = (const BenchUdpTx_t*)arg;
+    for (uint32_t i = 0U; i < iterations; i++) {
+        const RTNET_IPv6Addr_t dest = bench_peer((uint8_t)(i % c->destinations));
+        (void)RTNET_UDP_Send(&dest, BENCH_PEER_PORT, BENCH_UDP_PORT, c->payload, c->length,
+                             RTNET_QOS_NORMAL);
+    }
+}
+
+static void bench_udp_send_buffer(void* arg, uint32_t iterations)
+{
+    const BenchUdpTx_t* c = (const BenchUdpTx_t*)arg;
+    const RTNET_IPv6Addr_t dest = bench_peer(0U);
+    for (uint32_t i = 0U; i < iterations; i++) {
+        RTNET_Buffer_t* buf = RTNET_UDP_AllocBuffer(c->length, RTNET_QOS_NORMAL);
+        if (buf != NULL) {
+            memcpy(&buf->data[buf->offset], c->payload, c->length);
+            buf->length = c->length;
+            (void)RTNET_UDP_SendBuffer(buf, &dest, BENCH_PEER_PORT, BENCH_UDP_PORT);
+        }
+    }
+}
+
+static void bench_udp_send_batch(void* arg, uint32_t iterations)
+{
+    const BenchUdpTx_t* c = (const BenchUdpTx_t*)arg;
+    const RTNET_IPv6Addr_t dest = bench_peer(0U);
+    RTNET_UDPDatagram_t burst[RTNET_TX_BATCH_MAX];
+    for (uint8_t i = 0U; i < RTNET_TX_BATCH_MAX; i++) {
+        burst[i] = (RTNET_UDPDatagram_t){ &dest, c->payload, BENCH_PEER_PORT, c->length };
+    }
+
+    for (uint32_t i = 0U; i < iterations; i++) {
+        uint16_t sent = 0U;
+        (void)RTNET_UDP_SendBatch(burst, RTNET_TX_BATCH_MAX, BENCH_UDP_PORT,
+                                  RTNET_QOS_NORMAL, &sent);
+    }
+}
+
+static void bench_run_udp_tx(void)
+{
+    static BenchUdpTx_t c;
+    static const uint16_t sizes[] = {16U, 1024U};
+    char param[BENCH_PARAM_LEN];
+
+    bench_setup();
+    memset(c.payload, 0x5A, sizeof(c.payload));
+
+    for (uint8_t s = 0U; s < (sizeof(sizes) / sizeof(sizes[0])); s++) {
+        c.length = sizes[s];
+        const uint32_t frame_bytes = (uint32_t)BENCH_L4_OFFSET + 8U + c.length;
+
+        c.destinations = 1U;
+        (void)snprintf(param, sizeof(param), "dest=cached,payload=%u", (unsigned)c.length);
+        (void)RTNET_Bench_Run("udp_send", param, bench_udp_send, &c, frame_bytes, NULL);
+
+        c.destinations = BENCH_NEIGHBORS;
+        (void)snprintf(param, sizeof(param), "dest=rotating%u,payload=%u",
+                       (unsigned)BENCH_NEIGHBORS, (unsigned)c.length);
+        (void)RTNET_Bench_Run("udp_send", param, bench_udp_send, &c, frame_bytes, NULL);
+
+        (void)snprintf(param, sizeof(param), "zero_copy,payload=%u", (unsigned)c.length);
+        (void)RTNET_Bench_Run("udp_send", param, bench_udp_send_buffer, &c, frame_bytes, NULL);
+
+        (void)snprintf(param, sizeof(param), "batch=%u,payload=%u",
+                       (unsigned)RTNET_TX_BATCH_MAX, (unsigned)c.length);
+        (void)RTNET_Bench_Run("udp_send", param, bench_udp_send_batch, &c,
+                              frame_bytes * RTNET_TX_BATCH_MAX, NULL);
+    }
+}
+
+#if (RTNET_ENABLE_TCP != 0U)
+
+typedef struct {
+    uint8_t conn_id;
+    uint16_t length;        /* Bytes sent per operation */
+    uint32_t acked;         /* Next sequence number the peer acknowledges */
+    uint8_t ack[128];       /* Peer ACK segment, ack field patched per operation */
+    uint16_t ack_len;
+    uint8_t payload[1024];
+} BenchTcpTx_t;
+
+/**
+ * @brief Peer TCP segment to our ephemeral port
+ */
+static uint16_t bench_tcp_frame(uint8_t* frame, uint16_t dst_port, uint32_t seq, uint32_t ack,
+                                uint8_t flags)
+{
+    const RTNET_IPv6Addr_t src = bench_peer(0U);
+    uint8_t* tcp = &frame[BENCH_L4_OFFSET];
+
+    memset(tcp, 0, 20U);
+    tcp[0] = (uint8_t)(BENCH_PEER_PORT >> 8U); tcp[1] = (uint8_t)BENCH_PEER_PORT;
+    tcp[2] = (uint8_t)(dst_port >> 8U);        tcp[3] = (uint8_t)dst_port;
+    tcp[4] = (uint8_t)(seq >> 24U); tcp[5] = (uint8_t)(seq >> 16U);
+    tcp[6] = (uint8_t)(seq >> 8U);  tcp[7] = (uint8_t)seq;
+    tcp[8] = (uint8_t)(ack >> 24U); tcp[9] = (uint8_t)(ack >> 16U);
+    tcp[10] = (uint8_t)(ack >> 8U); tcp[11] = (uint8_t)ack;
+    tcp[12] = 0x50U;
+    tcp[13] = flags;
+    tcp[14] = 0xFFU; tcp[15] = 0xFFU;
+
+    return bench_frame(frame, &src, 20U, 6U, 16U);
+}
+
+/**
+ * @brief Send one segment and process the peer's ACK for it
+ */
+static void bench_tcp_send(void* arg, uint32_t iterations)
+{
+    BenchTcpTx_t* c = (BenchTcpTx_t*)arg;
+    uint8_t* tcp = &c->ack[BENCH_L4_OFFSET];
+
+    for (uint32_t i = 0U; i < iterations; i++) {
+        (void)RTNET_TCP_Send(c->conn_id, c->payload, c->length);
+
+        const uint32_t old_ack = c->acked;
+        c->acked += c->length;
+        const uint16_t csum = (uint16_t)((tcp[16] << 8U) | tcp[17]);
+        const uint16_t updated = RTNET_ChecksumUpdate32(csum, old_ack, c->acked);
+        tcp[8] = (uint8_t)(c->acked >> 24U); tcp[9] = (uint8_t)(c->acked >> 16U);
+        tcp[10] = (uint8_t)(c->acked >> 8U); tcp[11] = (uint8_t)c->acked;
+        tcp[16] = (uint8_t)(updated >> 8U);  tcp[17] = (uint8_t)updated;
+        (void)RTNET_ProcessRxPacket(c->ack, c->ack_len);
+    }
+}
+
+static void bench_run_tcp_tx(void)
+{
+    static BenchTcpTx_t c;
+    static const uint16_t sizes[] = {64U, 1024U};
+    char param[BENCH_PARAM_LEN];
+    uint8_t frame[128];
+
+    if (g_bench_config.last_tx == NULL) {
+        return;
+    }
+
+    for (uint8_t s = 0U; s < (sizeof(sizes) / sizeof(sizes[0])); s++) {
+        /* Handshake: read our SYN for the ISS and port, answer it */
+        bench_setup();
+        const RTNET_IPv6Addr_t peer = bench_peer(0U);
+        if (RTNET_TCP_Connect(&peer, BENCH_PEER_PORT, &c.conn_id) != RTNET_OK) {
+            return;
+        }
+        if (g_bench_config.last_tx(frame, sizeof(frame)) < (BENCH_L4_OFFSET + 20U)) {
+            return;
+        }
+        const uint8_t* syn = &frame[BENCH_L4_OFFSET];
+        const uint16_t port = (uint16_t)((syn[0] << 8U) | syn[1]);
+        const uint32_t iss = ((uint32_t)syn[4] << 24U) | ((uint32_t)syn[5] << 16U) |
+                             ((uint32_t)syn[6] << 8U) | syn[7];
+        uint16_t len = bench_tcp_frame(frame, port, BENCH_PEER_ISS, iss + 1U, 0x12U);
+        (void)RTNET_ProcessRxPacket(frame, len);
+        if (RTNET_TCP_GetState(c.conn_id) != RTNET_TCP_ESTABLISHED) {
+            return;
+        }
+
+        c.length = sizes[s];
+        c.acked = iss + 1U;
+        c.ack_len = bench_tcp_frame(c.ack, port, BENCH_PEER_ISS + 1U, c.acked, 0x10U);
+        memset(c.payload, 0x5A, sizeof(c.payload));
+
+        (void)snprintf(param, sizeof(param), "send+ack,payload=%u", (unsigned)c.length);
+        (void)RTNET_Bench_Run("tcp_send", param, bench_tcp_send, &c,
+                              (uint32_t)BENCH_L4_OFFSET + 20U + c.length, NULL);
+        (void)RTNET_CloseConnection(c.conn_id);
+    }
+}
+
+#endif /* RTNET_ENABLE_TCP */
+
+/* ==================== SUITE ==================== */
+
+uint16_t RTNET_Bench_RunAll(void)
+{
+    if (!g_bench_configured) {
+        return 0U;
+    }
+
+    char line[BENCH_LINE_LEN];
+    (void)snprintf(line, sizeof(line),
+                   "{\"suite\":\"rtns_bench\",\"cycles_per_us\":%" PRIu32 ",\"repeats\":%u,"
+                   "\"tcp\":%u,\"mdns\":%u,\"route_trie\":%u,\"profiling\":%u}",
+                   g_bench_config.cycles_per_us, (unsigned)g_bench_config.repeats,
+                   (unsigned)RTNET_ENABLE_TCP, (unsigned)RTNET_ENABLE_MDNS,
+                   (unsigned)RTNET_ENABLE_ROUTE_TRIE, (unsigned)RTNET_ENABLE_PROFILING);
+    g_bench_config.emit(line);
+
+    const uint16_t before = g_bench_reported;
+    bench_run_checksum();
+    bench_run_route();
+    bench_run_neighbor();
+    bench_run_buffers();
+    bench_run_rx();
+    bench_run_udp_tx();
+#if (RTNET_ENABLE_TCP != 0U)
+    bench_run_tcp_tx();
+#endif
+
+    return (uint16_t)(g_bench_reported - before);
+}
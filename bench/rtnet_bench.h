@@ -0,0 +1,112 @@
+/**
+ * @file rtnet_bench.h
+ * @brief Microbenchmark harness and stack benchmark cases
+ * @version 1.0.0
+ * @date 2026-10-14
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/bench/rtnet_bench.h
+ *
+ * Times through RTNET_GetCycleCount only, so the same harness runs on the
+ * host (stub nanosecond clock) and on a target (CPU cycle counter). Each
+ * case is calibrated to a batch of at least min_batch_us, repeated, and
+ * reported as one JSON object per line:
+ *
+ *   {"bench":"route_lookup","param":"routes=32,impl=indexed","iterations":65536,
+ *    "ns_per_op":41.250,"ns_per_op_median":42.031,"ops_per_s":24242424}
+ *
+ * ns_per_op is the fastest batch, ns_per_op_median the median one; cases
+ * that move a frame also report "frame_bytes" and "mbytes_per_s". Output
+ * uses integer formatting only (no printf float support needed).
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef RTNET_BENCH_H
+#define RTNET_BENCH_H
+
+#include "rtnet_stack.h"
+
+#define RTNET_BENCH_MAX_REPEATS     15U     /* Batches kept for the median */
+#define RTNET_BENCH_MAX_ITERATIONS  (1UL << 24U)
+
+/**
+ * @brief Benchmark body: run the operation `iterations` times
+ * @param arg Case state
+ */
+typedef void (*RTNET_BenchFunc_t)(void* arg, uint32_t iterations);
+
+/**
+ * @brief Harness configuration (platform side)
+ */
+typedef struct {
+    uint32_t cycles_per_us;     /* RTNET_GetCycleCount ticks per microsecond */
+    uint32_t min_batch_us;      /* Calibrated batch length; keep below the counter wrap */
+    uint8_t repeats;            /* Timed batches per case (1 .. RTNET_BENCH_MAX_REPEATS) */
+    const char* filter;         /* Run only cases whose name contains this, NULL = all */
+    void (*emit)(const char* line);  /* Receives each result line (no newline) */
+    /* Copy of the last transmitted frame; NULL skips cases that must read
+     * the stack's TX output (TCP handshake) */
+    uint16_t (*last_tx)(uint8_t* out, uint16_t max_len);
+} RTNET_BenchConfig_t;
+
+/**
+ * @brief Result of one case
+ * @note Times in picoseconds per operation to keep integer precision
+ */
+typedef struct {
+    uint32_t iterations;        /* Operations per timed batch */
+    uint64_t best_ps;           /* Fastest batch */
+    uint64_t median_ps;         /* Median batch */
+} RTNET_BenchResult_t;
+
+/**
+ * @brief Set the harness configuration (copied)
+ * @return RTNET_OK, RTNET_ERR_INVALID_PARAM for a zero clock rate or
+ *         repeat count, or a missing emit callback
+ */
+RTNET_Error_t RTNET_Bench_Configure(const RTNET_BenchConfig_t* config);
+
+/**
+ * @brief Calibrate, time and report one case
+ * @param name Case name ("bench" key)
+ * @param param Case parameters ("param" key), e.g. "len=64,align=0"
+ * @param fn Benchmark body
+ * @param arg Passed to fn
+ * @param frame_bytes Bytes moved per operation (0 = no throughput column)
+ * @param result [OUT] Optional copy of the measurement
+ * @return RTNET_OK (result->iterations is 0 if the filter skipped the
+ *         case), RTNET_ERR_INVALID_PARAM if not configured
+ */
+RTNET_Error_t RTNET_Bench_Run(const char* name, const char* param,
+                               RTNET_BenchFunc_t fn, void* arg,
+                               uint32_t frame_bytes, RTNET_BenchResult_t* result);
+
+/**
+ * @brief Run every stack benchmark case
+ * @return Number of cases reported (after the filter)
+ * @note Re-initializes the current stack instance (and leaves it
+ *       initialized with benchmark routes and neighbors). TX cases include
+ *       the cost of the platform's RTNET_HardwareTransmit.
+ */
+uint16_t RTNET_Bench_RunAll(void);
+
+#endif /* RTNET_BENCH_H */
@@ -0,0 +1,41 @@
+/**
+ * @file rtnet_bench_main.c
+ * @brief Host runner for the stack benchmarks (rtns_bench)
+ *
+ * Usage: rtns_bench [filter] [repeats]
+ * Writes one JSON object per line to stdout; pipe it into a file per
+ * release and diff ns_per_op to spot regressions. Build with
+ * -DCMAKE_BUILD_TYPE=Release for representative numbers.
+ */
+#include "rtnet_bench.h"
+#include "rtnet_platform_stubs.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static void emit_line(const char* line)
+{
+    (void)puts(line);
+}
+
+int main(int argc, char** argv)
+{
+    RTNET_BenchConfig_t config = {
+        .cycles_per_us = RTNET_STUB_CYCLES_PER_US,
+        .min_batch_us = 20000U,
+        .repeats = 9U,
+        .filter = (argc > 1) ? argv[1] : NULL,
+        .emit = emit_line,
+        .last_tx = RTNET_Stub_GetLastTxFrame,
+    };
+    if (argc > 2) {
+        config.repeats = (uint8_t)strtoul(argv[2], NULL, 10);
+    }
+
+    if (RTNET_Bench_Configure(&config) != RTNET_OK) {
+        fprintf(stderr, "usage: %s [filter] [repeats 1..%u]\n", argv[0],
+                (unsigned)RTNET_BENCH_MAX_REPEATS);
+        return 2;
+    }
+
+    return (RTNET_Bench_RunAll() != 0U) ? 0 : 1;
+}
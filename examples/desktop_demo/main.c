@@ -31,6 +31,7 @@ static void demo_udp(void)
     printf("[demo][udp] send -> %d\n", err);
 }
 
+#if (RTNET_ENABLE_TCP != 0U)
 static void demo_tcp(void)
 {
     uint8_t conn_id = 0U;
@@ -44,7 +45,9 @@ static void demo_tcp(void)
         printf("[demo][tcp] close -> %d\n", err);
     }
 }
+#endif
 
+#if (RTNET_ENABLE_MDNS != 0U)
 static void demo_mdns(void)
 {
     RTNET_mDNSRecord_t rec;
@@ -56,6 +59,7 @@ static void demo_mdns(void)
         printf("\n");
     }
 }
+#endif
 
 int main(void)
 {
@@ -64,8 +68,12 @@ int main(void)
     }
 
     demo_udp();
+#if (RTNET_ENABLE_TCP != 0U)
     demo_tcp();
+#endif
+#if (RTNET_ENABLE_MDNS != 0U)
     demo_mdns();
+#endif
 
     /* Run a few maintenance ticks to emulate periodic servicing */
     for (int i = 0; i < 3; i++) {
@@ -0,0 +1,23 @@
+/**
+ * @file rtnet_config.h
+ * @brief Sample project configuration: Linux host on AF_XDP (load testing)
+ *
+ * One UMEM chunk per buffer needs RTNET_BUFFER_SIZE of 2048 or 4096; the
+ * frame lands 256 bytes into its chunk (XDP headroom), leaving room for a
+ * 1500-byte MTU. Deeper pools and rings keep a NIC queue busy.
+ * Build with: cmake -DRTNS_PLATFORM=LINUX -DRTNS_CONFIG_DIR=<this directory> ...
+ */
+
+#ifndef RTNET_CONFIG_H
+#define RTNET_CONFIG_H
+
+/* UMEM chunk size */
+#define RTNET_BUFFER_SIZE           2048U
+
+/* Tables */
+#define RTNET_MAX_RX_BUFFERS        128U
+#define RTNET_MAX_TX_BUFFERS        64U
+#define RTNET_RX_RING_SIZE          128U
+#define RTNET_UDP_QUEUE_DEPTH       16U
+
+#endif /* RTNET_CONFIG_H */
@@ -1,12 +1,26 @@
 #include "rtnet_stack.h"
 #include <string.h>
 #include <stdio.h>
+#if defined(RTNET_PLATFORM_LINUX)
+#include "rtnet_platform_linux.h"
+#endif
 
 static const RTNET_IPv6Addr_t LOCAL_IP = { .addr = {0xFE,0x80,0,0,0,0,0,0,0,0,0,0,0,0,0,3} };
 static const RTNET_MACAddr_t LOCAL_MAC = { .addr = {0x00,0x10,0x20,0x30,0x40,0x50} };
 
-int main(void)
+int main(int argc, char** argv)
 {
+#if defined(RTNET_PLATFORM_LINUX)
+    /* Host: a TAP device or an AF_XDP queue, e.g. "tap:rtn0" or "xdp:eth0:0" */
+    if (RTNET_Linux_Open((argc > 1) ? argv[1] : "tap:rtn0") != RTNET_OK) {
+        printf("Cannot open %s\n", (argc > 1) ? argv[1] : "tap:rtn0");
+        return -1;
+    }
+#else
+    (void)argc;
+    (void)argv;
+#endif
+
     RTNET_Initialize(&LOCAL_IP, &LOCAL_MAC);
 
     RTNET_mDNSRecord_t record;
@@ -15,11 +29,14 @@ int main(void)
     if (err == RTNET_OK) {
         printf("Found service at port %u\n", record.port);
     } else {
-        printf("mDNS query returned %d (expected on host stub)\n", err);
+        printf("mDNS query returned %d (question sent, no answer cached yet)\n", err);
     }
 
     /* Periodic upkeep */
     for (;;) {
+#if defined(RTNET_PLATFORM_LINUX)
+        (void)RTNET_Linux_Poll(10);
+#endif
         RTNET_PeriodicTask();
     }
 }
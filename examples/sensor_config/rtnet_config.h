@@ -0,0 +1,37 @@
+/**
+ * @file rtnet_config.h
+ * @brief Sample project configuration: UDP-only sensor node
+ *
+ * Link-local UDP telemetry with no TCP, no mDNS, no routing table and no
+ * IPv6 fragmentation.
+ * Build with: cmake -DRTNS_CONFIG_DIR=<path to this directory> ...
+ * The configure step prints the resulting RAM per instance; the build
+ * fails if it exceeds RTNET_RAM_BUDGET.
+ */
+
+#ifndef RTNET_CONFIG_H
+#define RTNET_CONFIG_H
+
+/* Subsystems */
+#define RTNET_ENABLE_TCP            0U
+#define RTNET_ENABLE_MDNS           0U
+#define RTNET_ENABLE_ROUTING        0U
+#define RTNET_ENABLE_FRAGMENTATION  0U
+
+/* Tables */
+#define RTNET_MAX_RX_BUFFERS        4U
+#define RTNET_MAX_TX_BUFFERS        8U
+#define RTNET_MAX_NEIGHBOR_CACHE    4U
+#define RTNET_RX_RING_SIZE          4U
+#define RTNET_DEST_CACHE_SIZE       4U
+#define RTNET_UDP_HASH_SIZE         4U
+#define RTNET_ICMPV6_PEER_SLOTS     4U
+
+/* IPv6 minimum link MTU */
+#define RTNET_MTU_SIZE              1280U
+#define RTNET_BUFFER_SIZE           1312U
+
+/* Context + payload memory per instance */
+#define RTNET_RAM_BUDGET            16384U
+
+#endif /* RTNET_CONFIG_H */
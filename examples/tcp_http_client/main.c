@@ -1,23 +1,56 @@
 #include "rtnet_stack.h"
+#include <stdio.h>
 #include <string.h>
+#if defined(RTNET_PLATFORM_LINUX)
+#include "rtnet_platform_linux.h"
+#endif
 
 static const RTNET_IPv6Addr_t LOCAL_IP = { .addr = {0xFE,0x80,0,0,0,0,0,0,0,0,0,0,0,0,0,2} };
 static const RTNET_MACAddr_t LOCAL_MAC = { .addr = {0x00,0xAA,0xBB,0xCC,0xDD,0xEE} };
 static const RTNET_IPv6Addr_t SERVER_IP = { .addr = {0x20,0x01,0x0D,0xB8,0,0,0,0,0,0,0,0,0,0,0,1} }; /* 2001:db8::1 */
 
-int main(void)
+int main(int argc, char** argv)
 {
+#if defined(RTNET_PLATFORM_LINUX)
+    /* Host: a TAP device or an AF_XDP queue, e.g. "tap:rtn0" or "xdp:eth0:0" */
+    if (RTNET_Linux_Open((argc > 1) ? argv[1] : "tap:rtn0") != RTNET_OK) {
+        printf("[http_client] Cannot open %s\n", (argc > 1) ? argv[1] : "tap:rtn0");
+        return -1;
+    }
+#else
+    (void)argc;
+    (void)argv;
+#endif
+
     RTNET_Initialize(&LOCAL_IP, &LOCAL_MAC);
     RTNET_AddRoute(&SERVER_IP, 128U, NULL, 1U); /* direct for demo */
 
     uint8_t conn_id;
+    bool open = false;
     if (RTNET_TCP_Connect(&SERVER_IP, 80U, &conn_id) == RTNET_OK) {
-        const uint8_t http_get[] = "GET / HTTP/1.1\r\nHost: demo\r\n\r\n";
-        RTNET_TCP_Send(conn_id, http_get, (uint16_t)sizeof(http_get));
-        RTNET_TCP_Close(conn_id);
+        /* Buffered until the handshake completes */
+        const uint8_t http_get[] = "GET / HTTP/1.1\r\nHost: demo\r\nConnection: close\r\n\r\n";
+        RTNET_TCP_Send(conn_id, http_get, (uint16_t)(sizeof(http_get) - 1U));
+        open = true;
     }
 
     for (;;) {
+#if defined(RTNET_PLATFORM_LINUX)
+        (void)RTNET_Linux_Poll(10);
+#endif
+
+        /* Print the response; close once the server has closed its side */
+        if (open) {
+            uint8_t rx[256];
+            uint16_t received = 0U;
+            if (RTNET_TCP_Receive(conn_id, rx, (uint16_t)sizeof(rx), &received) != RTNET_OK) {
+                RTNET_TCP_Close(conn_id);
+                open = false;
+            } else if (received != 0U) {
+                (void)fwrite(rx, 1U, received, stdout);
+            }
+        }
+
         RTNET_PeriodicTask();
     }
 }
@@ -1,11 +1,14 @@
 #include "rtnet_stack.h"
 #include <stdio.h>
 #include <string.h>
+#if defined(RTNET_PLATFORM_LINUX)
+#include "rtnet_platform_linux.h"
+#endif
 
 static const RTNET_IPv6Addr_t LOCAL_IP = { .addr = {0xFE,0x80,0,0,0,0,0,0,0,0,0,0,0,0,0,1} };
 static const RTNET_MACAddr_t  LOCAL_MAC = { .addr = {0x00,0x11,0x22,0x33,0x44,0x55} };
-static const RTNET_IPv6Addr_t REMOTE_IP = { .addr = {0xFE,0x80,0,0,0,0,0,0,0,0,0,0,0,0,0,2} };
 
+#if !defined(RTNET_PLATFORM_LINUX)
 /* On target: invoke from Ethernet RX ISR with the received frame */
 static void ethernet_rx_handler(const uint8_t* frame, uint16_t length)
 {
@@ -13,6 +16,9 @@ static void ethernet_rx_handler(const uint8_t* frame, uint16_t length)
         (void)RTNET_ProcessRxPacket(frame, length);
     }
 }
+#endif
+
+static uint8_t g_echo_socket;
 
 static bool init_stack(void)
 {
@@ -29,32 +35,58 @@ static bool init_stack(void)
         return false;
     }
 
+    /* Echo service (RFC 862): datagrams to port 7 are queued for the loop */
+    if (RTNET_UDP_Bind(7U, NULL, &g_echo_socket) != RTNET_OK) {
+        printf("[udp_echo] Bind failed\n");
+        return false;
+    }
+
     return true;
 }
 
-static void send_echo_demo(void)
+static void serve_echo(void)
 {
-    const uint8_t echo_payload[] = "echo";
-    RTNET_Error_t err = RTNET_UDP_Send(&REMOTE_IP, 7U, 0U,
-                                       echo_payload, (uint16_t)sizeof(echo_payload),
-                                       RTNET_QOS_NORMAL);
-    if (err != RTNET_OK) {
-        printf("[udp_echo] UDP send error: %d\n", err);
+    RTNET_UDPPacket_t pkt;
+
+    while (RTNET_UDP_Recv(g_echo_socket, &pkt) == RTNET_OK) {
+        RTNET_Error_t err = RTNET_UDP_Send(&pkt.src_addr, pkt.src_port, 7U,
+                                           pkt.payload, pkt.payload_len,
+                                           RTNET_QOS_NORMAL);
+        if (err != RTNET_OK) {
+            printf("[udp_echo] UDP send error: %d\n", err);
+        }
+        (void)RTNET_UDP_Release(&pkt);
     }
 }
 
-int main(void)
+int main(int argc, char** argv)
 {
+#if defined(RTNET_PLATFORM_LINUX)
+    /* Host: a TAP device or an AF_XDP queue, e.g. "tap:rtn0" or "xdp:eth0:0" */
+    if (RTNET_Linux_Open((argc > 1) ? argv[1] : "tap:rtn0") != RTNET_OK) {
+        printf("[udp_echo] Cannot open %s\n", (argc > 1) ? argv[1] : "tap:rtn0");
+        return -1;
+    }
+#else
+    (void)argc;
+    (void)argv;
+#endif
+
     if (!init_stack()) {
         return -1;
     }
 
     for (;;) {
+#if defined(RTNET_PLATFORM_LINUX)
+        /* Frames from the device, parsed in place in the RX pool */
+        (void)RTNET_Linux_Poll(10);
+#else
         /* In real firmware, feed frames from ETH driver to the stack */
         ethernet_rx_handler(NULL, 0);
+#endif
 
-        /* Reply/demo send (would typically be triggered by received data) */
-        send_echo_demo();
+        /* Answer everything queued on the echo port */
+        serve_echo();
 
         /* Periodic maintenance for aging and timeouts */
         RTNET_PeriodicTask();
@@ -0,0 +1,388 @@
+/**
+ * @file rtnet_pcap.c
+ * @brief pcap / pcapng frame reader and pcap writer (host tooling)
+ * @version 1.0.0
+ * @date 2026-10-14
+ * @author Seregon
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/platforms/rtnet_pcap.c
+ *
+ * Formats: classic pcap (tcpdump.org "pcap savefile"), pcapng (IETF
+ * draft-ietf-opsawg-pcapng) Section Header, Interface Description,
+ * Enhanced, Simple and obsolete Packet blocks. Every length is checked
+ * against the capture size before use, so a truncated or corrupt file
+ * ends the walk with reader->malformed set.
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include "rtnet_pcap.h"
+#include <string.h>
+
+/* ==================== CONSTANTS ==================== */
+
+#define PCAP_MAGIC_US           0xA1B2C3D4UL
+#define PCAP_MAGIC_NS           0xA1B23C4DUL
+#define PCAP_FILE_HEADER_LEN    24U
+#define PCAP_RECORD_HEADER_LEN  16U
+
+#define PCAPNG_BLOCK_SHB        0x0A0D0D0AUL
+#define PCAPNG_BLOCK_IDB        0x00000001UL
+#define PCAPNG_BLOCK_OPB        0x00000002UL    /* Obsolete Packet Block */
+#define PCAPNG_BLOCK_SPB        0x00000003UL
+#define PCAPNG_BLOCK_EPB        0x00000006UL
+#define PCAPNG_BYTE_ORDER_MAGIC 0x1A2B3C4DUL
+#define PCAPNG_OPT_END          0U
+#define PCAPNG_OPT_IF_TSRESOL   9U
+#define PCAPNG_DEFAULT_TSRESOL  6U              /* Microseconds */
+
+#define NS_PER_SEC              1000000000ULL
+
+/* ==================== FIELD ACCESS ==================== */
+
+static uint16_t pcap_rd16(const RTNET_PcapReader_t* r, const uint8_t* p)
+{
+    return r->big_endian ? (uint16_t)((p[0] << 8U) | p[1])
+                         : (uint16_t)((p[1] << 8U) | p[0]);
+}
+
+static uint32_t pcap_rd32(const RTNET_PcapReader_t* r, const uint8_t* p)
+{
+    return r->big_endian
+        ? (((uint32_t)p[0] << 24U) | ((uint32_t)p[1] << 16U) | ((uint32_t)p[2] << 8U) | p[3])
+        : (((uint32_t)p[3] << 24U) | ((uint32_t)p[2] << 16U) | ((uint32_t)p[1] << 8U) | p[0]);
+}
+
+/**
+ * @brief Bytes left from the read position
+ */
+static size_t pcap_left(const RTNET_PcapReader_t* r)
+{
+    return r->size - r->pos;
+}
+
+/**
+ * @brief Timestamp in if_tsresol units to ns
+ * @note Bit 7 set: 2^-n seconds, else 10^-n seconds
+ */
+static uint64_t pcap_ts_ns(uint64_t ts, uint8_t tsresol)
+{
+    const uint8_t n = (uint8_t)(tsresol & 0x7FU);
+
+    if ((tsresol & 0x80U) != 0U) {
+        if (n >= 64U) {
+            return 0U;
+        }
+        uint64_t frac = ts & ((1ULL << n) - 1U);
+        uint8_t shift = n;
+        if (shift > 32U) {
+            frac >>= (shift - 32U);     /* Keeps frac x 1e9 inside 64 bits */
+            shift = 32U;
+        }
+        return ((ts >> n) * NS_PER_SEC) + ((frac * NS_PER_SEC) >> shift);
+    }
+
+    uint64_t scale = 1U;
+    if (n <= 9U) {
+        for (uint8_t i = n; i < 9U; i++) {
+            scale *= 10U;
+        }
+        return ts * scale;
+    }
+    for (uint8_t i = 9U; (i < n) && (i < 28U); i++) {
+        scale *= 10U;
+        if (scale > ts) {
+            return 0U;
+        }
+    }
+    return ts / scale;
+}
+
+/* ==================== CLASSIC PCAP ==================== */
+
+static bool pcap_next_classic(RTNET_PcapReader_t* r, RTNET_PcapFrame_t* frame)
+{
+    if (pcap_left(r) == 0U) {
+        return false;
+    }
+    if (pcap_left(r) < PCAP_RECORD_HEADER_LEN) {
+        r->malformed = true;
+        return false;
+    }
+
+    const uint8_t* hdr = &r->data[r->pos];
+    const uint32_t caplen = pcap_rd32(r, &hdr[8]);
+    if (caplen > (pcap_left(r) - PCAP_RECORD_HEADER_LEN)) {
+        r->malformed = true;
+        return false;
+    }
+
+    const uint64_t frac = pcap_rd32(r, &hdr[4]);
+    frame->data = &hdr[PCAP_RECORD_HEADER_LEN];
+    frame->caplen = caplen;
+    frame->origlen = pcap_rd32(r, &hdr[12]);
+    frame->ts_ns = ((uint64_t)pcap_rd32(r, &hdr[0]) * NS_PER_SEC) +
+                   ((r->ts_units == 1000000U) ? (frac * 1000U) : frac);
+    r->pos += PCAP_RECORD_HEADER_LEN + caplen;
+    return true;
+}
+
+/* ==================== PCAPNG ==================== */
+
+/**
+ * @brief Section Header Block at r->pos: byte order, reset interfaces
+ * @return false if the byte-order magic is not recognised
+ */
+static bool pcapng_section(RTNET_PcapReader_t* r, const uint8_t* block)
+{
+    if ((block[8] == 0x1AU) && (block[9] == 0x2BU)) {
+        r->big_endian = true;
+    } else if ((block[11] == 0x1AU) && (block[10] == 0x2BU)) {
+        r->big_endian = false;
+    } else {
+        return false;
+    }
+
+    r->if_count = 0U;
+    return (pcap_rd32(r, &block[8]) == PCAPNG_BYTE_ORDER_MAGIC);
+}
+
+/**
+ * @brief Interface Description Block: link type and if_tsresol
+ */
+static void pcapng_interface(RTNET_PcapReader_t* r, const uint8_t* block, uint32_t block_len)
+{
+    if (r->if_count >= RTNET_PCAP_MAX_INTERFACES) {
+        r->if_count++;                  /* Frames on it are skipped */
+        return;
+    }
+
+    const uint8_t idx = r->if_count;
+    r->if_linktype[idx] = pcap_rd16(r, &block[8]);
+    r->if_tsresol[idx] = PCAPNG_DEFAULT_TSRESOL;
+
+    /* Options between the fixed fields and the trailing length */
+    uint32_t pos = 16U;
+    while ((pos + 4U) <= (block_len - 4U)) {
+        const uint16_t code = pcap_rd16(r, &block[pos]);
+        const uint16_t len = pcap_rd16(r, &block[pos + 2U]);
+        if ((code == PCAPNG_OPT_END) || ((pos + 4U + len) > (block_len - 4U))) {
+            break;
+        }
+        if ((code == PCAPNG_OPT_IF_TSRESOL) && (len >= 1U)) {
+            r->if_tsresol[idx] = block[pos + 4U];
+        }
+        pos += 4U + (((uint32_t)len + 3U) & ~3U);
+    }
+
+    r->if_count++;
+}
+
+/**
+ * @brief Fill a frame from a packet block body
+ * @return false if the frame must be skipped (interface or link type)
+ */
+static bool pcapng_packet(RTNET_PcapReader_t* r, uint32_t if_id, uint64_t ts,
+                          const uint8_t* data, uint32_t caplen, uint32_t origlen,
+                          RTNET_PcapFrame_t* frame)
+{
+    if ((if_id >= r->if_count) || (if_id >= RTNET_PCAP_MAX_INTERFACES) ||
+        (r->if_linktype[if_id] != RTNET_PCAP_LINKTYPE_ETHERNET)) {
+        r->skipped++;
+        return false;
+    }
+
+    frame->data = data;
+    frame->caplen = caplen;
+    frame->origlen = origlen;
+    frame->ts_ns = pcap_ts_ns(ts, r->if_tsresol[if_id]);
+    r->last_ts_ns = frame->ts_ns;
+    return true;
+}
+
+static bool pcap_next_ng(RTNET_PcapReader_t* r, RTNET_PcapFrame_t* frame)
+{
+    while (pcap_left(r) != 0U) {
+        if (pcap_left(r) < 12U) {
+            r->malformed = true;
+            return false;
+        }
+
+        const uint8_t* block = &r->data[r->pos];
+        const uint32_t type = pcap_rd32(r, &block[0]);
+        if ((type == PCAPNG_BLOCK_SHB) && !pcapng_section(r, block)) {
+            r->malformed = true;
+            return false;
+        }
+
+        const uint32_t block_len = pcap_rd32(r, &block[4]);
+        if ((block_len < 12U) || ((block_len & 3U) != 0U) || (block_len > pcap_left(r))) {
+            r->malformed = true;
+            return false;
+        }
+        r->pos += block_len;
+
+        bool have = false;
+        if ((type == PCAPNG_BLOCK_IDB) && (block_len >= 20U)) {
+            pcapng_interface(r, block, block_len);
+        } else if (((type == PCAPNG_BLOCK_EPB) || (type == PCAPNG_BLOCK_OPB)) &&
+                   (block_len >= 32U)) {
+            const uint32_t caplen = pcap_rd32(r, &block[20]);
+            if (caplen > (block_len - 32U)) {
+                r->malformed = true;
+                return false;
+            }
+            const uint32_t if_id = (type == PCAPNG_BLOCK_EPB) ? pcap_rd32(r, &block[8])
+                                                              : pcap_rd16(r, &block[8]);
+            const uint64_t ts = ((uint64_t)pcap_rd32(r, &block[12]) << 32U) |
+                                pcap_rd32(r, &block[16]);
+            have = pcapng_packet(r, if_id, ts, &block[28], caplen, pcap_rd32(r, &block[24]),
+                                 frame);
+        } else if ((type == PCAPNG_BLOCK_SPB) && (block_len >= 16U)) {
+            /* No timestamp and no captured length: interface 0, origlen cut
+             * to the block; the previous frame's time is reused */
+            const uint32_t origlen = pcap_rd32(r, &block[8]);
+            const uint32_t room = block_len - 16U;
+            const uint64_t last_ts = r->last_ts_ns;
+            have = pcapng_packet(r, 0U, 0U, &block[12], (origlen < room) ? origlen : room,
+                                 origlen, frame);
+            if (have) {
+                frame->ts_ns = last_ts;
+                r->last_ts_ns = last_ts;
+            }
+        } else {
+            /* Name resolution, statistics, custom and unknown blocks */
+        }
+
+        if (have) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* ==================== READER ==================== */
+
+RTNET_Error_t RTNET_PcapReader_Init(RTNET_PcapReader_t* reader, const uint8_t* data, size_t size)
+{
+    if ((reader == NULL) || (data == NULL) || (size < 12U)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    memset(reader, 0, sizeof(*reader));
+    reader->data = data;
+    reader->size = size;
+
+    /* pcapng: the SHB is parsed by the first Next call */
+    if ((data[0] == 0x0AU) && (data[1] == 0x0DU) && (data[2] == 0x0DU) && (data[3] == 0x0AU)) {
+        reader->pcapng = true;
+        return RTNET_OK;
+    }
+
+    if (size < PCAP_FILE_HEADER_LEN) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    reader->big_endian = true;
+    uint32_t magic = pcap_rd32(reader, data);
+    if ((magic != PCAP_MAGIC_US) && (magic != PCAP_MAGIC_NS)) {
+        reader->big_endian = false;
+        magic = pcap_rd32(reader, data);
+    }
+    if ((magic != PCAP_MAGIC_US) && (magic != PCAP_MAGIC_NS)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    reader->ts_units = (magic == PCAP_MAGIC_NS) ? 1000000000U : 1000000U;
+    reader->linktype = pcap_rd32(reader, &data[20]) & 0xFFFFU;  /* Upper bits: FCS info */
+    if (reader->linktype != RTNET_PCAP_LINKTYPE_ETHERNET) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    reader->pos = PCAP_FILE_HEADER_LEN;
+    return RTNET_OK;
+}
+
+bool RTNET_PcapReader_Next(RTNET_PcapReader_t* reader, RTNET_PcapFrame_t* frame)
+{
+    if ((reader == NULL) || (frame == NULL) || (reader->data == NULL)) {
+        return false;
+    }
+
+    return reader->pcapng ? pcap_next_ng(reader, frame) : pcap_next_classic(reader, frame);
+}
+
+/* ==================== WRITER ==================== */
+
+/**
+ * @brief Write a 32-bit little-endian field (file is little-endian on every host)
+ */
+static void pcap_put32(FILE* file, uint32_t value)
+{
+    const uint8_t b[4] = {
+        (uint8_t)value, (uint8_t)(value >> 8U), (uint8_t)(value >> 16U), (uint8_t)(value >> 24U)
+    };
+    (void)fwrite(b, 1U, sizeof(b), file);
+}
+
+RTNET_Error_t RTNET_PcapWriter_Open(RTNET_PcapWriter_t* writer, const char* path)
+{
+    if ((writer == NULL) || (path == NULL)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    writer->frames = 0U;
+    writer->file = fopen(path, "wb");
+    if (writer->file == NULL) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    pcap_put32(writer->file, PCAP_MAGIC_NS);
+    pcap_put32(writer->file, 0x00040002UL);         /* Version 2.4 */
+    pcap_put32(writer->file, 0U);                   /* thiszone */
+    pcap_put32(writer->file, 0U);                   /* sigfigs */
+    pcap_put32(writer->file, 65535U);               /* snaplen */
+    pcap_put32(writer->file, RTNET_PCAP_LINKTYPE_ETHERNET);
+    return RTNET_OK;
+}
+
+void RTNET_PcapWriter_Write(RTNET_PcapWriter_t* writer, const uint8_t* data, uint16_t length,
+                            uint64_t ts_ns)
+{
+    if ((writer == NULL) || (writer->file == NULL) || (data == NULL)) {
+        return;
+    }
+
+    pcap_put32(writer->file, (uint32_t)(ts_ns / NS_PER_SEC));
+    pcap_put32(writer->file, (uint32_t)(ts_ns % NS_PER_SEC));
+    pcap_put32(writer->file, length);
+    pcap_put32(writer->file, length);
+    (void)fwrite(data, 1U, length, writer->file);
+    writer->frames++;
+}
+
+void RTNET_PcapWriter_Close(RTNET_PcapWriter_t* writer)
+{
+    if ((writer != NULL) && (writer->file != NULL)) {
+        (void)fclose(writer->file);
+        writer->file = NULL;
+    }
+}
@@ -0,0 +1,123 @@
+/**
+ * @file rtnet_pcap.h
+ * @brief pcap / pcapng frame reader and pcap writer (host tooling)
+ * @version 1.0.0
+ * @date 2026-10-14
+ * @author Seregon
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/platforms/rtnet_pcap.h
+ *
+ * The reader walks a capture held in memory (typically a read-only file
+ * mapping) without copying frames. It accepts classic pcap in either byte
+ * order with microsecond or nanosecond timestamps, and pcapng with any
+ * number of sections and interfaces (per-interface if_tsresol). Only
+ * Ethernet (LINKTYPE_ETHERNET) frames are returned; others are counted
+ * and skipped. The writer produces nanosecond pcap.
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef RTNET_PCAP_H
+#define RTNET_PCAP_H
+
+#include "rtnet_stack.h"
+#include <stddef.h>
+#include <stdio.h>
+
+#define RTNET_PCAP_LINKTYPE_ETHERNET    1U
+#define RTNET_PCAP_MAX_INTERFACES       8U   /* pcapng interfaces per section */
+
+/**
+ * @brief One captured frame (points into the capture memory)
+ */
+typedef struct {
+    const uint8_t* data;
+    uint32_t caplen;            /* Bytes present */
+    uint32_t origlen;           /* Bytes on the wire (> caplen if truncated) */
+    uint64_t ts_ns;             /* Capture timestamp, ns since the epoch */
+} RTNET_PcapFrame_t;
+
+/**
+ * @brief Reader state
+ */
+typedef struct {
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+    bool pcapng;
+    bool big_endian;            /* Byte order of the file (current section) */
+    bool malformed;             /* Set when a record runs past the end */
+    uint32_t linktype;          /* Classic pcap */
+    uint32_t ts_units;          /* Classic pcap: 1e6 or 1e9 per second */
+    uint8_t if_count;           /* pcapng: interfaces in this section */
+    uint32_t if_linktype[RTNET_PCAP_MAX_INTERFACES];
+    uint8_t if_tsresol[RTNET_PCAP_MAX_INTERFACES];
+    uint64_t last_ts_ns;        /* Given to pcapng simple packets (no timestamp) */
+    uint32_t skipped;           /* Non-Ethernet or unknown-interface frames */
+} RTNET_PcapReader_t;
+
+/**
+ * @brief Writer state
+ */
+typedef struct {
+    FILE* file;
+    uint32_t frames;
+} RTNET_PcapWriter_t;
+
+/**
+ * @brief Start reading a capture held in memory
+ * @param reader Reader state
+ * @param data Capture bytes (must outlive the reader)
+ * @param size Capture length
+ * @return RTNET_OK, RTNET_ERR_INVALID_PARAM for an unknown format or a
+ *         classic capture that is not Ethernet
+ */
+RTNET_Error_t RTNET_PcapReader_Init(RTNET_PcapReader_t* reader, const uint8_t* data, size_t size);
+
+/**
+ * @brief Next Ethernet frame
+ * @param reader Reader state
+ * @param frame [OUT] Frame pointing into the capture
+ * @return true if a frame was returned, false at the end of the capture
+ *         (reader->malformed tells a truncated file from a clean end)
+ */
+bool RTNET_PcapReader_Next(RTNET_PcapReader_t* reader, RTNET_PcapFrame_t* frame);
+
+/**
+ * @brief Create a nanosecond Ethernet pcap file
+ * @return RTNET_OK, RTNET_ERR_INVALID_PARAM if the file cannot be created
+ */
+RTNET_Error_t RTNET_PcapWriter_Open(RTNET_PcapWriter_t* writer, const char* path);
+
+/**
+ * @brief Append one frame
+ * @param ts_ns Timestamp in ns
+ */
+void RTNET_PcapWriter_Write(RTNET_PcapWriter_t* writer, const uint8_t* data, uint16_t length,
+                            uint64_t ts_ns);
+
+/**
+ * @brief Flush and close (no-op if not open)
+ */
+void RTNET_PcapWriter_Close(RTNET_PcapWriter_t* writer);
+
+#endif /* RTNET_PCAP_H */
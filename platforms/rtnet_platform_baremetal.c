@@ -30,6 +30,7 @@ SOFTWARE.
  */
 
 #include "rtnet_stack.h"
+#include <stddef.h>
 #include <stdint.h>
 
 #if defined(_MSC_VER)
@@ -46,6 +47,16 @@ RTNET_WEAK void RTNET_Platform_EthTransmit(const uint8_t* data, uint16_t length)
     /* Implement MAC driver TX here */
 }
 
+/* Board-specific offload capabilities; override when the MAC verifies/inserts
+ * checksums (e.g. STM32 ETH checksum offload with drop-on-error, i.MX RT ENET
+ * RX/TX accelerators). Default: everything done in software. */
+RTNET_WEAK void RTNET_Platform_GetHardwareCaps(RTNET_HardwareCaps_t* caps)
+{
+    caps->rx_csum = 0U;
+    caps->tx_csum = 0U;
+    caps->tx_features = 0U;  /* e.g. RTNET_HWCAP_TX_LAUNCH_TIME on TSN MACs */
+}
+
 /* Weak hooks for IRQ control; override with MCU-specific intrinsics */
 RTNET_WEAK void RTNET_Platform_DisableIRQ(void)
 {
@@ -75,13 +86,126 @@ uint32_t RTNET_GetTimeMs(void)
     return g_time_ms;
 }
 
+/* Board-specific microsecond clock for time-aware TX gating; override with a
+ * free-running hardware timer (DWT cycle counter, a 1 MHz timer, or the MAC's
+ * PTP clock when launch time is used, so both run on the same time base).
+ * Default: the millisecond tick scaled, which only suits gate intervals of
+ * several milliseconds. */
+RTNET_WEAK uint32_t RTNET_Platform_GetTimeUs(void)
+{
+    return g_time_ms * 1000U;
+}
+
+uint32_t RTNET_GetTimeUs(void)
+{
+    return RTNET_Platform_GetTimeUs();
+}
+
+/* Free-running cycle counter for the latency probes. Default: DWT CYCCNT on
+ * Cortex-M3/M4/M7/M33 (enabled on first use), else the microsecond clock.
+ * Override to use another counter or when a debugger owns the DWT. */
+RTNET_WEAK uint32_t RTNET_Platform_GetCycleCount(void)
+{
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+    volatile uint32_t* const demcr = (volatile uint32_t*)0xE000EDFCUL;
+    volatile uint32_t* const dwt_ctrl = (volatile uint32_t*)0xE0001000UL;
+    volatile uint32_t* const dwt_cyccnt = (volatile uint32_t*)0xE0001004UL;
+    
+    if ((*dwt_ctrl & 1UL) == 0UL) {
+        *demcr |= (1UL << 24U);     /* TRCENA */
+        *dwt_ctrl |= 1UL;           /* CYCCNTENA */
+    }
+    return *dwt_cyccnt;
+#else
+    return RTNET_GetTimeUs();
+#endif
+}
+
+uint32_t RTNET_GetCycleCount(void)
+{
+    return RTNET_Platform_GetCycleCount();
+}
+
+/* Execution context, selects the statistics counter block. Default: IPSR on
+ * Cortex-M (non-zero in any exception handler), else always task context,
+ * in which case an ISR that calls into the stack shares the task block. */
+RTNET_WEAK bool RTNET_Platform_InInterrupt(void)
+{
+#if (defined(__ARM_ARCH_6M__) || defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+     defined(__ARM_ARCH_8M_BASE__) || defined(__ARM_ARCH_8M_MAIN__)) && defined(__GNUC__)
+    uint32_t ipsr;
+    __asm volatile ("mrs %0, ipsr" : "=r" (ipsr));
+    return (ipsr != 0U);
+#else
+    return false;
+#endif
+}
+
+bool RTNET_InInterrupt(void)
+{
+    return RTNET_Platform_InInterrupt();
+}
+
 void RTNET_HardwareTransmit(const uint8_t* data, uint16_t length)
 {
     RTNET_Platform_EthTransmit(data, length);
 }
 
+/* Board-specific burst transmit; override to fill several DMA descriptors
+ * and ring the doorbell once. Default: one RTNET_Platform_EthTransmit per frame. */
+RTNET_WEAK void RTNET_Platform_EthTransmitBatch(const RTNET_TxFrame_t* frames, uint16_t count)
+{
+    for (uint16_t i = 0U; i < count; i++) {
+        RTNET_Platform_EthTransmit(frames[i].data, frames[i].length);
+    }
+}
+
+void RTNET_HardwareTransmitBatch(const RTNET_TxFrame_t* frames, uint16_t count)
+{
+    if (frames != NULL) {
+        RTNET_Platform_EthTransmitBatch(frames, count);
+    }
+}
+
+/* Board-specific TX descriptor count; override to report the free slots of
+ * the MAC TX ring so frames wait in the stack's priority queues instead of
+ * in the DMA ring. Call RTNET_PollTx from the TX-complete path. Default:
+ * the MAC always accepts (transmit is synchronous). */
+RTNET_WEAK uint16_t RTNET_Platform_EthTxSpace(void)
+{
+    return UINT16_MAX;
+}
+
+uint16_t RTNET_HardwareTxSpace(void)
+{
+    return RTNET_Platform_EthTxSpace();
+}
+
 /* Call this from a 1ms ISR (e.g., SysTick) to advance time */
 void RTNET_Platform_Tick1ms(void)
 {
     g_time_ms++;
 }
+
+void RTNET_GetHardwareCaps(RTNET_HardwareCaps_t* caps)
+{
+    if (caps != NULL) {
+        RTNET_Platform_GetHardwareCaps(caps);
+    }
+}
+
+/* Deferred RX: call from the Ethernet RX ISR of the port with a filled buffer
+ * obtained from that instance's RTNET_AllocRxBuffer() (ctx NULL = built-in
+ * instance), then drain with RTNET_PollRx(budget) from the main loop with
+ * the instance selected. On RTNET_ERR_NO_BUFFER the ISR still owns the buffer. */
+RTNET_Error_t RTNET_Platform_RxFromISR(RTNET_Context_t* ctx, RTNET_Buffer_t* buffer)
+{
+    return RTNET_EnqueueRxBufferTo(ctx, buffer);
+}
+
+/* Bare metal has nothing to wake: poll bound sockets with
+ * RTNET_UDP_Pending/RTNET_UDP_Recv after RTNET_PollRx. */
+void RTNET_UDPNotify(uint8_t socket_id)
+{
+    (void)socket_id;
+}
@@ -40,6 +40,14 @@ SOFTWARE.
     #define RTNET_WEAK __attribute__((weak))
 #endif
 
+#ifndef RTNET_PLATFORM_RX_BUDGET
+    #define RTNET_PLATFORM_RX_BUDGET 4U  /* Frames parsed per RTNET_PollRx batch */
+#endif
+
+#ifndef RTNET_PLATFORM_MAX_INTERFACES
+    #define RTNET_PLATFORM_MAX_INTERFACES 2U  /* Instances served, interface ids 0 .. n-1 */
+#endif
+
 /* Optional software loopback (for bring-up without NIC) */
 static bool g_loopback_enabled = false;
 
@@ -59,6 +67,16 @@ RTNET_WEAK void RTNET_Platform_EthTransmit(const uint8_t* data, uint16_t length)
     /* Otherwise: drop silently; override this function in BSP for real TX */
 }
 
+/* Board-specific offload capabilities; override when the MAC verifies/inserts
+ * checksums (e.g. STM32 ETH checksum offload with drop-on-error, i.MX RT ENET
+ * RX/TX accelerators). Default: everything done in software. */
+RTNET_WEAK void RTNET_Platform_GetHardwareCaps(RTNET_HardwareCaps_t* caps)
+{
+    caps->rx_csum = 0U;
+    caps->tx_csum = 0U;
+    caps->tx_features = 0U;  /* e.g. RTNET_HWCAP_TX_LAUNCH_TIME on TSN MACs */
+}
+
 void RTNET_CriticalSectionEnter(void)
 {
     taskENTER_CRITICAL();
@@ -74,7 +92,202 @@ uint32_t RTNET_GetTimeMs(void)
     return (uint32_t)(xTaskGetTickCount() * (TickType_t)portTICK_PERIOD_MS);
 }
 
+/* Board-specific microsecond clock for time-aware TX gating; override with a
+ * free-running hardware timer (DWT cycle counter, a 1 MHz timer, or the MAC's
+ * PTP clock when launch time is used, so both run on the same time base).
+ * Default: the millisecond tick scaled, which only suits gate intervals of
+ * several milliseconds. */
+RTNET_WEAK uint32_t RTNET_Platform_GetTimeUs(void)
+{
+    return RTNET_GetTimeMs() * 1000U;
+}
+
+uint32_t RTNET_GetTimeUs(void)
+{
+    return RTNET_Platform_GetTimeUs();
+}
+
+/* Free-running cycle counter for the latency probes. Default: DWT CYCCNT on
+ * Cortex-M3/M4/M7/M33 (enabled on first use), else the microsecond clock.
+ * Override to use another counter or when a debugger owns the DWT. */
+RTNET_WEAK uint32_t RTNET_Platform_GetCycleCount(void)
+{
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+    volatile uint32_t* const demcr = (volatile uint32_t*)0xE000EDFCUL;
+    volatile uint32_t* const dwt_ctrl = (volatile uint32_t*)0xE0001000UL;
+    volatile uint32_t* const dwt_cyccnt = (volatile uint32_t*)0xE0001004UL;
+    
+    if ((*dwt_ctrl & 1UL) == 0UL) {
+        *demcr |= (1UL << 24U);     /* TRCENA */
+        *dwt_ctrl |= 1UL;           /* CYCCNTENA */
+    }
+    return *dwt_cyccnt;
+#else
+    return RTNET_GetTimeUs();
+#endif
+}
+
+uint32_t RTNET_GetCycleCount(void)
+{
+    return RTNET_Platform_GetCycleCount();
+}
+
+/* Execution context, selects the statistics counter block. Default: IPSR on
+ * Cortex-M (non-zero in any exception handler), else always task context,
+ * in which case an ISR that calls into the stack shares the task block. */
+RTNET_WEAK bool RTNET_Platform_InInterrupt(void)
+{
+#if (defined(__ARM_ARCH_6M__) || defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+     defined(__ARM_ARCH_8M_BASE__) || defined(__ARM_ARCH_8M_MAIN__)) && defined(__GNUC__)
+    uint32_t ipsr;
+    __asm volatile ("mrs %0, ipsr" : "=r" (ipsr));
+    return (ipsr != 0U);
+#else
+    return false;
+#endif
+}
+
+bool RTNET_InInterrupt(void)
+{
+    return RTNET_Platform_InInterrupt();
+}
+
 void RTNET_HardwareTransmit(const uint8_t* data, uint16_t length)
 {
     RTNET_Platform_EthTransmit(data, length);
 }
+
+/* Board-specific burst transmit; override to fill several DMA descriptors
+ * and ring the doorbell once. Default: one RTNET_Platform_EthTransmit per frame. */
+RTNET_WEAK void RTNET_Platform_EthTransmitBatch(const RTNET_TxFrame_t* frames, uint16_t count)
+{
+    for (uint16_t i = 0U; i < count; i++) {
+        RTNET_Platform_EthTransmit(frames[i].data, frames[i].length);
+    }
+}
+
+void RTNET_HardwareTransmitBatch(const RTNET_TxFrame_t* frames, uint16_t count)
+{
+    if (frames != NULL) {
+        RTNET_Platform_EthTransmitBatch(frames, count);
+    }
+}
+
+/* Board-specific TX descriptor count; override to report the free slots of
+ * the MAC TX ring so frames wait in the stack's priority queues instead of
+ * in the DMA ring. Call RTNET_PollTx from the TX-complete path. Default:
+ * the MAC always accepts (transmit is synchronous). */
+RTNET_WEAK uint16_t RTNET_Platform_EthTxSpace(void)
+{
+    return UINT16_MAX;
+}
+
+uint16_t RTNET_HardwareTxSpace(void)
+{
+    return RTNET_Platform_EthTxSpace();
+}
+
+void RTNET_GetHardwareCaps(RTNET_HardwareCaps_t* caps)
+{
+    if (caps != NULL) {
+        RTNET_Platform_GetHardwareCaps(caps);
+    }
+}
+
+/* Per-instance task handles, indexed by interface id (RTNET_ContextBind).
+ * The built-in instance is interface 0. */
+typedef struct {
+    TaskHandle_t rx_task;
+    TaskHandle_t udp_waiter[RTNET_UDP_MAX_SOCKETS];
+} RTNET_PlatformPort_t;
+
+static RTNET_PlatformPort_t g_ports[RTNET_PLATFORM_MAX_INTERFACES];
+
+static RTNET_PlatformPort_t* RTNET_Platform_Port(uint8_t interface_id)
+{
+    return (interface_id < RTNET_PLATFORM_MAX_INTERFACES) ? &g_ports[interface_id] : NULL;
+}
+
+/* Deferred RX: call from the Ethernet RX ISR of the port with a filled
+ * buffer obtained from that instance's RTNET_AllocRxBuffer() (ctx NULL =
+ * built-in instance). The ISR only queues the descriptor and wakes the
+ * instance's network task; the instance the interrupted code selected is
+ * left as it was. On RTNET_ERR_NO_BUFFER the ISR still owns the buffer
+ * (re-arm it). */
+RTNET_Error_t RTNET_Platform_RxFromISR(RTNET_Context_t* ctx, RTNET_Buffer_t* buffer)
+{
+    RTNET_Error_t err = RTNET_EnqueueRxBufferTo(ctx, buffer);
+    const RTNET_PlatformPort_t* port = RTNET_Platform_Port((ctx != NULL) ? ctx->interface_id : 0U);
+    
+    if ((err == RTNET_OK) && (port != NULL) && (port->rx_task != NULL)) {
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(port->rx_task, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+    
+    return err;
+}
+
+/* Network task body, one per instance, e.g.
+ * xTaskCreate(RTNET_Platform_RxTask, "rtnet_b", ..., &g_port_b, ...);
+ * arg NULL serves the built-in instance. The task selects its instance, so
+ * several of them need -DRTNET_THREAD_LOCAL (see RTNET_SelectContext).
+ * Drains the ring in RTNET_PLATFORM_RX_BUDGET batches and yields between
+ * full batches so equal-priority tasks are not starved under load. */
+void RTNET_Platform_RxTask(void* arg)
+{
+    (void)RTNET_SelectContext((RTNET_Context_t*)arg);
+    RTNET_PlatformPort_t* port = RTNET_Platform_Port(RTNET_GetInterfaceId());
+    configASSERT(port != NULL);  /* Interface id >= RTNET_PLATFORM_MAX_INTERFACES */
+    if (port != NULL) {
+        port->rx_task = xTaskGetCurrentTaskHandle();
+    }
+    
+    for (;;) {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while (RTNET_PollRx(RTNET_PLATFORM_RX_BUDGET) == RTNET_PLATFORM_RX_BUDGET) {
+            taskYIELD();
+        }
+    }
+}
+
+/* Blocking UDP receive for a socket bound in queue mode on the instance
+ * current in the calling task. One task may wait per socket; RTNET_UDPNotify,
+ * called by the stack from that instance's network task, wakes it with a
+ * task notification. timeout is in ticks (portMAX_DELAY waits forever). */
+void RTNET_UDPNotify(uint8_t socket_id)
+{
+    const RTNET_PlatformPort_t* port = RTNET_Platform_Port(RTNET_GetInterfaceId());
+    
+    if ((port != NULL) && (socket_id < RTNET_UDP_MAX_SOCKETS) &&
+        (port->udp_waiter[socket_id] != NULL)) {
+        xTaskNotifyGive(port->udp_waiter[socket_id]);
+    }
+}
+
+RTNET_Error_t RTNET_Platform_UDPReceive(uint8_t socket_id,
+                                        RTNET_UDPPacket_t* packet,
+                                        TickType_t timeout)
+{
+    RTNET_PlatformPort_t* port = RTNET_Platform_Port(RTNET_GetInterfaceId());
+    
+    if ((port == NULL) || (socket_id >= RTNET_UDP_MAX_SOCKETS)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    TimeOut_t timeout_state;
+    vTaskSetTimeOutState(&timeout_state);
+    port->udp_waiter[socket_id] = xTaskGetCurrentTaskHandle();
+    
+    /* A datagram queued between the check and the wait leaves the
+     * notification pending, so the take returns at once */
+    RTNET_Error_t err = RTNET_UDP_Recv(socket_id, packet);
+    while ((err == RTNET_ERR_TIMEOUT) &&
+           (xTaskCheckForTimeOut(&timeout_state, &timeout) == pdFALSE)) {
+        (void)ulTaskNotifyTake(pdTRUE, timeout);
+        err = RTNET_UDP_Recv(socket_id, packet);
+    }
+    
+    port->udp_waiter[socket_id] = NULL;
+    return err;
+}
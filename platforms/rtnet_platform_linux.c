@@ -0,0 +1,742 @@
+/**
+ * @file rtnet_platform_linux.c
+ * @brief Linux host platform hooks: TAP device or AF_XDP socket, spinlock, CLOCK_MONOTONIC
+ * @version 1.0.0
+ * @date 2026-10-14
+ * @author Seregon
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/platforms/rtnet_platform_linux.c
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#define _GNU_SOURCE     /* struct ifreq, syscall() */
+
+#include "rtnet_platform_linux.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <linux/bpf.h>
+#include <linux/if_link.h>
+#include <linux/if_tun.h>
+#include <linux/if_xdp.h>
+
+#define RTNET_WEAK __attribute__((weak))
+
+#ifndef RTNET_LINUX_RX_BUDGET
+    #define RTNET_LINUX_RX_BUDGET       64U     /* Frames read per RTNET_Linux_Poll */
+#endif
+#ifndef RTNET_LINUX_XDP_RING_SIZE
+    #define RTNET_LINUX_XDP_RING_SIZE   512U    /* AF_XDP rings, power of two >= RX pool */
+#endif
+#ifndef RTNET_LINUX_XDP_TX_FRAMES
+    #define RTNET_LINUX_XDP_TX_FRAMES   256U    /* UMEM TX chunks (<= ring size) */
+#endif
+
+#ifndef SOL_XDP
+    #define SOL_XDP 283
+#endif
+
+/* Chunk layout of the UMEM: TX chunks first, then the stack's RX pool
+ * arena (RTNET_Memory_t starts with it), one chunk per RX buffer */
+#define LINUX_XDP_RX_BASE   ((uint64_t)RTNET_LINUX_XDP_TX_FRAMES * RTNET_BUFFER_SIZE)
+#define LINUX_XDP_UMEM_LEN  (LINUX_XDP_RX_BASE + ((uint64_t)RTNET_RX_POOL_SIZE * RTNET_BUFFER_SIZE))
+
+/* ==================== STATE ==================== */
+
+typedef enum {
+    LINUX_BACKEND_NONE = 0,
+    LINUX_BACKEND_TAP,
+    LINUX_BACKEND_XDP
+} LinuxBackend_t;
+
+/**
+ * @brief One mmap'd AF_XDP ring (we are the only producer or consumer)
+ */
+typedef struct {
+    uint32_t* producer;
+    uint32_t* consumer;
+    uint32_t* flags;
+    void* desc;
+    uint32_t cached;            /* Our side's index: producer or consumer */
+    void* map;
+    size_t map_len;
+} LinuxRing_t;
+
+static LinuxBackend_t g_backend = LINUX_BACKEND_NONE;
+static int g_fd = -1;
+static RTNET_Context_t* g_ctx = NULL;       /* Instance the device feeds */
+static RTNET_LinuxStats_t g_stats;
+
+static bool g_lock = false;
+static _Thread_local uint32_t t_lock_depth = 0U;
+
+/* AF_XDP */
+static RTNET_Context_t g_xdp_ctx;
+static uint8_t* g_umem = NULL;
+static size_t g_umem_map_len = 0U;
+static LinuxRing_t g_rx_ring;
+static LinuxRing_t g_tx_ring;
+static LinuxRing_t g_fill_ring;
+static LinuxRing_t g_comp_ring;
+static RTNET_Buffer_t* g_rx_chunk[RTNET_RX_POOL_SIZE];     /* Posted to the fill ring */
+static uint64_t g_tx_free[RTNET_LINUX_XDP_TX_FRAMES];
+static uint32_t g_tx_free_count = 0U;
+static bool g_need_wakeup = false;
+static int g_map_fd = -1;
+static int g_prog_fd = -1;
+static int g_link_fd = -1;
+
+/* ==================== PLATFORM HOOKS ==================== */
+
+static inline void linux_cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ volatile ("yield");
+#endif
+}
+
+/* Spinlock, nesting counted per thread: a short critical section never
+ * sleeps, like the IRQ-disable sections of the MCU ports */
+void RTNET_CriticalSectionEnter(void)
+{
+    if (t_lock_depth++ == 0U) {
+        while (__atomic_test_and_set(&g_lock, __ATOMIC_ACQUIRE)) {
+            linux_cpu_relax();
+        }
+    }
+}
+
+void RTNET_CriticalSectionExit(void)
+{
+    if (--t_lock_depth == 0U) {
+        __atomic_clear(&g_lock, __ATOMIC_RELEASE);
+    }
+}
+
+static uint64_t linux_monotonic_ns(void)
+{
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+uint32_t RTNET_GetTimeMs(void)
+{
+    return (uint32_t)(linux_monotonic_ns() / 1000000ULL);
+}
+
+uint32_t RTNET_GetTimeUs(void)
+{
+    return (uint32_t)(linux_monotonic_ns() / 1000ULL);
+}
+
+uint32_t RTNET_GetCycleCount(void)
+{
+    return (uint32_t)linux_monotonic_ns();
+}
+
+bool RTNET_InInterrupt(void)
+{
+    return false;
+}
+
+void RTNET_GetHardwareCaps(RTNET_HardwareCaps_t* caps)
+{
+    /* TAP and AF_XDP hand over raw frames: checksums in software */
+    if (caps != NULL) {
+        caps->rx_csum = 0U;
+        caps->tx_csum = 0U;
+        caps->tx_features = 0U;
+    }
+}
+
+/* Datagram queued on a UDP socket; override to wake the receiving thread.
+ * Default: the application polls with RTNET_UDP_Recv. */
+RTNET_WEAK void RTNET_Platform_UDPNotify(uint8_t socket_id)
+{
+    (void)socket_id;
+}
+
+void RTNET_UDPNotify(uint8_t socket_id)
+{
+    RTNET_Platform_UDPNotify(socket_id);
+}
+
+/* ==================== AF_XDP RINGS ==================== */
+
+static void xdp_reap_completions(void)
+{
+    const uint32_t prod = __atomic_load_n(g_comp_ring.producer, __ATOMIC_ACQUIRE);
+    const uint64_t* addrs = (const uint64_t*)g_comp_ring.desc;
+
+    while ((g_comp_ring.cached != prod) && (g_tx_free_count < RTNET_LINUX_XDP_TX_FRAMES)) {
+        g_tx_free[g_tx_free_count++] = addrs[g_comp_ring.cached & (RTNET_LINUX_XDP_RING_SIZE - 1U)];
+        g_comp_ring.cached++;
+    }
+    __atomic_store_n(g_comp_ring.consumer, g_comp_ring.cached, __ATOMIC_RELEASE);
+}
+
+static bool xdp_queue_tx(const uint8_t* data, uint16_t length)
+{
+    if ((data == NULL) || (length > RTNET_BUFFER_SIZE) || (g_tx_free_count == 0U)) {
+        return false;
+    }
+
+    const uint64_t addr = g_tx_free[--g_tx_free_count];
+    memcpy(&g_umem[addr], data, length);
+
+    struct xdp_desc* desc = &((struct xdp_desc*)g_tx_ring.desc)
+                                [g_tx_ring.cached & (RTNET_LINUX_XDP_RING_SIZE - 1U)];
+    desc->addr = addr;
+    desc->len = length;
+    desc->options = 0U;
+    g_tx_ring.cached++;
+    return true;
+}
+
+/**
+ * @brief Publish queued TX descriptors and ring the doorbell (one syscall)
+ */
+static void xdp_kick_tx(void)
+{
+    __atomic_store_n(g_tx_ring.producer, g_tx_ring.cached, __ATOMIC_RELEASE);
+    if (!g_need_wakeup ||
+        ((__atomic_load_n(g_tx_ring.flags, __ATOMIC_ACQUIRE) & XDP_RING_NEED_WAKEUP) != 0U)) {
+        (void)sendto(g_fd, NULL, 0U, MSG_DONTWAIT, NULL, 0U);
+    }
+}
+
+/**
+ * @brief Hand every free RX pool buffer to the kernel as a fill-ring chunk
+ */
+static void xdp_refill(void)
+{
+    const uint32_t cons = __atomic_load_n(g_fill_ring.consumer, __ATOMIC_ACQUIRE);
+    const uint32_t room = RTNET_LINUX_XDP_RING_SIZE - (g_fill_ring.cached - cons);
+    uint64_t* addrs = (uint64_t*)g_fill_ring.desc;
+    const uint8_t* const arena = &g_umem[LINUX_XDP_RX_BASE];
+    uint32_t posted = 0U;
+
+    while (posted < room) {
+        RTNET_Buffer_t* buffer = RTNET_AllocRxBuffer();
+        if (buffer == NULL) {
+            break;
+        }
+        const uint32_t chunk = (uint32_t)((size_t)(buffer->data - arena) / RTNET_BUFFER_SIZE);
+        g_rx_chunk[chunk] = buffer;
+        addrs[(g_fill_ring.cached + posted) & (RTNET_LINUX_XDP_RING_SIZE - 1U)] =
+            LINUX_XDP_RX_BASE + ((uint64_t)chunk * RTNET_BUFFER_SIZE);
+        posted++;
+    }
+
+    if (posted != 0U) {
+        g_fill_ring.cached += posted;
+        __atomic_store_n(g_fill_ring.producer, g_fill_ring.cached, __ATOMIC_RELEASE);
+        if (g_need_wakeup &&
+            ((__atomic_load_n(g_fill_ring.flags, __ATOMIC_ACQUIRE) & XDP_RING_NEED_WAKEUP) != 0U)) {
+            (void)recvfrom(g_fd, NULL, 0U, MSG_DONTWAIT, NULL, NULL);
+        }
+    }
+}
+
+static bool xdp_rx_pending(void)
+{
+    return __atomic_load_n(g_rx_ring.producer, __ATOMIC_ACQUIRE) != g_rx_ring.cached;
+}
+
+/* ==================== RX ==================== */
+
+/**
+ * @brief Queue a filled pool buffer for RTNET_PollRx
+ */
+static void linux_deliver(RTNET_Buffer_t* buffer)
+{
+    if (RTNET_EnqueueRxBuffer(buffer) == RTNET_OK) {
+        g_stats.rx_frames++;
+        g_stats.rx_bytes += buffer->length;
+    } else {
+        (void)RTNET_FreeRxBuffer(buffer);
+        g_stats.rx_dropped++;
+    }
+}
+
+static uint16_t xdp_receive(uint16_t budget)
+{
+    const uint32_t prod = __atomic_load_n(g_rx_ring.producer, __ATOMIC_ACQUIRE);
+    const struct xdp_desc* descs = (const struct xdp_desc*)g_rx_ring.desc;
+    uint16_t count = 0U;
+
+    while ((g_rx_ring.cached != prod) && (count < budget)) {
+        const struct xdp_desc* desc = &descs[g_rx_ring.cached & (RTNET_LINUX_XDP_RING_SIZE - 1U)];
+        g_rx_ring.cached++;
+        count++;
+
+        /* Frame sits in place in the RX buffer that owns the chunk */
+        const uint64_t rel = desc->addr - LINUX_XDP_RX_BASE;
+        const uint32_t chunk = (uint32_t)(rel / RTNET_BUFFER_SIZE);
+        if ((desc->addr < LINUX_XDP_RX_BASE) || (chunk >= RTNET_RX_POOL_SIZE) ||
+            (g_rx_chunk[chunk] == NULL)) {
+            g_stats.rx_dropped++;
+            continue;
+        }
+        RTNET_Buffer_t* buffer = g_rx_chunk[chunk];
+        g_rx_chunk[chunk] = NULL;
+        buffer->offset = (uint16_t)(rel % RTNET_BUFFER_SIZE);
+        buffer->length = (uint16_t)desc->len;
+        linux_deliver(buffer);
+    }
+    __atomic_store_n(g_rx_ring.consumer, g_rx_ring.cached, __ATOMIC_RELEASE);
+
+    return count;
+}
+
+static uint16_t tap_receive(uint16_t budget)
+{
+    uint16_t count = 0U;
+
+    while (count < budget) {
+        /* Read straight into the pool: the stack parses the frame in place */
+        RTNET_Buffer_t* buffer = RTNET_AllocRxBuffer();
+        if (buffer == NULL) {
+            break;                      /* Frames wait in the TAP queue */
+        }
+        const ssize_t length = read(g_fd, buffer->data, buffer->capacity);
+        if (length <= 0) {
+            (void)RTNET_FreeRxBuffer(buffer);
+            break;
+        }
+        buffer->length = (uint16_t)length;
+        linux_deliver(buffer);
+        count++;
+    }
+
+    return count;
+}
+
+/* ==================== TX ==================== */
+
+void RTNET_HardwareTransmit(const uint8_t* data, uint16_t length)
+{
+    bool sent = false;
+
+    if (g_backend == LINUX_BACKEND_TAP) {
+        sent = (write(g_fd, data, length) == (ssize_t)length);
+    } else if (g_backend == LINUX_BACKEND_XDP) {
+        sent = xdp_queue_tx(data, length);
+        xdp_kick_tx();
+    } else {
+        /* Not open: frame dropped */
+    }
+
+    if (sent) {
+        g_stats.tx_frames++;
+        g_stats.tx_bytes += length;
+    } else {
+        g_stats.tx_dropped++;
+    }
+}
+
+void RTNET_HardwareTransmitBatch(const RTNET_TxFrame_t* frames, uint16_t count)
+{
+    if (g_backend != LINUX_BACKEND_XDP) {
+        for (uint16_t i = 0U; i < count; i++) {
+            RTNET_HardwareTransmit(frames[i].data, frames[i].length);
+        }
+        return;
+    }
+
+    /* All descriptors first, then one doorbell */
+    for (uint16_t i = 0U; i < count; i++) {
+        if (xdp_queue_tx(frames[i].data, frames[i].length)) {
+            g_stats.tx_frames++;
+            g_stats.tx_bytes += frames[i].length;
+        } else {
+            g_stats.tx_dropped++;
+        }
+    }
+    xdp_kick_tx();
+}
+
+uint16_t RTNET_HardwareTxSpace(void)
+{
+    if (g_backend == LINUX_BACKEND_XDP) {
+        xdp_reap_completions();
+        return (uint16_t)g_tx_free_count;
+    }
+    return UINT16_MAX;                  /* write() to the TAP is synchronous */
+}
+
+/* ==================== TAP ==================== */
+
+static RTNET_Error_t tap_open(const char* name)
+{
+    struct ifreq ifr;
+
+    if ((name[0] == '\0') || (strlen(name) >= IFNAMSIZ)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    g_fd = open("/dev/net/tun", O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (g_fd < 0) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    memset(&ifr, 0, sizeof(ifr));
+    ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
+    memcpy(ifr.ifr_name, name, strlen(name));
+    if (ioctl(g_fd, TUNSETIFF, &ifr) < 0) {
+        (void)close(g_fd);
+        g_fd = -1;
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    /* Bring the link up; addresses on the host side are the user's choice */
+    const int sock = socket(AF_INET6, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (sock >= 0) {
+        if (ioctl(sock, SIOCGIFFLAGS, &ifr) == 0) {
+            ifr.ifr_flags |= IFF_UP;
+            (void)ioctl(sock, SIOCSIFFLAGS, &ifr);
+        }
+        (void)close(sock);
+    }
+
+    g_backend = LINUX_BACKEND_TAP;
+    g_ctx = RTNET_GetContext();
+    return RTNET_OK;
+}
+
+/* ==================== AF_XDP ==================== */
+
+static int xdp_bpf(int cmd, union bpf_attr* attr)
+{
+    return (int)syscall(__NR_bpf, cmd, attr, sizeof(*attr));
+}
+
+static void xdp_close_fd(int* fd)
+{
+    if (*fd >= 0) {
+        (void)close(*fd);
+        *fd = -1;
+    }
+}
+
+static bool xdp_map_ring(LinuxRing_t* ring, const struct xdp_ring_offset* off,
+                         size_t desc_size, uint64_t pgoff)
+{
+    ring->map_len = (size_t)off->desc + (RTNET_LINUX_XDP_RING_SIZE * desc_size);
+    ring->map = mmap(NULL, ring->map_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     g_fd, (off_t)pgoff);
+    if (ring->map == MAP_FAILED) {
+        ring->map = NULL;
+        return false;
+    }
+
+    uint8_t* base = (uint8_t*)ring->map;
+    ring->producer = (uint32_t*)(void*)&base[off->producer];
+    ring->consumer = (uint32_t*)(void*)&base[off->consumer];
+    ring->flags = (uint32_t*)(void*)&base[off->flags];
+    ring->desc = &base[off->desc];
+    ring->cached = 0U;
+    return true;
+}
+
+static void xdp_unmap_ring(LinuxRing_t* ring)
+{
+    if (ring->map != NULL) {
+        (void)munmap(ring->map, ring->map_len);
+    }
+    memset(ring, 0, sizeof(*ring));
+}
+
+/**
+ * @brief Load "return bpf_redirect_map(&xsks, ctx->rx_queue_index, XDP_PASS)"
+ * @note Frames of queues without a socket go on to the kernel stack
+ */
+static int xdp_load_program(int map_fd)
+{
+    const struct bpf_insn insns[] = {
+        { .code = BPF_LDX | BPF_MEM | BPF_W, .dst_reg = BPF_REG_2, .src_reg = BPF_REG_1,
+          .off = (int16_t)offsetof(struct xdp_md, rx_queue_index) },
+        { .code = BPF_LD | BPF_DW | BPF_IMM, .dst_reg = BPF_REG_1,
+          .src_reg = BPF_PSEUDO_MAP_FD, .imm = map_fd },
+        { .code = 0U },
+        { .code = BPF_ALU64 | BPF_MOV | BPF_K, .dst_reg = BPF_REG_3, .imm = XDP_PASS },
+        { .code = BPF_JMP | BPF_CALL, .imm = BPF_FUNC_redirect_map },
+        { .code = BPF_JMP | BPF_EXIT },
+    };
+    union bpf_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.prog_type = BPF_PROG_TYPE_XDP;
+    attr.insns = (uint64_t)(uintptr_t)insns;
+    attr.insn_cnt = (uint32_t)(sizeof(insns) / sizeof(insns[0]));
+    attr.license = (uint64_t)(uintptr_t)"Dual MIT/GPL";
+    return xdp_bpf(BPF_PROG_LOAD, &attr);
+}
+
+static void xdp_close(void)
+{
+    xdp_close_fd(&g_link_fd);           /* Detaches the program */
+    xdp_close_fd(&g_prog_fd);
+    xdp_close_fd(&g_map_fd);
+    xdp_close_fd(&g_fd);
+    xdp_unmap_ring(&g_rx_ring);
+    xdp_unmap_ring(&g_tx_ring);
+    xdp_unmap_ring(&g_fill_ring);
+    xdp_unmap_ring(&g_comp_ring);
+    if (g_umem != NULL) {
+        (void)munmap(g_umem, g_umem_map_len);
+        g_umem = NULL;
+    }
+    memset(g_rx_chunk, 0, sizeof(g_rx_chunk));
+    g_tx_free_count = 0U;
+}
+
+static RTNET_Error_t xdp_open(const char* ifname, uint32_t queue)
+{
+    /* One aligned UMEM chunk per buffer: a power of two, 2 KiB to a page */
+    if ((RTNET_BUFFER_SIZE != 2048U) && (RTNET_BUFFER_SIZE != 4096U)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    const unsigned int ifindex = if_nametoindex(ifname);
+    if (ifindex == 0U) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    /* UMEM: TX chunks, then the instance's payload memory */
+    const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    g_umem_map_len = (((size_t)LINUX_XDP_RX_BASE + sizeof(RTNET_Memory_t)) + page - 1U) &
+                     ~(page - 1U);
+    void* umem = mmap(NULL, g_umem_map_len, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (umem == MAP_FAILED) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    g_umem = (uint8_t*)umem;
+    (void)RTNET_ContextBind(&g_xdp_ctx, (RTNET_Memory_t*)(void*)&g_umem[LINUX_XDP_RX_BASE], 0U);
+
+    bool ok = false;
+    g_fd = socket(AF_XDP, SOCK_RAW | SOCK_CLOEXEC, 0);
+    if (g_fd >= 0) {
+        struct xdp_umem_reg reg;
+        memset(&reg, 0, sizeof(reg));
+        reg.addr = (uint64_t)(uintptr_t)g_umem;
+        reg.len = LINUX_XDP_UMEM_LEN;
+        reg.chunk_size = RTNET_BUFFER_SIZE;
+        reg.headroom = 0U;
+
+        const int ring_size = (int)RTNET_LINUX_XDP_RING_SIZE;
+        ok = (setsockopt(g_fd, SOL_XDP, XDP_UMEM_REG, &reg, sizeof(reg)) == 0) &&
+             (setsockopt(g_fd, SOL_XDP, XDP_UMEM_FILL_RING, &ring_size, sizeof(ring_size)) == 0) &&
+             (setsockopt(g_fd, SOL_XDP, XDP_UMEM_COMPLETION_RING, &ring_size,
+                         sizeof(ring_size)) == 0) &&
+             (setsockopt(g_fd, SOL_XDP, XDP_RX_RING, &ring_size, sizeof(ring_size)) == 0) &&
+             (setsockopt(g_fd, SOL_XDP, XDP_TX_RING, &ring_size, sizeof(ring_size)) == 0);
+    }
+
+    struct xdp_mmap_offsets off;
+    socklen_t off_len = sizeof(off);
+    ok = ok && (getsockopt(g_fd, SOL_XDP, XDP_MMAP_OFFSETS, &off, &off_len) == 0) &&
+         xdp_map_ring(&g_rx_ring, &off.rx, sizeof(struct xdp_desc), XDP_PGOFF_RX_RING) &&
+         xdp_map_ring(&g_tx_ring, &off.tx, sizeof(struct xdp_desc), XDP_PGOFF_TX_RING) &&
+         xdp_map_ring(&g_fill_ring, &off.fr, sizeof(uint64_t), XDP_UMEM_PGOFF_FILL_RING) &&
+         xdp_map_ring(&g_comp_ring, &off.cr, sizeof(uint64_t), XDP_UMEM_PGOFF_COMPLETION_RING);
+
+    /* Zero copy where the driver supports it, else copy mode */
+    if (ok) {
+        struct sockaddr_xdp sxdp;
+        memset(&sxdp, 0, sizeof(sxdp));
+        sxdp.sxdp_family = AF_XDP;
+        sxdp.sxdp_ifindex = ifindex;
+        sxdp.sxdp_queue_id = queue;
+        sxdp.sxdp_flags = XDP_ZEROCOPY | XDP_USE_NEED_WAKEUP;
+        g_stats.zero_copy = (bind(g_fd, (struct sockaddr*)&sxdp, sizeof(sxdp)) == 0);
+        if (!g_stats.zero_copy) {
+            sxdp.sxdp_flags = XDP_COPY | XDP_USE_NEED_WAKEUP;
+            ok = (bind(g_fd, (struct sockaddr*)&sxdp, sizeof(sxdp)) == 0);
+        }
+        g_need_wakeup = true;
+    }
+
+    /* XSKMAP[queue] = socket, then attach the redirect program */
+    if (ok) {
+        union bpf_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.map_type = BPF_MAP_TYPE_XSKMAP;
+        attr.key_size = sizeof(uint32_t);
+        attr.value_size = sizeof(uint32_t);
+        attr.max_entries = queue + 1U;
+        g_map_fd = xdp_bpf(BPF_MAP_CREATE, &attr);
+
+        const uint32_t key = queue;
+        const uint32_t value = (uint32_t)g_fd;
+        memset(&attr, 0, sizeof(attr));
+        attr.map_fd = (uint32_t)g_map_fd;
+        attr.key = (uint64_t)(uintptr_t)&key;
+        attr.value = (uint64_t)(uintptr_t)&value;
+        ok = (g_map_fd >= 0) && (xdp_bpf(BPF_MAP_UPDATE_ELEM, &attr) == 0);
+    }
+    if (ok) {
+        g_prog_fd = xdp_load_program(g_map_fd);
+        ok = (g_prog_fd >= 0);
+    }
+    if (ok) {
+        union bpf_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.link_create.prog_fd = (uint32_t)g_prog_fd;
+        attr.link_create.target_ifindex = ifindex;
+        attr.link_create.attach_type = BPF_XDP;
+        attr.link_create.flags = XDP_FLAGS_DRV_MODE;
+        g_link_fd = xdp_bpf(BPF_LINK_CREATE, &attr);
+        if ((g_link_fd < 0) && !g_stats.zero_copy) {
+            attr.link_create.flags = XDP_FLAGS_SKB_MODE;    /* Generic XDP */
+            g_link_fd = xdp_bpf(BPF_LINK_CREATE, &attr);
+        }
+        ok = (g_link_fd >= 0);
+    }
+
+    if (!ok) {
+        xdp_close();
+        g_stats.zero_copy = false;
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    for (uint32_t i = 0U; i < RTNET_LINUX_XDP_TX_FRAMES; i++) {
+        g_tx_free[i] = (uint64_t)i * RTNET_BUFFER_SIZE;
+    }
+    g_tx_free_count = RTNET_LINUX_XDP_TX_FRAMES;
+
+    g_backend = LINUX_BACKEND_XDP;
+    g_stats.xdp = true;
+    g_ctx = &g_xdp_ctx;
+    (void)RTNET_SelectContext(&g_xdp_ctx);
+    return RTNET_OK;
+}
+
+/* ==================== PUBLIC API ==================== */
+
+RTNET_Error_t RTNET_Linux_Open(const char* spec)
+{
+    if ((spec == NULL) || (g_backend != LINUX_BACKEND_NONE)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    memset(&g_stats, 0, sizeof(g_stats));
+
+    if (strncmp(spec, "xdp:", 4U) == 0) {
+        char ifname[IFNAMSIZ];
+        const char* name = &spec[4];
+        const char* colon = strchr(name, ':');
+        const size_t len = (colon != NULL) ? (size_t)(colon - name) : strlen(name);
+        uint32_t queue = 0U;
+
+        if ((len == 0U) || (len >= sizeof(ifname))) {
+            return RTNET_ERR_INVALID_PARAM;
+        }
+        if (colon != NULL) {
+            char* end;
+            queue = (uint32_t)strtoul(&colon[1], &end, 10);
+            if ((end == &colon[1]) || (*end != '\0')) {
+                return RTNET_ERR_INVALID_PARAM;
+            }
+        }
+        memcpy(ifname, name, len);
+        ifname[len] = '\0';
+        return xdp_open(ifname, queue);
+    }
+
+    return tap_open((strncmp(spec, "tap:", 4U) == 0) ? &spec[4] : spec);
+}
+
+uint16_t RTNET_Linux_Poll(int32_t timeout_ms)
+{
+    if (g_backend == LINUX_BACKEND_NONE) {
+        return 0U;
+    }
+    RTNET_Context_t* const previous = RTNET_SelectContext(g_ctx);
+    const bool xdp = (g_backend == LINUX_BACKEND_XDP);
+
+    if (xdp) {
+        xdp_refill();
+    }
+    if ((timeout_ms != 0) && (!xdp || !xdp_rx_pending())) {
+        struct pollfd pfd = { .fd = g_fd, .events = POLLIN, .revents = 0 };
+        (void)poll(&pfd, 1U, (int)timeout_ms);
+    }
+
+    /* Batches no larger than the deferred RX ring, drained as they come */
+    uint16_t total = 0U;
+    while (total < RTNET_LINUX_RX_BUDGET) {
+        uint16_t batch = (uint16_t)(RTNET_LINUX_RX_BUDGET - total);
+        if (batch > RTNET_RX_RING_SIZE) {
+            batch = (uint16_t)RTNET_RX_RING_SIZE;
+        }
+        const uint16_t got = xdp ? xdp_receive(batch) : tap_receive(batch);
+        if (got == 0U) {
+            break;
+        }
+        (void)RTNET_PollRx(got);
+        if (xdp) {
+            xdp_refill();
+        }
+        total = (uint16_t)(total + got);
+    }
+
+    /* Frames held while the UMEM had no free TX chunk */
+    (void)RTNET_PollTx(UINT16_MAX);
+
+    (void)RTNET_SelectContext(previous);
+    return total;
+}
+
+void RTNET_Linux_GetStats(RTNET_LinuxStats_t* stats)
+{
+    if (stats != NULL) {
+        *stats = g_stats;
+    }
+}
+
+void RTNET_Linux_Close(void)
+{
+    if (g_backend == LINUX_BACKEND_XDP) {
+        xdp_close();
+        (void)RTNET_SelectContext(NULL);
+    } else if (g_fd >= 0) {
+        (void)close(g_fd);
+        g_fd = -1;
+    } else {
+        /* Not open */
+    }
+    g_backend = LINUX_BACKEND_NONE;
+    g_ctx = NULL;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file rtnet_platform_linux.h
+ * @brief Linux host platform: TAP device or AF_XDP socket
+ * @version 1.0.0
+ * @date 2026-10-14
+ * @author Seregon
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/platforms/rtnet_platform_linux.h
+ *
+ * Binds the stack to a real link so it can talk to real peers and be
+ * load-tested before anything is flashed:
+ *
+ *   - "tap:NAME": a TAP device (created if missing, brought up). Frames are
+ *     read straight into RX pool buffers; one write() per TX frame.
+ *   - "xdp:IFNAME[:QUEUE]": an AF_XDP socket on one queue of an existing
+ *     interface. The UMEM is the stack's RX pool memory, so the NIC (zero
+ *     copy mode) or the kernel (copy mode) writes frames where the stack
+ *     parses them. TX frames are copied once into UMEM chunks, since the
+ *     stack reuses a TX buffer as soon as RTNET_HardwareTransmit returns.
+ *     Needs RTNET_BUFFER_SIZE set to 2048 or 4096 in rtnet_config.h (a
+ *     UMEM chunk per buffer) and CAP_NET_ADMIN + CAP_BPF. A built-in XDP
+ *     program redirects everything on that queue to the socket.
+ *
+ * Critical sections are a spinlock (nesting per thread), so another
+ * thread may send while one runs RTNET_Linux_Poll. Time is CLOCK_MONOTONIC.
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef RTNET_PLATFORM_LINUX_H
+#define RTNET_PLATFORM_LINUX_H
+
+#include "rtnet_stack.h"
+
+#define RTNET_LINUX_CYCLES_PER_US   1000U   /* RTNET_GetCycleCount ticks are ns */
+
+/**
+ * @brief Device counters (the stack's own are in RTNET_GetStatisticsExt)
+ */
+typedef struct {
+    uint64_t rx_frames;         /* Frames handed to the stack */
+    uint64_t rx_bytes;
+    uint64_t rx_dropped;        /* RX ring full or no RX buffer to read into */
+    uint64_t tx_frames;
+    uint64_t tx_bytes;
+    uint64_t tx_dropped;        /* Device refused the frame or no free UMEM chunk */
+    bool xdp;                   /* AF_XDP backend */
+    bool zero_copy;             /* AF_XDP bound in zero-copy (driver) mode */
+} RTNET_LinuxStats_t;
+
+/**
+ * @brief Open the link the stack runs on
+ * @param spec "tap:NAME", "xdp:IFNAME" or "xdp:IFNAME:QUEUE" (bare NAME = TAP)
+ * @return RTNET_OK, RTNET_ERR_INVALID_PARAM for a bad spec, a missing
+ *         interface or privilege, or (AF_XDP) an unsuitable RTNET_BUFFER_SIZE
+ * @note Call before RTNET_Initialize. AF_XDP binds and selects an instance
+ *       whose memory is the UMEM, so RTNET_Initialize sets up that one
+ */
+RTNET_Error_t RTNET_Linux_Open(const char* spec);
+
+/**
+ * @brief Receive and process pending frames, release queued TX frames
+ * @param timeout_ms Wait for the first frame (0 = busy poll, -1 = forever)
+ * @return Frames processed
+ * @note Runs the RX path in the calling thread (one polling thread only)
+ */
+uint16_t RTNET_Linux_Poll(int32_t timeout_ms);
+
+/**
+ * @brief Copy out the device counters
+ */
+void RTNET_Linux_GetStats(RTNET_LinuxStats_t* stats);
+
+/**
+ * @brief Close the device (detaches the XDP program, selects the built-in instance)
+ */
+void RTNET_Linux_Close(void);
+
+#endif /* RTNET_PLATFORM_LINUX_H */
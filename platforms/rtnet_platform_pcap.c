@@ -0,0 +1,346 @@
+/**
+ * @file rtnet_platform_pcap.c
+ * @brief pcap replay / capture platform hooks (host, virtual time)
+ * @version 1.0.0
+ * @date 2026-10-14
+ * @author Seregon
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/platforms/rtnet_platform_pcap.c
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#if !defined(_WIN32)
+    #define _POSIX_C_SOURCE 200809L     /* mmap, clock_gettime, nanosleep */
+#endif
+
+#include "rtnet_platform_pcap.h"
+#include "rtnet_pcap.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+/* ==================== CONSTANTS ==================== */
+
+#define RTNET_PCAP_MAX_CATCHUP  64U     /* Periodic runs per frame after a long gap */
+
+/* ==================== STATE ==================== */
+
+static const uint8_t* g_capture = NULL;
+static size_t g_capture_size = 0U;
+static bool g_capture_mapped = false;    /* mmap'd, else malloc'd */
+static RTNET_PcapWriter_t g_writer = {NULL, 0U};
+static uint64_t g_virtual_ns = 0U;
+static uint32_t g_tx_frames = 0U;
+
+/* ==================== HOST CLOCK ==================== */
+
+static uint64_t pcap_host_ns(void)
+{
+    struct timespec ts;
+#if !defined(_WIN32)
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+    (void)timespec_get(&ts, TIME_UTC);
+#endif
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static void pcap_sleep_until(uint64_t host_ns)
+{
+    const uint64_t now = pcap_host_ns();
+    if (host_ns <= now) {
+        return;
+    }
+
+#if !defined(_WIN32)
+    const uint64_t wait = host_ns - now;
+    struct timespec ts;
+    ts.tv_sec = (time_t)(wait / 1000000000ULL);
+    ts.tv_nsec = (long)(wait % 1000000000ULL);
+    (void)nanosleep(&ts, NULL);
+#else
+    while (pcap_host_ns() < host_ns) {
+        /* Spin: no portable C11 sleep */
+    }
+#endif
+}
+
+/* ==================== PLATFORM HOOKS ==================== */
+
+/* Single-threaded replay: nothing runs concurrently with the stack */
+void RTNET_CriticalSectionEnter(void) {}
+void RTNET_CriticalSectionExit(void) {}
+
+uint32_t RTNET_GetTimeMs(void)
+{
+    return (uint32_t)(g_virtual_ns / 1000000ULL);
+}
+
+uint32_t RTNET_GetTimeUs(void)
+{
+    return (uint32_t)(g_virtual_ns / 1000ULL);
+}
+
+uint32_t RTNET_GetCycleCount(void)
+{
+    return (uint32_t)pcap_host_ns();
+}
+
+bool RTNET_InInterrupt(void)
+{
+    return false;
+}
+
+void RTNET_HardwareTransmit(const uint8_t* data, uint16_t length)
+{
+    /* Stamped with virtual time: the output lines up with the input */
+    RTNET_PcapWriter_Write(&g_writer, data, length, g_virtual_ns);
+    g_tx_frames++;
+}
+
+void RTNET_HardwareTransmitBatch(const RTNET_TxFrame_t* frames, uint16_t count)
+{
+    for (uint16_t i = 0U; i < count; i++) {
+        RTNET_HardwareTransmit(frames[i].data, frames[i].length);
+    }
+}
+
+void RTNET_GetHardwareCaps(RTNET_HardwareCaps_t* caps)
+{
+    /* Software checksums: replayed frames carry whatever the wire had */
+    if (caps != NULL) {
+        caps->rx_csum = 0U;
+        caps->tx_csum = 0U;
+        caps->tx_features = 0U;
+    }
+}
+
+uint16_t RTNET_HardwareTxSpace(void)
+{
+    return UINT16_MAX;
+}
+
+void RTNET_UDPNotify(uint8_t socket_id)
+{
+    (void)socket_id;
+}
+
+/* ==================== CAPTURE FILES ==================== */
+
+static void pcap_unmap(void)
+{
+    if (g_capture != NULL) {
+#if !defined(_WIN32)
+        if (g_capture_mapped) {
+            (void)munmap((void*)(uintptr_t)g_capture, g_capture_size);
+        } else
+#endif
+        {
+            free((void*)(uintptr_t)g_capture);
+        }
+    }
+    g_capture = NULL;
+    g_capture_size = 0U;
+    g_capture_mapped = false;
+}
+
+/**
+ * @brief Read the whole file into the heap (no mmap, or mmap refused)
+ */
+static bool pcap_load(const char* path)
+{
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return false;
+    }
+
+    uint8_t* data = NULL;
+    long size = -1;
+    if (fseek(file, 0L, SEEK_END) == 0) {
+        size = ftell(file);
+    }
+    if ((size > 0) && (fseek(file, 0L, SEEK_SET) == 0)) {
+        data = (uint8_t*)malloc((size_t)size);
+        if ((data != NULL) && (fread(data, 1U, (size_t)size, file) != (size_t)size)) {
+            free(data);
+            data = NULL;
+        }
+    }
+    (void)fclose(file);
+
+    if (data == NULL) {
+        return false;
+    }
+    g_capture = data;
+    g_capture_size = (size_t)size;
+    g_capture_mapped = false;
+    return true;
+}
+
+RTNET_Error_t RTNET_Pcap_OpenReplay(const char* path)
+{
+    if (path == NULL) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    pcap_unmap();
+
+    bool loaded = false;
+#if !defined(_WIN32)
+    const int fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        struct stat st;
+        if ((fstat(fd, &st) == 0) && (st.st_size > 0)) {
+            void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED) {
+                g_capture = (const uint8_t*)map;
+                g_capture_size = (size_t)st.st_size;
+                g_capture_mapped = true;
+                loaded = true;
+            }
+        }
+        (void)close(fd);
+    }
+#endif
+    if (!loaded) {
+        loaded = pcap_load(path);
+    }
+    if (!loaded) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    /* Reject unknown formats now rather than on the first replay */
+    RTNET_PcapReader_t reader;
+    if (RTNET_PcapReader_Init(&reader, g_capture, g_capture_size) != RTNET_OK) {
+        pcap_unmap();
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    return RTNET_OK;
+}
+
+RTNET_Error_t RTNET_Pcap_OpenCapture(const char* path)
+{
+    RTNET_PcapWriter_Close(&g_writer);
+    return RTNET_PcapWriter_Open(&g_writer, path);
+}
+
+void RTNET_Pcap_AdvanceTimeUs(uint32_t us)
+{
+    g_virtual_ns += (uint64_t)us * 1000ULL;
+}
+
+void RTNET_Pcap_Close(void)
+{
+    pcap_unmap();
+    RTNET_PcapWriter_Close(&g_writer);
+}
+
+/* ==================== REPLAY ==================== */
+
+RTNET_Error_t RTNET_Pcap_Replay(RTNET_PcapPacing_t pacing, uint32_t periodic_ms,
+                                 RTNET_PcapReplayStats_t* stats)
+{
+    RTNET_PcapReader_t reader;
+    if ((g_capture == NULL) ||
+        (RTNET_PcapReader_Init(&reader, g_capture, g_capture_size) != RTNET_OK)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    RTNET_PcapReplayStats_t local;
+    memset(&local, 0, sizeof(local));
+    const uint32_t tx_start = g_tx_frames;
+    const uint64_t wall_start = pcap_host_ns();
+    const uint64_t period_ns = (uint64_t)periodic_ms * 1000000ULL;
+    uint64_t next_periodic = g_virtual_ns + period_ns;
+    uint64_t base_virtual = g_virtual_ns;
+    uint64_t first_ts = 0U;
+    uint64_t last_rel = 0U;
+
+    RTNET_PcapFrame_t frame;
+    while (RTNET_PcapReader_Next(&reader, &frame)) {
+        if ((frame.caplen == 0U) || (frame.caplen > UINT16_MAX)) {
+            local.skipped++;
+            continue;
+        }
+
+        /* Capture time relative to the first frame, never backwards */
+        if (local.frames == 0U) {
+            first_ts = frame.ts_ns;
+        }
+        uint64_t rel = (frame.ts_ns > first_ts) ? (frame.ts_ns - first_ts) : 0U;
+        if (rel < last_rel) {
+            rel = last_rel;
+        }
+        last_rel = rel;
+        const uint64_t now = base_virtual + rel;
+
+        /* Periodic work due before this frame runs at its own boundary; an
+         * idle gap longer than RTNET_PCAP_MAX_CATCHUP intervals only runs
+         * the last ones (timers see the same elapsed time either way) */
+        if (period_ns != 0U) {
+            if (next_periodic <= now) {
+                const uint64_t missed = (now - next_periodic) / period_ns;
+                if (missed > RTNET_PCAP_MAX_CATCHUP) {
+                    next_periodic += (missed - RTNET_PCAP_MAX_CATCHUP) * period_ns;
+                }
+            }
+            while (next_periodic <= now) {
+                g_virtual_ns = next_periodic;
+                RTNET_PeriodicTask();
+                local.periodic_calls++;
+                next_periodic += period_ns;
+            }
+        }
+        g_virtual_ns = now;
+
+        if (pacing == RTNET_PCAP_ORIGINAL_TIMING) {
+            pcap_sleep_until(wall_start + rel);
+        }
+
+        if (RTNET_ProcessRxPacket(frame.data, (uint16_t)frame.caplen) != RTNET_OK) {
+            local.rx_errors++;
+        }
+        local.frames++;
+        local.bytes += frame.caplen;
+    }
+
+    local.wall_ns = pcap_host_ns() - wall_start;
+    local.skipped += reader.skipped;
+    local.malformed = reader.malformed;
+    local.virtual_ns = last_rel;
+    local.tx_frames = g_tx_frames - tx_start;
+    if (local.wall_ns != 0U) {
+        local.frames_per_s = ((uint64_t)local.frames * 1000000000ULL) / local.wall_ns;
+    }
+
+    if (stats != NULL) {
+        *stats = local;
+    }
+    return RTNET_OK;
+}
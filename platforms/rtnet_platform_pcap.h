@@ -0,0 +1,111 @@
+/**
+ * @file rtnet_platform_pcap.h
+ * @brief pcap replay / capture platform for deterministic host load tests
+ * @version 1.0.0
+ * @date 2026-10-14
+ * @author Seregon
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/platforms/rtnet_platform_pcap.h
+ *
+ * Implements every platform hook on the host. RX frames come from a
+ * memory-mapped pcap/pcapng file, TX frames go to a pcap file, and the
+ * stack clocks (RTNET_GetTimeMs / RTNET_GetTimeUs) run on virtual time
+ * taken from the frame timestamps, so a replay behaves the same on every
+ * run whatever the host speed. RTNET_GetCycleCount is the host monotonic
+ * clock in nanoseconds, so the latency probes measure real host cost.
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef RTNET_PLATFORM_PCAP_H
+#define RTNET_PLATFORM_PCAP_H
+
+#include "rtnet_stack.h"
+
+#define RTNET_PCAP_CYCLES_PER_US    1000U   /* RTNET_GetCycleCount ticks are ns */
+
+/**
+ * @brief Replay pacing
+ */
+typedef enum {
+    RTNET_PCAP_FULL_SPEED = 0,      /* Back to back: sustained packets/s */
+    RTNET_PCAP_ORIGINAL_TIMING      /* Sleep to reproduce the capture's gaps */
+} RTNET_PcapPacing_t;
+
+/**
+ * @brief Replay summary
+ */
+typedef struct {
+    uint32_t frames;            /* Frames given to RTNET_ProcessRxPacket */
+    uint64_t bytes;
+    uint32_t rx_errors;         /* Of those, rejected by the stack (see RTNET_GetStats) */
+    uint32_t skipped;           /* Non-Ethernet, empty or oversized frames */
+    uint32_t tx_frames;         /* Frames the stack transmitted meanwhile */
+    uint32_t periodic_calls;    /* RTNET_PeriodicTask runs */
+    uint64_t virtual_ns;        /* Capture span (last - first timestamp) */
+    uint64_t wall_ns;           /* Host time spent in the replay */
+    uint64_t frames_per_s;      /* frames / wall time */
+    bool malformed;             /* Capture ended on a truncated record */
+} RTNET_PcapReplayStats_t;
+
+/**
+ * @brief Map a pcap or pcapng capture for replay
+ * @param path Capture file
+ * @return RTNET_OK, RTNET_ERR_INVALID_PARAM if the file cannot be read or
+ *         is not an Ethernet capture
+ * @note Replaces a capture already open
+ */
+RTNET_Error_t RTNET_Pcap_OpenReplay(const char* path);
+
+/**
+ * @brief Record every transmitted frame into a pcap file
+ * @param path Output file (nanosecond pcap, stamped with virtual time)
+ * @return RTNET_OK, RTNET_ERR_INVALID_PARAM if the file cannot be created
+ */
+RTNET_Error_t RTNET_Pcap_OpenCapture(const char* path);
+
+/**
+ * @brief Feed the open capture to the current stack instance
+ * @param pacing Full speed or original timing
+ * @param periodic_ms RTNET_PeriodicTask interval in virtual time (0 = never)
+ * @param stats [OUT] Optional summary
+ * @return RTNET_OK, RTNET_ERR_INVALID_PARAM if no capture is open
+ * @note Virtual time continues from its current value and follows the
+ *       timestamps relative to the first frame (held if a timestamp goes
+ *       backwards). The periodic task
+ *       runs on every interval boundary crossed, at that boundary's time
+ *       (at most the last 64 boundaries of a long idle gap)
+ */
+RTNET_Error_t RTNET_Pcap_Replay(RTNET_PcapPacing_t pacing, uint32_t periodic_ms,
+                                 RTNET_PcapReplayStats_t* stats);
+
+/**
+ * @brief Move virtual time forwards (e.g. to let timers expire after a replay)
+ */
+void RTNET_Pcap_AdvanceTimeUs(uint32_t us);
+
+/**
+ * @brief Unmap the capture and close the output file
+ */
+void RTNET_Pcap_Close(void);
+
+#endif /* RTNET_PLATFORM_PCAP_H */
@@ -0,0 +1,353 @@
+/**
+ * @file rtnet_buffer.c
+ * @brief Fixed buffer pools with O(1) allocation and QoS reservations
+ * @version 1.0.0
+ * @date 2026-01-07
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/src/rtnet_buffer.c
+ * 
+ * IMPLEMENTATION NOTES:
+ * - Allocation first claims a token from free_count (respecting the QoS
+ *   floor), then clears one bit in free_mask; a held token guarantees a
+ *   set bit exists, so the bit search cannot fail
+ * - Release sets the bit first and returns the token afterwards, so the
+ *   counter never promises a buffer that isn't in the bitmap
+ * - Without lock-free 32-bit atomics (e.g. ARMv6-M) both steps run
+ *   inside RTNET_CriticalSectionEnter/Exit
+ * - The RX ring needs no read-modify-write at all: the producer stores the
+ *   slot, then publishes head with release; the consumer reads head with
+ *   acquire before touching the slot (and symmetrically for tail)
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include "rtnet_buffer.h"
+#include <stddef.h>
+
+#if defined(__GCC_ATOMIC_INT_LOCK_FREE) && (__GCC_ATOMIC_INT_LOCK_FREE == 2)
+    #define RTNET_POOL_LOCK_FREE 1
+#else
+    #define RTNET_POOL_LOCK_FREE 0
+#endif
+
+/* ==================== HELPERS ==================== */
+
+/**
+ * @brief Index of the lowest set bit (word must be non-zero)
+ */
+static inline uint32_t RTNET_Pool_Ctz(uint32_t word)
+{
+#if defined(__GNUC__)
+    return (uint32_t)__builtin_ctz(word);
+#else
+    uint32_t bit = 0U;
+    while ((word & 1U) == 0U) {
+        word >>= 1U;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+#if ((RTNET_RX_RING_SIZE & (RTNET_RX_RING_SIZE - 1U)) != 0U) || \
+    (RTNET_RX_RING_SIZE < RTNET_RX_POOL_SIZE)
+    #error "RTNET_RX_RING_SIZE must be a power of two >= RTNET_RX_POOL_SIZE"
+#endif
+
+#if (RTNET_POOL_LOCK_FREE != 0)
+
+static inline uint32_t RTNET_Pool_Load(const volatile uint32_t* p)
+{
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static inline bool RTNET_Pool_Cas(volatile uint32_t* p, uint32_t* expected, uint32_t desired)
+{
+    return __atomic_compare_exchange_n(p, expected, desired, false,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+#endif
+
+/**
+ * @brief Claim one free-count token if more than floor buffers are free
+ */
+static bool RTNET_Pool_TakeToken(RTNET_BufferPool_t* pool, uint32_t floor)
+{
+#if (RTNET_POOL_LOCK_FREE != 0)
+    uint32_t count = RTNET_Pool_Load(&pool->free_count);
+    do {
+        if (count <= floor) {
+            return false;
+        }
+    } while (!RTNET_Pool_Cas(&pool->free_count, &count, count - 1U));
+#else
+    bool taken = false;
+    uint32_t count = 0U;
+    RTNET_CriticalSectionEnter();
+    if (pool->free_count > floor) {
+        count = pool->free_count--;
+        taken = true;
+    }
+    RTNET_CriticalSectionExit();
+    if (!taken) {
+        return false;
+    }
+#endif
+    
+    /* Low-water mark for statistics; a racing update may keep the higher value */
+    if ((count - 1U) < pool->min_free) {
+        pool->min_free = count - 1U;
+    }
+    return true;
+}
+
+/**
+ * @brief Clear one set bit in the free bitmap (caller holds a token)
+ * @return Buffer index
+ */
+static uint16_t RTNET_Pool_TakeBit(RTNET_BufferPool_t* pool)
+{
+    const uint16_t words = (uint16_t)RTNET_POOL_WORDS(pool->size);
+    
+    /* Terminates: the held token guarantees a set bit; a failed CAS only
+     * means the other context freed a buffer meanwhile */
+    for (;;) {
+        for (uint16_t w = 0U; w < words; w++) {
+#if (RTNET_POOL_LOCK_FREE != 0)
+            uint32_t word = RTNET_Pool_Load(&pool->free_mask[w]);
+            while (word != 0U) {
+                uint32_t bit = RTNET_Pool_Ctz(word);
+                if (RTNET_Pool_Cas(&pool->free_mask[w], &word, word & ~(1UL << bit))) {
+                    return (uint16_t)((w * 32U) + bit);
+                }
+            }
+#else
+            RTNET_CriticalSectionEnter();
+            uint32_t word = pool->free_mask[w];
+            if (word != 0U) {
+                uint32_t bit = RTNET_Pool_Ctz(word);
+                pool->free_mask[w] = word & ~(1UL << bit);
+                RTNET_CriticalSectionExit();
+                return (uint16_t)((w * 32U) + bit);
+            }
+            RTNET_CriticalSectionExit();
+#endif
+        }
+    }
+}
+
+/**
+ * @brief Ring index load/store with acquire/release ordering
+ * @note Aligned 32-bit loads and stores are single-copy atomic on every
+ *       supported core, so only ordering is needed (no lock-free CAS)
+ */
+static inline uint32_t RTNET_Ring_LoadIndex(const volatile uint32_t* p)
+{
+#if defined(__GNUC__)
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+#else
+    RTNET_CriticalSectionEnter();
+    uint32_t value = *p;
+    RTNET_CriticalSectionExit();
+    return value;
+#endif
+}
+
+static inline void RTNET_Ring_StoreIndex(volatile uint32_t* p, uint32_t value)
+{
+#if defined(__GNUC__)
+    __atomic_store_n(p, value, __ATOMIC_RELEASE);
+#else
+    RTNET_CriticalSectionEnter();
+    *p = value;
+    RTNET_CriticalSectionExit();
+#endif
+}
+
+/* ==================== PUBLIC API ==================== */
+
+RTNET_Error_t RTNET_Pool_Init(RTNET_BufferPool_t* pool,
+                               RTNET_Buffer_t* storage,
+                               uint8_t* payload,
+                               uint16_t buffer_size,
+                               uint16_t size,
+                               uint16_t reserve_critical,
+                               uint16_t reserve_high)
+{
+    if ((pool == NULL) || (storage == NULL) || (payload == NULL) || (size == 0U) ||
+        (buffer_size == 0U) || ((buffer_size % 4U) != 0U) ||
+        (size > (32U * RTNET_POOL_MAX_WORDS)) ||
+        (((uint32_t)reserve_critical + reserve_high) >= size)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    pool->buffers = storage;
+    pool->size = size;
+    pool->buffer_size = buffer_size;
+    
+    for (uint16_t w = 0U; w < RTNET_POOL_MAX_WORDS; w++) {
+        uint32_t bits = 0U;
+        if (size >= ((w + 1U) * 32U)) {
+            bits = 0xFFFFFFFFUL;
+        } else if (size > (w * 32U)) {
+            bits = (1UL << (size - (w * 32U))) - 1UL;
+        } else {
+            bits = 0U;
+        }
+        pool->free_mask[w] = bits;
+    }
+    pool->free_count = size;
+    pool->min_free = size;
+    
+    pool->floor[RTNET_QOS_CRITICAL] = 0U;
+    pool->floor[RTNET_QOS_HIGH] = reserve_critical;
+    pool->floor[RTNET_QOS_NORMAL] = (uint16_t)(reserve_critical + reserve_high);
+    pool->floor[RTNET_QOS_LOW] = (uint16_t)(reserve_critical + reserve_high);
+    
+    /* Bind each descriptor to its payload slice once; never rebound */
+    for (uint16_t i = 0U; i < size; i++) {
+        storage[i].data = &payload[(uint32_t)i * buffer_size];
+        storage[i].capacity = buffer_size;
+        storage[i].in_use = false;
+    }
+    
+    return RTNET_OK;
+}
+
+RTNET_Buffer_t* RTNET_Pool_Alloc(RTNET_BufferPool_t* pool, uint8_t qos_priority)
+{
+    if ((pool == NULL) || (qos_priority >= RTNET_QOS_LEVELS)) {
+        return NULL;
+    }
+    
+    if (!RTNET_Pool_TakeToken(pool, pool->floor[qos_priority])) {
+        return NULL;
+    }
+    
+    RTNET_Buffer_t* buffer = &pool->buffers[RTNET_Pool_TakeBit(pool)];
+    buffer->in_use = true;
+    
+    return buffer;
+}
+
+bool RTNET_Pool_Free(RTNET_BufferPool_t* pool, RTNET_Buffer_t* buffer)
+{
+    if ((pool == NULL) || (buffer == NULL) ||
+        (buffer < pool->buffers) || (buffer >= &pool->buffers[pool->size])) {
+        return false;
+    }
+    
+    const uint16_t index = (uint16_t)(buffer - pool->buffers);
+    const uint16_t w = (uint16_t)(index / 32U);
+    const uint32_t mask = 1UL << (index % 32U);
+    
+    buffer->in_use = false;
+    
+#if (RTNET_POOL_LOCK_FREE != 0)
+    uint32_t previous = __atomic_fetch_or(&pool->free_mask[w], mask, __ATOMIC_ACQ_REL);
+    if ((previous & mask) != 0U) {
+        return false; /* Double free: bit was already set */
+    }
+    (void)__atomic_fetch_add(&pool->free_count, 1U, __ATOMIC_RELEASE);
+#else
+    RTNET_CriticalSectionEnter();
+    uint32_t previous = pool->free_mask[w];
+    pool->free_mask[w] = previous | mask;
+    if ((previous & mask) == 0U) {
+        pool->free_count++;
+    }
+    RTNET_CriticalSectionExit();
+    if ((previous & mask) != 0U) {
+        return false;
+    }
+#endif
+    
+    return true;
+}
+
+uint16_t RTNET_Pool_Available(const RTNET_BufferPool_t* pool)
+{
+    if (pool == NULL) {
+        return 0U;
+    }
+    
+#if (RTNET_POOL_LOCK_FREE != 0)
+    return (uint16_t)RTNET_Pool_Load(&pool->free_count);
+#else
+    return (uint16_t)pool->free_count;
+#endif
+}
+
+uint16_t RTNET_Pool_HighWater(const RTNET_BufferPool_t* pool)
+{
+    if (pool == NULL) {
+        return 0U;
+    }
+    
+    return (uint16_t)(pool->size - pool->min_free);
+}
+
+void RTNET_Ring_Init(RTNET_RxRing_t* ring)
+{
+    if (ring != NULL) {
+        for (uint32_t i = 0U; i < RTNET_RX_RING_SIZE; i++) {
+            ring->slots[i] = NULL;
+        }
+        ring->head = 0U;
+        ring->tail = 0U;
+    }
+}
+
+bool RTNET_Ring_Push(RTNET_RxRing_t* ring, RTNET_Buffer_t* buffer)
+{
+    if ((ring == NULL) || (buffer == NULL)) {
+        return false;
+    }
+    
+    const uint32_t head = ring->head;  /* Own index: plain read */
+    if ((head - RTNET_Ring_LoadIndex(&ring->tail)) >= RTNET_RX_RING_SIZE) {
+        return false;
+    }
+    
+    ring->slots[head & (RTNET_RX_RING_SIZE - 1U)] = buffer;
+    RTNET_Ring_StoreIndex(&ring->head, head + 1U);
+    
+    return true;
+}
+
+RTNET_Buffer_t* RTNET_Ring_Pop(RTNET_RxRing_t* ring)
+{
+    if (ring == NULL) {
+        return NULL;
+    }
+    
+    const uint32_t tail = ring->tail;  /* Own index: plain read */
+    if (tail == RTNET_Ring_LoadIndex(&ring->head)) {
+        return NULL;
+    }
+    
+    RTNET_Buffer_t* buffer = ring->slots[tail & (RTNET_RX_RING_SIZE - 1U)];
+    RTNET_Ring_StoreIndex(&ring->tail, tail + 1U);
+    
+    return buffer;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file rtnet_buffer.h
+ * @brief Fixed buffer pools with O(1) allocation and QoS reservations,
+ *        plus the SPSC descriptor ring used for deferred RX
+ * @version 1.0.0
+ * @date 2026-01-07
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/src/rtnet_buffer.h
+ *
+ * A pool hands out RTNET_Buffer_t descriptors from caller-provided storage,
+ * each bound at init to a fixed slice of a separate payload arena. Keeping
+ * descriptors and payload apart lets the descriptors (and the pool state)
+ * live in fast RAM while the arena sits in DMA-capable memory, and lets
+ * each pool use its own size class. The
+ * free set is a bitmap (one bit per buffer) scanned with count-trailing-
+ * zeros, so allocation touches one word per 32 buffers and never the
+ * buffers themselves. Allocation and release may run concurrently in
+ * different contexts (task + ISR) without a critical section on targets
+ * with lock-free 32-bit atomics.
+ *
+ * Each QoS class has a floor: an allocation at that class only succeeds
+ * while more than floor buffers are free, so lower classes can never take
+ * the buffers reserved for higher ones.
+ *
+ * The RX ring passes buffer pointers from one producer (the Ethernet ISR)
+ * to one consumer (the stack task). Each index is written by one side
+ * only and published with release/acquire ordering, so neither side ever
+ * blocks or masks interrupts.
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef RTNET_BUFFER_H
+#define RTNET_BUFFER_H
+
+#include "rtnet_stack.h"
+
+/**
+ * @brief Initialize a pool over caller storage (all buffers free)
+ * @param pool Pool to initialize
+ * @param storage Descriptor array
+ * @param payload Arena of size * buffer_size bytes, 4-byte aligned
+ * @param buffer_size Payload bytes per buffer (non-zero multiple of 4)
+ * @param size Number of buffers (1 .. 32 * RTNET_POOL_MAX_WORDS)
+ * @param reserve_critical Buffers only RTNET_QOS_CRITICAL may take
+ * @param reserve_high Further buffers only HIGH and CRITICAL may take
+ * @return RTNET_OK, RTNET_ERR_INVALID_PARAM if sizes or reservations don't fit
+ */
+RTNET_Error_t RTNET_Pool_Init(RTNET_BufferPool_t* pool,
+                               RTNET_Buffer_t* storage,
+                               uint8_t* payload,
+                               uint16_t buffer_size,
+                               uint16_t size,
+                               uint16_t reserve_critical,
+                               uint16_t reserve_high);
+
+/**
+ * @brief Allocate a buffer
+ * @param pool Pool
+ * @param qos_priority RTNET_QOS_* class of the requester
+ * @return Buffer (in_use set, other metadata untouched), NULL if none left
+ *         for this class
+ * @note O(pool words); lock-free when RTNET_POOL_LOCK_FREE is 1
+ */
+RTNET_Buffer_t* RTNET_Pool_Alloc(RTNET_BufferPool_t* pool, uint8_t qos_priority);
+
+/**
+ * @brief Release a buffer
+ * @param pool Pool the buffer came from
+ * @param buffer Buffer
+ * @return true if released, false if foreign or already free
+ * @note O(1); safe against a concurrent RTNET_Pool_Alloc
+ */
+bool RTNET_Pool_Free(RTNET_BufferPool_t* pool, RTNET_Buffer_t* buffer);
+
+/**
+ * @brief Number of free buffers
+ */
+uint16_t RTNET_Pool_Available(const RTNET_BufferPool_t* pool);
+
+/**
+ * @brief Most buffers in use at once since RTNET_Pool_Init
+ */
+uint16_t RTNET_Pool_HighWater(const RTNET_BufferPool_t* pool);
+
+/**
+ * @brief Initialize an empty ring
+ */
+void RTNET_Ring_Init(RTNET_RxRing_t* ring);
+
+/**
+ * @brief Append a buffer (producer side only)
+ * @return true if queued, false if the ring is full
+ */
+bool RTNET_Ring_Push(RTNET_RxRing_t* ring, RTNET_Buffer_t* buffer);
+
+/**
+ * @brief Remove the oldest buffer (consumer side only)
+ * @return Buffer, NULL if the ring is empty
+ */
+RTNET_Buffer_t* RTNET_Ring_Pop(RTNET_RxRing_t* ring);
+
+#endif /* RTNET_BUFFER_H */
@@ -0,0 +1,405 @@
+/**
+ * @file rtnet_checksum.c
+ * @brief Internet checksum engine (RFC 1071 / RFC 1624)
+ * @version 1.0.0
+ * @date 2026-01-07
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/src/rtnet_checksum.c
+ * 
+ * IMPLEMENTATION NOTES:
+ * - Kernels sum native-endian words and byte-swap the folded result once;
+ *   the one's complement sum is byte-order independent (RFC 1071 2.(B))
+ * - Wide accumulators defer carry folding to the end of the buffer
+ * - Loads go through memcpy or unaligned-capable instructions only, so
+ *   any buffer alignment is safe
+ * - Kernel selection is compile-time; every compiled kernel stays
+ *   reachable through RTNET_ChecksumGetKernels() for verification
+ * 
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include "rtnet_checksum.h"
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define RTNET_CHECKSUM_HAVE_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define RTNET_CHECKSUM_HAVE_NEON 1
+    #include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) && defined(__thumb2__) && \
+    (defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_7M__))
+    #define RTNET_CHECKSUM_HAVE_CORTEX_M 1
+#endif
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    #define RTNET_CHECKSUM_BIG_ENDIAN 1
+#endif
+
+/* ==================== HELPERS ==================== */
+
+/**
+ * @brief Fold a wide native-order sum to 16 bits in wire order
+ */
+static uint16_t RTNET_Checksum_FoldNative(uint64_t sum)
+{
+    sum = (sum & 0xFFFFFFFFULL) + (sum >> 32U);
+    sum = (sum & 0xFFFFFFFFULL) + (sum >> 32U);
+
+    uint32_t s = (uint32_t)sum;
+    s = (s & 0xFFFFU) + (s >> 16U);
+    s = (s & 0xFFFFU) + (s >> 16U);
+
+#if defined(RTNET_CHECKSUM_BIG_ENDIAN)
+    return (uint16_t)s;
+#else
+    return (uint16_t)(((s & 0xFFU) << 8U) | ((s >> 8U) & 0xFFU));
+#endif
+}
+
+/**
+ * @brief Native-order sum of the last 0..7 bytes (zero-padded)
+ */
+static uint64_t RTNET_Checksum_Tail(const uint8_t* data, uint16_t length)
+{
+    uint8_t tail[8] = {0U};
+    uint32_t words[2];
+
+    memcpy(tail, data, length);
+    memcpy(words, tail, sizeof(words));
+
+    return (uint64_t)words[0] + (uint64_t)words[1];
+}
+
+/* ==================== KERNELS ==================== */
+
+/**
+ * @brief Reference kernel: big-endian 16-bit words, byte loads
+ */
+static uint16_t RTNET_Checksum_Kernel16(const uint8_t* data, uint16_t length)
+{
+    uint32_t sum = 0U;
+    uint16_t i = 0U;
+
+    for (; (uint16_t)(i + 1U) < length; i = (uint16_t)(i + 2U)) {
+        sum += ((uint32_t)data[i] << 8U) | (uint32_t)data[i + 1U];
+    }
+
+    if ((length & 1U) != 0U) {
+        sum += (uint32_t)data[length - 1U] << 8U;
+    }
+
+    sum = (sum & 0xFFFFU) + (sum >> 16U);
+    sum = (sum & 0xFFFFU) + (sum >> 16U);
+
+    return (uint16_t)sum;
+}
+
+/**
+ * @brief 32-bit loads into a 64-bit accumulator (no carry handling in loop)
+ */
+static uint16_t RTNET_Checksum_Kernel32(const uint8_t* data, uint16_t length)
+{
+    uint64_t sum = 0U;
+
+    while (length >= 16U) {
+        uint32_t w[4];
+        memcpy(w, data, sizeof(w));
+        sum += (uint64_t)w[0] + (uint64_t)w[1] + (uint64_t)w[2] + (uint64_t)w[3];
+        data += 16U;
+        length = (uint16_t)(length - 16U);
+    }
+
+    while (length >= 4U) {
+        uint32_t w;
+        memcpy(&w, data, sizeof(w));
+        sum += w;
+        data += 4U;
+        length = (uint16_t)(length - 4U);
+    }
+
+    sum += RTNET_Checksum_Tail(data, length);
+
+    return RTNET_Checksum_FoldNative(sum);
+}
+
+/**
+ * @brief 64-bit loads with a deferred carry counter
+ */
+static uint16_t RTNET_Checksum_Kernel64(const uint8_t* data, uint16_t length)
+{
+    uint64_t sum = 0U;
+    uint64_t carries = 0U;
+
+    while (length >= 8U) {
+        uint64_t w;
+        memcpy(&w, data, sizeof(w));
+        sum += w;
+        carries += (sum < w) ? 1U : 0U;
+        data += 8U;
+        length = (uint16_t)(length - 8U);
+    }
+
+    /* Carries out of bit 63 re-enter at bit 0 (2^64 == 1 mod 0xFFFF) */
+    uint64_t tail = RTNET_Checksum_Tail(data, length) + carries;
+    sum += tail;
+    carries = (sum < tail) ? 1U : 0U;
+
+    uint64_t folded = (sum & 0xFFFFFFFFULL) + (sum >> 32U) + carries;
+    return RTNET_Checksum_FoldNative(folded);
+}
+
+#if defined(RTNET_CHECKSUM_HAVE_CORTEX_M)
+/**
+ * @brief Cortex-M3/M4/M7 kernel: ADDS/ADCS carry chain, 16 bytes per pass
+ * @note LDR tolerates unaligned addresses on ARMv7-M; a leading halfword is
+ *       consumed for 2-byte aligned data so the loop runs word-aligned
+ */
+static uint16_t RTNET_Checksum_KernelCortexM(const uint8_t* data, uint16_t length)
+{
+    uint32_t sum = 0U;
+
+    if (((((uintptr_t)data) & 1U) == 0U) && ((((uintptr_t)data) & 2U) != 0U) &&
+        (length >= 2U)) {
+        uint16_t h;
+        memcpy(&h, data, sizeof(h));
+        sum = h;
+        data += 2U;
+        length = (uint16_t)(length - 2U);
+    }
+
+    while (length >= 16U) {
+        uint32_t a;
+        uint32_t b;
+        uint32_t c;
+        uint32_t d;
+        __asm__ ("ldr  %[a], [%[p]], #4\n\t"
+                 "ldr  %[b], [%[p]], #4\n\t"
+                 "ldr  %[c], [%[p]], #4\n\t"
+                 "ldr  %[d], [%[p]], #4\n\t"
+                 "adds %[s], %[s], %[a]\n\t"
+                 "adcs %[s], %[s], %[b]\n\t"
+                 "adcs %[s], %[s], %[c]\n\t"
+                 "adcs %[s], %[s], %[d]\n\t"
+                 "adc  %[s], %[s], #0"
+                 : [s] "+r" (sum), [p] "+r" (data),
+                   [a] "=&r" (a), [b] "=&r" (b), [c] "=&r" (c), [d] "=&r" (d)
+                 :
+                 : "cc", "memory");
+        length = (uint16_t)(length - 16U);
+    }
+
+    uint64_t wide = (uint64_t)sum;
+    while (length >= 4U) {
+        uint32_t w;
+        memcpy(&w, data, sizeof(w));
+        wide += w;
+        data += 4U;
+        length = (uint16_t)(length - 4U);
+    }
+
+    wide += RTNET_Checksum_Tail(data, length);
+
+    return RTNET_Checksum_FoldNative(wide);
+}
+#endif
+
+#if defined(RTNET_CHECKSUM_HAVE_SSE2)
+/**
+ * @brief SSE2 kernel: 16-bit lanes widened into 32-bit accumulators
+ * @note 65535 bytes add at most 4096 words per lane, far below 2^32
+ */
+static uint16_t RTNET_Checksum_KernelSSE2(const uint8_t* data, uint16_t length)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = _mm_setzero_si128();
+    __m128i acc2 = _mm_setzero_si128();
+
+    /* Two independent accumulators hide the add latency */
+    while (length >= 32U) {
+        __m128i v0 = _mm_loadu_si128((const __m128i*)(const void*)data);
+        __m128i v1 = _mm_loadu_si128((const __m128i*)(const void*)&data[16]);
+        acc = _mm_add_epi32(acc, _mm_unpacklo_epi16(v0, zero));
+        acc2 = _mm_add_epi32(acc2, _mm_unpackhi_epi16(v0, zero));
+        acc = _mm_add_epi32(acc, _mm_unpacklo_epi16(v1, zero));
+        acc2 = _mm_add_epi32(acc2, _mm_unpackhi_epi16(v1, zero));
+        data += 32U;
+        length = (uint16_t)(length - 32U);
+    }
+    acc = _mm_add_epi32(acc, acc2);
+
+    while (length >= 16U) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(const void*)data);
+        acc = _mm_add_epi32(acc, _mm_unpacklo_epi16(v, zero));
+        acc = _mm_add_epi32(acc, _mm_unpackhi_epi16(v, zero));
+        data += 16U;
+        length = (uint16_t)(length - 16U);
+    }
+
+    uint32_t lanes[4];
+    _mm_storeu_si128((__m128i*)(void*)lanes, acc);
+    uint64_t sum = (uint64_t)lanes[0] + (uint64_t)lanes[1] +
+                   (uint64_t)lanes[2] + (uint64_t)lanes[3];
+
+    while (length >= 8U) {
+        sum += RTNET_Checksum_Tail(data, 8U);
+        data += 8U;
+        length = (uint16_t)(length - 8U);
+    }
+
+    sum += RTNET_Checksum_Tail(data, length);
+
+    return RTNET_Checksum_FoldNative(sum);
+}
+#endif
+
+#if defined(RTNET_CHECKSUM_HAVE_NEON)
+/**
+ * @brief NEON kernel: pairwise add-accumulate of 16-bit lanes
+ */
+static uint16_t RTNET_Checksum_KernelNEON(const uint8_t* data, uint16_t length)
+{
+    uint32x4_t acc = vdupq_n_u32(0U);
+
+    while (length >= 16U) {
+        uint16x8_t v = vreinterpretq_u16_u8(vld1q_u8(data));
+        acc = vpadalq_u16(acc, v);
+        data += 16U;
+        length = (uint16_t)(length - 16U);
+    }
+
+    uint64x2_t pairs = vpaddlq_u32(acc);
+    uint64_t sum = vgetq_lane_u64(pairs, 0) + vgetq_lane_u64(pairs, 1);
+
+    while (length >= 8U) {
+        sum += RTNET_Checksum_Tail(data, 8U);
+        data += 8U;
+        length = (uint16_t)(length - 8U);
+    }
+
+    sum += RTNET_Checksum_Tail(data, length);
+
+    return RTNET_Checksum_FoldNative(sum);
+}
+#endif
+
+/* ==================== KERNEL SELECTION ==================== */
+
+/* Active kernel first, then every other kernel built for this target */
+static const RTNET_ChecksumKernelInfo_t g_checksum_kernels[] = {
+#if defined(RTNET_CHECKSUM_HAVE_SSE2)
+    { "sse2",      RTNET_Checksum_KernelSSE2 },
+#endif
+#if defined(RTNET_CHECKSUM_HAVE_NEON)
+    { "neon",      RTNET_Checksum_KernelNEON },
+#endif
+#if defined(RTNET_CHECKSUM_HAVE_CORTEX_M)
+    { "cortex-m",  RTNET_Checksum_KernelCortexM },
+#endif
+#if (UINTPTR_MAX > 0xFFFFFFFFU)
+    { "word64",    RTNET_Checksum_Kernel64 },
+    { "word32",    RTNET_Checksum_Kernel32 },
+#else
+    { "word32",    RTNET_Checksum_Kernel32 },
+    { "word64",    RTNET_Checksum_Kernel64 },
+#endif
+    { "ref16",     RTNET_Checksum_Kernel16 }
+};
+
+#if defined(RTNET_CHECKSUM_HAVE_SSE2)
+    #define RTNET_CHECKSUM_ACTIVE RTNET_Checksum_KernelSSE2
+#elif defined(RTNET_CHECKSUM_HAVE_NEON)
+    #define RTNET_CHECKSUM_ACTIVE RTNET_Checksum_KernelNEON
+#elif defined(RTNET_CHECKSUM_HAVE_CORTEX_M)
+    #define RTNET_CHECKSUM_ACTIVE RTNET_Checksum_KernelCortexM
+#elif (UINTPTR_MAX > 0xFFFFFFFFU)
+    #define RTNET_CHECKSUM_ACTIVE RTNET_Checksum_Kernel64
+#else
+    #define RTNET_CHECKSUM_ACTIVE RTNET_Checksum_Kernel32
+#endif
+
+/* ==================== PUBLIC FUNCTIONS ==================== */
+
+uint32_t RTNET_ChecksumPartial(const uint8_t* data, uint16_t length, uint32_t sum)
+{
+    if ((data == NULL) || (length == 0U)) {
+        return sum;
+    }
+
+    /* Keep head-room so long chains of partial sums cannot overflow */
+    sum = (sum & 0xFFFFU) + (sum >> 16U);
+
+    return sum + (uint32_t)RTNET_CHECKSUM_ACTIVE(data, length);
+}
+
+uint16_t RTNET_ChecksumFinish(uint32_t sum)
+{
+    while ((sum >> 16U) != 0U) {
+        sum = (sum & 0xFFFFU) + (sum >> 16U);
+    }
+
+    return (uint16_t)(~sum);
+}
+
+uint16_t RTNET_ComputeChecksum(const uint8_t* data, uint16_t length, uint32_t initial)
+{
+    if (data == NULL) {
+        return 0U;
+    }
+
+    return RTNET_ChecksumFinish(RTNET_ChecksumPartial(data, length, initial));
+}
+
+uint16_t RTNET_ChecksumUpdate16(uint16_t checksum, uint16_t old_word, uint16_t new_word)
+{
+    /* HC' = ~(~HC + ~m + m') */
+    uint32_t sum = (uint32_t)(uint16_t)~checksum +
+                   (uint32_t)(uint16_t)~old_word +
+                   (uint32_t)new_word;
+
+    return RTNET_ChecksumFinish(sum);
+}
+
+uint16_t RTNET_ChecksumUpdate32(uint16_t checksum, uint32_t old_value, uint32_t new_value)
+{
+    uint32_t sum = (uint32_t)(uint16_t)~checksum +
+                   (uint32_t)(uint16_t)~(uint16_t)(old_value >> 16U) +
+                   (uint32_t)(uint16_t)~(uint16_t)old_value +
+                   (new_value >> 16U) +
+                   (new_value & 0xFFFFU);
+
+    return RTNET_ChecksumFinish(sum);
+}
+
+uint8_t RTNET_ChecksumGetKernels(const RTNET_ChecksumKernelInfo_t** kernels)
+{
+    if (kernels != NULL) {
+        *kernels = g_checksum_kernels;
+    }
+
+    return (uint8_t)(sizeof(g_checksum_kernels) / sizeof(g_checksum_kernels[0]));
+}
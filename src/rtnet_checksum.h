@@ -0,0 +1,109 @@
+/**
+ * @file rtnet_checksum.h
+ * @brief Internet checksum engine (RFC 1071 / RFC 1624)
+ * @version 1.0.0
+ * @date 2026-01-07
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/src/rtnet_checksum.h
+ *
+ * All sums and checksums are host-order values of the big-endian wire
+ * field: write results with a big-endian store, feed field values read
+ * with a big-endian load. Partial sums may be chained across segments as
+ * long as every segment except the last has even length.
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef RTNET_CHECKSUM_H
+#define RTNET_CHECKSUM_H
+
+#include <stdint.h>
+
+/**
+ * @brief Checksum kernel: 16-bit one's complement sum of a buffer
+ * @param data Data buffer (any alignment)
+ * @param length Length in bytes
+ * @return Folded partial sum (0..0xFFFF), not complemented
+ */
+typedef uint16_t (*RTNET_ChecksumKernel_t)(const uint8_t* data, uint16_t length);
+
+/**
+ * @brief Kernel descriptor (for verification and benchmarking)
+ */
+typedef struct {
+    const char* name;
+    RTNET_ChecksumKernel_t sum;
+} RTNET_ChecksumKernelInfo_t;
+
+/**
+ * @brief Add the one's complement sum of a buffer to a running sum
+ * @param data Data buffer
+ * @param length Length in bytes
+ * @param sum Running sum (e.g. pseudo-header)
+ * @return Updated running sum (unfolded)
+ * @note Uses the fastest kernel compiled for the target
+ */
+uint32_t RTNET_ChecksumPartial(const uint8_t* data, uint16_t length, uint32_t sum);
+
+/**
+ * @brief Fold a running sum to 16 bits and complement it
+ * @param sum Running sum
+ * @return Final checksum
+ */
+uint16_t RTNET_ChecksumFinish(uint32_t sum);
+
+/**
+ * @brief Compute Internet checksum (RFC 1071)
+ * @param data Data buffer
+ * @param length Length in bytes
+ * @param initial Initial checksum value (for pseudo-header)
+ * @return 16-bit one's complement checksum (0 when verifying a valid message)
+ * @note WCET: < 80 μs for 1500 bytes @ 168MHz
+ */
+uint16_t RTNET_ComputeChecksum(const uint8_t* data, uint16_t length, uint32_t initial);
+
+/**
+ * @brief Incrementally update a checksum for a changed 16-bit field
+ * @param checksum Current checksum field value
+ * @param old_word Old field value
+ * @param new_word New field value
+ * @return Updated checksum, HC' = ~(~HC + ~m + m') (RFC 1624 eqn. 3)
+ */
+uint16_t RTNET_ChecksumUpdate16(uint16_t checksum, uint16_t old_word, uint16_t new_word);
+
+/**
+ * @brief Incrementally update a checksum for a changed 32-bit field
+ * @param checksum Current checksum field value
+ * @param old_value Old field value
+ * @param new_value New field value
+ * @return Updated checksum
+ */
+uint16_t RTNET_ChecksumUpdate32(uint16_t checksum, uint32_t old_value, uint32_t new_value);
+
+/**
+ * @brief List the kernels compiled for this target
+ * @param kernels [OUT] Kernel table (first entry is the active kernel)
+ * @return Number of entries
+ */
+uint8_t RTNET_ChecksumGetKernels(const RTNET_ChecksumKernelInfo_t** kernels);
+
+#endif /* RTNET_CHECKSUM_H */
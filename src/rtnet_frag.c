@@ -0,0 +1,338 @@
+/**
+ * @file rtnet_frag.c
+ * @brief IPv6 fragment reassembly into static slots (RFC 8200 4.5)
+ * @version 1.0.0
+ * @date 2026-10-14
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/src/rtnet_frag.c
+ *
+ * IMPLEMENTATION NOTES:
+ * - RTNET_REASM_SLOTS datagrams are reassembled at once, keyed by source,
+ *   destination and Identification. Each slot takes a buffer of the
+ *   instance's reassembly pool (RTNET_REASM_BUFFER_SIZE bytes) and copies
+ *   every fragment straight to its final offset, so the datagram is
+ *   contiguous once complete
+ * - Missing ranges are a bounded RFC 815 hole list. A fragment must fall
+ *   inside one hole; one that overlaps data already received abandons the
+ *   datagram (RFC 5722), except an exact duplicate, which is dropped alone
+ * - A complete datagram leaves its slot at once. Its buffer goes back to
+ *   the pool after delivery, or when a UDP socket queue took it, on
+ *   RTNET_UDP_Release
+ * - RTNET_PeriodicTask abandons datagrams still incomplete after
+ *   RTNET_REASM_TIMEOUT_MS. Full slots are never evicted early: fragments
+ *   of new datagrams are dropped until a slot frees up
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include "rtnet_stack.h"
+#include "rtnet_internal.h"
+#include "rtnet_buffer.h"
+#include <string.h>
+
+#if (RTNET_ENABLE_FRAGMENTATION != 0U)
+
+/* ==================== CONSTANTS ==================== */
+
+#if ((RTNET_REASM_SLOTS == 0U) || (RTNET_REASM_SLOTS > 32U))
+#error "RTNET_REASM_SLOTS must be 1 .. 32"
+#endif
+
+#if ((RTNET_REASM_MAX_SIZE < 1280U) || (RTNET_REASM_BUFFER_SIZE > 65532U))
+#error "RTNET_REASM_MAX_SIZE must be 1280 .. 65476"
+#endif
+
+#if ((RTNET_REASM_MAX_HOLES < 2U) || (RTNET_REASM_MAX_HOLES > 254U))
+#error "RTNET_REASM_MAX_HOLES must be 2 .. 254"
+#endif
+
+#define REASM_HOLE_OPEN         0xFFFFU  /* Hole end while the length is unknown */
+
+/* ICMPv6 Time Exceeded, fragment reassembly time exceeded (RFC 4443 3.3) */
+#define ICMPV6_TIME_EXCEEDED    3U
+#define ICMPV6_REASM_EXCEEDED   1U
+
+/* Error body in front of the quoted data: type-specific word, IPv6 and Fragment header */
+#define REASM_QUOTE_PREFIX_LEN  (4U + RTNET_IPV6_HEADER_LEN + RTNET_FRAG_HEADER_LEN)
+
+/* ==================== SLOTS ==================== */
+
+/**
+ * @brief Find the datagram a fragment belongs to
+ * @param ip IPv6 header of the fragment
+ * @param id Fragment header Identification
+ * @return Slot, NULL if no datagram has that key
+ */
+static RTNET_ReasmSlot_t* RTNET_Reasm_Find(const uint8_t* ip, uint32_t id)
+{
+    for (uint8_t i = 0U; i < RTNET_REASM_SLOTS; i++) {
+        RTNET_ReasmSlot_t* slot = &g_RTNET_Ctx->reasm[i];
+        if ((slot->buffer != NULL) && (slot->id == id) &&
+            (memcmp(slot->src_addr.addr, &ip[8], RTNET_IPV6_ADDR_LEN) == 0) &&
+            (memcmp(slot->dst_addr.addr, &ip[24], RTNET_IPV6_ADDR_LEN) == 0)) {
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Start reassembling a new datagram
+ * @param frame Ethernet frame of its first fragment to arrive
+ * @param id Fragment header Identification
+ * @return Slot with one open hole, NULL if no slot or buffer is free
+ */
+static RTNET_ReasmSlot_t* RTNET_Reasm_Open(const uint8_t* frame, uint32_t id)
+{
+    RTNET_ReasmSlot_t* slot = NULL;
+    for (uint8_t i = 0U; i < RTNET_REASM_SLOTS; i++) {
+        if (g_RTNET_Ctx->reasm[i].buffer == NULL) {
+            slot = &g_RTNET_Ctx->reasm[i];
+            break;
+        }
+    }
+    if (slot == NULL) {
+        return NULL;
+    }
+
+    /* Buffers of delivered datagrams may still sit in UDP socket queues */
+    RTNET_Buffer_t* buf = RTNET_Pool_Alloc(&g_RTNET_Ctx->reasm_pool, RTNET_QOS_LOW);
+    if (buf == NULL) {
+        return NULL;
+    }
+    buf->offset = 0U;
+    buf->length = 0U;
+    buf->timestamp_ms = RTNET_GetTimeMs();
+
+    const uint8_t* ip = &frame[RTNET_ETH_HEADER_LEN];
+    memcpy(buf->data, frame, RTNET_L4_OFFSET);
+    memcpy(slot->src_addr.addr, &ip[8], RTNET_IPV6_ADDR_LEN);
+    memcpy(slot->dst_addr.addr, &ip[24], RTNET_IPV6_ADDR_LEN);
+    slot->buffer = buf;
+    slot->id = id;
+    slot->start_ms = buf->timestamp_ms;
+    slot->total_len = 0U;
+    slot->end = 0U;
+    slot->first_len = 0U;
+    slot->holes[0].first = 0U;
+    slot->holes[0].last = REASM_HOLE_OPEN;
+    slot->hole_count = 1U;
+    slot->next_header = 0U;
+
+    return slot;
+}
+
+/**
+ * @brief Drop a datagram and everything received for it
+ * @param slot Slot in use
+ * @param reason Drop reason counted once for the datagram
+ */
+static void RTNET_Reasm_Abandon(RTNET_ReasmSlot_t* slot, RTNET_DropReason_t reason)
+{
+    (void)RTNET_Pool_Free(&g_RTNET_Ctx->reasm_pool, slot->buffer);
+    slot->buffer = NULL;
+
+    if (reason == RTNET_DROP_MALFORMED) {
+        RTNET_STAT_DROP(rx_errors, reason);
+    } else {
+        RTNET_STAT_DROP(rx_dropped, reason);
+    }
+}
+
+/**
+ * @brief Report an expired datagram to its source (ICMPv6 Time Exceeded)
+ * @param slot Slot whose offset 0 fragment arrived
+ * @note The quoted invoking packet is the offset 0 fragment, rebuilt in
+ *       place over the Ethernet header in front of its data (unfragmentable
+ *       extension headers are not kept, so they are not quoted)
+ */
+static void RTNET_Reasm_TimeExceeded(RTNET_ReasmSlot_t* slot)
+{
+    uint8_t* data = slot->buffer->data;
+    uint8_t src_mac[RTNET_MAC_ADDR_LEN];
+    memcpy(src_mac, &data[RTNET_MAC_ADDR_LEN], RTNET_MAC_ADDR_LEN);
+
+    uint8_t* body = &data[RTNET_L4_OFFSET - REASM_QUOTE_PREFIX_LEN];
+    uint8_t* ip = &body[4];
+    memmove(ip, &data[RTNET_ETH_HEADER_LEN], RTNET_IPV6_HEADER_LEN);
+    RTNET_Write16(&ip[4], (uint16_t)(RTNET_FRAG_HEADER_LEN + slot->first_len));
+    ip[6] = RTNET_IPV6_EXT_FRAGMENT;
+
+    uint8_t* frag = &ip[RTNET_IPV6_HEADER_LEN];
+    frag[0] = slot->next_header;
+    frag[1] = 0U;
+    RTNET_Write16(&frag[2], RTNET_FRAG_MORE);
+    RTNET_Write32(&frag[4], slot->id);
+    RTNET_Write32(&body[0], 0U);
+
+    (void)RTNET_ICMPv6_Error(src_mac, &slot->src_addr, ICMPV6_TIME_EXCEEDED,
+                             ICMPV6_REASM_EXCEEDED, body,
+                             (uint16_t)(REASM_QUOTE_PREFIX_LEN + slot->first_len));
+}
+
+/* ==================== INTERNAL API ==================== */
+
+void RTNET_Reasm_Init(void)
+{
+    (void)RTNET_Pool_Init(&g_RTNET_Ctx->reasm_pool, g_RTNET_Ctx->reasm_buffers,
+                          g_RTNET_Ctx->memory->reasm, RTNET_REASM_BUFFER_SIZE,
+                          RTNET_REASM_SLOTS, 0U, 0U);
+    for (uint8_t i = 0U; i < RTNET_REASM_SLOTS; i++) {
+        g_RTNET_Ctx->reasm[i].buffer = NULL;
+    }
+}
+
+RTNET_Buffer_t* RTNET_Reasm_Input(const uint8_t* frame, const uint8_t* frag, uint16_t frag_len)
+{
+    const uint16_t offset_flags = RTNET_Read16(&frag[2]);
+    const bool more = ((offset_flags & RTNET_FRAG_MORE) != 0U);
+    const uint16_t first = (uint16_t)(offset_flags & RTNET_FRAG_OFFSET_MASK);
+    const uint16_t data_len = (uint16_t)(frag_len - RTNET_FRAG_HEADER_LEN);
+    const uint8_t* data = &frag[RTNET_FRAG_HEADER_LEN];
+
+    /* Every fragment but the last carries a multiple of 8 bytes */
+    if ((data_len == 0U) || (more && ((data_len & 7U) != 0U))) {
+        RTNET_STAT_DROP(rx_errors, RTNET_DROP_MALFORMED);
+        return NULL;
+    }
+    if (((uint32_t)first + data_len) > RTNET_REASM_MAX_SIZE) {
+        RTNET_STAT_DROP(rx_dropped, RTNET_DROP_UNSUPPORTED);
+        return NULL;
+    }
+    const uint16_t last = (uint16_t)(first + data_len - 1U);
+    const uint32_t id = RTNET_Read32(&frag[4]);
+
+    RTNET_ReasmSlot_t* slot = RTNET_Reasm_Find(&frame[RTNET_ETH_HEADER_LEN], id);
+    if (slot == NULL) {
+        slot = RTNET_Reasm_Open(frame, id);
+        if (slot == NULL) {
+            RTNET_STAT_DROP(rx_dropped, RTNET_DROP_REASM_NO_SLOT);
+            return NULL;
+        }
+    }
+
+    /* The last fragment fixes the length: nothing may lie past it */
+    const uint32_t end = (uint32_t)last + 1U;
+    if (more ? ((slot->total_len != 0U) && (end > slot->total_len))
+             : (((slot->total_len != 0U) && (end != slot->total_len)) || (slot->end > end))) {
+        RTNET_Reasm_Abandon(slot, RTNET_DROP_MALFORMED);
+        return NULL;
+    }
+
+    /* The fragment must lie inside one hole */
+    uint8_t h = 0U;
+    bool overlap = false;
+    while (h < slot->hole_count) {
+        const RTNET_ReasmHole_t* hole = &slot->holes[h];
+        if ((first >= hole->first) && (last <= hole->last)) {
+            break;
+        }
+        if ((first <= hole->last) && (last >= hole->first)) {
+            overlap = true;
+        }
+        h++;
+    }
+
+    uint8_t* payload = &slot->buffer->data[RTNET_L4_OFFSET];
+    if (h == slot->hole_count) {
+        /* Already received: drop an exact duplicate alone, abandon on overlap */
+        if (!overlap && (memcmp(&payload[first], data, data_len) == 0)) {
+            return NULL;
+        }
+        RTNET_Reasm_Abandon(slot, RTNET_DROP_MALFORMED);
+        return NULL;
+    }
+
+    /* RFC 815: the hole shrinks to what is left on either side */
+    const RTNET_ReasmHole_t hole = slot->holes[h];
+    const bool left = (first > hole.first);
+    const bool right = more && (last < hole.last);
+    if (left && right && (slot->hole_count >= RTNET_REASM_MAX_HOLES)) {
+        RTNET_Reasm_Abandon(slot, RTNET_DROP_REASM_NO_SLOT);
+        return NULL;
+    }
+
+    slot->hole_count--;
+    slot->holes[h] = slot->holes[slot->hole_count];
+    if (left) {
+        slot->holes[slot->hole_count].first = hole.first;
+        slot->holes[slot->hole_count].last = (uint16_t)(first - 1U);
+        slot->hole_count++;
+    }
+    if (right) {
+        slot->holes[slot->hole_count].first = (uint16_t)(last + 1U);
+        slot->holes[slot->hole_count].last = hole.last;
+        slot->hole_count++;
+    }
+
+    memcpy(&payload[first], data, data_len);
+    if (end > slot->end) {
+        slot->end = (uint16_t)end;
+    }
+    if (!more) {
+        slot->total_len = (uint16_t)end;
+    }
+    if (first == 0U) {
+        /* Header and upper-layer protocol of the datagram come from offset 0 */
+        memcpy(slot->buffer->data, frame, RTNET_L4_OFFSET);
+        slot->first_len = data_len;
+        slot->next_header = frag[0];
+    }
+
+    if (slot->hole_count != 0U) {
+        return NULL;
+    }
+
+    RTNET_Buffer_t* whole = slot->buffer;
+    slot->buffer = NULL;
+
+    uint8_t* ip = &whole->data[RTNET_ETH_HEADER_LEN];
+    RTNET_Write16(&ip[4], slot->total_len);
+    ip[6] = slot->next_header;
+    whole->length = (uint16_t)(RTNET_L4_OFFSET + slot->total_len);
+
+    return whole;
+}
+
+bool RTNET_Reasm_Free(RTNET_Buffer_t* buffer)
+{
+    return RTNET_Pool_Free(&g_RTNET_Ctx->reasm_pool, buffer);
+}
+
+void RTNET_Reasm_Age(uint32_t now)
+{
+    for (uint8_t i = 0U; i < RTNET_REASM_SLOTS; i++) {
+        RTNET_ReasmSlot_t* slot = &g_RTNET_Ctx->reasm[i];
+        if ((slot->buffer == NULL) || ((now - slot->start_ms) < RTNET_REASM_TIMEOUT_MS)) {
+            continue;
+        }
+
+        /* RFC 8200 4.5: report only if the first fragment arrived; never
+         * for a datagram sent to a group (RFC 4443 2.4 e) */
+        if ((slot->first_len != 0U) && (slot->dst_addr.addr[0] != 0xFFU)) {
+            RTNET_Reasm_TimeExceeded(slot);
+        }
+        RTNET_Reasm_Abandon(slot, RTNET_DROP_REASM_TIMEOUT);
+    }
+}
+
+#endif /* RTNET_ENABLE_FRAGMENTATION */
@@ -0,0 +1,359 @@
+/**
+ * @file rtnet_internal.h
+ * @brief Interfaces shared between stack modules (not part of the public API)
+ * @version 1.0.0
+ * @date 2026-01-07
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/src/rtnet_internal.h
+ *
+ * rtnet_ipv6.c owns the context, buffers, routing and neighbor discovery;
+ * transport modules such as rtnet_tcp.c build their segments behind the
+ * link and IPv6 headers and hand them to RTNET_IPv6_Output.
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef RTNET_INTERNAL_H
+#define RTNET_INTERNAL_H
+
+#include "rtnet_stack.h"
+
+/* Framing in front of every upper-layer message */
+#define RTNET_ETH_HEADER_LEN        14U
+#define RTNET_IPV6_HEADER_LEN       40U
+#define RTNET_L4_OFFSET             (RTNET_ETH_HEADER_LEN + RTNET_IPV6_HEADER_LEN)
+
+/* IPv6 Fragment header (RFC 8200 4.5) */
+#define RTNET_IPV6_EXT_FRAGMENT     44U
+#define RTNET_FRAG_HEADER_LEN       8U
+#define RTNET_FRAG_OFFSET_MASK      0xFFF8U  /* Offset in 8-byte units, already scaled */
+#define RTNET_FRAG_MORE             0x0001U  /* M flag */
+
+/* Current stack instance (rtnet_ipv6.c) */
+extern RTNET_THREAD_LOCAL RTNET_Context_t* g_RTNET_Ctx;
+
+/* ==================== BYTE ORDER ==================== */
+
+/**
+ * @brief Read big-endian 16-bit field (alignment-safe)
+ */
+static inline uint16_t RTNET_Read16(const uint8_t* p)
+{
+    return (uint16_t)(((uint16_t)p[0] << 8U) | (uint16_t)p[1]);
+}
+
+/**
+ * @brief Write big-endian 16-bit field (alignment-safe)
+ */
+static inline void RTNET_Write16(uint8_t* p, uint16_t value)
+{
+    p[0] = (uint8_t)(value >> 8U);
+    p[1] = (uint8_t)value;
+}
+
+/**
+ * @brief Read big-endian 32-bit field (alignment-safe)
+ */
+static inline uint32_t RTNET_Read32(const uint8_t* p)
+{
+    return ((uint32_t)p[0] << 24U) | ((uint32_t)p[1] << 16U) |
+           ((uint32_t)p[2] << 8U) | (uint32_t)p[3];
+}
+
+/**
+ * @brief Write big-endian 32-bit field (alignment-safe)
+ */
+static inline void RTNET_Write32(uint8_t* p, uint32_t value)
+{
+    p[0] = (uint8_t)(value >> 24U);
+    p[1] = (uint8_t)(value >> 16U);
+    p[2] = (uint8_t)(value >> 8U);
+    p[3] = (uint8_t)value;
+}
+
+/* ==================== rtnet_ipv6.c ==================== */
+
+/**
+ * @brief Allocate TX buffer sized for frame_len bytes (offset/length cleared)
+ */
+RTNET_Buffer_t* RTNET_AllocTxBuffer(uint8_t qos_priority, uint32_t frame_len);
+
+/**
+ * @brief Release a TX buffer
+ */
+void RTNET_FreeBuffer(RTNET_Buffer_t* buffer);
+
+/**
+ * @brief Next ephemeral port (49152-65535, wrapping)
+ */
+uint16_t RTNET_EphemeralPort(void);
+
+/**
+ * @brief Prepend Ethernet/IPv6 headers to an upper-layer message and send it
+ * @param buf TX buffer; the message sits at data[offset + RTNET_L4_OFFSET]
+ * @param dest_addr Destination address
+ * @param next_header Upper-layer protocol
+ * @param l4_len Upper-layer message length
+ * @param csum_offset Checksum field offset inside the message (filled here
+ *        unless the MAC inserts it)
+ * @return RTNET_OK if sent or queued for address resolution, error otherwise
+ * @note Consumes buf in every case
+ */
+RTNET_Error_t RTNET_IPv6_Output(RTNET_Buffer_t* buf,
+                                const RTNET_IPv6Addr_t* dest_addr,
+                                uint8_t next_header,
+                                uint16_t l4_len,
+                                uint16_t csum_offset);
+
+/**
+ * @brief Send an ICMPv6 error message from the local address (RFC 4443)
+ * @param dst_mac Destination MAC (the link-layer source of the invoking packet)
+ * @param dst_addr Source of the invoking packet
+ * @param type ICMPv6 error type
+ * @param code ICMPv6 code
+ * @param body 4-byte type-specific field followed by the invoking packet
+ * @param body_len Body length; trimmed so the error fits the IPv6 minimum MTU
+ * @return RTNET_OK if sent or suppressed by the error rate limit (2.4 f;
+ *         counted as tx_dropped / RTNET_DROP_RATE_LIMITED),
+ *         RTNET_ERR_INVALID_PARAM if dst_addr is multicast or unspecified
+ *         (RFC 4443 2.4 e), or RTNET_ERR_NO_BUFFER
+ */
+RTNET_Error_t RTNET_ICMPv6_Error(const uint8_t* dst_mac,
+                                 const RTNET_IPv6Addr_t* dst_addr,
+                                 uint8_t type,
+                                 uint8_t code,
+                                 const uint8_t* body,
+                                 uint16_t body_len);
+
+/* ==================== rtnet_frag.c ==================== */
+
+#if (RTNET_ENABLE_FRAGMENTATION != 0U)
+/**
+ * @brief Free every reassembly slot over the instance's reassembly arena
+ *        (called by RTNET_Initialize)
+ */
+void RTNET_Reasm_Init(void);
+
+/**
+ * @brief Add a fragment to the datagram it belongs to (RFC 8200 4.5)
+ * @param frame Ethernet frame carrying the fragment (headers at fixed offsets)
+ * @param frag Fragment header inside the frame
+ * @param frag_len Fragment header + fragment data length
+ * @return Buffer with the complete datagram once its last hole is filled,
+ *         NULL while fragments are missing or when the fragment was dropped
+ *         (counted in the statistics)
+ * @note The returned buffer holds the rebuilt Ethernet + IPv6 header at
+ *       data[0] (Next Header and Payload Length of the whole datagram)
+ *       and the payload at data[RTNET_L4_OFFSET]; length is the frame
+ *       length. Release it with RTNET_Reasm_Free
+ */
+RTNET_Buffer_t* RTNET_Reasm_Input(const uint8_t* frame, const uint8_t* frag, uint16_t frag_len);
+
+/**
+ * @brief Release a reassembled datagram
+ * @return false if the buffer is not a reassembly buffer
+ */
+bool RTNET_Reasm_Free(RTNET_Buffer_t* buffer);
+
+/**
+ * @brief Abandon datagrams older than RTNET_REASM_TIMEOUT_MS (called by RTNET_PeriodicTask)
+ * @note Sends Time Exceeded (fragment reassembly) when the offset 0 fragment
+ *       had arrived and the datagram was not sent to a multicast group
+ */
+void RTNET_Reasm_Age(uint32_t now);
+#endif
+
+/* ==================== rtnet_ratelimit.c ==================== */
+
+/**
+ * @brief Load the default ICMPv6 rate limits with every bucket full
+ *        (called by RTNET_Initialize)
+ */
+void RTNET_RateLimit_Init(void);
+
+/**
+ * @brief Check, without charging, that the buckets of a class and peer hold
+ *        one message
+ * @param limit Class
+ * @param peer 16-byte source address
+ * @return false if either bucket is empty (message may be dropped unverified)
+ */
+bool RTNET_RateLimit_Check(RTNET_ICMPv6Limit_t limit, const uint8_t* peer);
+
+/**
+ * @brief Charge one message to the buckets of its class and peer
+ * @param limit Class
+ * @param peer 16-byte source (received) or destination (errors) address
+ * @return false if either bucket is empty (message must be dropped)
+ */
+bool RTNET_RateLimit_Admit(RTNET_ICMPv6Limit_t limit, const uint8_t* peer);
+
+/* ==================== rtnet_sched.c ==================== */
+
+/**
+ * @brief Empty the TX queues and load the default quanta (called by RTNET_Initialize)
+ */
+void RTNET_TxSched_Init(void);
+
+/**
+ * @brief Queue a completed frame by its qos_priority (sent by RTNET_PollTx)
+ * @param buf TX buffer with length set and destination MAC filled
+ * @note Consumes buf; marks the IPv6 Traffic Class with the class DSCP
+ *       when RTNET_QOS_MARK_DSCP is set
+ */
+void RTNET_TxSched_Enqueue(RTNET_Buffer_t* buf);
+
+/* ==================== rtnet_tcp.c ==================== */
+
+/**
+ * @brief Bind connection rings to their storage (called by RTNET_Initialize)
+ */
+void RTNET_TCP_Init(void);
+
+/**
+ * @brief Feed a checksum-verified segment to the connection it belongs to
+ * @param src Source address
+ * @param seg TCP header + data
+ * @param seg_len Segment length (header length already validated)
+ * @return true if a connection consumed it
+ */
+bool RTNET_TCP_Segment(const RTNET_IPv6Addr_t* src, const uint8_t* seg, uint16_t seg_len);
+
+/**
+ * @brief Retransmission, delayed ACK and TIME_WAIT timers (called by RTNET_PeriodicTask)
+ */
+void RTNET_TCP_Timers(uint32_t now);
+
+/* ==================== rtnet_udp.c ==================== */
+
+/**
+ * @brief Empty the UDP socket table (called by RTNET_Initialize)
+ */
+void RTNET_UDP_Init(void);
+
+/**
+ * @brief Hand a checksum-verified datagram to the socket bound to its port
+ * @param view Borrowed view of the datagram
+ * @return true if a socket took it (queued, dropped on a full queue, or
+ *         passed to the socket callback); false if the port is not bound
+ * @note Takes g_RTNET_Ctx->rx_current when the frame lives in it, otherwise
+ *       copies the payload into an RX pool buffer
+ */
+bool RTNET_UDP_Demux(const RTNET_RxView_t* view);
+
+/* ==================== rtnet_mdns.c ==================== */
+
+/**
+ * @brief Empty the mDNS name table, cache and service list (called by RTNET_Initialize)
+ */
+void RTNET_mDNS_Init(void);
+
+/**
+ * @brief Expire cached records, send due questions and announcements
+ *        (called by RTNET_PeriodicTask)
+ */
+void RTNET_mDNS_Periodic(uint32_t now);
+
+/* ==================== STATISTICS ==================== */
+
+#if defined(__GNUC__)
+    #define RTNET_STATS_BARRIER()   __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+    #define RTNET_STATS_BARRIER()   ((void)0)
+#endif
+
+/**
+ * @brief Open the counter block of the calling context for update
+ * @return Block to update; pass it to RTNET_Stats_End
+ * @note Each block has a single writer (the task or the ISR), so the
+ *       sequence counter needs no atomic read-modify-write
+ */
+static inline RTNET_StatsBlock_t* RTNET_Stats_Begin(void)
+{
+    RTNET_StatsBlock_t* blk = &g_RTNET_Ctx->stats[RTNET_InInterrupt() ? RTNET_STATS_CTX_ISR
+                                                                      : RTNET_STATS_CTX_TASK];
+    blk->seq++;
+    RTNET_STATS_BARRIER();
+    return blk;
+}
+
+static inline void RTNET_Stats_End(RTNET_StatsBlock_t* blk)
+{
+    RTNET_STATS_BARRIER();
+    blk->seq++;
+}
+
+/* Single counter update, e.g. RTNET_STAT_INC(rx_packets) */
+#define RTNET_STAT_ADD(field, n) \
+    do { \
+        RTNET_StatsBlock_t* const stats_blk_ = RTNET_Stats_Begin(); \
+        stats_blk_->c.field += (n); \
+        RTNET_Stats_End(stats_blk_); \
+    } while (0)
+#define RTNET_STAT_INC(field)   RTNET_STAT_ADD(field, 1U)
+
+/* Drop: summary counter plus its reason, e.g. RTNET_STAT_DROP(rx_dropped, RTNET_DROP_NOT_FOR_US) */
+#define RTNET_STAT_DROP(field, reason) \
+    do { \
+        RTNET_StatsBlock_t* const stats_blk_ = RTNET_Stats_Begin(); \
+        stats_blk_->c.field++; \
+        stats_blk_->c.drops[(reason)]++; \
+        RTNET_Stats_End(stats_blk_); \
+    } while (0)
+
+/**
+ * @brief Per-protocol counter index of an IPv6 next header value
+ */
+static inline uint8_t RTNET_Stats_ProtoIndex(uint8_t next_header)
+{
+    switch (next_header) {
+        case (uint8_t)RTNET_PROTO_ICMPV6:
+            return (uint8_t)RTNET_STATS_PROTO_ICMPV6;
+        case (uint8_t)RTNET_PROTO_UDP:
+            return (uint8_t)RTNET_STATS_PROTO_UDP;
+        case (uint8_t)RTNET_PROTO_TCP:
+            return (uint8_t)RTNET_STATS_PROTO_TCP;
+        default:
+            return (uint8_t)RTNET_STATS_PROTO_OTHER;
+    }
+}
+
+/* ==================== LATENCY PROBES ==================== */
+
+#if (RTNET_ENABLE_PROFILING != 0U)
+/**
+ * @brief Add one sample to a probe histogram
+ * @param point Probe point
+ * @param cycles Elapsed RTNET_GetCycleCount ticks
+ * @note Lock-free like the statistics counters: a sample racing another
+ *       update of the same point may be lost, never out of bounds
+ */
+void RTNET_Probe_Record(RTNET_ProbePoint_t point, uint32_t cycles);
+
+#define RTNET_PROBE_BEGIN(name)         const uint32_t name = RTNET_GetCycleCount()
+#define RTNET_PROBE_END(point, name)    RTNET_Probe_Record((point), RTNET_GetCycleCount() - (name))
+#else
+#define RTNET_PROBE_BEGIN(name)         ((void)0)
+#define RTNET_PROBE_END(point, name)    ((void)0)
+#endif
+
+#endif /* RTNET_INTERNAL_H */
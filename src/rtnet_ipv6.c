@@ -7,7 +7,7 @@
  * 
  * IMPLEMENTATION NOTES:
  * - All IPv6 addresses use network byte order (big-endian)
- * - Checksums computed using optimized assembly on Cortex-M4
+ * - Checksums computed by rtnet_checksum.c (word/SIMD kernel per target)
  * - Routing via longest-prefix-match with hash acceleration
  * - Zero-copy buffer handling via pointer offsets
  * 
@@ -45,6 +45,9 @@ SOFTWARE.
  */
 
 #include "rtnet_stack.h"
+#include "rtnet_checksum.h"
+#include "rtnet_buffer.h"
+#include "rtnet_internal.h"
 #include <string.h>
 
 /* ==================== IPv6 HEADER STRUCTURE ==================== */
@@ -82,6 +85,74 @@ typedef struct __attribute__((packed)) {
 /* Default hop limit */
 #define IPV6_DEFAULT_HOP_LIMIT  64U
 
+/* Ethernet framing */
+#define ETH_HEADER_LEN          14U
+#define ETH_TYPE_OFFSET         12U
+#define ETH_TYPE_IPV6           0x86DDU
+
+/* Header lengths */
+#define IPV6_HEADER_LEN         40U
+#define UDP_HEADER_LEN          8U
+#define TCP_MIN_HEADER_LEN      20U
+#define ICMPV6_HEADER_LEN       4U
+
+/* Extension headers walked by the RX path (bounded chain) */
+#define IPV6_EXT_HOP_BY_HOP     0U
+#define IPV6_EXT_ROUTING        43U
+#define IPV6_EXT_FRAGMENT       44U
+#define IPV6_EXT_NO_NEXT        59U
+#define IPV6_EXT_DEST_OPTS      60U
+#define IPV6_MAX_EXT_HEADERS    4U
+
+/* ICMPv6 message types (RFC 4443, RFC 4861) */
+#define ICMPV6_ECHO_REQUEST     128U
+#define ICMPV6_ECHO_REPLY       129U
+#define ICMPV6_NEIGHBOR_SOLICIT 135U
+#define ICMPV6_NEIGHBOR_ADVERT  136U
+#define ICMPV6_ROUTER_SOLICIT   133U    /* First Neighbor Discovery type */
+#define ICMPV6_REDIRECT         137U    /* Last Neighbor Discovery type */
+
+/* Neighbor Discovery */
+#define ND_HOP_LIMIT            255U
+#define ND_MSG_MIN_LEN          24U   /* type..target */
+#define ND_OPT_SOURCE_LLADDR    1U
+#define ND_OPT_TARGET_LLADDR    2U
+#define ND_NA_FLAG_SOLICITED    0x40U
+#define ND_NA_FLAG_OVERRIDE     0x20U
+#define ND_RETRANS_TIMER_MS     1000U /* RETRANS_TIMER */
+#define ND_MAX_MULTICAST_SOLICIT 3U   /* MAX_MULTICAST_SOLICIT */
+#define ND_MAX_UNICAST_SOLICIT  3U    /* MAX_UNICAST_SOLICIT */
+#define ND_REACHABLE_TIME_MS    30000U /* REACHABLE_TIME */
+#define ND_DELAY_FIRST_PROBE_MS 5000U /* DELAY_FIRST_PROBE_TIME */
+
+/* ICMPv6 errors: body after the 4-byte header, within the IPv6 minimum MTU and a TX buffer */
+#define ICMPV6_MIN_MTU          1280U
+#define ICMPV6_ERROR_MAX_BODY   (((ICMPV6_MIN_MTU + ETH_HEADER_LEN) <= RTNET_BUFFER_SIZE) ? \
+                                 (ICMPV6_MIN_MTU - IPV6_HEADER_LEN - ICMPV6_HEADER_LEN) : \
+                                 (RTNET_BUFFER_SIZE - ETH_HEADER_LEN - IPV6_HEADER_LEN - \
+                                  ICMPV6_HEADER_LEN))
+
+/* Largest UDP payload in one frame */
+#define UDP_MAX_PAYLOAD         (RTNET_MTU_SIZE - IPV6_HEADER_LEN - UDP_HEADER_LEN)
+#define UDP_FRAME_HDR_LEN       (ETH_HEADER_LEN + IPV6_HEADER_LEN + UDP_HEADER_LEN)
+
+#if (RTNET_ENABLE_FRAGMENTATION != 0U)
+#define IPV6_FRAG_CHUNK         RTNET_FRAG_PAYLOAD
+
+#if (RTNET_TX_POOL_SIZE < RTNET_TX_POOL_MIN)
+#error "RTNET_TX_POOL_SIZE leaves NORMAL/LOW too few buffers for one fragmented datagram"
+#endif
+#if (RTNET_ND_MAX_PENDING < RTNET_FRAG_MAX_FRAMES)
+#error "RTNET_ND_MAX_PENDING cannot queue one fragmented datagram"
+#endif
+
+/* Largest UDP payload sent (as fragments beyond UDP_MAX_PAYLOAD) */
+#define UDP_MAX_DATAGRAM        (((RTNET_REASM_MAX_SIZE - UDP_HEADER_LEN) > UDP_MAX_PAYLOAD) ? \
+                                 (RTNET_REASM_MAX_SIZE - UDP_HEADER_LEN) : UDP_MAX_PAYLOAD)
+#else
+#define UDP_MAX_DATAGRAM        UDP_MAX_PAYLOAD
+#endif
+
 /* Special addresses */
 static const uint8_t IPV6_ADDR_UNSPECIFIED[16] = {0};
 static const uint8_t IPV6_ADDR_LOOPBACK[16] = {
@@ -90,10 +161,30 @@ static const uint8_t IPV6_ADDR_LOOPBACK[16] = {
 
 /* ==================== GLOBAL CONTEXT ==================== */
 
-static RTNET_Context_t g_RTNET_Ctx;
+/* Payload arenas of the built-in instance, placed apart from its descriptors */
+RTNET_SECTION_DMA RTNET_ALIGNED_4
+static RTNET_Memory_t g_RTNET_DefaultMemory;
+
+RTNET_SECTION_FAST
+static RTNET_Context_t g_RTNET_DefaultCtx = { .memory = &g_RTNET_DefaultMemory };
+
+#if (RTNET_RAM_BUDGET != 0U)
+_Static_assert((sizeof(RTNET_Context_t) + sizeof(RTNET_Memory_t)) <= RTNET_RAM_BUDGET,
+               "RTNET_RAM_BUDGET exceeded: context + memory of one instance");
+#endif
+
+RTNET_THREAD_LOCAL RTNET_Context_t* g_RTNET_Ctx = &g_RTNET_DefaultCtx;
 
 /* ==================== UTILITY FUNCTIONS ==================== */
 
+/**
+ * @brief Check for an IPv6 multicast address (ff00::/8)
+ */
+static inline bool RTNET_IPv6_IsMulticast(const uint8_t* addr)
+{
+    return (addr[0] == 0xFFU);
+}
+
 /**
  * @brief Compare two IPv6 addresses
  * @param addr1 First address
@@ -116,6 +207,21 @@ static bool RTNET_IPv6_AddressEqual(const RTNET_IPv6Addr_t* addr1,
     return (diff == 0U);
 }
 
+/**
+ * @brief Hash an IPv6 address (FNV-1a over all 16 bytes)
+ * @note Used to index the neighbor and destination caches
+ */
+static uint32_t RTNET_IPv6_Hash(const RTNET_IPv6Addr_t* addr)
+{
+    uint32_t hash = 2166136261U;
+    
+    for (uint8_t i = 0U; i < RTNET_IPV6_ADDR_LEN; i++) {
+        hash = (hash ^ addr->addr[i]) * 16777619U;
+    }
+    
+    return hash ^ (hash >> 16U);
+}
+
 /**
  * @brief Check if address matches prefix
  * @param addr Address to check
@@ -150,45 +256,6 @@ static bool RTNET_IPv6_PrefixMatch(const RTNET_IPv6Addr_t* addr,
     return true;
 }
 
-/**
- * @brief Compute Internet checksum (RFC 1071)
- * @param data Data buffer
- * @param length Length in bytes
- * @param initial Initial checksum value (for pseudo-header)
- * @return 16-bit one's complement checksum
- * @note Optimized for ARM Cortex-M4 (uses DSP instructions where available)
- * @note WCET: < 80 μs for 1500 bytes @ 168MHz
- */
-static uint16_t RTNET_ComputeChecksum(const uint8_t* data,
-                                       uint16_t length,
-                                       uint32_t initial)
-{
-    if (data == NULL) {
-        return 0U;
-    }
-    
-    uint32_t sum = initial;
-    uint16_t words = length / 2U;
-    
-    /* Process 16-bit words */
-    const uint16_t* ptr16 = (const uint16_t*)data;
-    for (uint16_t i = 0U; i < words; i++) {
-        sum += ptr16[i];
-    }
-    
-    /* Handle odd byte */
-    if ((length & 1U) != 0U) {
-        sum += (uint16_t)(data[length - 1U] << 8U);
-    }
-    
-    /* Fold 32-bit sum to 16 bits */
-    while ((sum >> 16U) != 0U) {
-        sum = (sum & 0xFFFFU) + (sum >> 16U);
-    }
-    
-    return (uint16_t)(~sum);
-}
-
 /**
  * @brief Compute IPv6 pseudo-header checksum
  * @param src_addr Source address
@@ -202,24 +269,10 @@ static uint32_t RTNET_IPv6_PseudoHeaderChecksum(const RTNET_IPv6Addr_t* src_addr
                                                   uint16_t payload_len,
                                                   uint8_t next_header)
 {
-    uint32_t sum = 0U;
-    
-    /* Source address */
-    const uint16_t* src_ptr = (const uint16_t*)src_addr->addr;
-    for (uint8_t i = 0U; i < 8U; i++) {
-        sum += src_ptr[i];
-    }
-    
-    /* Destination address */
-    const uint16_t* dst_ptr = (const uint16_t*)dst_addr->addr;
-    for (uint8_t i = 0U; i < 8U; i++) {
-        sum += dst_ptr[i];
-    }
-    
-    /* Payload length (32-bit) */
+    /* Addresses, then 32-bit upper-layer length and zero-padded next header */
+    uint32_t sum = RTNET_ChecksumPartial(src_addr->addr, RTNET_IPV6_ADDR_LEN, 0U);
+    sum = RTNET_ChecksumPartial(dst_addr->addr, RTNET_IPV6_ADDR_LEN, sum);
     sum += (uint32_t)payload_len;
-    
-    /* Next header (zero-padded to 32-bit) */
     sum += (uint32_t)next_header;
     
     return sum;
@@ -228,24 +281,39 @@ static uint32_t RTNET_IPv6_PseudoHeaderChecksum(const RTNET_IPv6Addr_t* src_addr
 /* ==================== ROUTING ==================== */
 
 /**
- * @brief Find route for destination address
+ * @brief Check whether a route beats the current best of equal prefix length
+ * @param index Candidate routing table index
+ * @param best Current best index (RTNET_ROUTE_NONE if none)
+ * @return true if candidate has lower metric (ties go to lower index)
+ */
+static bool RTNET_RouteBetterMetric(uint16_t index, uint16_t best)
+{
+    if (best == RTNET_ROUTE_NONE) {
+        return true;
+    }
+    
+    uint16_t metric = g_RTNET_Ctx->routing_table[index].metric;
+    uint16_t best_metric = g_RTNET_Ctx->routing_table[best].metric;
+    
+    return (metric < best_metric) || ((metric == best_metric) && (index < best));
+}
+
+/**
+ * @brief Find route by scanning the whole routing table
  * @param dest_addr Destination address
  * @return Pointer to route entry, NULL if no route found
- * @note Uses longest-prefix-match algorithm
- * @note WCET: < 15 μs (hash-accelerated)
+ * @note Reference longest-prefix-match; WCET grows with table size
  */
-static RTNET_RouteEntry_t* RTNET_FindRoute(const RTNET_IPv6Addr_t* dest_addr)
+static RTNET_RouteEntry_t* RTNET_FindRouteLinear(const RTNET_IPv6Addr_t* dest_addr)
 {
     if (dest_addr == NULL) {
         return NULL;
     }
     
-    RTNET_RouteEntry_t* best_match = NULL;
-    uint8_t best_prefix_len = 0U;
-    uint16_t best_metric = UINT16_MAX;
+    uint16_t best = RTNET_ROUTE_NONE;
     
-    for (uint8_t i = 0U; i < RTNET_MAX_ROUTING_ENTRIES; i++) {
-        RTNET_RouteEntry_t* entry = &g_RTNET_Ctx.routing_table[i];
+    for (uint16_t i = 0U; i < RTNET_MAX_ROUTING_ENTRIES; i++) {
+        RTNET_RouteEntry_t* entry = &g_RTNET_Ctx->routing_table[i];
         
         if (!entry->valid) {
             continue;
@@ -253,85 +321,268 @@ static RTNET_RouteEntry_t* RTNET_FindRoute(const RTNET_IPv6Addr_t* dest_addr)
         
         if (RTNET_IPv6_PrefixMatch(dest_addr, &entry->destination, entry->prefix_len)) {
             /* Prefer longer prefix, then lower metric */
-            if ((entry->prefix_len > best_prefix_len) ||
-                ((entry->prefix_len == best_prefix_len) && (entry->metric < best_metric))) {
-                best_match = entry;
-                best_prefix_len = entry->prefix_len;
-                best_metric = entry->metric;
+            if ((best == RTNET_ROUTE_NONE) ||
+                (entry->prefix_len > g_RTNET_Ctx->routing_table[best].prefix_len) ||
+                ((entry->prefix_len == g_RTNET_Ctx->routing_table[best].prefix_len) &&
+                 RTNET_RouteBetterMetric(i, best))) {
+                best = i;
             }
         }
     }
     
-    return best_match;
+    return (best != RTNET_ROUTE_NONE) ? &g_RTNET_Ctx->routing_table[best] : NULL;
 }
 
-/* ==================== NEIGHBOR DISCOVERY ==================== */
+#if (RTNET_ENABLE_ROUTE_TRIE != 0U)
 
 /**
- * @brief Lookup MAC address for IPv6 address (Neighbor Discovery)
- * @param ipv6_addr IPv6 address
- * @param mac_addr [OUT] MAC address
- * @return true if found in cache, false otherwise
+ * @brief Read one address bit (bit 0 = MSB of byte 0)
  */
-static bool RTNET_ND_Lookup(const RTNET_IPv6Addr_t* ipv6_addr,
-                             RTNET_MACAddr_t* mac_addr)
+static uint8_t RTNET_IPv6_AddrBit(const RTNET_IPv6Addr_t* addr, uint8_t bit)
 {
-    if ((ipv6_addr == NULL) || (mac_addr == NULL)) {
-        return false;
+    return (uint8_t)((addr->addr[bit >> 3U] >> (7U - (bit & 7U))) & 1U);
+}
+
+/**
+ * @brief Length of the common leading bit string of two addresses
+ * @param limit Upper bound for the result (<= 128)
+ */
+static uint8_t RTNET_IPv6_CommonPrefixLen(const RTNET_IPv6Addr_t* a,
+                                           const RTNET_IPv6Addr_t* b,
+                                           uint8_t limit)
+{
+    uint8_t len = 0U;
+    
+    for (uint8_t i = 0U; i < RTNET_IPV6_ADDR_LEN; i++) {
+        uint8_t diff = (uint8_t)(a->addr[i] ^ b->addr[i]);
+        if (diff == 0U) {
+            len = (uint8_t)(len + 8U);
+            continue;
+        }
+        while ((diff & 0x80U) == 0U) {
+            diff = (uint8_t)(diff << 1U);
+            len++;
+        }
+        break;
+    }
+    
+    return (len < limit) ? len : limit;
+}
+
+/**
+ * @brief Allocate a trie node for a (pre-masked) prefix
+ * @return Node index, RTNET_ROUTE_NONE if the node pool is exhausted
+ */
+static uint16_t RTNET_RouteTrie_NewNode(const RTNET_IPv6Addr_t* prefix, uint8_t prefix_len)
+{
+    RTNET_RouteTrie_t* trie = &g_RTNET_Ctx->route_trie;
+    
+    if (trie->node_count >= RTNET_ROUTE_TRIE_NODES) {
+        return RTNET_ROUTE_NONE;
+    }
+    
+    uint16_t index = trie->node_count++;
+    RTNET_RouteTrieNode_t* node = &trie->nodes[index];
+    
+    /* Keep only the significant bits so nodes compare byte-exact */
+    memset(&node->prefix, 0, sizeof(RTNET_IPv6Addr_t));
+    uint8_t full_bytes = (uint8_t)(prefix_len / 8U);
+    uint8_t remainder_bits = (uint8_t)(prefix_len % 8U);
+    memcpy(node->prefix.addr, prefix->addr, full_bytes);
+    if (remainder_bits > 0U) {
+        node->prefix.addr[full_bytes] =
+            (uint8_t)(prefix->addr[full_bytes] & (uint8_t)(0xFFU << (8U - remainder_bits)));
     }
     
-    for (uint8_t i = 0U; i < RTNET_MAX_NEIGHBOR_CACHE; i++) {
-        RTNET_NeighborEntry_t* entry = &g_RTNET_Ctx.neighbor_cache[i];
+    node->prefix_len = prefix_len;
+    node->child[0] = RTNET_ROUTE_NONE;
+    node->child[1] = RTNET_ROUTE_NONE;
+    node->routes = RTNET_ROUTE_NONE;
+    
+    return index;
+}
+
+/**
+ * @brief Attach a routing table entry to the node owning its prefix
+ */
+static void RTNET_RouteTrie_Attach(uint16_t node, uint16_t route)
+{
+    RTNET_RouteTrie_t* trie = &g_RTNET_Ctx->route_trie;
+    
+    trie->route_next[route] = trie->nodes[node].routes;
+    trie->nodes[node].routes = route;
+}
+
+/**
+ * @brief Insert routing table entry into the trie
+ * @param route Routing table index (entry must be valid)
+ * @return RTNET_OK, RTNET_ERR_OVERFLOW if the node pool is exhausted
+ * @note At most two nodes per insert (split + leaf), so a pool of
+ *       2 * RTNET_MAX_ROUTING_ENTRIES never overflows between rebuilds
+ */
+static RTNET_Error_t RTNET_RouteTrie_Insert(uint16_t route)
+{
+    RTNET_RouteTrie_t* trie = &g_RTNET_Ctx->route_trie;
+    const RTNET_IPv6Addr_t* prefix = &g_RTNET_Ctx->routing_table[route].destination;
+    uint8_t prefix_len = g_RTNET_Ctx->routing_table[route].prefix_len;
+    uint16_t* link = &trie->root;
+    
+    /* Bounded: every iteration descends at least one bit */
+    for (uint16_t depth = 0U; depth <= 128U; depth++) {
+        uint16_t index = *link;
+        
+        if (index == RTNET_ROUTE_NONE) {
+            uint16_t leaf = RTNET_RouteTrie_NewNode(prefix, prefix_len);
+            if (leaf == RTNET_ROUTE_NONE) {
+                return RTNET_ERR_OVERFLOW;
+            }
+            RTNET_RouteTrie_Attach(leaf, route);
+            *link = leaf;
+            return RTNET_OK;
+        }
+        
+        RTNET_RouteTrieNode_t* node = &trie->nodes[index];
+        uint8_t limit = (prefix_len < node->prefix_len) ? prefix_len : node->prefix_len;
+        uint8_t common = RTNET_IPv6_CommonPrefixLen(prefix, &node->prefix, limit);
+        
+        if (common == node->prefix_len) {
+            if (prefix_len == node->prefix_len) {
+                RTNET_RouteTrie_Attach(index, route);
+                return RTNET_OK;
+            }
+            /* Node prefix covers ours: descend */
+            link = &node->child[RTNET_IPv6_AddrBit(prefix, node->prefix_len)];
+            continue;
+        }
+        
+        /* Diverges inside the node's prefix: new parent at the common length */
+        uint16_t parent = RTNET_RouteTrie_NewNode(prefix, common);
+        if (parent == RTNET_ROUTE_NONE) {
+            return RTNET_ERR_OVERFLOW;
+        }
+        node = &trie->nodes[index];
+        trie->nodes[parent].child[RTNET_IPv6_AddrBit(&node->prefix, common)] = index;
         
-        if (entry->valid && RTNET_IPv6_AddressEqual(&entry->ipv6_addr, ipv6_addr)) {
-            memcpy(mac_addr, &entry->mac_addr, sizeof(RTNET_MACAddr_t));
-            entry->last_confirmed_ms = RTNET_GetTimeMs();
-            return true;
+        if (common == prefix_len) {
+            /* Our prefix is the parent itself */
+            RTNET_RouteTrie_Attach(parent, route);
+        } else {
+            uint16_t leaf = RTNET_RouteTrie_NewNode(prefix, prefix_len);
+            if (leaf == RTNET_ROUTE_NONE) {
+                return RTNET_ERR_OVERFLOW;
+            }
+            RTNET_RouteTrie_Attach(leaf, route);
+            trie->nodes[parent].child[RTNET_IPv6_AddrBit(prefix, common)] = leaf;
         }
+        
+        *link = parent;
+        return RTNET_OK;
     }
     
-    return false;
+    return RTNET_ERR_OVERFLOW;
 }
 
 /**
- * @brief Add entry to neighbor cache
- * @param ipv6_addr IPv6 address
- * @param mac_addr MAC address
- * @return true if added, false if cache full
+ * @brief Rebuild trie from the valid routing table entries
+ * @note Used at init and after routes are removed (removal is rare, so
+ *       nodes are never unlinked individually)
  */
-static bool RTNET_ND_AddEntry(const RTNET_IPv6Addr_t* ipv6_addr,
-                               const RTNET_MACAddr_t* mac_addr)
+static void RTNET_RouteTrie_Build(void)
 {
-    if ((ipv6_addr == NULL) || (mac_addr == NULL)) {
-        return false;
-    }
+    RTNET_RouteTrie_t* trie = &g_RTNET_Ctx->route_trie;
     
-    /* Find empty slot or oldest entry */
-    uint8_t oldest_idx = 0U;
-    uint32_t oldest_time = UINT32_MAX;
+    trie->root = RTNET_ROUTE_NONE;
+    trie->node_count = 0U;
+    
+    for (uint16_t i = 0U; i < RTNET_MAX_ROUTING_ENTRIES; i++) {
+        if (g_RTNET_Ctx->routing_table[i].valid) {
+            (void)RTNET_RouteTrie_Insert(i);
+        }
+    }
+}
+
+/**
+ * @brief Find route via the trie index
+ * @param dest_addr Destination address
+ * @return Pointer to route entry, NULL if no route found
+ * @note Visits only nodes on the destination's path: bounded by the
+ *       number of distinct prefix lengths covering it (<= 129), not by
+ *       table size
+ */
+static RTNET_RouteEntry_t* RTNET_FindRouteTrie(const RTNET_IPv6Addr_t* dest_addr)
+{
+    const RTNET_RouteTrie_t* trie = &g_RTNET_Ctx->route_trie;
+    uint16_t best = RTNET_ROUTE_NONE;
+    uint16_t index = trie->root;
     
-    for (uint8_t i = 0U; i < RTNET_MAX_NEIGHBOR_CACHE; i++) {
-        RTNET_NeighborEntry_t* entry = &g_RTNET_Ctx.neighbor_cache[i];
+    while (index != RTNET_ROUTE_NONE) {
+        const RTNET_RouteTrieNode_t* node = &trie->nodes[index];
         
-        if (!entry->valid) {
-            oldest_idx = i;
+        if (!RTNET_IPv6_PrefixMatch(dest_addr, &node->prefix, node->prefix_len)) {
             break;
         }
         
-        if (entry->last_confirmed_ms < oldest_time) {
-            oldest_time = entry->last_confirmed_ms;
-            oldest_idx = i;
+        /* Deeper match always wins; pick lowest metric among equals */
+        if (node->routes != RTNET_ROUTE_NONE) {
+            best = RTNET_ROUTE_NONE;
+            for (uint16_t r = node->routes; r != RTNET_ROUTE_NONE; r = trie->route_next[r]) {
+                if (RTNET_RouteBetterMetric(r, best)) {
+                    best = r;
+                }
+            }
+        }
+        
+        if (node->prefix_len >= 128U) {
+            break;
         }
+        index = node->child[RTNET_IPv6_AddrBit(dest_addr, node->prefix_len)];
     }
     
-    /* Insert entry */
-    RTNET_NeighborEntry_t* entry = &g_RTNET_Ctx.neighbor_cache[oldest_idx];
-    memcpy(&entry->ipv6_addr, ipv6_addr, sizeof(RTNET_IPv6Addr_t));
-    memcpy(&entry->mac_addr, mac_addr, sizeof(RTNET_MACAddr_t));
-    entry->last_confirmed_ms = RTNET_GetTimeMs();
-    entry->valid = true;
+    return (best != RTNET_ROUTE_NONE) ? &g_RTNET_Ctx->routing_table[best] : NULL;
+}
+
+#endif /* RTNET_ENABLE_ROUTE_TRIE */
+
+/**
+ * @brief Find route for destination address
+ * @param dest_addr Destination address
+ * @return Pointer to route entry, NULL if no route found
+ * @note Uses longest-prefix-match algorithm
+ * @note WCET: < 15 μs (trie index, bounded by prefix depth)
+ */
+static RTNET_RouteEntry_t* RTNET_FindRoute(const RTNET_IPv6Addr_t* dest_addr)
+{
+    if (dest_addr == NULL) {
+        return NULL;
+    }
     
-    return true;
+    RTNET_PROBE_BEGIN(start);
+#if (RTNET_ENABLE_ROUTE_TRIE != 0U)
+    RTNET_RouteEntry_t* route = RTNET_FindRouteTrie(dest_addr);
+#else
+    RTNET_RouteEntry_t* route = RTNET_FindRouteLinear(dest_addr);
+#endif
+    RTNET_PROBE_END(RTNET_PROBE_ROUTE_LOOKUP, start);
+    
+    return route;
+}
+
+/**
+ * @brief Invalidate every destination cache entry
+ * @note O(1): entries are only trusted while their generation matches.
+ *       Called whenever a route or neighbor the cache may reference changes
+ */
+static void RTNET_DestCache_Invalidate(void)
+{
+    g_RTNET_Ctx->dest_cache_gen++;
+    
+    if (g_RTNET_Ctx->dest_cache_gen == 0U) {
+        /* Wrapped: clear stale tags so none can match again */
+        for (uint8_t i = 0U; i < RTNET_DEST_CACHE_SIZE; i++) {
+            g_RTNET_Ctx->dest_cache[i].generation = 0U;
+        }
+        g_RTNET_Ctx->dest_cache_gen = 1U;
+    }
 }
 
 /* ==================== BUFFER MANAGEMENT ==================== */
@@ -339,35 +590,25 @@ static bool RTNET_ND_AddEntry(const RTNET_IPv6Addr_t* ipv6_addr,
 /**
  * @brief Allocate TX buffer
  * @param qos_priority QoS priority
+ * @param frame_len Bytes the frame needs (<= RTNET_BUFFER_SIZE)
  * @return Pointer to buffer, NULL if none available
- * @note Prefers buffers matching QoS priority
+ * @note O(1) bitmap pools; frames that fit RTNET_SMALL_BUFFER_SIZE use the
+ *       control-size pool first and fall back to a full-size buffer. Lower
+ *       classes cannot dip into the RTNET_TX_RESERVE_CRITICAL /
+ *       RTNET_TX_RESERVE_HIGH reservations of either pool
  */
-static RTNET_Buffer_t* RTNET_AllocTxBuffer(uint8_t qos_priority)
+RTNET_Buffer_t* RTNET_AllocTxBuffer(uint8_t qos_priority, uint32_t frame_len)
 {
     RTNET_Buffer_t* selected = NULL;
     
-    /* First pass: find buffer with matching priority */
-    for (uint8_t i = 0U; i < RTNET_MAX_TX_BUFFERS; i++) {
-        RTNET_Buffer_t* buf = &g_RTNET_Ctx.tx_buffers[i];
-        if (!buf->in_use && (buf->qos_priority == qos_priority)) {
-            selected = buf;
-            break;
-        }
+    if (frame_len <= RTNET_SMALL_BUFFER_SIZE) {
+        selected = RTNET_Pool_Alloc(&g_RTNET_Ctx->tx_small_pool, qos_priority);
     }
-    
-    /* Second pass: any available buffer */
     if (selected == NULL) {
-        for (uint8_t i = 0U; i < RTNET_MAX_TX_BUFFERS; i++) {
-            RTNET_Buffer_t* buf = &g_RTNET_Ctx.tx_buffers[i];
-            if (!buf->in_use) {
-                selected = buf;
-                break;
-            }
-        }
+        selected = RTNET_Pool_Alloc(&g_RTNET_Ctx->tx_pool, qos_priority);
     }
     
     if (selected != NULL) {
-        selected->in_use = true;
         selected->qos_priority = qos_priority;
         selected->length = 0U;
         selected->offset = 0U;
@@ -378,138 +619,2414 @@ static RTNET_Buffer_t* RTNET_AllocTxBuffer(uint8_t qos_priority)
 }
 
 /**
- * @brief Free buffer
+ * @brief Free TX buffer
  * @param buffer Buffer to free
  */
-static void RTNET_FreeBuffer(RTNET_Buffer_t* buffer)
+void RTNET_FreeBuffer(RTNET_Buffer_t* buffer)
 {
-    if (buffer != NULL) {
-        buffer->in_use = false;
+    if (buffer == NULL) {
+        return;
+    }
+    
+    if (buffer >= &g_RTNET_Ctx->tx_buffers[RTNET_TX_POOL_SIZE]) {
+        (void)RTNET_Pool_Free(&g_RTNET_Ctx->tx_small_pool, buffer);
+    } else {
+        (void)RTNET_Pool_Free(&g_RTNET_Ctx->tx_pool, buffer);
     }
 }
 
-/* ==================== PUBLIC API IMPLEMENTATION ==================== */
+/* ==================== TX PATH ==================== */
 
-RTNET_Error_t RTNET_Initialize(const RTNET_IPv6Addr_t* local_ipv6,
-                                const RTNET_MACAddr_t* local_mac)
+/**
+ * @brief Map an upper-layer protocol to its checksum offload flag
+ * @param next_header Upper-layer protocol
+ * @return RTNET_HWCAP_CSUM_* flag, 0 if the protocol has no offload flag
+ */
+static uint32_t RTNET_HwChecksumFlag(uint8_t next_header)
 {
-    if ((local_ipv6 == NULL) || (local_mac == NULL)) {
-        return RTNET_ERR_INVALID_PARAM;
+    switch (next_header) {
+        case (uint8_t)RTNET_PROTO_ICMPV6:
+            return RTNET_HWCAP_CSUM_ICMPV6;
+        case (uint8_t)RTNET_PROTO_UDP:
+            return RTNET_HWCAP_CSUM_UDP;
+        case (uint8_t)RTNET_PROTO_TCP:
+            return RTNET_HWCAP_CSUM_TCP;
+        default:
+            return 0U;
     }
-    
-    /* Zero all state */
-    memset(&g_RTNET_Ctx, 0, sizeof(RTNET_Context_t));
-    
-    /* Copy addresses */
-    memcpy(&g_RTNET_Ctx.local_ipv6, local_ipv6, sizeof(RTNET_IPv6Addr_t));
-    memcpy(&g_RTNET_Ctx.local_mac, local_mac, sizeof(RTNET_MACAddr_t));
-    
-    /* Initialize ephemeral port range (49152-65535) */
-    g_RTNET_Ctx.next_ephemeral_port = 49152U;
-    
-    /* Initialize sequence number */
-    g_RTNET_Ctx.sequence_number = RTNET_GetTimeMs();
-    
-    /* Add link-local route */
-    RTNET_IPv6Addr_t link_local_prefix = {
-        .addr = {0xFE, 0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
-    };
-    RTNET_AddRoute(&link_local_prefix, 10U, NULL, 1U);
-    
-    g_RTNET_Ctx.initialized = true;
-    
-    return RTNET_OK;
 }
 
-RTNET_Error_t RTNET_AddRoute(const RTNET_IPv6Addr_t* destination,
-                              uint8_t prefix_len,
-                              const RTNET_IPv6Addr_t* next_hop,
-                              uint16_t metric)
+/**
+ * @brief Check whether the MAC inserts the checksum for a TX protocol
+ */
+static inline bool RTNET_HwChecksumTx(uint8_t next_header)
 {
-    if ((destination == NULL) || (prefix_len > 128U)) {
-        return RTNET_ERR_INVALID_PARAM;
-    }
-    
-    /* Find empty slot */
-    for (uint8_t i = 0U; i < RTNET_MAX_ROUTING_ENTRIES; i++) {
-        RTNET_RouteEntry_t* entry = &g_RTNET_Ctx.routing_table[i];
-        
-        if (!entry->valid) {
-            memcpy(&entry->destination, destination, sizeof(RTNET_IPv6Addr_t));
-            entry->prefix_len = prefix_len;
-            
-            if (next_hop != NULL) {
-                memcpy(&entry->next_hop, next_hop, sizeof(RTNET_IPv6Addr_t));
-            } else {
-                memset(&entry->next_hop, 0, sizeof(RTNET_IPv6Addr_t));
-            }
-            
-            entry->metric = metric;
-            entry->last_used_ms = RTNET_GetTimeMs();
-            entry->valid = true;
-            
-            return RTNET_OK;
-        }
-    }
-    
-    return RTNET_ERR_OVERFLOW;
+    return ((g_RTNET_Ctx->hw_caps.tx_csum & RTNET_HwChecksumFlag(next_header)) != 0U);
 }
 
-RTNET_Error_t RTNET_GetStatistics(RTNET_Statistics_t* stats)
+/**
+ * @brief Check whether the MAC already verified an RX protocol checksum
+ */
+static inline bool RTNET_HwChecksumRx(uint8_t next_header)
 {
-    if (stats == NULL) {
-        return RTNET_ERR_INVALID_PARAM;
-    }
-    
-    RTNET_CriticalSectionEnter();
-    memcpy(stats, &g_RTNET_Ctx.stats, sizeof(RTNET_Statistics_t));
-    RTNET_CriticalSectionExit();
-    
-    return RTNET_OK;
+    return ((g_RTNET_Ctx->hw_caps.rx_csum & RTNET_HwChecksumFlag(next_header)) != 0U);
 }
 
-void RTNET_PeriodicTask(void)
+/**
+ * @brief Map an IPv6 multicast group to its Ethernet address (RFC 2464 7)
+ * @param group Multicast group address
+ * @param mac [OUT] 33:33:xx:xx:xx:xx
+ */
+static void RTNET_IPv6_MulticastMAC(const uint8_t* group, uint8_t* mac)
 {
-    uint32_t now = RTNET_GetTimeMs();
-    
-    /* Age neighbor cache (remove entries older than 30 seconds) */
-    for (uint8_t i = 0U; i < RTNET_MAX_NEIGHBOR_CACHE; i++) {
-        RTNET_NeighborEntry_t* entry = &g_RTNET_Ctx.neighbor_cache[i];
-        if (entry->valid && ((now - entry->last_confirmed_ms) > 30000U)) {
-            entry->valid = false;
-        }
-    }
-    
-    /* Age routing table (remove unused routes after 5 minutes) */
-    for (uint8_t i = 0U; i < RTNET_MAX_ROUTING_ENTRIES; i++) {
-        RTNET_RouteEntry_t* entry = &g_RTNET_Ctx.routing_table[i];
-        if (entry->valid && ((now - entry->last_used_ms) > 300000U)) {
-            entry->valid = false;
-        }
-    }
-    
-    /* Check TCP connections for timeout */
-    for (uint8_t i = 0U; i < RTNET_MAX_TCP_CONNECTIONS; i++) {
-        RTNET_TCPConnection_t* conn = &g_RTNET_Ctx.tcp_connections[i];
-        if (conn->in_use && ((now - conn->last_activity_ms) > RTNET_TCP_TIMEOUT_MS)) {
-            conn->state = RTNET_TCP_CLOSED;
-            conn->in_use = false;
-        }
-    }
+    mac[0] = 0x33U;
+    mac[1] = 0x33U;
+    memcpy(&mac[2], &group[12], 4U);
 }
 
-RTNET_Error_t RTNET_CloseConnection(uint8_t connection_id)
+/**
+ * @brief Write Ethernet source/type and IPv6 header at the start of a frame
+ * @param frame Frame start (destination MAC is filled once the next hop is resolved)
+ * @param dst_addr Destination IPv6 address
+ * @param payload_len IPv6 payload length
+ * @param next_header Upper-layer protocol
+ * @param hop_limit Hop limit
+ */
+static void RTNET_IPv6_BuildHeader(uint8_t* frame,
+                                   const RTNET_IPv6Addr_t* dst_addr,
+                                   uint16_t payload_len,
+                                   uint8_t next_header,
+                                   uint8_t hop_limit)
 {
-    if (connection_id >= RTNET_MAX_TCP_CONNECTIONS) {
+    memcpy(&frame[RTNET_MAC_ADDR_LEN], g_RTNET_Ctx->local_mac.addr, RTNET_MAC_ADDR_LEN);
+    RTNET_Write16(&frame[ETH_TYPE_OFFSET], ETH_TYPE_IPV6);
+
+    uint8_t* ip = &frame[ETH_HEADER_LEN];
+    ip[0] = (uint8_t)(IPV6_VERSION >> 24U);
+    ip[1] = 0U;
+    ip[2] = 0U;
+    ip[3] = 0U;
+    RTNET_Write16(&ip[4], payload_len);
+    ip[6] = next_header;
+    ip[7] = hop_limit;
+    memcpy(&ip[8], g_RTNET_Ctx->local_ipv6.addr, RTNET_IPV6_ADDR_LEN);
+    memcpy(&ip[24], dst_addr->addr, RTNET_IPV6_ADDR_LEN);
+}
+
+/**
+ * @brief Queue a completed frame for the MAC and run the TX scheduler
+ * @param buf TX buffer with length set and destination MAC filled (consumed)
+ */
+static void RTNET_TxFrame(RTNET_Buffer_t* buf)
+{
+    RTNET_TxSched_Enqueue(buf);
+    (void)RTNET_PollTx(UINT16_MAX);
+}
+
+/**
+ * @brief Completed frames waiting for one RTNET_HardwareTransmitBatch call
+ */
+typedef struct {
+    RTNET_Buffer_t* buffers[RTNET_TX_BATCH_MAX];
+    uint16_t count;
+} RTNET_TxBatch_t;
+
+/**
+ * @brief Queue all batched frames, then run the TX scheduler once
+ * @param batch Batch (emptied on return)
+ * @note The scheduler hands the frames to the MAC in scatter lists of up
+ *       to RTNET_TX_BATCH_MAX, so the batch still costs one doorbell
+ */
+static void RTNET_TxBatch_Flush(RTNET_TxBatch_t* batch)
+{
+    if (batch->count == 0U) {
+        return;
+    }
+
+    for (uint16_t i = 0U; i < batch->count; i++) {
+        RTNET_TxSched_Enqueue(batch->buffers[i]);
+    }
+    batch->count = 0U;
+
+    (void)RTNET_PollTx(UINT16_MAX);
+}
+
+/**
+ * @brief Build and transmit an ICMPv6 message from the local address
+ * @param dst_mac Destination MAC address
+ * @param dst_addr Destination IPv6 address
+ * @param type ICMPv6 type
+ * @param code ICMPv6 code
+ * @param hop_limit IPv6 hop limit
+ * @param body Message body after the 4-byte ICMPv6 header
+ * @param body_len Body length in bytes
+ * @param checksum Precomputed checksum (NULL = compute over the message)
+ * @return RTNET_OK on success, error code otherwise
+ */
+static RTNET_Error_t RTNET_ICMPv6_Output(const uint8_t* dst_mac,
+                                         const RTNET_IPv6Addr_t* dst_addr,
+                                         uint8_t type,
+                                         uint8_t code,
+                                         uint8_t hop_limit,
+                                         const uint8_t* body,
+                                         uint16_t body_len,
+                                         const uint16_t* checksum)
+{
+    const uint16_t icmp_len = (uint16_t)(ICMPV6_HEADER_LEN + body_len);
+    const uint32_t frame_len = ETH_HEADER_LEN + IPV6_HEADER_LEN + (uint32_t)icmp_len;
+    if (frame_len > RTNET_BUFFER_SIZE) {
+        return RTNET_ERR_OVERFLOW;
+    }
+
+    RTNET_Buffer_t* buf = RTNET_AllocTxBuffer(RTNET_QOS_CRITICAL, frame_len);
+    if (buf == NULL) {
+        RTNET_STAT_DROP(tx_dropped, RTNET_DROP_NO_TX_BUFFER);
+        return RTNET_ERR_NO_BUFFER;
+    }
+
+    RTNET_PROBE_BEGIN(start);
+    uint8_t* frame = buf->data;
+    memcpy(&frame[0], dst_mac, RTNET_MAC_ADDR_LEN);
+    RTNET_IPv6_BuildHeader(frame, dst_addr, icmp_len, (uint8_t)RTNET_PROTO_ICMPV6, hop_limit);
+
+    /* ICMPv6 header + body */
+    uint8_t* icmp = &frame[ETH_HEADER_LEN + IPV6_HEADER_LEN];
+    icmp[0] = type;
+    icmp[1] = code;
+    icmp[2] = 0U;
+    icmp[3] = 0U;
+    if (body_len > 0U) {
+        memcpy(&icmp[ICMPV6_HEADER_LEN], body, body_len);
+    }
+
+    if (RTNET_HwChecksumTx((uint8_t)RTNET_PROTO_ICMPV6)) {
+        /* MAC inserts the checksum; field stays zero */
+    } else if (checksum != NULL) {
+        RTNET_Write16(&icmp[2], *checksum);
+    } else {
+        uint32_t pseudo = RTNET_IPv6_PseudoHeaderChecksum(&g_RTNET_Ctx->local_ipv6, dst_addr,
+                                                           icmp_len, (uint8_t)RTNET_PROTO_ICMPV6);
+        RTNET_PROBE_BEGIN(csum_start);
+        RTNET_Write16(&icmp[2], RTNET_ComputeChecksum(icmp, icmp_len, pseudo));
+        RTNET_PROBE_END(RTNET_PROBE_CHECKSUM, csum_start);
+    }
+
+    buf->length = (uint16_t)(ETH_HEADER_LEN + IPV6_HEADER_LEN + icmp_len);
+    RTNET_PROBE_END(RTNET_PROBE_TX_BUILD, start);
+    RTNET_TxFrame(buf);
+
+    return RTNET_OK;
+}
+
+RTNET_Error_t RTNET_ICMPv6_Error(const uint8_t* dst_mac,
+                                 const RTNET_IPv6Addr_t* dst_addr,
+                                 uint8_t type,
+                                 uint8_t code,
+                                 const uint8_t* body,
+                                 uint16_t body_len)
+{
+    /* Never to a group or to a node without an address */
+    if (RTNET_IPv6_IsMulticast(dst_addr->addr) ||
+        (memcmp(dst_addr->addr, IPV6_ADDR_UNSPECIFIED, RTNET_IPV6_ADDR_LEN) == 0)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    /* Bounded error rate, per destination and overall (RFC 4443 2.4 f):
+     * suppression is the intended outcome, not a failure */
+    if (!RTNET_RateLimit_Admit(RTNET_ICMPV6_LIMIT_ERROR, dst_addr->addr)) {
+        RTNET_STAT_DROP(tx_dropped, RTNET_DROP_RATE_LIMITED);
+        return RTNET_OK;
+    }
+
+    /* As much of the invoking packet as fits the minimum MTU (RFC 4443 2.4 c) */
+    if (body_len > ICMPV6_ERROR_MAX_BODY) {
+        body_len = ICMPV6_ERROR_MAX_BODY;
+    }
+
+    return RTNET_ICMPv6_Output(dst_mac, dst_addr, type, code, IPV6_DEFAULT_HOP_LIMIT,
+                               body, body_len, NULL);
+}
+
+/**
+ * @brief Determine the on-link next hop for a destination
+ * @param dest_addr Destination address
+ * @param next_hop [OUT] Neighbor to resolve (destination itself when on-link)
+ * @param route_out [OUT] Route used (NULL for multicast)
+ * @return true if a route exists
+ */
+static bool RTNET_IPv6_NextHop(const RTNET_IPv6Addr_t* dest_addr,
+                               RTNET_IPv6Addr_t* next_hop,
+                               RTNET_RouteEntry_t** route_out)
+{
+    *route_out = NULL;
+
+    if (RTNET_IPv6_IsMulticast(dest_addr->addr)) {
+        memcpy(next_hop, dest_addr, sizeof(RTNET_IPv6Addr_t));
+        return true;
+    }
+
+    RTNET_RouteEntry_t* route = RTNET_FindRoute(dest_addr);
+    if (route == NULL) {
+        return false;
+    }
+
+    *route_out = route;
+
+    route->last_used_ms = RTNET_GetTimeMs();
+
+    if (memcmp(route->next_hop.addr, IPV6_ADDR_UNSPECIFIED, RTNET_IPV6_ADDR_LEN) == 0) {
+        memcpy(next_hop, dest_addr, sizeof(RTNET_IPv6Addr_t));
+    } else {
+        memcpy(next_hop, &route->next_hop, sizeof(RTNET_IPv6Addr_t));
+    }
+
+    return true;
+}
+
+/* ==================== NEIGHBOR DISCOVERY ==================== */
+
+/**
+ * @brief Home slot of an address in the neighbor hash
+ */
+static uint16_t RTNET_ND_Home(const RTNET_IPv6Addr_t* ipv6_addr)
+{
+    return (uint16_t)(RTNET_IPv6_Hash(ipv6_addr) & (RTNET_ND_HASH_SIZE - 1U));
+}
+
+/**
+ * @brief Locate the hash slot holding an address
+ * @return Slot position, RTNET_ND_NONE if not cached
+ * @note At most RTNET_ND_MAX_PROBE compares
+ */
+static uint16_t RTNET_ND_SlotOf(const RTNET_IPv6Addr_t* ipv6_addr)
+{
+    const RTNET_NeighborIndex_t* nx = &g_RTNET_Ctx->neighbor_index;
+    uint16_t home = RTNET_ND_Home(ipv6_addr);
+    
+    for (uint16_t probe = 0U; probe < RTNET_ND_MAX_PROBE; probe++) {
+        uint16_t pos = (uint16_t)((home + probe) & (RTNET_ND_HASH_SIZE - 1U));
+        uint16_t index = nx->slots[pos];
+        
+        if (index == RTNET_ND_NONE) {
+            break;
+        }
+        if (RTNET_IPv6_AddressEqual(&g_RTNET_Ctx->neighbor_cache[index].ipv6_addr, ipv6_addr)) {
+            return pos;
+        }
+    }
+    
+    return RTNET_ND_NONE;
+}
+
+/**
+ * @brief Find neighbor cache entry for an address (any state)
+ * @param ipv6_addr IPv6 address
+ * @return Entry, NULL if not cached
+ */
+static RTNET_NeighborEntry_t* RTNET_ND_Find(const RTNET_IPv6Addr_t* ipv6_addr)
+{
+    uint16_t pos = RTNET_ND_SlotOf(ipv6_addr);
+    if (pos == RTNET_ND_NONE) {
+        return NULL;
+    }
+    
+    return &g_RTNET_Ctx->neighbor_cache[g_RTNET_Ctx->neighbor_index.slots[pos]];
+}
+
+/**
+ * @brief Remove an entry from the LRU list
+ */
+static void RTNET_ND_LruUnlink(uint16_t index)
+{
+    RTNET_NeighborIndex_t* nx = &g_RTNET_Ctx->neighbor_index;
+    RTNET_NeighborEntry_t* entry = &g_RTNET_Ctx->neighbor_cache[index];
+    
+    if (entry->lru_prev != RTNET_ND_NONE) {
+        g_RTNET_Ctx->neighbor_cache[entry->lru_prev].lru_next = entry->lru_next;
+    } else {
+        nx->lru_head = entry->lru_next;
+    }
+    
+    if (entry->lru_next != RTNET_ND_NONE) {
+        g_RTNET_Ctx->neighbor_cache[entry->lru_next].lru_prev = entry->lru_prev;
+    } else {
+        nx->lru_tail = entry->lru_prev;
+    }
+}
+
+/**
+ * @brief Insert an entry at the most-recently-used end of the LRU list
+ */
+static void RTNET_ND_LruPushFront(uint16_t index)
+{
+    RTNET_NeighborIndex_t* nx = &g_RTNET_Ctx->neighbor_index;
+    RTNET_NeighborEntry_t* entry = &g_RTNET_Ctx->neighbor_cache[index];
+    
+    entry->lru_prev = RTNET_ND_NONE;
+    entry->lru_next = nx->lru_head;
+    
+    if (nx->lru_head != RTNET_ND_NONE) {
+        g_RTNET_Ctx->neighbor_cache[nx->lru_head].lru_prev = index;
+    } else {
+        nx->lru_tail = index;
+    }
+    nx->lru_head = index;
+}
+
+/**
+ * @brief Reset neighbor cache index (all entries on the free list)
+ */
+static void RTNET_ND_Init(void)
+{
+    RTNET_NeighborIndex_t* nx = &g_RTNET_Ctx->neighbor_index;
+    
+    for (uint16_t i = 0U; i < RTNET_ND_HASH_SIZE; i++) {
+        nx->slots[i] = RTNET_ND_NONE;
+    }
+    
+    for (uint16_t i = 0U; i < RTNET_MAX_NEIGHBOR_CACHE; i++) {
+        g_RTNET_Ctx->neighbor_cache[i].valid = false;
+        g_RTNET_Ctx->neighbor_cache[i].lru_next =
+            ((i + 1U) < RTNET_MAX_NEIGHBOR_CACHE) ? (uint16_t)(i + 1U) : RTNET_ND_NONE;
+    }
+    
+    nx->free_head = 0U;
+    nx->lru_head = RTNET_ND_NONE;
+    nx->lru_tail = RTNET_ND_NONE;
+}
+
+/**
+ * @brief Note a transmission to a neighbor (RFC 4861 7.3.3)
+ * @param entry Resolved neighbor entry
+ * @param now Current time in ms
+ * @note Refreshes LRU position only; reachability is confirmed solely by
+ *       advertisements, so a busy but dead neighbor still gets probed
+ */
+static void RTNET_ND_Touch(RTNET_NeighborEntry_t* entry, uint32_t now)
+{
+    uint16_t index = (uint16_t)(entry - g_RTNET_Ctx->neighbor_cache);
+    
+    if (g_RTNET_Ctx->neighbor_index.lru_head != index) {
+        RTNET_ND_LruUnlink(index);
+        RTNET_ND_LruPushFront(index);
+    }
+    entry->last_used_ms = now;
+    
+    if (entry->state == RTNET_ND_STATE_STALE) {
+        entry->state = RTNET_ND_STATE_DELAY;
+        entry->timer_ms = now;
+    }
+}
+
+/**
+ * @brief Lookup MAC address for IPv6 address (Neighbor Discovery)
+ * @param ipv6_addr IPv6 address
+ * @param mac_addr [OUT] MAC address
+ * @return true if found in cache, false otherwise (including unresolved entries)
+ * @note Counts as a transmission: STALE entries move to DELAY
+ */
+static bool RTNET_ND_Lookup(const RTNET_IPv6Addr_t* ipv6_addr,
+                             RTNET_MACAddr_t* mac_addr)
+{
+    if ((ipv6_addr == NULL) || (mac_addr == NULL)) {
+        return false;
+    }
+    
+    RTNET_NeighborEntry_t* entry = RTNET_ND_Find(ipv6_addr);
+    if ((entry == NULL) || (entry->state == RTNET_ND_STATE_INCOMPLETE)) {
+        return false;
+    }
+    
+    memcpy(mac_addr, &entry->mac_addr, sizeof(RTNET_MACAddr_t));
+    RTNET_ND_Touch(entry, RTNET_GetTimeMs());
+    return true;
+}
+
+/**
+ * @brief Release packets queued on an unresolved neighbor
+ * @param entry Neighbor entry
+ */
+static void RTNET_ND_DropPending(RTNET_NeighborEntry_t* entry)
+{
+    for (uint8_t i = 0U; i < entry->pending_count; i++) {
+        RTNET_FreeBuffer(&g_RTNET_Ctx->tx_buffers[entry->pending[i]]);
+        RTNET_STAT_DROP(tx_dropped, RTNET_DROP_ND_UNRESOLVED);
+    }
+    entry->pending_count = 0U;
+}
+
+/**
+ * @brief Transmit packets queued on a neighbor that just resolved
+ * @param entry Neighbor entry (MAC address valid)
+ */
+static void RTNET_ND_FlushPending(RTNET_NeighborEntry_t* entry)
+{
+    if (entry->pending_count == 0U) {
+        return;
+    }
+    
+    for (uint8_t i = 0U; i < entry->pending_count; i++) {
+        RTNET_Buffer_t* buf = &g_RTNET_Ctx->tx_buffers[entry->pending[i]];
+        memcpy(&buf->data[buf->offset], entry->mac_addr.addr, RTNET_MAC_ADDR_LEN);
+        RTNET_TxFrame(buf);
+    }
+    entry->pending_count = 0U;
+    
+    RTNET_ND_Touch(entry, RTNET_GetTimeMs());
+}
+
+/**
+ * @brief Clear a hash slot, shifting later probe-chain members back
+ * @param pos Slot to clear
+ * @note Backward-shift deletion: no tombstones, and no entry ever moves
+ *       further than RTNET_ND_MAX_PROBE from its home slot
+ */
+static void RTNET_ND_HashRemove(uint16_t pos)
+{
+    RTNET_NeighborIndex_t* nx = &g_RTNET_Ctx->neighbor_index;
+    uint16_t hole = pos;
+    
+    nx->slots[hole] = RTNET_ND_NONE;
+    
+    for (uint16_t step = 1U; step < RTNET_ND_HASH_SIZE; step++) {
+        uint16_t next = (uint16_t)((pos + step) & (RTNET_ND_HASH_SIZE - 1U));
+        uint16_t index = nx->slots[next];
+        
+        /* Nothing past an empty slot or beyond probe reach of the hole */
+        if ((index == RTNET_ND_NONE) ||
+            (((uint16_t)(next - hole) & (RTNET_ND_HASH_SIZE - 1U)) >= RTNET_ND_MAX_PROBE)) {
+            break;
+        }
+        
+        uint16_t home = RTNET_ND_Home(&g_RTNET_Ctx->neighbor_cache[index].ipv6_addr);
+        if (((uint16_t)(next - home) & (RTNET_ND_HASH_SIZE - 1U)) >=
+            ((uint16_t)(next - hole) & (RTNET_ND_HASH_SIZE - 1U))) {
+            nx->slots[hole] = index;
+            nx->slots[next] = RTNET_ND_NONE;
+            hole = next;
+        }
+    }
+}
+
+/**
+ * @brief Return an entry to the free list (hash slot handled by caller)
+ */
+static void RTNET_ND_Discard(uint16_t index)
+{
+    RTNET_NeighborIndex_t* nx = &g_RTNET_Ctx->neighbor_index;
+    RTNET_NeighborEntry_t* entry = &g_RTNET_Ctx->neighbor_cache[index];
+    
+    RTNET_ND_DropPending(entry);
+    RTNET_ND_LruUnlink(index);
+    entry->valid = false;
+    entry->lru_next = nx->free_head;
+    nx->free_head = index;
+    
+    /* Cached TX paths may point at this entry */
+    RTNET_DestCache_Invalidate();
+}
+
+/**
+ * @brief Delete a neighbor cache entry
+ * @param index neighbor_cache index
+ */
+static void RTNET_ND_Release(uint16_t index)
+{
+    uint16_t pos = RTNET_ND_SlotOf(&g_RTNET_Ctx->neighbor_cache[index].ipv6_addr);
+    
+    if (pos != RTNET_ND_NONE) {
+        RTNET_ND_HashRemove(pos);
+    }
+    RTNET_ND_Discard(index);
+}
+
+/**
+ * @brief Create a neighbor cache entry
+ * @param ipv6_addr Neighbor address (must not be cached yet)
+ * @param state Initial state
+ * @param now Current time in ms
+ * @return New entry (MAC zeroed)
+ * @note O(1) + RTNET_ND_MAX_PROBE: a full cache evicts the LRU tail, a
+ *       full probe window evicts its least recently used member
+ */
+static RTNET_NeighborEntry_t* RTNET_ND_Create(const RTNET_IPv6Addr_t* ipv6_addr,
+                                              uint8_t state,
+                                              uint32_t now)
+{
+    RTNET_NeighborIndex_t* nx = &g_RTNET_Ctx->neighbor_index;
+    
+    if (nx->free_head == RTNET_ND_NONE) {
+        RTNET_ND_Release(nx->lru_tail);
+    }
+    
+    uint16_t home = RTNET_ND_Home(ipv6_addr);
+    uint16_t pos = RTNET_ND_NONE;
+    uint16_t victim_pos = RTNET_ND_NONE;
+    uint32_t victim_idle = 0U;
+    
+    for (uint16_t probe = 0U; probe < RTNET_ND_MAX_PROBE; probe++) {
+        uint16_t slot = (uint16_t)((home + probe) & (RTNET_ND_HASH_SIZE - 1U));
+        uint16_t occupant = nx->slots[slot];
+        
+        if (occupant == RTNET_ND_NONE) {
+            pos = slot;
+            break;
+        }
+        
+        uint32_t idle = now - g_RTNET_Ctx->neighbor_cache[occupant].last_used_ms;
+        if ((victim_pos == RTNET_ND_NONE) || (idle > victim_idle)) {
+            victim_pos = slot;
+            victim_idle = idle;
+        }
+    }
+    
+    if (pos == RTNET_ND_NONE) {
+        /* Reuse the victim's slot directly; it lies in our probe window */
+        RTNET_ND_Discard(nx->slots[victim_pos]);
+        pos = victim_pos;
+    }
+    
+    uint16_t index = nx->free_head;
+    RTNET_NeighborEntry_t* entry = &g_RTNET_Ctx->neighbor_cache[index];
+    nx->free_head = entry->lru_next;
+    
+    memset(entry, 0, sizeof(RTNET_NeighborEntry_t));
+    memcpy(&entry->ipv6_addr, ipv6_addr, sizeof(RTNET_IPv6Addr_t));
+    entry->state = state;
+    entry->timer_ms = now;
+    entry->last_confirmed_ms = now;
+    entry->last_used_ms = now;
+    entry->valid = true;
+    
+    nx->slots[pos] = index;
+    RTNET_ND_LruPushFront(index);
+    
+    return entry;
+}
+
+/**
+ * @brief Record a link-layer address carried by a Neighbor Solicitation
+ * @param ipv6_addr Solicitation source
+ * @param mac_addr Source link-layer address option
+ * @note RFC 4861 7.2.3: new or changed addresses enter STALE
+ */
+static void RTNET_ND_LearnFromSolicit(const RTNET_IPv6Addr_t* ipv6_addr,
+                                      const RTNET_MACAddr_t* mac_addr)
+{
+    RTNET_NeighborEntry_t* entry = RTNET_ND_Find(ipv6_addr);
+    
+    if (entry == NULL) {
+        entry = RTNET_ND_Create(ipv6_addr, RTNET_ND_STATE_STALE, RTNET_GetTimeMs());
+        memcpy(&entry->mac_addr, mac_addr, sizeof(RTNET_MACAddr_t));
+        return;
+    }
+    
+    if (entry->state == RTNET_ND_STATE_INCOMPLETE) {
+        memcpy(&entry->mac_addr, mac_addr, sizeof(RTNET_MACAddr_t));
+        entry->state = RTNET_ND_STATE_STALE;
+        entry->solicit_count = 0U;
+        RTNET_ND_FlushPending(entry);
+        return;
+    }
+    
+    if (memcmp(&entry->mac_addr, mac_addr, sizeof(RTNET_MACAddr_t)) != 0) {
+        /* Neighbor moved: cached headers carry the old MAC */
+        memcpy(&entry->mac_addr, mac_addr, sizeof(RTNET_MACAddr_t));
+        entry->state = RTNET_ND_STATE_STALE;
+        RTNET_DestCache_Invalidate();
+    }
+}
+
+/**
+ * @brief Apply a Neighbor Advertisement to the cache (RFC 4861 7.2.5)
+ * @param target Advertised target address
+ * @param mac_addr Target link-layer address option (NULL if absent)
+ * @param flags NA flag byte (Solicited / Override)
+ * @note Advertisements for uncached targets are discarded
+ */
+static void RTNET_ND_ApplyAdvert(const RTNET_IPv6Addr_t* target,
+                                 const RTNET_MACAddr_t* mac_addr,
+                                 uint8_t flags)
+{
+    RTNET_NeighborEntry_t* entry = RTNET_ND_Find(target);
+    if (entry == NULL) {
+        return;
+    }
+    
+    const bool solicited = ((flags & ND_NA_FLAG_SOLICITED) != 0U);
+    const bool override = ((flags & ND_NA_FLAG_OVERRIDE) != 0U);
+    uint32_t now = RTNET_GetTimeMs();
+    
+    if (entry->state == RTNET_ND_STATE_INCOMPLETE) {
+        if (mac_addr == NULL) {
+            return;
+        }
+        memcpy(&entry->mac_addr, mac_addr, sizeof(RTNET_MACAddr_t));
+        entry->state = solicited ? RTNET_ND_STATE_REACHABLE : RTNET_ND_STATE_STALE;
+        entry->last_confirmed_ms = now;
+        entry->solicit_count = 0U;
+        RTNET_ND_FlushPending(entry);
+        return;
+    }
+    
+    const bool changed = (mac_addr != NULL) &&
+                         (memcmp(&entry->mac_addr, mac_addr, sizeof(RTNET_MACAddr_t)) != 0);
+    
+    if (changed && !override) {
+        /* Keep the cached address but stop trusting it */
+        if (entry->state == RTNET_ND_STATE_REACHABLE) {
+            entry->state = RTNET_ND_STATE_STALE;
+        }
+        return;
+    }
+    
+    if (changed) {
+        memcpy(&entry->mac_addr, mac_addr, sizeof(RTNET_MACAddr_t));
+        RTNET_DestCache_Invalidate();
+    }
+    
+    if (solicited) {
+        entry->state = RTNET_ND_STATE_REACHABLE;
+        entry->last_confirmed_ms = now;
+        entry->solicit_count = 0U;
+    } else if (changed) {
+        entry->state = RTNET_ND_STATE_STALE;
+    } else {
+        /* Unsolicited, same address: no reachability information */
+    }
+}
+
+/**
+ * @brief Send a Neighbor Solicitation for a target (RFC 4861 7.2.2)
+ * @param target Address to resolve
+ * @param unicast_mac Cached MAC for reachability probes, NULL to resolve
+ *        via the solicited-node multicast group
+ */
+static void RTNET_ND_SendSolicit(const RTNET_IPv6Addr_t* target, const uint8_t* unicast_mac)
+{
+    /* Solicited-node multicast group ff02::1:ffXX:XXXX */
+    RTNET_IPv6Addr_t group = {
+        .addr = {0xFF, 0x02, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01, 0xFF, 0, 0, 0}
+    };
+    memcpy(&group.addr[13], &target->addr[13], 3U);
+
+    uint8_t group_mac[RTNET_MAC_ADDR_LEN];
+    RTNET_IPv6_MulticastMAC(group.addr, group_mac);
+
+    /* Body: reserved(4) + target(16) + SLLA option(8) */
+    uint8_t body[4U + RTNET_IPV6_ADDR_LEN + 8U];
+    memset(body, 0, sizeof(body));
+    memcpy(&body[4], target->addr, RTNET_IPV6_ADDR_LEN);
+    body[20] = ND_OPT_SOURCE_LLADDR;
+    body[21] = 1U;
+    memcpy(&body[22], g_RTNET_Ctx->local_mac.addr, RTNET_MAC_ADDR_LEN);
+
+    if (unicast_mac != NULL) {
+        (void)RTNET_ICMPv6_Output(unicast_mac, target, ICMPV6_NEIGHBOR_SOLICIT, 0U,
+                                  ND_HOP_LIMIT, body, (uint16_t)sizeof(body), NULL);
+    } else {
+        (void)RTNET_ICMPv6_Output(group_mac, &group, ICMPV6_NEIGHBOR_SOLICIT, 0U,
+                                  ND_HOP_LIMIT, body, (uint16_t)sizeof(body), NULL);
+    }
+}
+
+/**
+ * @brief Transmit a frame to a next hop, resolving its MAC address
+ * @param next_hop On-link neighbor (or multicast group)
+ * @param buf Built frame; ownership passes to this function
+ * @return RTNET_OK if sent or queued for resolution, error code otherwise
+ * @note At most RTNET_ND_MAX_PENDING packets wait per unresolved neighbor.
+ *       Further sends are refused with RTNET_ERR_NO_BUFFER rather than
+ *       silently replacing an accepted packet (RFC 4861 7.2.2 deviation).
+ */
+static RTNET_Error_t RTNET_ND_Resolve(const RTNET_IPv6Addr_t* next_hop, RTNET_Buffer_t* buf)
+{
+    uint8_t* dst_mac = &buf->data[buf->offset];
+
+    if (RTNET_IPv6_IsMulticast(next_hop->addr)) {
+        RTNET_IPv6_MulticastMAC(next_hop->addr, dst_mac);
+        RTNET_TxFrame(buf);
+        return RTNET_OK;
+    }
+
+    if (RTNET_ND_Lookup(next_hop, (RTNET_MACAddr_t*)dst_mac)) {
+        RTNET_TxFrame(buf);
+        return RTNET_OK;
+    }
+
+    RTNET_NeighborEntry_t* entry = RTNET_ND_Find(next_hop);
+    bool solicit = false;
+
+    if (entry == NULL) {
+        entry = RTNET_ND_Create(next_hop, RTNET_ND_STATE_INCOMPLETE, RTNET_GetTimeMs());
+        entry->solicit_count = 1U;
+        solicit = true;
+    }
+
+    if (entry->pending_count >= RTNET_ND_MAX_PENDING) {
+        RTNET_FreeBuffer(buf);
+        RTNET_STAT_DROP(tx_dropped, RTNET_DROP_ND_QUEUE_FULL);
+        return RTNET_ERR_NO_BUFFER;
+    }
+
+    entry->pending[entry->pending_count] = (uint8_t)(buf - g_RTNET_Ctx->tx_buffers);
+    entry->pending_count++;
+
+    if (solicit) {
+        RTNET_ND_SendSolicit(next_hop, NULL);
+    }
+
+    return RTNET_OK;
+}
+
+#if (RTNET_ENABLE_FRAGMENTATION != 0U)
+/**
+ * @brief Check that RTNET_ND_Resolve will accept several packets for a next hop
+ * @param next_hop On-link neighbor (or multicast group)
+ * @param count Packets to be sent (<= RTNET_ND_MAX_PENDING)
+ * @return true if none of them would be refused for a full pending queue
+ */
+static bool RTNET_ND_CanQueue(const RTNET_IPv6Addr_t* next_hop, uint16_t count)
+{
+    if (RTNET_IPv6_IsMulticast(next_hop->addr)) {
+        return true;
+    }
+
+    const RTNET_NeighborEntry_t* entry = RTNET_ND_Find(next_hop);
+    if ((entry == NULL) || (entry->state != RTNET_ND_STATE_INCOMPLETE)) {
+        return true;
+    }
+
+    return ((uint16_t)(RTNET_ND_MAX_PENDING - entry->pending_count) >= count);
+}
+#endif
+
+/**
+ * @brief Neighbor Unreachability Detection timers (called from RTNET_PeriodicTask)
+ * @param now Current time in ms
+ */
+static void RTNET_ND_Age(uint32_t now)
+{
+    for (uint16_t i = 0U; i < RTNET_MAX_NEIGHBOR_CACHE; i++) {
+        RTNET_NeighborEntry_t* entry = &g_RTNET_Ctx->neighbor_cache[i];
+        if (!entry->valid) {
+            continue;
+        }
+
+        switch (entry->state) {
+            case RTNET_ND_STATE_INCOMPLETE:
+            case RTNET_ND_STATE_PROBE:
+            {
+                /* Retransmit solicitations, then give up (drops queued packets) */
+                const bool probing = (entry->state == RTNET_ND_STATE_PROBE);
+                if ((now - entry->timer_ms) < ND_RETRANS_TIMER_MS) {
+                    break;
+                }
+                if (entry->solicit_count >= (probing ? ND_MAX_UNICAST_SOLICIT
+                                                     : ND_MAX_MULTICAST_SOLICIT)) {
+                    RTNET_ND_Release(i);
+                    break;
+                }
+                entry->solicit_count++;
+                entry->timer_ms = now;
+                RTNET_ND_SendSolicit(&entry->ipv6_addr, probing ? entry->mac_addr.addr : NULL);
+                break;
+            }
+
+            case RTNET_ND_STATE_REACHABLE:
+                if ((now - entry->last_confirmed_ms) > ND_REACHABLE_TIME_MS) {
+                    entry->state = RTNET_ND_STATE_STALE;
+                }
+                break;
+
+            case RTNET_ND_STATE_DELAY:
+                if ((now - entry->timer_ms) >= ND_DELAY_FIRST_PROBE_MS) {
+                    entry->state = RTNET_ND_STATE_PROBE;
+                    entry->solicit_count = 1U;
+                    entry->timer_ms = now;
+                    RTNET_ND_SendSolicit(&entry->ipv6_addr, entry->mac_addr.addr);
+                }
+                break;
+
+            default:
+                /* STALE: kept until evicted or used */
+                break;
+        }
+    }
+}
+
+/* ==================== DESTINATION CACHE ==================== */
+
+/**
+ * @brief Destination cache slot for an address
+ */
+static RTNET_DestCacheEntry_t* RTNET_DestCache_Slot(const RTNET_IPv6Addr_t* dest_addr)
+{
+    return &g_RTNET_Ctx->dest_cache[RTNET_IPv6_Hash(dest_addr) & (RTNET_DEST_CACHE_SIZE - 1U)];
+}
+
+/**
+ * @brief Look up a resolved TX path
+ * @param dest_addr Destination address
+ * @return Entry, NULL on miss or if invalidated since it was filled
+ * @note Refreshes route usage and drives the neighbor state machine like
+ *       the uncached path does
+ */
+static const RTNET_DestCacheEntry_t* RTNET_DestCache_Lookup(const RTNET_IPv6Addr_t* dest_addr)
+{
+    RTNET_DestCacheEntry_t* entry = RTNET_DestCache_Slot(dest_addr);
+    
+    if ((entry->generation != g_RTNET_Ctx->dest_cache_gen) ||
+        !RTNET_IPv6_AddressEqual(&entry->destination, dest_addr)) {
+        return NULL;
+    }
+    
+    uint32_t now = RTNET_GetTimeMs();
+    if (entry->route != NULL) {
+        entry->route->last_used_ms = now;
+    }
+    if (entry->neighbor != NULL) {
+        RTNET_ND_Touch(entry->neighbor, now);
+    }
+    
+    return entry;
+}
+
+/**
+ * @brief Cache the TX path of a destination once its next hop is resolved
+ * @param dest_addr Destination address
+ * @param route Route used (NULL for multicast)
+ * @param next_hop Next hop returned by RTNET_IPv6_NextHop
+ * @return Filled entry, NULL if the next hop is not resolved yet
+ */
+static const RTNET_DestCacheEntry_t* RTNET_DestCache_Fill(const RTNET_IPv6Addr_t* dest_addr,
+                                                       RTNET_RouteEntry_t* route,
+                                                       const RTNET_IPv6Addr_t* next_hop)
+{
+    RTNET_NeighborEntry_t* neighbor = NULL;
+    RTNET_DestCacheEntry_t* entry = RTNET_DestCache_Slot(dest_addr);
+    
+    if (RTNET_IPv6_IsMulticast(next_hop->addr)) {
+        RTNET_IPv6_MulticastMAC(next_hop->addr, entry->header);
+    } else {
+        neighbor = RTNET_ND_Find(next_hop);
+        if ((neighbor == NULL) || (neighbor->state == RTNET_ND_STATE_INCOMPLETE)) {
+            RTNET_STAT_INC(neighbor_misses);
+            return NULL;
+        }
+        RTNET_STAT_INC(neighbor_hits);
+        memcpy(entry->header, neighbor->mac_addr.addr, RTNET_MAC_ADDR_LEN);
+        RTNET_ND_Touch(neighbor, RTNET_GetTimeMs());
+    }
+    
+    /* Length, next header and hop limit are patched per packet */
+    RTNET_IPv6_BuildHeader(entry->header, dest_addr, 0U, 0U, 0U);
+    
+    memcpy(&entry->destination, dest_addr, sizeof(RTNET_IPv6Addr_t));
+    entry->route = route;
+    entry->neighbor = neighbor;
+    entry->pseudo_sum = RTNET_IPv6_PseudoHeaderChecksum(&g_RTNET_Ctx->local_ipv6, dest_addr,
+                                                        0U, 0U);
+    entry->generation = g_RTNET_Ctx->dest_cache_gen;
+    
+    return entry;
+}
+
+/**
+ * @brief Write a cached Ethernet + IPv6 header into a frame
+ * @param entry Destination cache entry
+ * @param frame Frame start (Ethernet header)
+ * @param payload_len IPv6 payload length
+ * @param next_header Upper-layer protocol
+ * @param hop_limit Hop limit
+ */
+static void RTNET_DestCache_WriteHeader(const RTNET_DestCacheEntry_t* entry,
+                                        uint8_t* frame,
+                                        uint16_t payload_len,
+                                        uint8_t next_header,
+                                        uint8_t hop_limit)
+{
+    memcpy(frame, entry->header, RTNET_DEST_CACHE_HDR_LEN);
+    
+    uint8_t* ip = &frame[ETH_HEADER_LEN];
+    RTNET_Write16(&ip[4], payload_len);
+    ip[6] = next_header;
+    ip[7] = hop_limit;
+}
+
+/* ==================== UPPER-LAYER TX ==================== */
+
+uint16_t RTNET_EphemeralPort(void)
+{
+    uint16_t port = g_RTNET_Ctx->next_ephemeral_port;
+    g_RTNET_Ctx->next_ephemeral_port = (port == UINT16_MAX) ? 49152U : (uint16_t)(port + 1U);
+    return port;
+}
+
+/**
+ * @brief Resolve how a datagram to dest_addr leaves the node
+ * @param dest_addr Destination
+ * @param dest Out: destination cache entry, NULL if the neighbor is unresolved
+ * @param next_hop Out: next hop (valid when *dest is NULL)
+ * @return RTNET_OK, RTNET_ERR_NO_ROUTE
+ * @note Steady state is a single destination cache hit
+ */
+static RTNET_Error_t RTNET_IPv6_Route(const RTNET_IPv6Addr_t* dest_addr,
+                                     const RTNET_DestCacheEntry_t** dest,
+                                     RTNET_IPv6Addr_t* next_hop)
+{
+    *dest = RTNET_DestCache_Lookup(dest_addr);
+    if (*dest != NULL) {
+        RTNET_STAT_INC(dest_cache_hits);
+    } else {
+        RTNET_STAT_INC(dest_cache_misses);
+        RTNET_RouteEntry_t* route;
+        if (!RTNET_IPv6_NextHop(dest_addr, next_hop, &route)) {
+            RTNET_STAT_DROP(routing_errors, RTNET_DROP_NO_ROUTE);
+            return RTNET_ERR_NO_ROUTE;
+        }
+        *dest = RTNET_DestCache_Fill(dest_addr, route, next_hop);
+    }
+
+    return RTNET_OK;
+}
+
+/**
+ * @brief Write Ethernet/IPv6/UDP headers and checksum in front of a payload
+ * @param buf TX buffer; the frame starts at data[offset] and the payload
+ *        already sits at data[offset + UDP_FRAME_HDR_LEN]
+ * @param dest Cached destination (header template), NULL = build from scratch
+ * @param dest_addr Destination address
+ * @param dest_port Destination port
+ * @param src_port Source port (non-zero)
+ * @param payload_len Payload length
+ */
+static void RTNET_UDP_BuildFrame(RTNET_Buffer_t* buf,
+                                 const RTNET_DestCacheEntry_t* dest,
+                                 const RTNET_IPv6Addr_t* dest_addr,
+                                 uint16_t dest_port,
+                                 uint16_t src_port,
+                                 uint16_t payload_len)
+{
+    RTNET_PROBE_BEGIN(start);
+    const uint16_t udp_len = (uint16_t)(UDP_HEADER_LEN + payload_len);
+    uint8_t* frame = &buf->data[buf->offset];
+    if (dest != NULL) {
+        RTNET_DestCache_WriteHeader(dest, frame, udp_len, (uint8_t)RTNET_PROTO_UDP,
+                                    IPV6_DEFAULT_HOP_LIMIT);
+    } else {
+        RTNET_IPv6_BuildHeader(frame, dest_addr, udp_len, (uint8_t)RTNET_PROTO_UDP,
+                               IPV6_DEFAULT_HOP_LIMIT);
+    }
+
+    uint8_t* udp = &frame[ETH_HEADER_LEN + IPV6_HEADER_LEN];
+    RTNET_Write16(&udp[0], src_port);
+    RTNET_Write16(&udp[2], dest_port);
+    RTNET_Write16(&udp[4], udp_len);
+    RTNET_Write16(&udp[6], 0U);
+
+    if (!RTNET_HwChecksumTx((uint8_t)RTNET_PROTO_UDP)) {
+        uint32_t pseudo = (dest != NULL)
+            ? (dest->pseudo_sum + udp_len + (uint32_t)RTNET_PROTO_UDP)
+            : RTNET_IPv6_PseudoHeaderChecksum(&g_RTNET_Ctx->local_ipv6, dest_addr,
+                                              udp_len, (uint8_t)RTNET_PROTO_UDP);
+        RTNET_PROBE_BEGIN(csum_start);
+        uint16_t csum = RTNET_ComputeChecksum(udp, udp_len, pseudo);
+        RTNET_PROBE_END(RTNET_PROBE_CHECKSUM, csum_start);
+        /* Zero is transmitted as all-ones (RFC 768, RFC 8200 8.1) */
+        RTNET_Write16(&udp[6], (csum == 0U) ? 0xFFFFU : csum);
+    }
+
+    buf->length = (uint16_t)(UDP_FRAME_HDR_LEN + payload_len);
+    RTNET_PROBE_END(RTNET_PROBE_TX_BUILD, start);
+}
+
+/**
+ * @brief Copy an application payload behind the header space of a fresh buffer
+ */
+static void RTNET_UDP_CopyPayload(RTNET_Buffer_t* buf, const uint8_t* payload, uint16_t payload_len)
+{
+    memcpy(&buf->data[buf->offset + UDP_FRAME_HDR_LEN], payload, payload_len);
+}
+
+RTNET_Error_t RTNET_IPv6_Output(RTNET_Buffer_t* buf,
+                                const RTNET_IPv6Addr_t* dest_addr,
+                                uint8_t next_header,
+                                uint16_t l4_len,
+                                uint16_t csum_offset)
+{
+    RTNET_IPv6Addr_t next_hop;
+    const RTNET_DestCacheEntry_t* dest = NULL;
+    if (RTNET_IPv6_Route(dest_addr, &dest, &next_hop) != RTNET_OK) {
+        RTNET_FreeBuffer(buf);
+        return RTNET_ERR_NO_ROUTE;
+    }
+
+    RTNET_PROBE_BEGIN(start);
+    uint8_t* frame = &buf->data[buf->offset];
+    if (dest != NULL) {
+        RTNET_DestCache_WriteHeader(dest, frame, l4_len, next_header, IPV6_DEFAULT_HOP_LIMIT);
+    } else {
+        RTNET_IPv6_BuildHeader(frame, dest_addr, l4_len, next_header, IPV6_DEFAULT_HOP_LIMIT);
+    }
+
+    uint8_t* l4 = &frame[ETH_HEADER_LEN + IPV6_HEADER_LEN];
+    RTNET_Write16(&l4[csum_offset], 0U);
+    if (!RTNET_HwChecksumTx(next_header)) {
+        uint32_t pseudo = (dest != NULL)
+            ? (dest->pseudo_sum + l4_len + (uint32_t)next_header)
+            : RTNET_IPv6_PseudoHeaderChecksum(&g_RTNET_Ctx->local_ipv6, dest_addr,
+                                              l4_len, next_header);
+        RTNET_PROBE_BEGIN(csum_start);
+        RTNET_Write16(&l4[csum_offset], RTNET_ComputeChecksum(l4, l4_len, pseudo));
+        RTNET_PROBE_END(RTNET_PROBE_CHECKSUM, csum_start);
+    }
+
+    buf->length = (uint16_t)(ETH_HEADER_LEN + IPV6_HEADER_LEN + l4_len);
+    RTNET_PROBE_END(RTNET_PROBE_TX_BUILD, start);
+
+    if (dest != NULL) {
+        RTNET_TxFrame(buf);
+        return RTNET_OK;
+    }
+
+    return RTNET_ND_Resolve(&next_hop, buf);
+}
+
+#if (RTNET_ENABLE_FRAGMENTATION != 0U)
+/**
+ * @brief Send a UDP datagram too large for one frame as IPv6 fragments
+ * @param dest Cached destination, NULL = resolve next_hop per fragment
+ * @param dest_addr Destination address
+ * @param next_hop Next hop (used when dest is NULL)
+ * @param dest_port Destination port
+ * @param src_port Source port (non-zero)
+ * @param payload Payload data
+ * @param payload_len Payload length (<= UDP_MAX_DATAGRAM)
+ * @param qos_priority QoS class of every fragment
+ * @return RTNET_OK, or RTNET_ERR_NO_BUFFER if the class cannot take a TX
+ *         buffer per fragment or the neighbor cannot queue them all (nothing
+ *         sent or queued)
+ * @note Each fragment is written straight into its own TX buffer: header
+ *       template, Fragment header, then its slice of the UDP header and
+ *       payload. The checksum covers the whole datagram, so it is always
+ *       computed in software. Fragments are sized for the link MTU
+ */
+static RTNET_Error_t RTNET_UDP_SendFragments(const RTNET_DestCacheEntry_t* dest,
+                                             const RTNET_IPv6Addr_t* dest_addr,
+                                             const RTNET_IPv6Addr_t* next_hop,
+                                             uint16_t dest_port,
+                                             uint16_t src_port,
+                                             const uint8_t* payload,
+                                             uint16_t payload_len,
+                                             uint8_t qos_priority)
+{
+    const uint16_t udp_len = (uint16_t)(UDP_HEADER_LEN + payload_len);
+    const uint16_t count = (uint16_t)((udp_len + IPV6_FRAG_CHUNK - 1U) / IPV6_FRAG_CHUNK);
+    RTNET_Buffer_t* frames[RTNET_FRAG_MAX_FRAMES];
+
+    /* A partly queued datagram could never be reassembled */
+    if ((dest == NULL) && !RTNET_ND_CanQueue(next_hop, count)) {
+        RTNET_STAT_DROP(tx_dropped, RTNET_DROP_ND_QUEUE_FULL);
+        return RTNET_ERR_NO_BUFFER;
+    }
+
+    /* All buffers first: the datagram goes out whole or not at all */
+    for (uint16_t i = 0U; i < count; i++) {
+        const uint16_t chunk = (i < (count - 1U)) ? (uint16_t)IPV6_FRAG_CHUNK
+                                                  : (uint16_t)(udp_len - (i * IPV6_FRAG_CHUNK));
+        frames[i] = RTNET_AllocTxBuffer(qos_priority, ETH_HEADER_LEN + IPV6_HEADER_LEN +
+                                        RTNET_FRAG_HEADER_LEN + (uint32_t)chunk);
+        if (frames[i] == NULL) {
+            for (uint16_t j = 0U; j < i; j++) {
+                RTNET_FreeBuffer(frames[j]);
+            }
+            RTNET_STAT_DROP(tx_dropped, RTNET_DROP_NO_TX_BUFFER);
+            return RTNET_ERR_NO_BUFFER;
+        }
+    }
+
+    RTNET_PROBE_BEGIN(start);
+    uint8_t udp[UDP_HEADER_LEN];
+    RTNET_Write16(&udp[0], src_port);
+    RTNET_Write16(&udp[2], dest_port);
+    RTNET_Write16(&udp[4], udp_len);
+    RTNET_Write16(&udp[6], 0U);
+
+    uint32_t sum = (dest != NULL)
+        ? (dest->pseudo_sum + udp_len + (uint32_t)RTNET_PROTO_UDP)
+        : RTNET_IPv6_PseudoHeaderChecksum(&g_RTNET_Ctx->local_ipv6, dest_addr,
+                                          udp_len, (uint8_t)RTNET_PROTO_UDP);
+    RTNET_PROBE_BEGIN(csum_start);
+    sum = RTNET_ChecksumPartial(udp, UDP_HEADER_LEN, sum);
+    sum = RTNET_ChecksumPartial(payload, payload_len, sum);
+    const uint16_t csum = RTNET_ChecksumFinish(sum);
+    RTNET_PROBE_END(RTNET_PROBE_CHECKSUM, csum_start);
+    RTNET_Write16(&udp[6], (csum == 0U) ? 0xFFFFU : csum);
+
+    const uint32_t id = g_RTNET_Ctx->frag_id;
+    g_RTNET_Ctx->frag_id++;
+
+    uint16_t offset = 0U;
+    for (uint16_t i = 0U; i < count; i++) {
+        const bool more = (i < (count - 1U));
+        const uint16_t chunk = more ? (uint16_t)IPV6_FRAG_CHUNK : (uint16_t)(udp_len - offset);
+        const uint16_t ip_len = (uint16_t)(RTNET_FRAG_HEADER_LEN + chunk);
+        uint8_t* frame = &frames[i]->data[frames[i]->offset];
+        if (dest != NULL) {
+            RTNET_DestCache_WriteHeader(dest, frame, ip_len, IPV6_EXT_FRAGMENT,
+                                        IPV6_DEFAULT_HOP_LIMIT);
+        } else {
+            RTNET_IPv6_BuildHeader(frame, dest_addr, ip_len, IPV6_EXT_FRAGMENT,
+                                   IPV6_DEFAULT_HOP_LIMIT);
+        }
+
+        uint8_t* frag = &frame[ETH_HEADER_LEN + IPV6_HEADER_LEN];
+        frag[0] = (uint8_t)RTNET_PROTO_UDP;
+        frag[1] = 0U;
+        RTNET_Write16(&frag[2], (uint16_t)(offset | (more ? RTNET_FRAG_MORE : 0U)));
+        RTNET_Write32(&frag[4], id);
+
+        uint8_t* data = &frag[RTNET_FRAG_HEADER_LEN];
+        if (offset == 0U) {
+            memcpy(data, udp, UDP_HEADER_LEN);
+            memcpy(&data[UDP_HEADER_LEN], payload, (size_t)chunk - UDP_HEADER_LEN);
+        } else {
+            memcpy(data, &payload[offset - UDP_HEADER_LEN], chunk);
+        }
+
+        frames[i]->length = (uint16_t)(ETH_HEADER_LEN + IPV6_HEADER_LEN + ip_len);
+        offset = (uint16_t)(offset + chunk);
+    }
+    RTNET_PROBE_END(RTNET_PROBE_TX_BUILD, start);
+
+    if (dest != NULL) {
+        for (uint16_t i = 0U; i < count; i++) {
+            RTNET_TxSched_Enqueue(frames[i]);
+        }
+        (void)RTNET_PollTx(UINT16_MAX);
+        return RTNET_OK;
+    }
+
+    /* Unresolved neighbor: every fragment waits in its ND queue, which was
+     * checked above to have room for all of them */
+    for (uint16_t i = 0U; i < count; i++) {
+        (void)RTNET_ND_Resolve(next_hop, frames[i]);
+    }
+
+    return RTNET_OK;
+}
+#endif
+
+/* ==================== RX PATH ==================== */
+
+/**
+ * @brief Upper-layer packet located inside an RX frame
+ * @note All pointers borrow from the caller's frame; nothing is copied
+ */
+typedef struct {
+    const uint8_t* eth;                 /* Ethernet header */
+    const RTNET_IPv6Header_t* ip;       /* IPv6 fixed header */
+    const uint8_t* l4;                  /* Upper-layer header */
+    uint16_t l4_len;                    /* Upper-layer length (header + data) */
+    uint8_t next_header;                /* Upper-layer protocol */
+} RTNET_RxPacket_t;
+
+/**
+ * @brief Verify upper-layer checksum over pseudo-header + l4 data
+ * @param pkt Parsed packet
+ * @return true if the checksum is valid or was verified by the MAC
+ */
+static bool RTNET_RxChecksumValid(const RTNET_RxPacket_t* pkt)
+{
+    if (RTNET_HwChecksumRx(pkt->next_header)) {
+        return true; /* MAC drops frames whose checksum failed */
+    }
+
+    uint32_t pseudo = RTNET_IPv6_PseudoHeaderChecksum(
+        (const RTNET_IPv6Addr_t*)pkt->ip->src_addr,
+        (const RTNET_IPv6Addr_t*)pkt->ip->dst_addr,
+        pkt->l4_len, pkt->next_header);
+
+    RTNET_PROBE_BEGIN(start);
+    const bool valid = (RTNET_ComputeChecksum(pkt->l4, pkt->l4_len, pseudo) == 0U);
+    RTNET_PROBE_END(RTNET_PROBE_CHECKSUM, start);
+
+    return valid;
+}
+
+/**
+ * @brief Check whether an IPv6 destination is accepted by this node
+ * @param dst Destination address from the IPv6 header
+ * @return true for our unicast address or any multicast group
+ */
+static bool RTNET_IPv6_IsForUs(const uint8_t* dst)
+{
+    if (RTNET_IPv6_IsMulticast(dst)) {
+        return true;
+    }
+
+    return RTNET_IPv6_AddressEqual((const RTNET_IPv6Addr_t*)dst,
+                                   &g_RTNET_Ctx->local_ipv6);
+}
+
+/**
+ * @brief Fill a borrowed RX view of a transport segment
+ * @param pkt Parsed packet
+ * @param header_len Transport header length
+ * @param payload_len Transport payload length
+ * @param view [OUT] View pointing into the RX frame
+ */
+static void RTNET_RxFillView(const RTNET_RxPacket_t* pkt,
+                             uint16_t header_len,
+                             uint16_t payload_len,
+                             RTNET_RxView_t* view)
+{
+    const uint8_t* ip = (const uint8_t*)pkt->ip;
+
+    view->src_addr = (const RTNET_IPv6Addr_t*)pkt->ip->src_addr;
+    view->dst_addr = (const RTNET_IPv6Addr_t*)pkt->ip->dst_addr;
+    view->src_mac = (const RTNET_MACAddr_t*)&pkt->eth[RTNET_MAC_ADDR_LEN];
+    view->transport = pkt->l4;
+    view->payload = &pkt->l4[header_len];
+    view->payload_len = payload_len;
+    view->src_port = RTNET_Read16(&pkt->l4[0]);
+    view->dst_port = RTNET_Read16(&pkt->l4[2]);
+    view->next_header = pkt->next_header;
+    view->traffic_class = (uint8_t)(((uint8_t)(ip[0] << 4U)) | (uint8_t)(ip[1] >> 4U));
+    view->hop_limit = pkt->ip->hop_limit;
+}
+
+/**
+ * @brief Fill a borrowed RX view and hand it to the registered handler
+ * @param pkt Parsed packet
+ * @param header_len Transport header length
+ * @param payload_len Transport payload length
+ * @param handler Application handler
+ */
+static void RTNET_RxDeliver(const RTNET_RxPacket_t* pkt,
+                            uint16_t header_len,
+                            uint16_t payload_len,
+                            RTNET_RxHandler_t handler)
+{
+    RTNET_RxView_t view;
+    RTNET_RxFillView(pkt, header_len, payload_len, &view);
+
+    handler(&view);
+}
+
+/**
+ * @brief Find a link-layer address option in an ND message
+ * @param options First option byte
+ * @param options_len Bytes of options
+ * @param type Option type to look for
+ * @param lladdr [OUT] Borrowed pointer to the 6-byte address, NULL if absent
+ * @return false if the option list is malformed
+ */
+static bool RTNET_ND_FindLLAddrOption(const uint8_t* options,
+                                      uint16_t options_len,
+                                      uint8_t type,
+                                      const uint8_t** lladdr)
+{
+    uint16_t pos = 0U;
+    *lladdr = NULL;
+
+    /* Each option is at least 8 bytes, so the walk is bounded by the MTU */
+    while ((pos + 2U) <= options_len) {
+        uint16_t opt_len = (uint16_t)options[pos + 1U] * 8U;
+        if ((opt_len == 0U) || ((pos + opt_len) > options_len)) {
+            return false;
+        }
+
+        if ((options[pos] == type) && (opt_len >= (2U + RTNET_MAC_ADDR_LEN))) {
+            *lladdr = &options[pos + 2U];
+        }
+
+        pos = (uint16_t)(pos + opt_len);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Handle Neighbor Solicitation (RFC 4861 7.2.3)
+ */
+static RTNET_Error_t RTNET_ND_HandleSolicit(const RTNET_RxPacket_t* pkt)
+{
+    const uint8_t* target = &pkt->l4[8];
+    if (!RTNET_IPv6_AddressEqual((const RTNET_IPv6Addr_t*)target, &g_RTNET_Ctx->local_ipv6)) {
+        return RTNET_OK; /* Not for one of our addresses */
+    }
+
+    const uint8_t* slla = NULL;
+    if (!RTNET_ND_FindLLAddrOption(&pkt->l4[ND_MSG_MIN_LEN],
+                                   (uint16_t)(pkt->l4_len - ND_MSG_MIN_LEN),
+                                   ND_OPT_SOURCE_LLADDR, &slla)) {
+        RTNET_STAT_DROP(rx_errors, RTNET_DROP_ND_INVALID);
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    const RTNET_IPv6Addr_t* src = (const RTNET_IPv6Addr_t*)pkt->ip->src_addr;
+    const bool dad = (memcmp(src->addr, IPV6_ADDR_UNSPECIFIED, RTNET_IPV6_ADDR_LEN) == 0);
+
+    /* Advertisement body: flags(4) + target(16) + TLLA option(8) */
+    uint8_t body[4U + RTNET_IPV6_ADDR_LEN + 8U];
+    memset(body, 0, sizeof(body));
+    body[0] = dad ? ND_NA_FLAG_OVERRIDE : (uint8_t)(ND_NA_FLAG_SOLICITED | ND_NA_FLAG_OVERRIDE);
+    memcpy(&body[4], g_RTNET_Ctx->local_ipv6.addr, RTNET_IPV6_ADDR_LEN);
+    body[20] = ND_OPT_TARGET_LLADDR;
+    body[21] = 1U;
+    memcpy(&body[22], g_RTNET_Ctx->local_mac.addr, RTNET_MAC_ADDR_LEN);
+
+    if (dad) {
+        /* Duplicate Address Detection: answer to all-nodes, SLLA must be absent */
+        static const RTNET_IPv6Addr_t all_nodes = {
+            .addr = {0xFF, 0x02, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01}
+        };
+        static const uint8_t all_nodes_mac[RTNET_MAC_ADDR_LEN] = {
+            0x33, 0x33, 0x00, 0x00, 0x00, 0x01
+        };
+
+        if (slla != NULL) {
+            RTNET_STAT_DROP(rx_errors, RTNET_DROP_ND_INVALID);
+            return RTNET_ERR_INVALID_PARAM;
+        }
+
+        return RTNET_ICMPv6_Output(all_nodes_mac, &all_nodes, ICMPV6_NEIGHBOR_ADVERT, 0U,
+                                   ND_HOP_LIMIT, body, (uint16_t)sizeof(body), NULL);
+    }
+
+    const uint8_t* reply_mac = &pkt->eth[RTNET_MAC_ADDR_LEN];
+    if (slla != NULL) {
+        RTNET_ND_LearnFromSolicit(src, (const RTNET_MACAddr_t*)slla);
+        reply_mac = slla;
+    }
+
+    return RTNET_ICMPv6_Output(reply_mac, src, ICMPV6_NEIGHBOR_ADVERT, 0U,
+                               ND_HOP_LIMIT, body, (uint16_t)sizeof(body), NULL);
+}
+
+/**
+ * @brief Handle Neighbor Advertisement (RFC 4861 7.2.5)
+ */
+static RTNET_Error_t RTNET_ND_HandleAdvert(const RTNET_RxPacket_t* pkt)
+{
+    const uint8_t* tlla = NULL;
+    if (!RTNET_ND_FindLLAddrOption(&pkt->l4[ND_MSG_MIN_LEN],
+                                   (uint16_t)(pkt->l4_len - ND_MSG_MIN_LEN),
+                                   ND_OPT_TARGET_LLADDR, &tlla)) {
+        RTNET_STAT_DROP(rx_errors, RTNET_DROP_ND_INVALID);
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    /* RFC 4861 7.1.2: unicast target; Solicited only on unicast replies */
+    const RTNET_IPv6Addr_t* target = (const RTNET_IPv6Addr_t*)&pkt->l4[8];
+    const uint8_t flags = pkt->l4[4];
+    if (RTNET_IPv6_IsMulticast(target->addr) ||
+        (RTNET_IPv6_IsMulticast(pkt->ip->dst_addr) && ((flags & ND_NA_FLAG_SOLICITED) != 0U))) {
+        RTNET_STAT_DROP(rx_errors, RTNET_DROP_ND_INVALID);
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    RTNET_ND_ApplyAdvert(target, (const RTNET_MACAddr_t*)tlla, flags);
+
+    return RTNET_OK;
+}
+
+/**
+ * @brief Answer an Echo Request (RFC 4443 4.2)
+ * @note For unicast requests the pseudo-header is unchanged (addresses are
+ *       only swapped), so the reply checksum is patched from the request's
+ *       instead of re-summing the echo data
+ */
+static RTNET_Error_t RTNET_ICMPv6_EchoReply(const RTNET_RxPacket_t* pkt)
+{
+    const RTNET_IPv6Addr_t* src = (const RTNET_IPv6Addr_t*)pkt->ip->src_addr;
+    const uint16_t* checksum = NULL;
+    uint16_t patched;
+
+    if (!RTNET_IPv6_IsMulticast(pkt->ip->dst_addr)) {
+        patched = RTNET_ChecksumUpdate16(RTNET_Read16(&pkt->l4[2]),
+                                         RTNET_Read16(&pkt->l4[0]),
+                                         (uint16_t)((uint16_t)ICMPV6_ECHO_REPLY << 8U));
+        checksum = &patched;
+    }
+
+    return RTNET_ICMPv6_Output(&pkt->eth[RTNET_MAC_ADDR_LEN], src,
+                               ICMPV6_ECHO_REPLY, 0U, IPV6_DEFAULT_HOP_LIMIT,
+                               &pkt->l4[ICMPV6_HEADER_LEN],
+                               (uint16_t)(pkt->l4_len - ICMPV6_HEADER_LEN),
+                               checksum);
+}
+
+/**
+ * @brief Rate limit class of a received ICMPv6 message
+ * @return Class, or RTNET_ICMPV6_LIMIT_COUNT for a solicited advertisement
+ *         answering our own solicitation (not limited)
+ * @note Solicitations for our address and answers to ours stay out of the
+ *       shared ND budget, so a flood of other ND traffic cannot stall
+ *       resolution in either direction
+ */
+static RTNET_ICMPv6Limit_t RTNET_ICMPv6_LimitOf(const RTNET_RxPacket_t* pkt)
+{
+    const uint8_t type = pkt->l4[0];
+    if (type == ICMPV6_ECHO_REQUEST) {
+        return RTNET_ICMPV6_LIMIT_ECHO;
+    }
+    if (((type == ICMPV6_NEIGHBOR_SOLICIT) || (type == ICMPV6_NEIGHBOR_ADVERT)) &&
+        (pkt->l4_len >= ND_MSG_MIN_LEN)) {
+        const RTNET_IPv6Addr_t* target = (const RTNET_IPv6Addr_t*)&pkt->l4[8];
+        if (type == ICMPV6_NEIGHBOR_SOLICIT) {
+            if (RTNET_IPv6_AddressEqual(target, &g_RTNET_Ctx->local_ipv6)) {
+                return RTNET_ICMPV6_LIMIT_ND_LOCAL;
+            }
+        } else if ((pkt->l4[4] & ND_NA_FLAG_SOLICITED) != 0U) {
+            const RTNET_NeighborEntry_t* entry = RTNET_ND_Find(target);
+            if ((entry != NULL) && ((entry->state == RTNET_ND_STATE_INCOMPLETE) ||
+                                    (entry->state == RTNET_ND_STATE_PROBE))) {
+                return RTNET_ICMPV6_LIMIT_COUNT;
+            }
+        } else {
+            /* Unsolicited advertisement: shared ND budget */
+        }
+    }
+    if ((type >= ICMPV6_ROUTER_SOLICIT) && (type <= ICMPV6_REDIRECT)) {
+        return RTNET_ICMPV6_LIMIT_ND;
+    }
+    return RTNET_ICMPV6_LIMIT_OTHER;
+}
+
+/**
+ * @brief ICMPv6 input (echo and Neighbor Discovery handled in-stack)
+ * @note A message of a class or source without credit is dropped before
+ *       its checksum is verified; the buckets are charged only once it
+ *       verifies, so corrupt floods do not spend anyone's budget
+ */
+static RTNET_Error_t RTNET_ICMPv6_Input(const RTNET_RxPacket_t* pkt)
+{
+    if (pkt->l4_len < ICMPV6_HEADER_LEN) {
+        RTNET_STAT_DROP(rx_errors, RTNET_DROP_MALFORMED);
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    /* Over-budget messages cost no checksum pass and no parsing */
+    const uint8_t type = pkt->l4[0];
+    const RTNET_ICMPv6Limit_t limit = RTNET_ICMPv6_LimitOf(pkt);
+    if ((limit != RTNET_ICMPV6_LIMIT_COUNT) &&
+        !RTNET_RateLimit_Check(limit, pkt->ip->src_addr)) {
+        RTNET_STAT_DROP(rx_dropped, RTNET_DROP_RATE_LIMITED);
+        return RTNET_OK;
+    }
+
+    if (!RTNET_RxChecksumValid(pkt)) {
+        RTNET_STAT_DROP(checksum_errors, RTNET_DROP_CHECKSUM);
+        return RTNET_ERR_CHECKSUM;
+    }
+
+    if (limit != RTNET_ICMPV6_LIMIT_COUNT) {
+        (void)RTNET_RateLimit_Admit(limit, pkt->ip->src_addr);
+    }
+
+    switch (type) {
+        case ICMPV6_ECHO_REQUEST:
+            return RTNET_ICMPv6_EchoReply(pkt);
+
+        case ICMPV6_NEIGHBOR_SOLICIT:
+        case ICMPV6_NEIGHBOR_ADVERT:
+            /* RFC 4861: only accept on-link, unrouted ND messages */
+            if ((pkt->ip->hop_limit != ND_HOP_LIMIT) || (pkt->l4[1] != 0U) ||
+                (pkt->l4_len < ND_MSG_MIN_LEN)) {
+                RTNET_STAT_DROP(rx_dropped, RTNET_DROP_ND_INVALID);
+                return RTNET_ERR_INVALID_PARAM;
+            }
+            return (type == ICMPV6_NEIGHBOR_SOLICIT) ? RTNET_ND_HandleSolicit(pkt)
+                                                     : RTNET_ND_HandleAdvert(pkt);
+
+        default:
+            /* Errors and unsupported informational messages are ignored */
+            return RTNET_OK;
+    }
+}
+
+/**
+ * @brief UDP input (RFC 768, checksum mandatory over IPv6)
+ */
+static RTNET_Error_t RTNET_UDP_Input(const RTNET_RxPacket_t* pkt)
+{
+    if (pkt->l4_len < UDP_HEADER_LEN) {
+        RTNET_STAT_DROP(rx_errors, RTNET_DROP_MALFORMED);
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    const uint16_t udp_len = RTNET_Read16(&pkt->l4[4]);
+    if ((udp_len < UDP_HEADER_LEN) || (udp_len > pkt->l4_len)) {
+        RTNET_STAT_DROP(rx_errors, RTNET_DROP_MALFORMED);
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    /* Zero checksum is not allowed for UDP over IPv6 (RFC 8200 8.1) */
+    RTNET_RxPacket_t udp = *pkt;
+    udp.l4_len = udp_len;
+    if ((RTNET_Read16(&pkt->l4[6]) == 0U) || !RTNET_RxChecksumValid(&udp)) {
+        RTNET_STAT_DROP(checksum_errors, RTNET_DROP_CHECKSUM);
+        return RTNET_ERR_CHECKSUM;
+    }
+
+    /* Bound sockets first, then the catch-all handler */
+    RTNET_RxView_t view;
+    RTNET_RxFillView(&udp, UDP_HEADER_LEN, (uint16_t)(udp_len - UDP_HEADER_LEN), &view);
+    if (RTNET_UDP_Demux(&view)) {
+        return RTNET_OK;
+    }
+
+    if (g_RTNET_Ctx->udp_rx_handler == NULL) {
+        RTNET_STAT_DROP(rx_dropped, RTNET_DROP_NO_LISTENER);
+        return RTNET_OK;
+    }
+
+    g_RTNET_Ctx->udp_rx_handler(&view);
+    return RTNET_OK;
+}
+
+/**
+ * @brief TCP input (segment validation and delivery)
+ */
+static RTNET_Error_t RTNET_TCP_Input(const RTNET_RxPacket_t* pkt)
+{
+    if (pkt->l4_len < TCP_MIN_HEADER_LEN) {
+        RTNET_STAT_DROP(rx_errors, RTNET_DROP_MALFORMED);
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    const uint16_t data_offset = (uint16_t)((pkt->l4[12] >> 4U) * 4U);
+    if ((data_offset < TCP_MIN_HEADER_LEN) || (data_offset > pkt->l4_len)) {
+        RTNET_STAT_DROP(rx_errors, RTNET_DROP_MALFORMED);
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    if (!RTNET_RxChecksumValid(pkt)) {
+        RTNET_STAT_DROP(checksum_errors, RTNET_DROP_CHECKSUM);
+        return RTNET_ERR_CHECKSUM;
+    }
+
+#if (RTNET_ENABLE_TCP != 0U)
+    /* Connection state machine first; unmatched segments go to the raw handler */
+    if (RTNET_TCP_Segment((const RTNET_IPv6Addr_t*)pkt->ip->src_addr, pkt->l4, pkt->l4_len)) {
+        return RTNET_OK;
+    }
+#endif
+
+    if (g_RTNET_Ctx->tcp_rx_handler == NULL) {
+        RTNET_STAT_DROP(rx_dropped, RTNET_DROP_NO_LISTENER);
+        return RTNET_OK;
+    }
+
+    RTNET_RxDeliver(pkt, data_offset, (uint16_t)(pkt->l4_len - data_offset),
+                    g_RTNET_Ctx->tcp_rx_handler);
+    return RTNET_OK;
+}
+
+/**
+ * @brief Skip hop-by-hop, routing and destination options headers (bounded)
+ * @param ext First header after the IPv6 fixed header (or the Fragment header)
+ * @param payload_len Bytes from ext to the end of the packet
+ * @param next_header [IN/OUT] Type of the header at ext, then of the first
+ *        header not skipped
+ * @param pos [OUT] Offset of that header from ext
+ * @return false if an extension header runs past the packet
+ */
+static bool RTNET_IPv6_SkipExtHeaders(const uint8_t* ext, uint16_t payload_len,
+                                      uint8_t* next_header, uint16_t* pos)
+{
+    *pos = 0U;
+
+    for (uint8_t i = 0U; i < IPV6_MAX_EXT_HEADERS; i++) {
+        if ((*next_header != IPV6_EXT_HOP_BY_HOP) &&
+            (*next_header != IPV6_EXT_ROUTING) &&
+            (*next_header != IPV6_EXT_DEST_OPTS)) {
+            break;
+        }
+
+        if ((*pos + 8U) > payload_len) {
+            return false;
+        }
+
+        const uint16_t ext_len = (uint16_t)(((uint16_t)ext[*pos + 1U] + 1U) * 8U);
+        if ((*pos + ext_len) > payload_len) {
+            return false;
+        }
+
+        *next_header = ext[*pos];
+        *pos = (uint16_t)(*pos + ext_len);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Hand a located upper-layer packet to its protocol
+ * @param pkt Packet with l4, l4_len and next_header set
+ * @return RTNET_OK on success, error code otherwise
+ */
+static RTNET_Error_t RTNET_IPv6_Deliver(const RTNET_RxPacket_t* pkt)
+{
+    RTNET_STAT_INC(rx_proto[RTNET_Stats_ProtoIndex(pkt->next_header)]);
+
+    RTNET_Error_t err;
+    RTNET_PROBE_BEGIN(start);
+    switch (pkt->next_header) {
+        case (uint8_t)RTNET_PROTO_ICMPV6:
+            err = RTNET_ICMPv6_Input(pkt);
+            RTNET_PROBE_END(RTNET_PROBE_RX_ICMPV6, start);
+            break;
+
+        case (uint8_t)RTNET_PROTO_UDP:
+            err = RTNET_UDP_Input(pkt);
+            RTNET_PROBE_END(RTNET_PROBE_RX_UDP, start);
+            break;
+
+        case (uint8_t)RTNET_PROTO_TCP:
+            err = RTNET_TCP_Input(pkt);
+            RTNET_PROBE_END(RTNET_PROBE_RX_TCP, start);
+            break;
+
+        case IPV6_EXT_NO_NEXT:
+            err = RTNET_OK;
+            break;
+
+        default:
+            /* Nested or unreassembled fragments, over-long extension
+             * chains and unknown protocols */
+            RTNET_STAT_DROP(rx_dropped, RTNET_DROP_UNSUPPORTED);
+            err = RTNET_ERR_INVALID_PARAM;
+            break;
+    }
+
+    return err;
+}
+
+#if (RTNET_ENABLE_FRAGMENTATION != 0U)
+/**
+ * @brief Fragment header input: reassemble, then deliver the whole datagram
+ * @param pkt Packet whose eth and ip point at the fragment's frame
+ * @param frag Fragment header
+ * @param frag_len Fragment header + data length
+ * @return RTNET_OK while fragments are missing, else the delivery result
+ * @note The reassembled datagram is delivered from its reassembly buffer,
+ *       which stands in for rx_current meanwhile so a UDP socket queue can
+ *       keep it without a copy
+ */
+static RTNET_Error_t RTNET_IPv6_FragmentInput(RTNET_RxPacket_t* pkt,
+                                              const uint8_t* frag,
+                                              uint16_t frag_len)
+{
+    if (frag_len < RTNET_FRAG_HEADER_LEN) {
+        RTNET_STAT_DROP(rx_errors, RTNET_DROP_MALFORMED);
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    uint8_t next_header = frag[0];
+    const uint8_t* ext = &frag[RTNET_FRAG_HEADER_LEN];
+    uint16_t payload_len = (uint16_t)(frag_len - RTNET_FRAG_HEADER_LEN);
+    RTNET_Buffer_t* whole = NULL;
+
+    /* Atomic fragments (offset 0, no M flag) are processed in place (RFC 6946) */
+    if ((RTNET_Read16(&frag[2]) & (RTNET_FRAG_OFFSET_MASK | RTNET_FRAG_MORE)) != 0U) {
+        whole = RTNET_Reasm_Input(pkt->eth, frag, frag_len);
+        if (whole == NULL) {
+            return RTNET_OK;
+        }
+        pkt->eth = whole->data;
+        pkt->ip = (const RTNET_IPv6Header_t*)&whole->data[ETH_HEADER_LEN];
+        next_header = pkt->ip->next_header;
+        ext = &whole->data[ETH_HEADER_LEN + IPV6_HEADER_LEN];
+        payload_len = (uint16_t)(whole->length - ETH_HEADER_LEN - IPV6_HEADER_LEN);
+    }
+
+    RTNET_Error_t err;
+    uint16_t pos;
+    if (!RTNET_IPv6_SkipExtHeaders(ext, payload_len, &next_header, &pos)) {
+        RTNET_STAT_DROP(rx_errors, RTNET_DROP_MALFORMED);
+        err = RTNET_ERR_INVALID_PARAM;
+    } else {
+        pkt->l4 = &ext[pos];
+        pkt->l4_len = (uint16_t)(payload_len - pos);
+        pkt->next_header = next_header;
+
+        RTNET_Buffer_t* const outer = g_RTNET_Ctx->rx_current;
+        if (whole != NULL) {
+            g_RTNET_Ctx->rx_current = whole;
+        }
+        err = RTNET_IPv6_Deliver(pkt);
+        if ((whole != NULL) && (g_RTNET_Ctx->rx_current != whole)) {
+            whole = NULL;   /* Kept by a UDP socket queue */
+        }
+        g_RTNET_Ctx->rx_current = outer;
+    }
+
+    if (whole != NULL) {
+        (void)RTNET_Reasm_Free(whole);
+    }
+
+    return err;
+}
+#endif
+
+/**
+ * @brief Validate Ethernet + IPv6 headers and demultiplex to upper layers
+ * @param frame Ethernet frame (parsed in place)
+ * @param length Frame length in bytes
+ * @return RTNET_OK on success, error code otherwise
+ */
+static RTNET_Error_t RTNET_IPv6_Input(const uint8_t* frame, uint16_t length)
+{
+    if (!g_RTNET_Ctx->initialized) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    if (length < (ETH_HEADER_LEN + IPV6_HEADER_LEN)) {
+        RTNET_STAT_DROP(rx_errors, RTNET_DROP_MALFORMED);
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    /* Ethernet: IPv6 only, unicast to us or multicast */
+    if (RTNET_Read16(&frame[ETH_TYPE_OFFSET]) != ETH_TYPE_IPV6) {
+        RTNET_STAT_DROP(rx_dropped, RTNET_DROP_NOT_IPV6);
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    if (((frame[0] & 0x01U) == 0U) &&
+        (memcmp(frame, g_RTNET_Ctx->local_mac.addr, RTNET_MAC_ADDR_LEN) != 0)) {
+        RTNET_STAT_DROP(rx_dropped, RTNET_DROP_NOT_FOR_US);
+        return RTNET_OK;
+    }
+
+    /* IPv6 fixed header */
+    RTNET_RxPacket_t pkt;
+    pkt.eth = frame;
+    pkt.ip = (const RTNET_IPv6Header_t*)&frame[ETH_HEADER_LEN];
+
+    const uint8_t* ip = &frame[ETH_HEADER_LEN];
+    if ((ip[0] >> 4U) != (uint8_t)(IPV6_VERSION >> IPV6_VERSION_SHIFT)) {
+        RTNET_STAT_DROP(rx_errors, RTNET_DROP_MALFORMED);
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    /* Payload length must fit; trailing Ethernet padding is tolerated */
+    const uint16_t payload_len = RTNET_Read16(&ip[4]);
+    if (payload_len > (uint16_t)(length - ETH_HEADER_LEN - IPV6_HEADER_LEN)) {
+        RTNET_STAT_DROP(rx_errors, RTNET_DROP_MALFORMED);
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    if (!RTNET_IPv6_IsForUs(pkt.ip->dst_addr)) {
+        RTNET_STAT_DROP(rx_dropped, RTNET_DROP_NOT_FOR_US);
+        return RTNET_OK;
+    }
+
+    RTNET_StatsBlock_t* const blk = RTNET_Stats_Begin();
+    blk->c.rx_packets++;
+    blk->c.rx_bytes += length;
+    RTNET_Stats_End(blk);
+
+    /* Skip extension headers (bounded) */
+    uint8_t next_header = pkt.ip->next_header;
+    const uint8_t* ext = &ip[IPV6_HEADER_LEN];
+    uint16_t pos;
+    if (!RTNET_IPv6_SkipExtHeaders(ext, payload_len, &next_header, &pos)) {
+        RTNET_STAT_DROP(rx_errors, RTNET_DROP_MALFORMED);
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+#if (RTNET_ENABLE_FRAGMENTATION != 0U)
+    if (next_header == IPV6_EXT_FRAGMENT) {
+        return RTNET_IPv6_FragmentInput(&pkt, &ext[pos], (uint16_t)(payload_len - pos));
+    }
+#endif
+
+    pkt.l4 = &ext[pos];
+    pkt.l4_len = (uint16_t)(payload_len - pos);
+    pkt.next_header = next_header;
+
+    return RTNET_IPv6_Deliver(&pkt);
+}
+
+/* ==================== PUBLIC API IMPLEMENTATION ==================== */
+
+RTNET_Error_t RTNET_Initialize(const RTNET_IPv6Addr_t* local_ipv6,
+                                const RTNET_MACAddr_t* local_mac)
+{
+    if ((local_ipv6 == NULL) || (local_mac == NULL)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    RTNET_Memory_t* memory = g_RTNET_Ctx->memory;
+    uint8_t interface_id = g_RTNET_Ctx->interface_id;
+    if (memory == NULL) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    /* Zero all state but the instance binding */
+    memset(g_RTNET_Ctx, 0, sizeof(RTNET_Context_t));
+    g_RTNET_Ctx->memory = memory;
+    g_RTNET_Ctx->interface_id = interface_id;
+    
+    /* Copy addresses */
+    memcpy(&g_RTNET_Ctx->local_ipv6, local_ipv6, sizeof(RTNET_IPv6Addr_t));
+    memcpy(&g_RTNET_Ctx->local_mac, local_mac, sizeof(RTNET_MACAddr_t));
+    
+    /* Buffer pools (all buffers free) */
+    (void)RTNET_Pool_Init(&g_RTNET_Ctx->rx_pool, g_RTNET_Ctx->rx_buffers,
+                          memory->rx, RTNET_BUFFER_SIZE,
+                          RTNET_RX_POOL_SIZE, 0U, 0U);
+    (void)RTNET_Pool_Init(&g_RTNET_Ctx->tx_pool, g_RTNET_Ctx->tx_buffers,
+                          memory->tx, RTNET_BUFFER_SIZE,
+                          RTNET_TX_POOL_SIZE, RTNET_TX_RESERVE_CRITICAL, RTNET_TX_RESERVE_HIGH);
+    (void)RTNET_Pool_Init(&g_RTNET_Ctx->tx_small_pool, &g_RTNET_Ctx->tx_buffers[RTNET_TX_POOL_SIZE],
+                          &memory->tx[RTNET_TX_POOL_SIZE * RTNET_BUFFER_SIZE],
+                          RTNET_SMALL_BUFFER_SIZE, RTNET_TX_SMALL_POOL_SIZE,
+                          RTNET_TX_RESERVE_CRITICAL, RTNET_TX_RESERVE_HIGH);
+    RTNET_Ring_Init(&g_RTNET_Ctx->rx_ring);
+    RTNET_TxSched_Init();
+    RTNET_RateLimit_Init();
+#if (RTNET_ENABLE_TCP != 0U)
+    RTNET_TCP_Init();
+#endif
+    RTNET_UDP_Init();
+#if (RTNET_ENABLE_MDNS != 0U)
+    RTNET_mDNS_Init();
+#endif
+#if (RTNET_ENABLE_FRAGMENTATION != 0U)
+    RTNET_Reasm_Init();
+    
+    /* Fragment Identification: not predictable from one boot to the next (RFC 7739) */
+    g_RTNET_Ctx->frag_id = RTNET_GetCycleCount() ^ RTNET_IPv6_Hash(local_ipv6);
+#endif
+    
+    /* Query MAC offload capabilities once */
+    RTNET_GetHardwareCaps(&g_RTNET_Ctx->hw_caps);
+    
+    /* Initialize ephemeral port range (49152-65535) */
+    g_RTNET_Ctx->next_ephemeral_port = 49152U;
+    
+    /* Initialize sequence number */
+    g_RTNET_Ctx->sequence_number = RTNET_GetTimeMs();
+    
+#if (RTNET_ENABLE_ROUTE_TRIE != 0U)
+    /* Empty route index */
+    RTNET_RouteTrie_Build();
+#endif
+    
+    /* Zeroed cache entries carry generation 0: start past it */
+    g_RTNET_Ctx->dest_cache_gen = 1U;
+    
+    /* Empty neighbor cache: every entry on the free list */
+    RTNET_ND_Init();
+    
+    /* Add link-local route */
+    RTNET_IPv6Addr_t link_local_prefix = {
+        .addr = {0xFE, 0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
+    };
+    RTNET_AddRoute(&link_local_prefix, 10U, NULL, 1U);
+    
+    g_RTNET_Ctx->initialized = true;
+    
+    return RTNET_OK;
+}
+
+RTNET_Error_t RTNET_ContextBind(RTNET_Context_t* ctx, RTNET_Memory_t* memory,
+                                 uint8_t interface_id)
+{
+    if ((ctx == NULL) || (memory == NULL)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    memset(ctx, 0, sizeof(RTNET_Context_t));
+    ctx->memory = memory;
+    ctx->interface_id = interface_id;
+    
+    return RTNET_OK;
+}
+
+RTNET_Context_t* RTNET_SelectContext(RTNET_Context_t* ctx)
+{
+    RTNET_Context_t* previous = g_RTNET_Ctx;
+    
+    g_RTNET_Ctx = (ctx != NULL) ? ctx : &g_RTNET_DefaultCtx;
+    return previous;
+}
+
+RTNET_Context_t* RTNET_GetContext(void)
+{
+    return g_RTNET_Ctx;
+}
+
+uint8_t RTNET_GetInterfaceId(void)
+{
+    return g_RTNET_Ctx->interface_id;
+}
+
+RTNET_Error_t RTNET_AddRoute(const RTNET_IPv6Addr_t* destination,
+                              uint8_t prefix_len,
+                              const RTNET_IPv6Addr_t* next_hop,
+                              uint16_t metric)
+{
+    if ((destination == NULL) || (prefix_len > 128U)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    /* Find empty slot */
+    for (uint16_t i = 0U; i < RTNET_MAX_ROUTING_ENTRIES; i++) {
+        RTNET_RouteEntry_t* entry = &g_RTNET_Ctx->routing_table[i];
+        
+        if (!entry->valid) {
+            memcpy(&entry->destination, destination, sizeof(RTNET_IPv6Addr_t));
+            entry->prefix_len = prefix_len;
+            
+            if (next_hop != NULL) {
+                memcpy(&entry->next_hop, next_hop, sizeof(RTNET_IPv6Addr_t));
+            } else {
+                memset(&entry->next_hop, 0, sizeof(RTNET_IPv6Addr_t));
+            }
+            
+            entry->metric = metric;
+            entry->last_used_ms = RTNET_GetTimeMs();
+            entry->valid = true;
+            
+#if (RTNET_ENABLE_ROUTE_TRIE != 0U)
+            /* Incremental index update */
+            if (RTNET_RouteTrie_Insert(i) != RTNET_OK) {
+                entry->valid = false;
+                return RTNET_ERR_OVERFLOW;
+            }
+#endif
+            
+            /* A longer prefix may now win for cached destinations */
+            RTNET_DestCache_Invalidate();
+            
+            return RTNET_OK;
+        }
+    }
+    
+    return RTNET_ERR_OVERFLOW;
+}
+
+RTNET_Error_t RTNET_LookupRoute(const RTNET_IPv6Addr_t* destination,
+                                 RTNET_RouteEntry_t* route)
+{
+    if ((destination == NULL) || (route == NULL)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    const RTNET_RouteEntry_t* entry = RTNET_FindRoute(destination);
+    if (entry == NULL) {
+        return RTNET_ERR_NO_ROUTE;
+    }
+    
+    memcpy(route, entry, sizeof(RTNET_RouteEntry_t));
+    return RTNET_OK;
+}
+
+RTNET_Error_t RTNET_LookupRouteLinear(const RTNET_IPv6Addr_t* destination,
+                                       RTNET_RouteEntry_t* route)
+{
+    if ((destination == NULL) || (route == NULL)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    const RTNET_RouteEntry_t* entry = RTNET_FindRouteLinear(destination);
+    if (entry == NULL) {
+        return RTNET_ERR_NO_ROUTE;
+    }
+    
+    memcpy(route, entry, sizeof(RTNET_RouteEntry_t));
+    return RTNET_OK;
+}
+
+RTNET_Error_t RTNET_LookupNeighbor(const RTNET_IPv6Addr_t* ipv6_addr,
+                                    RTNET_MACAddr_t* mac_addr)
+{
+    if ((ipv6_addr == NULL) || (mac_addr == NULL)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    const RTNET_NeighborEntry_t* entry = RTNET_ND_Find(ipv6_addr);
+    if ((entry == NULL) || (entry->state == RTNET_ND_STATE_INCOMPLETE)) {
+        return RTNET_ERR_NO_ROUTE;
+    }
+    
+    memcpy(mac_addr, &entry->mac_addr, sizeof(RTNET_MACAddr_t));
+    return RTNET_OK;
+}
+
+RTNET_Error_t RTNET_ProcessRxPacket(const uint8_t* data, uint16_t length)
+{
+    if ((data == NULL) || (length == 0U)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    RTNET_PROBE_BEGIN(start);
+    const RTNET_Error_t err = RTNET_IPv6_Input(data, length);
+    RTNET_PROBE_END(RTNET_PROBE_RX_FRAME, start);
+
+    return err;
+}
+
+RTNET_Error_t RTNET_ProcessRxBuffer(const RTNET_Buffer_t* buffer)
+{
+    if ((buffer == NULL) || (buffer->data == NULL) || (buffer->length == 0U) ||
+        (((uint32_t)buffer->offset + buffer->length) > buffer->capacity)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    /* Parse straight out of the DMA buffer */
+    RTNET_PROBE_BEGIN(start);
+    const RTNET_Error_t err = RTNET_IPv6_Input(&buffer->data[buffer->offset], buffer->length);
+    RTNET_PROBE_END(RTNET_PROBE_RX_FRAME, start);
+
+    return err;
+}
+
+RTNET_Buffer_t* RTNET_AllocRxBuffer(void)
+{
+    RTNET_Buffer_t* buffer = RTNET_Pool_Alloc(&g_RTNET_Ctx->rx_pool, RTNET_QOS_CRITICAL);
+    
+    if (buffer != NULL) {
+        buffer->length = 0U;
+        buffer->offset = 0U;
+    }
+    
+    return buffer;
+}
+
+RTNET_Error_t RTNET_FreeRxBuffer(RTNET_Buffer_t* buffer)
+{
+    return RTNET_Pool_Free(&g_RTNET_Ctx->rx_pool, buffer) ? RTNET_OK : RTNET_ERR_INVALID_PARAM;
+}
+
+RTNET_Error_t RTNET_EnqueueRxBuffer(RTNET_Buffer_t* buffer)
+{
+    if ((buffer == NULL) || (buffer < g_RTNET_Ctx->rx_buffers) ||
+        (buffer >= &g_RTNET_Ctx->rx_buffers[RTNET_RX_POOL_SIZE]) ||
+        !buffer->in_use || (buffer->length == 0U)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    if (!RTNET_Ring_Push(&g_RTNET_Ctx->rx_ring, buffer)) {
+        RTNET_STAT_DROP(rx_dropped, RTNET_DROP_RX_RING_FULL);
+        return RTNET_ERR_NO_BUFFER;
+    }
+    
+    return RTNET_OK;
+}
+
+RTNET_Error_t RTNET_EnqueueRxBufferTo(RTNET_Context_t* ctx, RTNET_Buffer_t* buffer)
+{
+    /* Restored before returning, so the interrupted code never sees the switch */
+    RTNET_Context_t* const interrupted = RTNET_SelectContext(ctx);
+    const RTNET_Error_t err = RTNET_EnqueueRxBuffer(buffer);
+    
+    (void)RTNET_SelectContext(interrupted);
+    return err;
+}
+
+uint16_t RTNET_PollRx(uint16_t budget)
+{
+    uint16_t processed = 0U;
+    
+    while (processed < budget) {
+        RTNET_Buffer_t* buffer = RTNET_Ring_Pop(&g_RTNET_Ctx->rx_ring);
+        if (buffer == NULL) {
+            break;
+        }
+        
+        /* Errors are already counted in the statistics. A UDP socket
+         * queue may keep the buffer (rx_current cleared) */
+        g_RTNET_Ctx->rx_current = buffer;
+        (void)RTNET_ProcessRxBuffer(buffer);
+        if (g_RTNET_Ctx->rx_current != NULL) {
+            (void)RTNET_Pool_Free(&g_RTNET_Ctx->rx_pool, buffer);
+            g_RTNET_Ctx->rx_current = NULL;
+        }
+        processed++;
+    }
+    
+    return processed;
+}
+
+RTNET_Error_t RTNET_SetRxHandler(RTNET_Protocol_t protocol, RTNET_RxHandler_t handler)
+{
+    switch (protocol) {
+        case RTNET_PROTO_UDP:
+            g_RTNET_Ctx->udp_rx_handler = handler;
+            return RTNET_OK;
+
+        case RTNET_PROTO_TCP:
+            g_RTNET_Ctx->tcp_rx_handler = handler;
+            return RTNET_OK;
+
+        default:
+            /* ICMPv6 is handled inside the stack */
+            return RTNET_ERR_INVALID_PARAM;
+    }
+}
+
+RTNET_Error_t RTNET_UDP_Send(const RTNET_IPv6Addr_t* dest_addr,
+                              uint16_t dest_port,
+                              uint16_t src_port,
+                              const uint8_t* payload,
+                              uint16_t payload_len,
+                              uint8_t qos_priority)
+{
+    if ((dest_addr == NULL) || (payload == NULL) || (dest_port == 0U) ||
+        (payload_len == 0U) || (payload_len > UDP_MAX_DATAGRAM) ||
+        (qos_priority > RTNET_QOS_LOW) || !g_RTNET_Ctx->initialized) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    RTNET_IPv6Addr_t next_hop;
+    const RTNET_DestCacheEntry_t* dest = NULL;
+    RTNET_Error_t err = RTNET_IPv6_Route(dest_addr, &dest, &next_hop);
+    if (err != RTNET_OK) {
+        return err;
+    }
+
+#if (RTNET_ENABLE_FRAGMENTATION != 0U)
+    if (payload_len > UDP_MAX_PAYLOAD) {
+        if (src_port == 0U) {
+            src_port = RTNET_EphemeralPort();
+        }
+        return RTNET_UDP_SendFragments(dest, dest_addr, &next_hop, dest_port, src_port,
+                                       payload, payload_len, qos_priority);
+    }
+#endif
+
+    const uint16_t udp_len = (uint16_t)(UDP_HEADER_LEN + payload_len);
+    RTNET_Buffer_t* buf = RTNET_AllocTxBuffer(qos_priority,
+                                              ETH_HEADER_LEN + IPV6_HEADER_LEN + (uint32_t)udp_len);
+    if (buf == NULL) {
+        RTNET_STAT_DROP(tx_dropped, RTNET_DROP_NO_TX_BUFFER);
+        return RTNET_ERR_NO_BUFFER;
+    }
+
+    if (src_port == 0U) {
+        src_port = RTNET_EphemeralPort();
+    }
+
+    RTNET_UDP_CopyPayload(buf, payload, payload_len);
+    RTNET_UDP_BuildFrame(buf, dest, dest_addr, dest_port, src_port, payload_len);
+
+    if (dest != NULL) {
+        RTNET_TxFrame(buf);
+        return RTNET_OK;
+    }
+
+    return RTNET_ND_Resolve(&next_hop, buf);
+}
+
+RTNET_Error_t RTNET_UDP_SendBatch(const RTNET_UDPDatagram_t* datagrams,
+                                   uint16_t count,
+                                   uint16_t src_port,
+                                   uint8_t qos_priority,
+                                   uint16_t* sent)
+{
+    if (sent != NULL) {
+        *sent = 0U;
+    }
+    if ((datagrams == NULL) || (count == 0U) ||
+        (qos_priority > RTNET_QOS_LOW) || !g_RTNET_Ctx->initialized) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    /* One source port for the whole burst */
+    if (src_port == 0U) {
+        src_port = RTNET_EphemeralPort();
+    }
+
+    RTNET_TxBatch_t batch;
+    batch.count = 0U;
+    RTNET_Error_t result = RTNET_OK;
+    uint16_t accepted = 0U;
+    const RTNET_DestCacheEntry_t* dest = NULL;
+    RTNET_IPv6Addr_t next_hop;
+
+    for (uint16_t i = 0U; i < count; i++) {
+        const RTNET_UDPDatagram_t* dgram = &datagrams[i];
+        RTNET_Error_t err = RTNET_OK;
+
+        if ((dgram->dest_addr == NULL) || (dgram->payload == NULL) || (dgram->dest_port == 0U) ||
+            (dgram->payload_len == 0U) || (dgram->payload_len > UDP_MAX_PAYLOAD)) {
+            err = RTNET_ERR_INVALID_PARAM;
+        } else if ((dest != NULL) && (dest->generation == g_RTNET_Ctx->dest_cache_gen) &&
+                   RTNET_IPv6_AddressEqual(dgram->dest_addr, &dest->destination)) {
+            /* Same cached destination as the previous datagram: skip the lookup */
+        } else {
+            err = RTNET_IPv6_Route(dgram->dest_addr, &dest, &next_hop);
+        }
+
+        RTNET_Buffer_t* buf = NULL;
+        if (err == RTNET_OK) {
+            const uint32_t frame_len = ETH_HEADER_LEN + IPV6_HEADER_LEN + UDP_HEADER_LEN +
+                                       (uint32_t)dgram->payload_len;
+            buf = RTNET_AllocTxBuffer(qos_priority, frame_len);
+            if ((buf == NULL) && (batch.count > 0U)) {
+                /* Our own unsent frames hold the pool: ring the doorbell early */
+                RTNET_TxBatch_Flush(&batch);
+                buf = RTNET_AllocTxBuffer(qos_priority, frame_len);
+            }
+            if (buf == NULL) {
+                RTNET_STAT_DROP(tx_dropped, RTNET_DROP_NO_TX_BUFFER);
+                err = RTNET_ERR_NO_BUFFER;
+            }
+        }
+
+        if (err == RTNET_OK) {
+            RTNET_UDP_CopyPayload(buf, dgram->payload, dgram->payload_len);
+            RTNET_UDP_BuildFrame(buf, dest, dgram->dest_addr, dgram->dest_port, src_port,
+                                 dgram->payload_len);
+            if (dest != NULL) {
+                batch.buffers[batch.count] = buf;
+                batch.count++;
+                if (batch.count == RTNET_TX_BATCH_MAX) {
+                    RTNET_TxBatch_Flush(&batch);
+                }
+            } else {
+                err = RTNET_ND_Resolve(&next_hop, buf);
+            }
+        }
+
+        if (err == RTNET_OK) {
+            accepted++;
+        } else if (result == RTNET_OK) {
+            result = err;  /* Report the first failure, keep sending the rest */
+        } else {
+            /* Later failures are only counted in the statistics */
+        }
+    }
+
+    RTNET_TxBatch_Flush(&batch);
+
+    if (sent != NULL) {
+        *sent = accepted;
+    }
+
+    return result;
+}
+
+RTNET_Buffer_t* RTNET_UDP_AllocBuffer(uint16_t payload_len, uint8_t qos_priority)
+{
+    if ((payload_len == 0U) || (payload_len > UDP_MAX_PAYLOAD) ||
+        (qos_priority > RTNET_QOS_LOW) || !g_RTNET_Ctx->initialized) {
+        return NULL;
+    }
+
+    RTNET_Buffer_t* buf = RTNET_AllocTxBuffer(qos_priority, RTNET_TX_HEADROOM + (uint32_t)payload_len);
+    if (buf == NULL) {
+        RTNET_STAT_DROP(tx_dropped, RTNET_DROP_NO_TX_BUFFER);
+        return NULL;
+    }
+
+    buf->offset = RTNET_TX_HEADROOM;
+    return buf;
+}
+
+RTNET_Error_t RTNET_UDP_SendBuffer(RTNET_Buffer_t* buffer,
+                                    const RTNET_IPv6Addr_t* dest_addr,
+                                    uint16_t dest_port,
+                                    uint16_t src_port)
+{
+    /* Only a live stack buffer can change hands */
+    if ((buffer == NULL) || (buffer < g_RTNET_Ctx->tx_buffers) ||
+        (buffer >= &g_RTNET_Ctx->tx_buffers[RTNET_TX_BUFFER_COUNT]) || !buffer->in_use) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    /* From here the buffer is consumed whatever the outcome */
+    if ((dest_addr == NULL) || (dest_port == 0U) ||
+        (buffer->offset != RTNET_TX_HEADROOM) ||
+        (buffer->length == 0U) || (buffer->length > UDP_MAX_PAYLOAD) ||
+        (((uint32_t)buffer->offset + buffer->length) > buffer->capacity)) {
+        RTNET_FreeBuffer(buffer);
         return RTNET_ERR_INVALID_PARAM;
     }
 
-    RTNET_TCPConnection_t* conn = &g_RTNET_Ctx.tcp_connections[connection_id];
-    if (!conn->in_use) {
-        return RTNET_ERR_CONNECTION;
+    RTNET_IPv6Addr_t next_hop;
+    const RTNET_DestCacheEntry_t* dest = NULL;
+    RTNET_Error_t err = RTNET_IPv6_Route(dest_addr, &dest, &next_hop);
+    if (err != RTNET_OK) {
+        RTNET_FreeBuffer(buffer);
+        return err;
+    }
+
+    if (src_port == 0U) {
+        src_port = RTNET_EphemeralPort();
+    }
+
+    /* Prepend the headers into the headroom; the payload stays where it is */
+    const uint16_t payload_len = buffer->length;
+    buffer->offset = (uint16_t)(buffer->offset - UDP_FRAME_HDR_LEN);
+    RTNET_UDP_BuildFrame(buffer, dest, dest_addr, dest_port, src_port, payload_len);
+
+    if (dest != NULL) {
+        RTNET_TxFrame(buffer);
+        return RTNET_OK;
+    }
+
+    return RTNET_ND_Resolve(&next_hop, buffer);
+}
+
+RTNET_Error_t RTNET_FreeTxBuffer(RTNET_Buffer_t* buffer)
+{
+    if ((buffer == NULL) || (buffer < g_RTNET_Ctx->tx_buffers) ||
+        (buffer >= &g_RTNET_Ctx->tx_buffers[RTNET_TX_BUFFER_COUNT]) || !buffer->in_use) {
+        return RTNET_ERR_INVALID_PARAM;
     }
 
-    conn->in_use = false;
-    conn->state = RTNET_TCP_CLOSED;
+    RTNET_FreeBuffer(buffer);
     return RTNET_OK;
-}
\ No newline at end of file
+}
+
+void RTNET_PeriodicTask(void)
+{
+    uint32_t now = RTNET_GetTimeMs();
+    
+    /* Age neighbor cache, retry pending resolutions */
+    RTNET_ND_Age(now);
+    
+#if (RTNET_ENABLE_FRAGMENTATION != 0U)
+    /* Abandon datagrams whose fragments stopped arriving */
+    RTNET_Reasm_Age(now);
+#endif
+    
+#if (RTNET_ENABLE_ROUTING != 0U)
+    /* Age routing table (remove unused routes after 5 minutes) */
+    bool routes_removed = false;
+    for (uint16_t i = 0U; i < RTNET_MAX_ROUTING_ENTRIES; i++) {
+        RTNET_RouteEntry_t* entry = &g_RTNET_Ctx->routing_table[i];
+        if (entry->valid && ((now - entry->last_used_ms) > 300000U)) {
+            entry->valid = false;
+            routes_removed = true;
+        }
+    }
+    
+    if (routes_removed) {
+#if (RTNET_ENABLE_ROUTE_TRIE != 0U)
+        RTNET_RouteTrie_Build();
+#endif
+        RTNET_DestCache_Invalidate();
+    }
+#endif
+    
+#if (RTNET_ENABLE_TCP != 0U)
+    /* TCP retransmission, delayed ACK and handshake/close timeouts */
+    RTNET_TCP_Timers(now);
+#endif
+    
+#if (RTNET_ENABLE_MDNS != 0U)
+    /* mDNS record expiry, re-queries and announcements */
+    RTNET_mDNS_Periodic(now);
+#endif
+    
+    /* Frames left queued while the MAC had no room */
+    (void)RTNET_PollTx(UINT16_MAX);
+}
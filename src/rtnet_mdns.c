@@ -0,0 +1,2041 @@
+/**
+ * @file rtnet_mdns.c
+ * @brief mDNS (RFC 6762) querier cache and responder
+ * @version 1.0.0
+ * @date 2026-01-07
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/src/rtnet_mdns.c
+ *
+ * IMPLEMENTATION NOTES:
+ * - Names are interned once in wire format in a label arena and referred
+ *   to by a uint8_t index; lookups hash the name (FNV-1a, case-folded)
+ *   into RTNET_MDNS_HASH_SIZE chains and compare bytes only on a hash
+ *   match. Freed arena space is reclaimed by compaction when it runs out
+ * - Cached records are chained by owner name and type, and kept in a
+ *   min-heap on expires_ms: RTNET_PeriodicTask only looks at the heap
+ *   root, and a full cache evicts the record closest to expiry
+ * - Only records for names already known are cached: PTRs for a type
+ *   being asked about, then the SRV and AAAA records they lead to
+ * - Outgoing questions carry the cached answers that still have more than
+ *   half their TTL left (known-answer suppression, RFC 6762 7.1); a query
+ *   from another host asking the same question with no answer we lack
+ *   counts as our own (duplicate question suppression, RFC 6762 7.3)
+ * - Each question is repeated at doubling intervals from 1 s up to one
+ *   hour (RFC 6762 5.2). When one is due, every question due within
+ *   MDNS_GROUP_WINDOW_MS goes into the same packet. The initial 20-120 ms
+ *   random delay is not applied: there is no random source in the stack
+ * - Browses are evaluated after every received response and when
+ *   started: a PTR that resolves down to an address is reported once as
+ *   added, and as removed when it leaves the cache
+ * - The responder answers from the services published by
+ *   RTNET_mDNS_Announce, leaves out what the query's known answers
+ *   already hold with at least half our TTL, and multicasts one response
+ *   per query (QU questions included) with the answers of all its
+ *   questions and services
+ * - Each service is encoded once, when announced, into a template of its
+ *   PTR, SRV, TXT and AAAA records with names compressed across them.
+ *   Announcements, responses and goodbyes copy records from it and only
+ *   rewrite the compression pointers, the TTL (goodbye) and the address.
+ *   A record copied into the answers brings the records its pointers
+ *   lead into (e.g. the PTR for an SRV question)
+ * - Messages are written straight into a TX buffer and sent with
+ *   RTNET_UDP_SendBuffer at RTNET_QOS_NORMAL and the default hop limit;
+ *   names are compressed down to their longest suffix already written
+ * - Traffic from a source port other than 5353 (legacy unicast) is ignored
+ * - The RX handler runs in the RX path context and shares the engine state
+ *   with the API calls and RTNET_PeriodicTask without locking: all three
+ *   must run in the same task. Worst-case handler stack is about 0.7 KB
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include "rtnet_stack.h"
+#include "rtnet_internal.h"
+#include <stddef.h>
+#include <string.h>
+
+#if (RTNET_ENABLE_MDNS != 0U)
+
+/* ==================== CONSTANTS ==================== */
+
+#define MDNS_PORT                   5353U
+#define MDNS_HEADER_LEN             12U
+#define MDNS_FLAG_RESPONSE          0x8000U
+#define MDNS_FLAG_AUTHORITATIVE     0x0400U
+#define MDNS_OPCODE_MASK            0x7800U
+#define MDNS_RCODE_MASK             0x000FU
+#define MDNS_CLASS_IN               1U
+#define MDNS_CLASS_MASK             0x7FFFU
+#define MDNS_CLASS_TOP_BIT          0x8000U  /* RR: cache-flush; question: unicast response */
+
+#define MDNS_SECTION_QD             0U
+#define MDNS_SECTION_AN             1U
+#define MDNS_SECTION_AR             3U
+
+#define MDNS_MAX_POINTERS           16U      /* Compression pointers followed per name */
+#define MDNS_MAX_LABEL              63U
+#define MDNS_MAX_TTL_S              2000000U /* Keeps expiry times wrap-safe */
+#define MDNS_HOST_TTL_S             120U     /* RFC 6762 10: host name records */
+#define MDNS_GOODBYE_MS             1000U    /* RFC 6762 10.1: TTL 0 expires in 1 s */
+#define MDNS_FIRST_INTERVAL_MS      1000U    /* RFC 6762 5.2: then doubled */
+#define MDNS_MAX_INTERVAL_MS        3600000U
+#define MDNS_GROUP_WINDOW_MS        250U     /* Questions this close to due join a packet */
+#define MDNS_QUESTION_LIFETIME_MS   10000U   /* Question dropped when no longer asked */
+#define MDNS_ANNOUNCE_COUNT         2U       /* RFC 6762 8.3: at least two, 1 s apart */
+#define MDNS_ANNOUNCE_INTERVAL_MS   1000U
+
+#define MDNS_RX_MAX_QUESTIONS       8U       /* Questions examined per received query */
+#define MDNS_RX_MAX_KNOWN           8U       /* Known answers examined per received query */
+#define MDNS_WRITER_LABELS          24U      /* Name suffixes remembered for compression */
+
+/* Template records: bit (1 << index) in the masks below */
+#define MDNS_ANS_PTR                0x01U
+#define MDNS_ANS_SRV                0x02U
+#define MDNS_ANS_TXT                0x04U
+#define MDNS_ANS_AAAA               0x08U
+#define MDNS_RECORD_AAAA            3U
+
+#define MDNS_NAME_NONE              ((uint8_t)RTNET_MDNS_MAX_NAMES)
+#define MDNS_CACHE_NONE             ((uint8_t)RTNET_MAX_MDNS_CACHE)
+
+#define MDNS_HOST_PREFIX            "rtnet-"
+#define MDNS_HOST_LABEL_LEN         12U      /* "rtnet-" + 6 hex digits */
+
+#if ((RTNET_MDNS_HASH_SIZE & (RTNET_MDNS_HASH_SIZE - 1U)) != 0U)
+#error "RTNET_MDNS_HASH_SIZE must be a power of two"
+#endif
+
+#if (RTNET_MDNS_MAX_NAMES >= 255U) || (RTNET_MAX_MDNS_CACHE >= 255U)
+#error "mDNS name and cache indices must fit a uint8_t"
+#endif
+
+#if ((2U * RTNET_MAX_MDNS_CACHE + RTNET_MDNS_MAX_QUESTIONS + \
+      2U * RTNET_MDNS_MAX_SERVICES + RTNET_MDNS_MAX_BROWSES + 1U) > 255U)
+#error "mDNS name reference count would overflow"
+#endif
+
+#if (RTNET_MDNS_MAX_QUESTIONS > 32U)
+#error "RTNET_MDNS_MAX_QUESTIONS must fit a uint32_t mask"
+#endif
+
+#if (RTNET_MDNS_MAX_NAME_LEN > 255U)
+#error "RTNET_MDNS_MAX_NAME_LEN must fit a uint8_t"
+#endif
+
+#if (RTNET_MDNS_MAX_MESSAGE > (RTNET_MTU_SIZE - 48U))
+#error "RTNET_MDNS_MAX_MESSAGE must fit one IPv6/UDP datagram"
+#endif
+
+/* Longest type name with the host label in front, plus the other records */
+#if (RTNET_MDNS_TEMPLATE_SIZE < (RTNET_MDNS_MAX_NAME_LEN + 86U))
+#error "RTNET_MDNS_TEMPLATE_SIZE cannot hold a service with the longest name"
+#endif
+
+static const RTNET_IPv6Addr_t g_RTNET_mDNSGroup = {
+    .addr = {0xFF, 0x02, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFB}
+};
+
+/**
+ * @brief Resource record decoded from a received message
+ */
+typedef struct {
+    uint8_t owner[RTNET_MDNS_MAX_NAME_LEN];
+    uint8_t target[RTNET_MDNS_MAX_NAME_LEN];  /* PTR/SRV */
+    RTNET_IPv6Addr_t addr;                     /* AAAA */
+    uint32_t ttl_s;
+    uint16_t type;
+    uint16_t rrclass;
+    uint16_t port;                             /* SRV */
+    uint8_t owner_len;
+    uint8_t target_len;
+} RTNET_mDNSRR_t;
+
+/**
+ * @brief Known answer of a received query, reduced to names we know
+ */
+typedef struct {
+    RTNET_IPv6Addr_t addr;
+    uint32_t ttl_s;
+    uint16_t type;
+    uint8_t name;
+    uint8_t target;             /* MDNS_NAME_NONE if not interned */
+} RTNET_mDNSKnown_t;
+
+/**
+ * @brief Question of a received query
+ */
+typedef struct {
+    uint16_t type;
+    uint8_t name;
+    bool unicast;               /* QU bit */
+} RTNET_mDNSRxQuestion_t;
+
+/**
+ * @brief Message being written into a TX buffer or a template
+ */
+typedef struct {
+    RTNET_Buffer_t* buffer;     /* NULL when compiling a template */
+    uint8_t* msg;
+    uint16_t len;
+    uint16_t cap;
+    uint16_t counts[4];         /* QD, AN, NS, AR */
+    uint16_t label_offset[MDNS_WRITER_LABELS];
+    uint8_t label_name[MDNS_WRITER_LABELS];
+    uint8_t label_start[MDNS_WRITER_LABELS];  /* Byte of the name the suffix starts at */
+    uint8_t label_count;
+    uint8_t pointer_count;
+    uint16_t pointer_pos[RTNET_MDNS_TEMPLATE_FIXUPS];  /* First pointers written */
+} RTNET_mDNSWriter_t;
+
+/* ==================== NAME TABLE ==================== */
+
+static inline bool RTNET_mDNS_Due(uint32_t now, uint32_t when)
+{
+    return ((int32_t)(now - when) >= 0);
+}
+
+static inline uint8_t RTNET_mDNS_Lower(uint8_t c)
+{
+    /* Label length bytes (<= 63) never fall in 'A'..'Z' */
+    return ((c >= (uint8_t)'A') && (c <= (uint8_t)'Z')) ? (uint8_t)(c + 32U) : c;
+}
+
+static uint32_t RTNET_mDNS_Hash(const uint8_t* wire, uint8_t len)
+{
+    uint32_t hash = 2166136261U;
+
+    for (uint8_t i = 0U; i < len; i++) {
+        hash ^= RTNET_mDNS_Lower(wire[i]);
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+static inline uint8_t RTNET_mDNS_Bucket(uint32_t hash)
+{
+    return (uint8_t)((hash ^ (hash >> 16U)) & (RTNET_MDNS_HASH_SIZE - 1U));
+}
+
+static inline const uint8_t* RTNET_mDNS_NameWire(uint8_t id)
+{
+    return &g_RTNET_Ctx->mdns.arena[g_RTNET_Ctx->mdns.names[id].offset];
+}
+
+static bool RTNET_mDNS_WireEqual(const uint8_t* a, const uint8_t* b, uint8_t len)
+{
+    for (uint8_t i = 0U; i < len; i++) {
+        if (RTNET_mDNS_Lower(a[i]) != RTNET_mDNS_Lower(b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static uint8_t RTNET_mDNS_NameFind(const uint8_t* wire, uint8_t len, uint32_t hash)
+{
+    RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+    uint8_t id = mdns->name_hash[RTNET_mDNS_Bucket(hash)];
+
+    while (id != MDNS_NAME_NONE) {
+        const RTNET_mDNSName_t* name = &mdns->names[id];
+        if ((name->hash == hash) && (name->length == len) &&
+            RTNET_mDNS_WireEqual(RTNET_mDNS_NameWire(id), wire, len)) {
+            return id;
+        }
+        id = name->next;
+    }
+
+    return MDNS_NAME_NONE;
+}
+
+static inline uint8_t RTNET_mDNS_NameLookup(const uint8_t* wire, uint8_t len)
+{
+    return RTNET_mDNS_NameFind(wire, len, RTNET_mDNS_Hash(wire, len));
+}
+
+/**
+ * @brief Slide live names down over freed arena space
+ * @note Each arena record is [index][length][wire]; a record is live when
+ *       its slot is in use and still points at it
+ */
+static void RTNET_mDNS_ArenaCompact(void)
+{
+    RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+    uint16_t rd = 0U;
+    uint16_t wr = 0U;
+
+    while (rd < mdns->arena_used) {
+        uint8_t id = mdns->arena[rd];
+        uint16_t total = (uint16_t)(mdns->arena[rd + 1U] + 2U);
+
+        if ((id < RTNET_MDNS_MAX_NAMES) && (mdns->names[id].length != 0U) &&
+            (mdns->names[id].offset == (uint16_t)(rd + 2U))) {
+            if (wr != rd) {
+                memmove(&mdns->arena[wr], &mdns->arena[rd], total);
+            }
+            mdns->names[id].offset = (uint16_t)(wr + 2U);
+            wr = (uint16_t)(wr + total);
+        }
+        rd = (uint16_t)(rd + total);
+    }
+
+    mdns->arena_used = wr;
+}
+
+/**
+ * @brief Find or add a name and take a reference on it
+ * @return Name index, MDNS_NAME_NONE if the table or arena is full
+ */
+static uint8_t RTNET_mDNS_NameIntern(const uint8_t* wire, uint8_t len)
+{
+    RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+    uint32_t hash = RTNET_mDNS_Hash(wire, len);
+    uint8_t id = RTNET_mDNS_NameFind(wire, len, hash);
+
+    if (id != MDNS_NAME_NONE) {
+        mdns->names[id].refs++;
+        return id;
+    }
+
+    id = mdns->name_free;
+    if ((id == MDNS_NAME_NONE) || (len == 0U)) {
+        return MDNS_NAME_NONE;
+    }
+
+    uint16_t need = (uint16_t)(len + 2U);
+    if ((mdns->arena_used + need) > RTNET_MDNS_ARENA_SIZE) {
+        RTNET_mDNS_ArenaCompact();
+        if ((mdns->arena_used + need) > RTNET_MDNS_ARENA_SIZE) {
+            return MDNS_NAME_NONE;
+        }
+    }
+
+    RTNET_mDNSName_t* name = &mdns->names[id];
+    mdns->name_free = name->next;
+
+    mdns->arena[mdns->arena_used] = id;
+    mdns->arena[mdns->arena_used + 1U] = len;
+    memcpy(&mdns->arena[mdns->arena_used + 2U], wire, len);
+
+    name->hash = hash;
+    name->offset = (uint16_t)(mdns->arena_used + 2U);
+    name->length = len;
+    name->refs = 1U;
+
+    uint8_t bucket = RTNET_mDNS_Bucket(hash);
+    name->next = mdns->name_hash[bucket];
+    mdns->name_hash[bucket] = id;
+    mdns->arena_used = (uint16_t)(mdns->arena_used + need);
+
+    return id;
+}
+
+static void RTNET_mDNS_NameRelease(uint8_t id)
+{
+    RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+
+    if (id >= RTNET_MDNS_MAX_NAMES) {
+        return;
+    }
+
+    RTNET_mDNSName_t* name = &mdns->names[id];
+    if (--name->refs != 0U) {
+        return;
+    }
+
+    uint8_t* link = &mdns->name_hash[RTNET_mDNS_Bucket(name->hash)];
+    while (*link != id) {
+        link = &mdns->names[*link].next;
+    }
+    *link = name->next;
+
+    /* Arena bytes are reclaimed by the next compaction */
+    name->length = 0U;
+    name->next = mdns->name_free;
+    mdns->name_free = id;
+}
+
+/**
+ * @brief Convert a dotted name ("_http._tcp.local") to wire format
+ * @param max_len Capacity of wire in bytes (<= RTNET_MDNS_MAX_NAME_LEN)
+ * @return false if a label is empty or too long, or the name does not fit
+ */
+static bool RTNET_mDNS_FromText(const char* text, uint8_t* wire, uint16_t max_len,
+                                uint8_t* wire_len)
+{
+    uint16_t pos = 0U;      /* Length byte of the current label */
+    uint16_t out = 1U;
+
+    for (size_t i = 0U; ; i++) {
+        char c = text[i];
+
+        if ((c == '.') || (c == '\0')) {
+            uint16_t label_len = (uint16_t)(out - pos - 1U);
+            if (label_len == 0U) {
+                /* Only a trailing dot may leave an empty label */
+                if ((c == '\0') && (pos > 0U)) {
+                    break;
+                }
+                return false;
+            }
+            if ((label_len > MDNS_MAX_LABEL) || (out >= max_len)) {
+                return false;
+            }
+            wire[pos] = (uint8_t)label_len;
+            pos = out;
+            out++;
+            if (c == '\0') {
+                break;
+            }
+        } else {
+            if (out >= max_len) {
+                return false;
+            }
+            wire[out] = (uint8_t)c;
+            out++;
+        }
+    }
+
+    wire[pos] = 0U;
+    *wire_len = (uint8_t)(pos + 1U);
+    return true;
+}
+
+/**
+ * @brief Convert a wire-format name to dotted text (truncated to fit)
+ */
+static void RTNET_mDNS_ToText(const uint8_t* wire, char* text, uint16_t max_len)
+{
+    uint16_t out = 0U;
+    uint16_t i = 0U;
+
+    while ((wire[i] != 0U) && ((out + 1U) < max_len)) {
+        uint8_t len = wire[i];
+        if (out > 0U) {
+            text[out] = '.';
+            out++;
+        }
+        for (uint8_t j = 1U; (j <= len) && ((out + 1U) < max_len); j++) {
+            text[out] = (char)wire[i + j];
+            out++;
+        }
+        i = (uint16_t)(i + len + 1U);
+    }
+
+    text[out] = '\0';
+}
+
+/* ==================== MESSAGE PARSING ==================== */
+
+/**
+ * @brief Read a possibly compressed name
+ * @param pos [IN/OUT] Name offset; moved past the name as it appears in place
+ * @return false on a malformed, looping or too long name
+ */
+static bool RTNET_mDNS_ReadName(const uint8_t* msg, uint16_t msg_len, uint16_t* pos,
+                                uint8_t* wire, uint8_t* wire_len)
+{
+    uint16_t p = *pos;
+    uint16_t out = 0U;
+    uint8_t jumps = 0U;
+    bool jumped = false;
+
+    for (;;) {
+        if (p >= msg_len) {
+            return false;
+        }
+
+        uint8_t len = msg[p];
+        if ((len & 0xC0U) == 0xC0U) {
+            jumps++;
+            if (((p + 1U) >= msg_len) || (jumps > MDNS_MAX_POINTERS)) {
+                return false;
+            }
+            if (!jumped) {
+                *pos = (uint16_t)(p + 2U);
+                jumped = true;
+            }
+            p = (uint16_t)(((uint16_t)(len & 0x3FU) << 8U) | msg[p + 1U]);
+            continue;
+        }
+
+        if ((len > MDNS_MAX_LABEL) ||
+            ((uint32_t)out + len + 1U > RTNET_MDNS_MAX_NAME_LEN) ||
+            ((uint32_t)p + len + 1U > msg_len)) {
+            return false;
+        }
+
+        memcpy(&wire[out], &msg[p], (size_t)len + 1U);
+        out = (uint16_t)(out + len + 1U);
+        p = (uint16_t)(p + len + 1U);
+        if (len == 0U) {
+            break;
+        }
+    }
+
+    if (!jumped) {
+        *pos = p;
+    }
+    *wire_len = (uint8_t)out;
+    return true;
+}
+
+/**
+ * @brief Decode one resource record; PTR, SRV and AAAA data are unpacked
+ * @return false if the record runs past the message or is malformed
+ */
+static bool RTNET_mDNS_ReadRR(const uint8_t* msg, uint16_t msg_len, uint16_t* pos,
+                              RTNET_mDNSRR_t* rr)
+{
+    if (!RTNET_mDNS_ReadName(msg, msg_len, pos, rr->owner, &rr->owner_len) ||
+        ((uint32_t)*pos + 10U > msg_len)) {
+        return false;
+    }
+
+    const uint8_t* hdr = &msg[*pos];
+    rr->type = RTNET_Read16(&hdr[0]);
+    rr->rrclass = RTNET_Read16(&hdr[2]);
+    rr->ttl_s = RTNET_Read32(&hdr[4]);
+    uint16_t rdlen = RTNET_Read16(&hdr[8]);
+    uint16_t rdata = (uint16_t)(*pos + 10U);
+
+    if ((uint32_t)rdata + rdlen > msg_len) {
+        return false;
+    }
+    *pos = (uint16_t)(rdata + rdlen);
+    rr->target_len = 0U;
+    rr->port = 0U;
+
+    uint16_t p = rdata;
+    switch (rr->type) {
+        case RTNET_MDNS_TYPE_PTR:
+            return RTNET_mDNS_ReadName(msg, msg_len, &p, rr->target, &rr->target_len) &&
+                   (p <= *pos);
+
+        case RTNET_MDNS_TYPE_SRV:
+            if (rdlen < 7U) {
+                return false;
+            }
+            rr->port = RTNET_Read16(&msg[rdata + 4U]);
+            p = (uint16_t)(rdata + 6U);
+            return RTNET_mDNS_ReadName(msg, msg_len, &p, rr->target, &rr->target_len) &&
+                   (p <= *pos);
+
+        case RTNET_MDNS_TYPE_AAAA:
+            if (rdlen != 16U) {
+                return false;
+            }
+            memcpy(rr->addr.addr, &msg[rdata], 16U);
+            return true;
+
+        default:
+            return true;
+    }
+}
+
+/* ==================== RECORD CACHE ==================== */
+
+static inline uint8_t RTNET_mDNS_CacheBucket(uint8_t name, uint16_t type)
+{
+    return RTNET_mDNS_Bucket(g_RTNET_Ctx->mdns.names[name].hash ^ ((uint32_t)type * 0x9E3779B1U));
+}
+
+/**
+ * @brief First cache entry for (name, type) at or after chain position id
+ */
+static uint8_t RTNET_mDNS_CacheNext(uint8_t id, uint8_t name, uint16_t type)
+{
+    while (id != MDNS_CACHE_NONE) {
+        const RTNET_mDNSCacheEntry_t* entry = &g_RTNET_Ctx->mdns.cache[id];
+        if ((entry->name == name) && (entry->type == type)) {
+            return id;
+        }
+        id = entry->next;
+    }
+    return MDNS_CACHE_NONE;
+}
+
+static inline uint8_t RTNET_mDNS_CacheFirst(uint8_t name, uint16_t type)
+{
+    return RTNET_mDNS_CacheNext(g_RTNET_Ctx->mdns.cache_hash[RTNET_mDNS_CacheBucket(name, type)],
+                                name, type);
+}
+
+/**
+ * @brief Find the cached copy of a record
+ * @note SRV is unique per owner; PTR is keyed by target, AAAA by address
+ */
+static uint8_t RTNET_mDNS_CacheMatch(uint8_t name, uint16_t type, uint8_t target,
+                                     const RTNET_IPv6Addr_t* addr)
+{
+    uint8_t id = RTNET_mDNS_CacheFirst(name, type);
+
+    while (id != MDNS_CACHE_NONE) {
+        const RTNET_mDNSCacheEntry_t* entry = &g_RTNET_Ctx->mdns.cache[id];
+        if ((type == RTNET_MDNS_TYPE_SRV) ||
+            ((type == RTNET_MDNS_TYPE_PTR) && (entry->target == target)) ||
+            ((type == RTNET_MDNS_TYPE_AAAA) && (memcmp(entry->addr.addr, addr->addr, 16U) == 0))) {
+            return id;
+        }
+        id = RTNET_mDNS_CacheNext(entry->next, name, type);
+    }
+
+    return MDNS_CACHE_NONE;
+}
+
+/**
+ * @brief Known-answer freshness: more than half the received TTL left
+ */
+static inline bool RTNET_mDNS_CacheFresh(const RTNET_mDNSCacheEntry_t* entry, uint32_t now)
+{
+    uint32_t left = entry->expires_ms - now;
+    return ((int32_t)left > 0) && (left > (entry->ttl_ms / 2U));
+}
+
+static inline bool RTNET_mDNS_Earlier(uint8_t a, uint8_t b)
+{
+    const RTNET_mDNSCacheEntry_t* cache = g_RTNET_Ctx->mdns.cache;
+    return ((int32_t)(cache[a].expires_ms - cache[b].expires_ms) < 0);
+}
+
+static inline void RTNET_mDNS_HeapSet(uint16_t pos, uint8_t id)
+{
+    g_RTNET_Ctx->mdns.heap[pos] = id;
+    g_RTNET_Ctx->mdns.cache[id].heap_pos = (uint8_t)pos;
+}
+
+/**
+ * @brief Restore heap order around pos after its expiry time changed
+ */
+static void RTNET_mDNS_HeapSift(uint16_t pos)
+{
+    RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+    uint8_t id = mdns->heap[pos];
+
+    while (pos > 0U) {
+        uint16_t parent = (uint16_t)((pos - 1U) / 2U);
+        if (!RTNET_mDNS_Earlier(id, mdns->heap[parent])) {
+            break;
+        }
+        RTNET_mDNS_HeapSet(pos, mdns->heap[parent]);
+        pos = parent;
+    }
+
+    for (;;) {
+        uint16_t child = (uint16_t)(2U * pos + 1U);
+        if (child >= mdns->heap_count) {
+            break;
+        }
+        if (((child + 1U) < mdns->heap_count) &&
+            RTNET_mDNS_Earlier(mdns->heap[child + 1U], mdns->heap[child])) {
+            child++;
+        }
+        if (!RTNET_mDNS_Earlier(mdns->heap[child], id)) {
+            break;
+        }
+        RTNET_mDNS_HeapSet(pos, mdns->heap[child]);
+        pos = child;
+    }
+
+    RTNET_mDNS_HeapSet(pos, id);
+}
+
+/**
+ * @brief Fill a result from a cached PTR, following its SRV and AAAA
+ * @param missing [OUT] First missing link (MDNS_NAME_NONE if resolved)
+ * @return true if resolved down to an address
+ */
+static bool RTNET_mDNS_FillRecord(uint8_t ptr, RTNET_mDNSRecord_t* result,
+                                  uint8_t* missing, uint16_t* missing_type)
+{
+    const RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+    uint8_t instance = mdns->cache[ptr].target;
+
+    memset(result, 0, sizeof(RTNET_mDNSRecord_t));
+    RTNET_mDNS_ToText(RTNET_mDNS_NameWire(instance), result->service_name,
+                      (uint16_t)sizeof(result->service_name));
+
+    uint8_t srv = RTNET_mDNS_CacheFirst(instance, RTNET_MDNS_TYPE_SRV);
+    if (srv == MDNS_CACHE_NONE) {
+        *missing = instance;
+        *missing_type = RTNET_MDNS_TYPE_SRV;
+        return false;
+    }
+
+    const RTNET_mDNSCacheEntry_t* entry = &mdns->cache[srv];
+    result->port = entry->port;
+    result->ttl_ms = entry->ttl_ms;
+    result->last_seen_ms = entry->expires_ms - entry->ttl_ms;
+
+    uint8_t aaaa = RTNET_mDNS_CacheFirst(entry->target, RTNET_MDNS_TYPE_AAAA);
+    if (aaaa == MDNS_CACHE_NONE) {
+        *missing = entry->target;
+        *missing_type = RTNET_MDNS_TYPE_AAAA;
+        return false;
+    }
+
+    memcpy(&result->ipv6_addr, &mdns->cache[aaaa].addr, sizeof(RTNET_IPv6Addr_t));
+    result->valid = true;
+    *missing = MDNS_NAME_NONE;
+    return true;
+}
+
+/**
+ * @brief Report an instance to the browse of its service type, if any
+ */
+static void RTNET_mDNS_Notify(uint8_t ptr, RTNET_mDNSBrowseEvent_t event,
+                              const RTNET_mDNSRecord_t* record)
+{
+    const RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+
+    for (uint8_t i = 0U; i < RTNET_MDNS_MAX_BROWSES; i++) {
+        const RTNET_mDNSBrowse_t* browse = &mdns->browses[i];
+        if (browse->in_use && (browse->type_name == mdns->cache[ptr].name)) {
+            browse->callback(i, event, record);
+            return;
+        }
+    }
+}
+
+static void RTNET_mDNS_CacheRemove(uint8_t id)
+{
+    RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+    RTNET_mDNSCacheEntry_t* entry = &mdns->cache[id];
+
+    if (entry->reported) {
+        /* Reported while the entry is still whole */
+        RTNET_mDNSRecord_t record;
+        uint8_t missing;
+        uint16_t missing_type;
+        (void)RTNET_mDNS_FillRecord(id, &record, &missing, &missing_type);
+        record.valid = false;
+        entry->reported = false;
+        RTNET_mDNS_Notify(id, RTNET_MDNS_INSTANCE_REMOVED, &record);
+    }
+
+    uint8_t* link = &mdns->cache_hash[RTNET_mDNS_CacheBucket(entry->name, entry->type)];
+    while (*link != id) {
+        link = &mdns->cache[*link].next;
+    }
+    *link = entry->next;
+
+    mdns->heap_count--;
+    if (entry->heap_pos != mdns->heap_count) {
+        uint16_t pos = entry->heap_pos;
+        RTNET_mDNS_HeapSet(pos, mdns->heap[mdns->heap_count]);
+        RTNET_mDNS_HeapSift(pos);
+    }
+
+    RTNET_mDNS_NameRelease(entry->name);
+    RTNET_mDNS_NameRelease(entry->target);
+
+    entry->valid = false;
+    entry->next = mdns->cache_free;
+    mdns->cache_free = id;
+}
+
+/**
+ * @brief Take a free cache entry, evicting the one closest to expiry if needed
+ */
+static uint8_t RTNET_mDNS_CacheAlloc(void)
+{
+    RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+
+    if ((mdns->cache_free == MDNS_CACHE_NONE) && (mdns->heap_count > 0U)) {
+        RTNET_mDNS_CacheRemove(mdns->heap[0]);
+    }
+
+    uint8_t id = mdns->cache_free;
+    if (id != MDNS_CACHE_NONE) {
+        mdns->cache_free = mdns->cache[id].next;
+    }
+    return id;
+}
+
+/**
+ * @brief Cache, refresh or expire (TTL 0) a record from a response
+ */
+static void RTNET_mDNS_CacheStore(const RTNET_mDNSRR_t* rr, uint32_t now)
+{
+    RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+
+    if (((rr->type != RTNET_MDNS_TYPE_PTR) && (rr->type != RTNET_MDNS_TYPE_SRV) &&
+         (rr->type != RTNET_MDNS_TYPE_AAAA)) ||
+        ((rr->rrclass & MDNS_CLASS_MASK) != MDNS_CLASS_IN)) {
+        return;
+    }
+
+    /* Nobody asked about this name, directly or through a cached record */
+    uint8_t name = RTNET_mDNS_NameLookup(rr->owner, rr->owner_len);
+    if (name == MDNS_NAME_NONE) {
+        return;
+    }
+
+    uint8_t target = MDNS_NAME_NONE;
+    if (rr->target_len != 0U) {
+        target = RTNET_mDNS_NameLookup(rr->target, rr->target_len);
+    }
+
+    uint8_t id = RTNET_mDNS_CacheMatch(name, rr->type, target, &rr->addr);
+
+    if (rr->ttl_s == 0U) {
+        /* Goodbye: keep the record one more second */
+        if (id != MDNS_CACHE_NONE) {
+            mdns->cache[id].expires_ms = now + MDNS_GOODBYE_MS;
+            mdns->cache[id].ttl_ms = MDNS_GOODBYE_MS;
+            RTNET_mDNS_HeapSift(mdns->cache[id].heap_pos);
+        }
+        return;
+    }
+
+    if ((rr->rrclass & MDNS_CLASS_TOP_BIT) != 0U) {
+        /* Cache flush: other records of the set received over 1 s ago go stale */
+        uint8_t other = RTNET_mDNS_CacheFirst(name, rr->type);
+        while (other != MDNS_CACHE_NONE) {
+            RTNET_mDNSCacheEntry_t* entry = &mdns->cache[other];
+            if ((other != id) && ((now - (entry->expires_ms - entry->ttl_ms)) > MDNS_GOODBYE_MS) &&
+                !RTNET_mDNS_Due(now + MDNS_GOODBYE_MS, entry->expires_ms)) {
+                entry->expires_ms = now + MDNS_GOODBYE_MS;
+                RTNET_mDNS_HeapSift(entry->heap_pos);
+            }
+            other = RTNET_mDNS_CacheNext(entry->next, name, rr->type);
+        }
+    }
+
+    uint32_t ttl_s = (rr->ttl_s > MDNS_MAX_TTL_S) ? MDNS_MAX_TTL_S : rr->ttl_s;
+    RTNET_mDNSCacheEntry_t* entry;
+
+    if (id == MDNS_CACHE_NONE) {
+        /* Pin the names: an eviction below may drop their last reference */
+        mdns->names[name].refs++;
+        if (rr->target_len != 0U) {
+            target = RTNET_mDNS_NameIntern(rr->target, rr->target_len);
+            if (target == MDNS_NAME_NONE) {
+                RTNET_mDNS_NameRelease(name);
+                return;
+            }
+        }
+
+        id = RTNET_mDNS_CacheAlloc();
+        if (id == MDNS_CACHE_NONE) {
+            RTNET_mDNS_NameRelease(name);
+            RTNET_mDNS_NameRelease(target);
+            return;
+        }
+
+        entry = &mdns->cache[id];
+        entry->name = name;
+        entry->type = rr->type;
+        entry->target = target;
+        entry->port = rr->port;
+        memcpy(&entry->addr, &rr->addr, sizeof(RTNET_IPv6Addr_t));
+        entry->reported = false;
+        entry->valid = true;
+
+        uint8_t bucket = RTNET_mDNS_CacheBucket(name, rr->type);
+        entry->next = mdns->cache_hash[bucket];
+        mdns->cache_hash[bucket] = id;
+
+        RTNET_mDNS_HeapSet(mdns->heap_count, id);
+        mdns->heap_count++;
+    } else {
+        entry = &mdns->cache[id];
+        if ((rr->type == RTNET_MDNS_TYPE_SRV) && (target != entry->target)) {
+            uint8_t new_target = RTNET_mDNS_NameIntern(rr->target, rr->target_len);
+            if (new_target == MDNS_NAME_NONE) {
+                return;
+            }
+            RTNET_mDNS_NameRelease(entry->target);
+            entry->target = new_target;
+        }
+        entry->port = rr->port;
+    }
+
+    entry->ttl_ms = ttl_s * 1000U;
+    entry->expires_ms = now + entry->ttl_ms;
+    RTNET_mDNS_HeapSift(entry->heap_pos);
+}
+
+/* ==================== MESSAGE WRITER ==================== */
+
+static void RTNET_mDNS_WriterInit(RTNET_mDNSWriter_t* w, uint8_t* msg, uint16_t cap,
+                                  uint16_t flags)
+{
+    w->msg = msg;
+    w->cap = cap;
+    memset(w->msg, 0, MDNS_HEADER_LEN);
+    RTNET_Write16(&w->msg[2], flags);
+    w->len = MDNS_HEADER_LEN;
+    memset(w->counts, 0, sizeof(w->counts));
+    w->label_count = 0U;
+    w->pointer_count = 0U;
+}
+
+static bool RTNET_mDNS_WriterOpen(RTNET_mDNSWriter_t* w, uint16_t flags)
+{
+    w->buffer = RTNET_UDP_AllocBuffer(RTNET_MDNS_MAX_MESSAGE, RTNET_QOS_NORMAL);
+    if (w->buffer == NULL) {
+        return false;
+    }
+
+    RTNET_mDNS_WriterInit(w, &w->buffer->data[w->buffer->offset], RTNET_MDNS_MAX_MESSAGE, flags);
+    return true;
+}
+
+static void RTNET_mDNS_WriterSend(RTNET_mDNSWriter_t* w)
+{
+    if ((w->counts[MDNS_SECTION_QD] == 0U) && (w->counts[MDNS_SECTION_AN] == 0U)) {
+        (void)RTNET_FreeTxBuffer(w->buffer);
+        return;
+    }
+
+    for (uint8_t i = 0U; i < 4U; i++) {
+        RTNET_Write16(&w->msg[4U + (2U * i)], w->counts[i]);
+    }
+    w->buffer->length = w->len;
+    (void)RTNET_UDP_SendBuffer(w->buffer, &g_RTNET_mDNSGroup, MDNS_PORT, MDNS_PORT);
+}
+
+static inline bool RTNET_mDNS_Room(const RTNET_mDNSWriter_t* w, uint16_t bytes)
+{
+    return ((uint32_t)w->len + bytes) <= w->cap;
+}
+
+/**
+ * @brief Write a name, ending in a pointer to its longest suffix written before
+ */
+static bool RTNET_mDNS_PutName(RTNET_mDNSWriter_t* w, uint8_t id)
+{
+    const RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+    const uint8_t* wire = RTNET_mDNS_NameWire(id);
+    uint8_t len = mdns->names[id].length;
+    uint8_t pos = 0U;
+    uint16_t target = 0U;
+    bool found = false;
+
+    while (!found && (wire[pos] != 0U)) {
+        uint8_t rest = (uint8_t)(len - pos);
+        for (uint8_t i = 0U; i < w->label_count; i++) {
+            uint8_t other = w->label_name[i];
+            uint8_t start = w->label_start[i];
+            if (((uint8_t)(mdns->names[other].length - start) == rest) &&
+                RTNET_mDNS_WireEqual(&RTNET_mDNS_NameWire(other)[start], &wire[pos], rest)) {
+                target = w->label_offset[i];
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            pos = (uint8_t)(pos + wire[pos] + 1U);
+        }
+    }
+
+    uint8_t copy = found ? pos : len;
+    if (!RTNET_mDNS_Room(w, (uint16_t)(copy + (found ? 2U : 0U)))) {
+        return false;
+    }
+
+    memcpy(&w->msg[w->len], wire, copy);
+    for (uint8_t k = 0U; (k < copy) && (wire[k] != 0U); k = (uint8_t)(k + wire[k] + 1U)) {
+        if ((w->label_count < MDNS_WRITER_LABELS) && ((w->len + k) <= 0x3FFFU)) {
+            w->label_offset[w->label_count] = (uint16_t)(w->len + k);
+            w->label_name[w->label_count] = id;
+            w->label_start[w->label_count] = k;
+            w->label_count++;
+        }
+    }
+    w->len = (uint16_t)(w->len + copy);
+
+    if (found) {
+        if (w->pointer_count < RTNET_MDNS_TEMPLATE_FIXUPS) {
+            w->pointer_pos[w->pointer_count] = w->len;
+            w->pointer_count++;
+        }
+        RTNET_Write16(&w->msg[w->len], (uint16_t)(0xC000U | target));
+        w->len = (uint16_t)(w->len + 2U);
+    }
+    return true;
+}
+
+static bool RTNET_mDNS_PutQuestion(RTNET_mDNSWriter_t* w, uint8_t name, uint16_t type)
+{
+    uint16_t saved_len = w->len;
+    uint8_t saved_labels = w->label_count;
+    uint8_t saved_pointers = w->pointer_count;
+
+    if (!RTNET_mDNS_PutName(w, name) || !RTNET_mDNS_Room(w, 4U)) {
+        w->len = saved_len;
+        w->label_count = saved_labels;
+        w->pointer_count = saved_pointers;
+        return false;
+    }
+
+    RTNET_Write16(&w->msg[w->len], type);
+    RTNET_Write16(&w->msg[w->len + 2U], MDNS_CLASS_IN);
+    w->len = (uint16_t)(w->len + 4U);
+    w->counts[MDNS_SECTION_QD]++;
+    return true;
+}
+
+/**
+ * @brief Append a resource record, whole or not at all
+ * @param rdata Fixed leading RDATA bytes (may be NULL when rdata_len is 0)
+ * @param rdata_name Name closing the RDATA, MDNS_NAME_NONE if none
+ */
+static bool RTNET_mDNS_PutRecord(RTNET_mDNSWriter_t* w, uint8_t section, uint8_t name,
+                                 uint16_t type, bool flush, uint32_t ttl_s,
+                                 const uint8_t* rdata, uint16_t rdata_len, uint8_t rdata_name)
+{
+    uint16_t saved_len = w->len;
+    uint8_t saved_labels = w->label_count;
+    uint8_t saved_pointers = w->pointer_count;
+    bool ok = RTNET_mDNS_PutName(w, name) && RTNET_mDNS_Room(w, (uint16_t)(10U + rdata_len));
+
+    if (ok) {
+        uint16_t rr = w->len;
+        RTNET_Write16(&w->msg[rr], type);
+        RTNET_Write16(&w->msg[rr + 2U],
+                      (uint16_t)(MDNS_CLASS_IN | (flush ? MDNS_CLASS_TOP_BIT : 0U)));
+        RTNET_Write32(&w->msg[rr + 4U], ttl_s);
+        if (rdata_len != 0U) {
+            memcpy(&w->msg[rr + 10U], rdata, rdata_len);
+        }
+        w->len = (uint16_t)(rr + 10U + rdata_len);
+
+        ok = (rdata_name == MDNS_NAME_NONE) || RTNET_mDNS_PutName(w, rdata_name);
+        if (ok) {
+            RTNET_Write16(&w->msg[rr + 8U], (uint16_t)(w->len - rr - 10U));
+            w->counts[section]++;
+        }
+    }
+
+    if (!ok) {
+        w->len = saved_len;
+        w->label_count = saved_labels;
+        w->pointer_count = saved_pointers;
+    }
+    return ok;
+}
+
+static bool RTNET_mDNS_PutCached(RTNET_mDNSWriter_t* w, const RTNET_mDNSCacheEntry_t* entry,
+                                 uint32_t ttl_s)
+{
+    uint8_t srv[6] = {0U, 0U, 0U, 0U, 0U, 0U};
+
+    switch (entry->type) {
+        case RTNET_MDNS_TYPE_PTR:
+            return RTNET_mDNS_PutRecord(w, MDNS_SECTION_AN, entry->name, entry->type, false,
+                                        ttl_s, NULL, 0U, entry->target);
+        case RTNET_MDNS_TYPE_SRV:
+            RTNET_Write16(&srv[4], entry->port);
+            return RTNET_mDNS_PutRecord(w, MDNS_SECTION_AN, entry->name, entry->type, false,
+                                        ttl_s, srv, sizeof(srv), entry->target);
+        default:
+            return RTNET_mDNS_PutRecord(w, MDNS_SECTION_AN, entry->name, entry->type, false,
+                                        ttl_s, entry->addr.addr, 16U, MDNS_NAME_NONE);
+    }
+}
+
+/**
+ * @brief Append one record of a published service (or the host AAAA)
+ * @param what MDNS_ANS_* bit, 0 = host AAAA
+ */
+static bool RTNET_mDNS_PutService(RTNET_mDNSWriter_t* w, uint8_t section,
+                                  const RTNET_mDNSService_t* svc, uint8_t what)
+{
+    const RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+    uint8_t srv[6] = {0U, 0U, 0U, 0U, 0U, 0U};
+    const uint8_t txt_empty = 0U;
+
+    switch (what) {
+        case MDNS_ANS_PTR:
+            return RTNET_mDNS_PutRecord(w, section, svc->type_name, RTNET_MDNS_TYPE_PTR, false,
+                                        svc->ttl_s, NULL, 0U, svc->instance);
+        case MDNS_ANS_SRV:
+            RTNET_Write16(&srv[4], svc->port);
+            return RTNET_mDNS_PutRecord(w, section, svc->instance, RTNET_MDNS_TYPE_SRV, true,
+                                        svc->ttl_s, srv, sizeof(srv), mdns->host);
+        case MDNS_ANS_TXT:
+            return RTNET_mDNS_PutRecord(w, section, svc->instance, RTNET_MDNS_TYPE_TXT, true,
+                                        svc->ttl_s, &txt_empty, 1U, MDNS_NAME_NONE);
+        default:
+            return RTNET_mDNS_PutRecord(w, section, mdns->host, RTNET_MDNS_TYPE_AAAA, true,
+                                        MDNS_HOST_TTL_S, g_RTNET_Ctx->local_ipv6.addr, 16U,
+                                        MDNS_NAME_NONE);
+    }
+}
+
+/* ==================== SERVICE TEMPLATES ==================== */
+
+/**
+ * @brief Offset just past a name written by this engine
+ */
+static uint16_t RTNET_mDNS_SkipName(const uint8_t* msg, uint16_t pos)
+{
+    while ((msg[pos] != 0U) && ((msg[pos] & 0xC0U) != 0xC0U)) {
+        pos = (uint16_t)(pos + msg[pos] + 1U);
+    }
+    return (uint16_t)(pos + ((msg[pos] == 0U) ? 1U : 2U));
+}
+
+/**
+ * @brief Template record holding a message offset of the compiled template
+ */
+static uint8_t RTNET_mDNS_RecordAt(const RTNET_mDNSService_t* svc, uint16_t pos)
+{
+    uint8_t r = 0U;
+
+    pos = (uint16_t)(pos - MDNS_HEADER_LEN);
+    while (((r + 1U) < RTNET_MDNS_TEMPLATE_RECORDS) && (pos >= svc->records[r + 1U].offset)) {
+        r++;
+    }
+    return r;
+}
+
+/**
+ * @brief Encode the PTR, SRV, TXT and AAAA records of a service once
+ * @return false if they do not fit RTNET_MDNS_TEMPLATE_SIZE
+ * @note Names are compressed across the four records; each pointer is
+ *       kept as a fix-up against the record it leads into, so any subset
+ *       closed under RTNET_mDNSTemplateRR_t.deps can be copied anywhere
+ */
+static bool RTNET_mDNS_Compile(RTNET_mDNSService_t* svc)
+{
+    static const uint8_t what[RTNET_MDNS_TEMPLATE_RECORDS] = {
+        MDNS_ANS_PTR, MDNS_ANS_SRV, MDNS_ANS_TXT, 0U
+    };
+    uint8_t scratch[MDNS_HEADER_LEN + RTNET_MDNS_TEMPLATE_SIZE];
+    RTNET_mDNSWriter_t w;
+
+    w.buffer = NULL;
+    RTNET_mDNS_WriterInit(&w, scratch, (uint16_t)sizeof(scratch), 0U);
+
+    for (uint8_t r = 0U; r < RTNET_MDNS_TEMPLATE_RECORDS; r++) {
+        RTNET_mDNSTemplateRR_t* rec = &svc->records[r];
+        uint16_t start = w.len;
+        if (!RTNET_mDNS_PutService(&w, MDNS_SECTION_AN, svc, what[r])) {
+            return false;
+        }
+        rec->offset = (uint16_t)(start - MDNS_HEADER_LEN);
+        rec->length = (uint16_t)(w.len - start);
+        rec->ttl_pos = (uint16_t)(RTNET_mDNS_SkipName(scratch, start) + 4U - start);
+        rec->deps = 0U;
+    }
+
+    /* At most two names per record, so every pointer was recorded */
+    svc->fixup_count = 0U;
+    for (uint8_t i = 0U; i < w.pointer_count; i++) {
+        RTNET_mDNSTemplateFixup_t* fix = &svc->fixups[svc->fixup_count];
+        uint16_t pos = w.pointer_pos[i];
+        uint16_t target = (uint16_t)(RTNET_Read16(&scratch[pos]) & 0x3FFFU);
+
+        fix->record = RTNET_mDNS_RecordAt(svc, pos);
+        fix->target = RTNET_mDNS_RecordAt(svc, target);
+        fix->pos = (uint16_t)(pos - MDNS_HEADER_LEN - svc->records[fix->record].offset);
+        fix->target_off = (uint16_t)(target - MDNS_HEADER_LEN - svc->records[fix->target].offset);
+        if (fix->target != fix->record) {
+            svc->records[fix->record].deps |= (uint8_t)(1U << fix->target);
+        }
+        svc->fixup_count++;
+    }
+
+    memcpy(svc->tmpl, &scratch[MDNS_HEADER_LEN], (size_t)w.len - MDNS_HEADER_LEN);
+    return true;
+}
+
+/**
+ * @brief Add the records a set of template records points into
+ */
+static uint8_t RTNET_mDNS_Closure(const RTNET_mDNSService_t* svc, uint8_t mask)
+{
+    /* Pointers only lead backwards: one pass from the last record */
+    for (uint8_t r = RTNET_MDNS_TEMPLATE_RECORDS; r > 0U; r--) {
+        if ((mask & (1U << (r - 1U))) != 0U) {
+            mask |= svc->records[r - 1U].deps;
+        }
+    }
+    return mask;
+}
+
+/**
+ * @brief Copy template records into a message, rewriting their pointers
+ * @param mask Records to copy (MDNS_ANS_* bits)
+ * @param goodbye Send with TTL 0
+ * @param out_pos [IN/OUT] Message offset of each record of the service
+ * @param written [IN/OUT] Records of the service already in the message
+ * @note A record is left out when it does not fit or a record it points
+ *       into was left out
+ */
+static void RTNET_mDNS_PutTemplate(RTNET_mDNSWriter_t* w, uint8_t section,
+                                   const RTNET_mDNSService_t* svc, uint8_t mask, bool goodbye,
+                                   uint16_t* out_pos, uint8_t* written)
+{
+    for (uint8_t r = 0U; r < RTNET_MDNS_TEMPLATE_RECORDS; r++) {
+        const RTNET_mDNSTemplateRR_t* rec = &svc->records[r];
+        uint8_t bit = (uint8_t)(1U << r);
+        if (((mask & bit) == 0U) || ((*written & bit) != 0U) ||
+            ((rec->deps & (uint8_t)~*written) != 0U) || !RTNET_mDNS_Room(w, rec->length)) {
+            continue;
+        }
+
+        uint8_t* out = &w->msg[w->len];
+        out_pos[r] = w->len;
+        memcpy(out, &svc->tmpl[rec->offset], rec->length);
+        for (uint8_t i = 0U; i < svc->fixup_count; i++) {
+            const RTNET_mDNSTemplateFixup_t* fix = &svc->fixups[i];
+            if (fix->record == r) {
+                RTNET_Write16(&out[fix->pos],
+                              (uint16_t)(0xC000U | (out_pos[fix->target] + fix->target_off)));
+            }
+        }
+        if (goodbye) {
+            RTNET_Write32(&out[rec->ttl_pos], 0U);
+        }
+        if (r == MDNS_RECORD_AAAA) {
+            /* The address may have changed since Announce */
+            memcpy(&out[rec->length - 16U], g_RTNET_Ctx->local_ipv6.addr, 16U);
+        }
+
+        *written |= bit;
+        w->len = (uint16_t)(w->len + rec->length);
+        w->counts[section]++;
+    }
+}
+
+/* ==================== QUERIER ==================== */
+
+/**
+ * @brief Schedule the next transmission of a question sent now
+ */
+static void RTNET_mDNS_Sent(RTNET_mDNSQuestion_t* q, uint32_t now)
+{
+    q->next_send_ms = now + q->interval_ms;
+    q->interval_ms = (q->interval_ms >= (MDNS_MAX_INTERVAL_MS / 2U)) ?
+                     MDNS_MAX_INTERVAL_MS : (2U * q->interval_ms);
+}
+
+/**
+ * @brief Send the due questions, grouped with those due shortly after
+ * @note Known answers follow all the questions of a packet; questions
+ *       that do not fit go out in a further packet
+ */
+static void RTNET_mDNS_SendDue(uint32_t now)
+{
+    RTNET_mDNSQuestion_t* questions = g_RTNET_Ctx->mdns.questions;
+    uint32_t due = 0U;
+    uint32_t group = 0U;
+
+    for (uint8_t i = 0U; i < RTNET_MDNS_MAX_QUESTIONS; i++) {
+        if (questions[i].in_use) {
+            if (RTNET_mDNS_Due(now, questions[i].next_send_ms)) {
+                due |= (1UL << i);
+            }
+            if (RTNET_mDNS_Due(now + MDNS_GROUP_WINDOW_MS, questions[i].next_send_ms)) {
+                group |= (1UL << i);
+            }
+        }
+    }
+
+    while (due != 0U) {
+        RTNET_mDNSWriter_t w;
+        uint32_t sent = 0U;
+
+        if (!RTNET_mDNS_WriterOpen(&w, 0U)) {
+            return;
+        }
+
+        for (uint8_t i = 0U; i < RTNET_MDNS_MAX_QUESTIONS; i++) {
+            if (((group & (1UL << i)) != 0U) &&
+                RTNET_mDNS_PutQuestion(&w, questions[i].name, questions[i].type)) {
+                sent |= (1UL << i);
+            }
+        }
+
+        bool full = false;
+        for (uint8_t i = 0U; (i < RTNET_MDNS_MAX_QUESTIONS) && !full; i++) {
+            if ((sent & (1UL << i)) == 0U) {
+                continue;
+            }
+            uint8_t id = RTNET_mDNS_CacheFirst(questions[i].name, questions[i].type);
+            while ((id != MDNS_CACHE_NONE) && !full) {
+                const RTNET_mDNSCacheEntry_t* entry = &g_RTNET_Ctx->mdns.cache[id];
+                full = RTNET_mDNS_CacheFresh(entry, now) &&
+                       !RTNET_mDNS_PutCached(&w, entry, (entry->expires_ms - now) / 1000U);
+                id = RTNET_mDNS_CacheNext(entry->next, questions[i].name, questions[i].type);
+            }
+        }
+
+        RTNET_mDNS_WriterSend(&w);
+        if (sent == 0U) {
+            return;
+        }
+
+        for (uint8_t i = 0U; i < RTNET_MDNS_MAX_QUESTIONS; i++) {
+            if ((sent & (1UL << i)) != 0U) {
+                RTNET_mDNS_Sent(&questions[i], now);
+            }
+        }
+        due &= ~sent;
+        group &= ~sent;
+    }
+}
+
+/**
+ * @brief Keep asking (name, type); a new question is due at once
+ * @return Question, NULL if all RTNET_MDNS_MAX_QUESTIONS are taken
+ */
+static RTNET_mDNSQuestion_t* RTNET_mDNS_Ask(uint8_t name, uint16_t type, uint32_t now)
+{
+    RTNET_mDNSQuestion_t* free_q = NULL;
+
+    for (uint8_t i = 0U; i < RTNET_MDNS_MAX_QUESTIONS; i++) {
+        RTNET_mDNSQuestion_t* q = &g_RTNET_Ctx->mdns.questions[i];
+        if (!q->in_use) {
+            if (free_q == NULL) {
+                free_q = q;
+            }
+        } else if ((q->name == name) && (q->type == type)) {
+            q->expires_ms = now + MDNS_QUESTION_LIFETIME_MS;
+            return q;
+        }
+    }
+
+    if (free_q != NULL) {
+        g_RTNET_Ctx->mdns.names[name].refs++;
+        free_q->name = name;
+        free_q->type = type;
+        free_q->next_send_ms = now;
+        free_q->interval_ms = MDNS_FIRST_INTERVAL_MS;
+        free_q->expires_ms = now + MDNS_QUESTION_LIFETIME_MS;
+        free_q->continuous = false;
+        free_q->in_use = true;
+    }
+    return free_q;
+}
+
+/**
+ * @brief Report newly resolved instances of every browse; ask for the
+ *        missing links of the others
+ */
+static void RTNET_mDNS_EvaluateBrowses(uint32_t now)
+{
+    RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+
+    for (uint8_t i = 0U; i < RTNET_MDNS_MAX_BROWSES; i++) {
+        if (!mdns->browses[i].in_use) {
+            continue;
+        }
+        uint8_t type_name = mdns->browses[i].type_name;
+        uint8_t ptr = RTNET_mDNS_CacheFirst(type_name, RTNET_MDNS_TYPE_PTR);
+
+        while (ptr != MDNS_CACHE_NONE) {
+            /* A callback may stop the browse or drop entries: fetch next first */
+            uint8_t next = RTNET_mDNS_CacheNext(mdns->cache[ptr].next, type_name,
+                                                RTNET_MDNS_TYPE_PTR);
+            if (!mdns->cache[ptr].reported) {
+                RTNET_mDNSRecord_t record;
+                uint8_t missing;
+                uint16_t missing_type;
+
+                if (RTNET_mDNS_FillRecord(ptr, &record, &missing, &missing_type)) {
+                    mdns->cache[ptr].reported = true;
+                    mdns->browses[i].callback(i, RTNET_MDNS_INSTANCE_ADDED, &record);
+                    if (!mdns->browses[i].in_use) {
+                        break;
+                    }
+                } else {
+                    (void)RTNET_mDNS_Ask(missing, missing_type, now);
+                }
+            }
+            ptr = next;
+        }
+    }
+}
+
+/**
+ * @brief Return the first instance of a service type resolved down to
+ *        its address
+ * @return RTNET_OK with result filled, RTNET_ERR_TIMEOUT after asking for
+ *         the first missing link
+ */
+static RTNET_Error_t RTNET_mDNS_Resolve(uint8_t type_name, RTNET_mDNSRecord_t* result,
+                                        uint32_t now)
+{
+    const RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+    uint8_t first_missing = MDNS_NAME_NONE;
+    uint16_t first_missing_type = 0U;
+
+    uint8_t ptr = RTNET_mDNS_CacheFirst(type_name, RTNET_MDNS_TYPE_PTR);
+    while (ptr != MDNS_CACHE_NONE) {
+        uint8_t missing;
+        uint16_t missing_type;
+
+        if (RTNET_mDNS_FillRecord(ptr, result, &missing, &missing_type)) {
+            return RTNET_OK;
+        }
+        if (first_missing == MDNS_NAME_NONE) {
+            first_missing = missing;
+            first_missing_type = missing_type;
+        }
+        ptr = RTNET_mDNS_CacheNext(mdns->cache[ptr].next, type_name, RTNET_MDNS_TYPE_PTR);
+    }
+
+    memset(result, 0, sizeof(RTNET_mDNSRecord_t));
+    (void)RTNET_mDNS_Ask(type_name, RTNET_MDNS_TYPE_PTR, now);
+    if (first_missing != MDNS_NAME_NONE) {
+        (void)RTNET_mDNS_Ask(first_missing, first_missing_type, now);
+    }
+    RTNET_mDNS_SendDue(now);
+
+    return RTNET_ERR_TIMEOUT;
+}
+
+/* ==================== RESPONDER ==================== */
+
+static bool RTNET_mDNS_IsKnown(const RTNET_mDNSKnown_t* known, uint8_t count, uint8_t name,
+                               uint16_t type, uint8_t target, uint32_t ttl_s)
+{
+    for (uint8_t i = 0U; i < count; i++) {
+        const RTNET_mDNSKnown_t* k = &known[i];
+        if ((k->name == name) && (k->type == type) && (k->ttl_s >= (ttl_s / 2U)) &&
+            ((type != RTNET_MDNS_TYPE_PTR) || (k->target == target)) &&
+            ((type != RTNET_MDNS_TYPE_AAAA) ||
+             (memcmp(k->addr.addr, g_RTNET_Ctx->local_ipv6.addr, 16U) == 0))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Treat our pending question as sent when another host just asked
+ *        it with no known answer we lack (RFC 6762 7.3)
+ */
+static void RTNET_mDNS_SuppressDuplicates(const RTNET_mDNSRxQuestion_t* rxq, uint8_t nq,
+                                          const RTNET_mDNSKnown_t* known, uint8_t nk,
+                                          uint32_t now)
+{
+    for (uint8_t i = 0U; i < nq; i++) {
+        if (rxq[i].unicast) {
+            continue;
+        }
+        for (uint8_t j = 0U; j < RTNET_MDNS_MAX_QUESTIONS; j++) {
+            RTNET_mDNSQuestion_t* q = &g_RTNET_Ctx->mdns.questions[j];
+            if (!q->in_use || (q->name != rxq[i].name) || (q->type != rxq[i].type)) {
+                continue;
+            }
+
+            bool covered = true;
+            for (uint8_t k = 0U; (k < nk) && covered; k++) {
+                if ((known[k].name == q->name) && (known[k].type == q->type)) {
+                    uint8_t id = RTNET_mDNS_CacheMatch(q->name, q->type, known[k].target,
+                                                       &known[k].addr);
+                    covered = (id != MDNS_CACHE_NONE) &&
+                              RTNET_mDNS_CacheFresh(&g_RTNET_Ctx->mdns.cache[id], now);
+                }
+            }
+            if (covered) {
+                RTNET_mDNS_Sent(q, now);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Answer the questions of a query from the published services
+ */
+static void RTNET_mDNS_Respond(const RTNET_mDNSRxQuestion_t* rxq, uint8_t nq,
+                               const RTNET_mDNSKnown_t* known, uint8_t nk)
+{
+    const RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+    uint8_t answer[RTNET_MDNS_MAX_SERVICES];
+    uint8_t extra[RTNET_MDNS_MAX_SERVICES];
+    bool host_answer = false;
+    bool host_extra = false;
+    bool any = false;
+
+    memset(answer, 0, sizeof(answer));
+    memset(extra, 0, sizeof(extra));
+
+    for (uint8_t i = 0U; i < nq; i++) {
+        uint16_t type = rxq[i].type;
+        bool any_type = (type == RTNET_MDNS_TYPE_ANY);
+
+        for (uint8_t s = 0U; s < RTNET_MDNS_MAX_SERVICES; s++) {
+            const RTNET_mDNSService_t* svc = &mdns->services[s];
+            if (!svc->in_use) {
+                continue;
+            }
+            if ((rxq[i].name == svc->type_name) && (any_type || (type == RTNET_MDNS_TYPE_PTR))) {
+                answer[s] |= MDNS_ANS_PTR;
+            }
+            if (rxq[i].name == svc->instance) {
+                if (any_type || (type == RTNET_MDNS_TYPE_SRV)) {
+                    answer[s] |= MDNS_ANS_SRV;
+                }
+                if (any_type || (type == RTNET_MDNS_TYPE_TXT)) {
+                    answer[s] |= MDNS_ANS_TXT;
+                }
+            }
+        }
+        if ((rxq[i].name == mdns->host) && (any_type || (type == RTNET_MDNS_TYPE_AAAA))) {
+            host_answer = true;
+        }
+    }
+
+    /* Additional records (RFC 6763 12), then known-answer suppression */
+    for (uint8_t s = 0U; s < RTNET_MDNS_MAX_SERVICES; s++) {
+        const RTNET_mDNSService_t* svc = &mdns->services[s];
+        if ((answer[s] & MDNS_ANS_PTR) != 0U) {
+            extra[s] = (uint8_t)((MDNS_ANS_SRV | MDNS_ANS_TXT) & ~answer[s]);
+        }
+        if (((answer[s] | extra[s]) & MDNS_ANS_SRV) != 0U) {
+            host_extra = true;
+        }
+
+        if (((answer[s] & MDNS_ANS_PTR) != 0U) &&
+            RTNET_mDNS_IsKnown(known, nk, svc->type_name, RTNET_MDNS_TYPE_PTR,
+                               svc->instance, svc->ttl_s)) {
+            /* The querier has the PTR: its additionals go too */
+            answer[s] &= (uint8_t)~MDNS_ANS_PTR;
+            extra[s] = 0U;
+        }
+        if ((((answer[s] | extra[s]) & MDNS_ANS_SRV) != 0U) &&
+            RTNET_mDNS_IsKnown(known, nk, svc->instance, RTNET_MDNS_TYPE_SRV,
+                               MDNS_NAME_NONE, svc->ttl_s)) {
+            answer[s] &= (uint8_t)~MDNS_ANS_SRV;
+            extra[s] &= (uint8_t)~MDNS_ANS_SRV;
+        }
+        if ((((answer[s] | extra[s]) & MDNS_ANS_TXT) != 0U) &&
+            RTNET_mDNS_IsKnown(known, nk, svc->instance, RTNET_MDNS_TYPE_TXT,
+                               MDNS_NAME_NONE, svc->ttl_s)) {
+            answer[s] &= (uint8_t)~MDNS_ANS_TXT;
+            extra[s] &= (uint8_t)~MDNS_ANS_TXT;
+        }
+        any = any || (answer[s] != 0U);
+    }
+    if ((host_answer || host_extra) &&
+        RTNET_mDNS_IsKnown(known, nk, mdns->host, RTNET_MDNS_TYPE_AAAA,
+                           MDNS_NAME_NONE, MDNS_HOST_TTL_S)) {
+        host_answer = false;
+        host_extra = false;
+    }
+    any = any || host_answer;
+
+    RTNET_mDNSWriter_t w;
+    if (!any || !RTNET_mDNS_WriterOpen(&w, MDNS_FLAG_RESPONSE | MDNS_FLAG_AUTHORITATIVE)) {
+        return;
+    }
+
+    /* The host AAAA goes with the first SRV of its section and shares its
+     * name; records the answers point into become answers themselves */
+    bool carried = false;
+    for (uint8_t s = 0U; s < RTNET_MDNS_MAX_SERVICES; s++) {
+        const RTNET_mDNSService_t* svc = &mdns->services[s];
+        if (!carried && host_answer && ((answer[s] & MDNS_ANS_SRV) != 0U)) {
+            answer[s] |= MDNS_ANS_AAAA;
+            carried = true;
+        } else if (!carried && host_extra && !host_answer &&
+                   (((answer[s] | extra[s]) & MDNS_ANS_SRV) != 0U)) {
+            extra[s] |= MDNS_ANS_AAAA;
+            carried = true;
+        }
+        uint8_t an = RTNET_mDNS_Closure(svc, answer[s]);
+        extra[s] = (uint8_t)(RTNET_mDNS_Closure(svc, (uint8_t)(answer[s] | extra[s])) & ~an);
+        answer[s] = an;
+    }
+
+    uint16_t out_pos[RTNET_MDNS_MAX_SERVICES][RTNET_MDNS_TEMPLATE_RECORDS];
+    uint8_t written[RTNET_MDNS_MAX_SERVICES];
+    memset(written, 0, sizeof(written));
+
+    for (uint8_t s = 0U; s < RTNET_MDNS_MAX_SERVICES; s++) {
+        RTNET_mDNS_PutTemplate(&w, MDNS_SECTION_AN, &mdns->services[s], answer[s], false,
+                               out_pos[s], &written[s]);
+    }
+    if (host_answer && !carried) {
+        (void)RTNET_mDNS_PutService(&w, MDNS_SECTION_AN, NULL, 0U);
+    }
+    for (uint8_t s = 0U; s < RTNET_MDNS_MAX_SERVICES; s++) {
+        RTNET_mDNS_PutTemplate(&w, MDNS_SECTION_AR, &mdns->services[s], extra[s], false,
+                               out_pos[s], &written[s]);
+    }
+    if (host_extra && !host_answer && !carried) {
+        (void)RTNET_mDNS_PutService(&w, MDNS_SECTION_AR, NULL, 0U);
+    }
+
+    RTNET_mDNS_WriterSend(&w);
+}
+
+/**
+ * @brief Unsolicited response with every record of a service (RFC 6762 8.3)
+ * @param goodbye Withdraw the service records instead (RFC 6762 10.1)
+ */
+static void RTNET_mDNS_SendAnnouncement(const RTNET_mDNSService_t* svc, bool goodbye)
+{
+    uint16_t out_pos[RTNET_MDNS_TEMPLATE_RECORDS];
+    uint8_t written = 0U;
+    RTNET_mDNSWriter_t w;
+
+    if (!RTNET_mDNS_WriterOpen(&w, MDNS_FLAG_RESPONSE | MDNS_FLAG_AUTHORITATIVE)) {
+        return;
+    }
+
+    /* Other services still use the host address */
+    uint8_t mask = goodbye ? (uint8_t)(MDNS_ANS_PTR | MDNS_ANS_SRV | MDNS_ANS_TXT) : 0x0FU;
+    RTNET_mDNS_PutTemplate(&w, MDNS_SECTION_AN, svc, mask, goodbye, out_pos, &written);
+
+    RTNET_mDNS_WriterSend(&w);
+}
+
+static void RTNET_mDNS_AnnounceDue(uint32_t now)
+{
+    for (uint8_t i = 0U; i < RTNET_MDNS_MAX_SERVICES; i++) {
+        RTNET_mDNSService_t* svc = &g_RTNET_Ctx->mdns.services[i];
+        if (svc->in_use && (svc->announce_left > 0U) &&
+            RTNET_mDNS_Due(now, svc->next_announce_ms)) {
+            RTNET_mDNS_SendAnnouncement(svc, false);
+            svc->announce_left--;
+            svc->next_announce_ms = now + MDNS_ANNOUNCE_INTERVAL_MS;
+        }
+    }
+}
+
+/* ==================== RECEIVE ==================== */
+
+static void RTNET_mDNS_HandleResponse(const uint8_t* msg, uint16_t len, uint32_t now)
+{
+    RTNET_mDNSRR_t rr;
+    uint16_t pos = MDNS_HEADER_LEN;
+    uint16_t qd = RTNET_Read16(&msg[4]);
+    uint16_t an = RTNET_Read16(&msg[6]);
+    uint16_t ns = RTNET_Read16(&msg[8]);
+    uint16_t ar = RTNET_Read16(&msg[10]);
+
+    for (uint16_t i = 0U; i < qd; i++) {
+        if (!RTNET_mDNS_ReadName(msg, len, &pos, rr.owner, &rr.owner_len) ||
+            ((uint32_t)pos + 4U > len)) {
+            return;
+        }
+        pos = (uint16_t)(pos + 4U);
+    }
+
+    uint32_t records = (uint32_t)an + ns + ar;
+    for (uint32_t i = 0U; i < records; i++) {
+        if (!RTNET_mDNS_ReadRR(msg, len, &pos, &rr)) {
+            break;
+        }
+        /* Authority records only matter to probing hosts */
+        if ((i < an) || (i >= ((uint32_t)an + ns))) {
+            RTNET_mDNS_CacheStore(&rr, now);
+        }
+    }
+
+    RTNET_mDNS_EvaluateBrowses(now);
+    RTNET_mDNS_SendDue(now);
+}
+
+static void RTNET_mDNS_HandleQuery(const uint8_t* msg, uint16_t len, uint32_t now)
+{
+    RTNET_mDNSRxQuestion_t rxq[MDNS_RX_MAX_QUESTIONS];
+    RTNET_mDNSKnown_t known[MDNS_RX_MAX_KNOWN];
+    RTNET_mDNSRR_t rr;
+    uint8_t nq = 0U;
+    uint8_t nk = 0U;
+    uint16_t pos = MDNS_HEADER_LEN;
+    uint16_t qd = RTNET_Read16(&msg[4]);
+    uint16_t an = RTNET_Read16(&msg[6]);
+
+    for (uint16_t i = 0U; i < qd; i++) {
+        if (!RTNET_mDNS_ReadName(msg, len, &pos, rr.owner, &rr.owner_len) ||
+            ((uint32_t)pos + 4U > len)) {
+            return;
+        }
+        uint8_t name = RTNET_mDNS_NameLookup(rr.owner, rr.owner_len);
+        if ((name != MDNS_NAME_NONE) && (nq < MDNS_RX_MAX_QUESTIONS)) {
+            rxq[nq].name = name;
+            rxq[nq].type = RTNET_Read16(&msg[pos]);
+            rxq[nq].unicast = ((RTNET_Read16(&msg[pos + 2U]) & MDNS_CLASS_TOP_BIT) != 0U);
+            nq++;
+        }
+        pos = (uint16_t)(pos + 4U);
+    }
+
+    if (nq == 0U) {
+        return;
+    }
+
+    /* Known answers: a name we do not know cannot match anything of ours */
+    for (uint16_t i = 0U; i < an; i++) {
+        if (!RTNET_mDNS_ReadRR(msg, len, &pos, &rr)) {
+            return;
+        }
+        uint8_t name = RTNET_mDNS_NameLookup(rr.owner, rr.owner_len);
+        if ((name != MDNS_NAME_NONE) && (nk < MDNS_RX_MAX_KNOWN)) {
+            known[nk].name = name;
+            known[nk].type = rr.type;
+            known[nk].ttl_s = rr.ttl_s;
+            known[nk].target = (rr.target_len != 0U) ?
+                               RTNET_mDNS_NameLookup(rr.target, rr.target_len) : MDNS_NAME_NONE;
+            memcpy(&known[nk].addr, &rr.addr, sizeof(RTNET_IPv6Addr_t));
+            nk++;
+        }
+    }
+
+    RTNET_mDNS_SuppressDuplicates(rxq, nq, known, nk, now);
+    RTNET_mDNS_Respond(rxq, nq, known, nk);
+}
+
+/**
+ * @brief UDP 5353 handler
+ */
+static void RTNET_mDNS_Receive(const RTNET_RxView_t* view)
+{
+    const uint8_t* msg = view->payload;
+
+    if ((view->src_port != MDNS_PORT) || (view->payload_len < MDNS_HEADER_LEN)) {
+        return;
+    }
+
+    uint16_t flags = RTNET_Read16(&msg[2]);
+    if ((flags & MDNS_OPCODE_MASK) != 0U) {
+        return;
+    }
+
+    uint32_t now = RTNET_GetTimeMs();
+    if ((flags & MDNS_FLAG_RESPONSE) != 0U) {
+        if ((flags & MDNS_RCODE_MASK) == 0U) {
+            RTNET_mDNS_HandleResponse(msg, view->payload_len, now);
+        }
+    } else {
+        RTNET_mDNS_HandleQuery(msg, view->payload_len, now);
+    }
+}
+
+/**
+ * @brief Bind UDP 5353 and name the host, on first use
+ */
+static RTNET_Error_t RTNET_mDNS_Start(void)
+{
+    RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+    static const char hex[] = "0123456789abcdef";
+
+    if (mdns->bound) {
+        return RTNET_OK;
+    }
+
+    RTNET_Error_t err = RTNET_UDP_Bind(MDNS_PORT, RTNET_mDNS_Receive, &mdns->socket_id);
+    if (err != RTNET_OK) {
+        return err;
+    }
+
+    /* "rtnet-XXXXXX.local" from the low MAC bytes */
+    uint8_t wire[MDNS_HOST_LABEL_LEN + 8U];
+    wire[0] = MDNS_HOST_LABEL_LEN;
+    memcpy(&wire[1], MDNS_HOST_PREFIX, sizeof(MDNS_HOST_PREFIX) - 1U);
+    for (uint8_t i = 0U; i < 3U; i++) {
+        uint8_t b = g_RTNET_Ctx->local_mac.addr[3U + i];
+        wire[7U + (2U * i)] = (uint8_t)hex[b >> 4U];
+        wire[8U + (2U * i)] = (uint8_t)hex[b & 0x0FU];
+    }
+    memcpy(&wire[MDNS_HOST_LABEL_LEN + 1U], "\005local", 7U);
+
+    mdns->host = RTNET_mDNS_NameIntern(wire, (uint8_t)sizeof(wire));
+    mdns->bound = true;
+    return RTNET_OK;
+}
+
+/* ==================== PUBLIC API ==================== */
+
+void RTNET_mDNS_Init(void)
+{
+    RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+
+    memset(mdns, 0, sizeof(RTNET_mDNS_t));
+    memset(mdns->name_hash, MDNS_NAME_NONE, sizeof(mdns->name_hash));
+    memset(mdns->cache_hash, MDNS_CACHE_NONE, sizeof(mdns->cache_hash));
+
+    for (uint8_t i = 0U; i < RTNET_MDNS_MAX_NAMES; i++) {
+        mdns->names[i].next = (uint8_t)(i + 1U);
+    }
+    for (uint8_t i = 0U; i < RTNET_MAX_MDNS_CACHE; i++) {
+        mdns->cache[i].next = (uint8_t)(i + 1U);
+    }
+    mdns->name_free = 0U;
+    mdns->cache_free = 0U;
+    mdns->host = MDNS_NAME_NONE;
+}
+
+void RTNET_mDNS_Periodic(uint32_t now)
+{
+    RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+
+    while ((mdns->heap_count > 0U) &&
+           RTNET_mDNS_Due(now, mdns->cache[mdns->heap[0]].expires_ms)) {
+        RTNET_mDNS_CacheRemove(mdns->heap[0]);
+    }
+
+    for (uint8_t i = 0U; i < RTNET_MDNS_MAX_QUESTIONS; i++) {
+        RTNET_mDNSQuestion_t* q = &mdns->questions[i];
+        if (q->in_use && !q->continuous && RTNET_mDNS_Due(now, q->expires_ms)) {
+            q->in_use = false;
+            RTNET_mDNS_NameRelease(q->name);
+        }
+    }
+
+    RTNET_mDNS_SendDue(now);
+    RTNET_mDNS_AnnounceDue(now);
+}
+
+RTNET_Error_t RTNET_mDNS_Query(const char* service_name,
+                                RTNET_mDNSRecord_t* result)
+{
+    uint8_t wire[RTNET_MDNS_MAX_NAME_LEN];
+    uint8_t wire_len = 0U;
+
+    if ((service_name == NULL) || (result == NULL) || !g_RTNET_Ctx->initialized) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    memset(result, 0, sizeof(RTNET_mDNSRecord_t));
+
+    if (!RTNET_mDNS_FromText(service_name, wire, sizeof(wire), &wire_len)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    RTNET_Error_t err = RTNET_mDNS_Start();
+    if (err != RTNET_OK) {
+        return err;
+    }
+
+    uint8_t type_name = RTNET_mDNS_NameIntern(wire, wire_len);
+    if (type_name == MDNS_NAME_NONE) {
+        return RTNET_ERR_OVERFLOW;
+    }
+
+    err = RTNET_mDNS_Resolve(type_name, result, RTNET_GetTimeMs());
+    RTNET_mDNS_NameRelease(type_name);
+
+    return err;
+}
+
+RTNET_Error_t RTNET_mDNS_BrowseStart(const char* service_type,
+                                      RTNET_mDNSBrowseCallback_t callback,
+                                      uint8_t* browse_id)
+{
+    RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+    uint8_t wire[RTNET_MDNS_MAX_NAME_LEN];
+    uint8_t wire_len = 0U;
+
+    if ((service_type == NULL) || (callback == NULL) || (browse_id == NULL) ||
+        !g_RTNET_Ctx->initialized) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    if (!RTNET_mDNS_FromText(service_type, wire, sizeof(wire), &wire_len)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    RTNET_Error_t err = RTNET_mDNS_Start();
+    if (err != RTNET_OK) {
+        return err;
+    }
+
+    uint8_t type_name = RTNET_mDNS_NameIntern(wire, wire_len);
+    if (type_name == MDNS_NAME_NONE) {
+        return RTNET_ERR_OVERFLOW;
+    }
+
+    RTNET_mDNSBrowse_t* browse = NULL;
+    uint8_t id = 0U;
+    for (uint8_t i = 0U; i < RTNET_MDNS_MAX_BROWSES; i++) {
+        if (mdns->browses[i].in_use) {
+            if (mdns->browses[i].type_name == type_name) {
+                RTNET_mDNS_NameRelease(type_name);
+                return RTNET_ERR_CONNECTION;
+            }
+        } else if (browse == NULL) {
+            browse = &mdns->browses[i];
+            id = i;
+        }
+    }
+
+    uint32_t now = RTNET_GetTimeMs();
+    RTNET_mDNSQuestion_t* q = (browse != NULL) ?
+                              RTNET_mDNS_Ask(type_name, RTNET_MDNS_TYPE_PTR, now) : NULL;
+    if (q == NULL) {
+        RTNET_mDNS_NameRelease(type_name);
+        return RTNET_ERR_OVERFLOW;
+    }
+
+    /* Restart the back-off: a new browse wants answers now */
+    q->continuous = true;
+    q->next_send_ms = now;
+    q->interval_ms = MDNS_FIRST_INTERVAL_MS;
+
+    browse->type_name = type_name;
+    browse->callback = callback;
+    browse->in_use = true;
+    *browse_id = id;
+
+    /* Cached instances first, then the wire */
+    RTNET_mDNS_EvaluateBrowses(now);
+    RTNET_mDNS_SendDue(now);
+
+    return RTNET_OK;
+}
+
+RTNET_Error_t RTNET_mDNS_BrowseStop(uint8_t browse_id)
+{
+    RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+
+    if ((browse_id >= RTNET_MDNS_MAX_BROWSES) || !mdns->browses[browse_id].in_use) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    RTNET_mDNSBrowse_t* browse = &mdns->browses[browse_id];
+    uint8_t type_name = browse->type_name;
+    browse->in_use = false;
+
+    /* A later browse of the type reports the cached instances again */
+    uint8_t ptr = RTNET_mDNS_CacheFirst(type_name, RTNET_MDNS_TYPE_PTR);
+    while (ptr != MDNS_CACHE_NONE) {
+        mdns->cache[ptr].reported = false;
+        ptr = RTNET_mDNS_CacheNext(mdns->cache[ptr].next, type_name, RTNET_MDNS_TYPE_PTR);
+    }
+
+    /* The PTR question lapses unless RTNET_mDNS_Query still asks it */
+    for (uint8_t i = 0U; i < RTNET_MDNS_MAX_QUESTIONS; i++) {
+        RTNET_mDNSQuestion_t* q = &mdns->questions[i];
+        if (q->in_use && q->continuous && (q->name == type_name)) {
+            q->continuous = false;
+        }
+    }
+
+    RTNET_mDNS_NameRelease(type_name);
+    return RTNET_OK;
+}
+
+RTNET_Error_t RTNET_mDNS_Announce(const char* service_name,
+                                   uint16_t port,
+                                   uint32_t ttl_sec)
+{
+    RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+    uint8_t wire[RTNET_MDNS_MAX_NAME_LEN];
+    uint8_t wire_len = 0U;
+
+    if ((service_name == NULL) || (port == 0U) || (ttl_sec == 0U) || !g_RTNET_Ctx->initialized) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    /* Room for the instance label in front of the type */
+    if (!RTNET_mDNS_FromText(service_name, &wire[MDNS_HOST_LABEL_LEN + 1U],
+                             sizeof(wire) - (MDNS_HOST_LABEL_LEN + 1U), &wire_len)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    RTNET_Error_t err = RTNET_mDNS_Start();
+    if ((err != RTNET_OK) || (mdns->host == MDNS_NAME_NONE)) {
+        return (err != RTNET_OK) ? err : RTNET_ERR_OVERFLOW;
+    }
+
+    uint8_t type_name = RTNET_mDNS_NameIntern(&wire[MDNS_HOST_LABEL_LEN + 1U], wire_len);
+    if (type_name == MDNS_NAME_NONE) {
+        return RTNET_ERR_OVERFLOW;
+    }
+
+    RTNET_mDNSService_t* svc = NULL;
+    RTNET_mDNSService_t* free_svc = NULL;
+    for (uint8_t i = 0U; i < RTNET_MDNS_MAX_SERVICES; i++) {
+        RTNET_mDNSService_t* s = &mdns->services[i];
+        if (s->in_use && (s->type_name == type_name)) {
+            svc = s;
+        } else if (!s->in_use && (free_svc == NULL)) {
+            free_svc = s;
+        }
+    }
+
+    if (svc != NULL) {
+        RTNET_mDNS_NameRelease(type_name);
+    } else {
+        if (free_svc == NULL) {
+            RTNET_mDNS_NameRelease(type_name);
+            return RTNET_ERR_OVERFLOW;
+        }
+
+        /* Instance: the host label followed by the type */
+        memcpy(wire, RTNET_mDNS_NameWire(mdns->host), MDNS_HOST_LABEL_LEN + 1U);
+        uint8_t instance = RTNET_mDNS_NameIntern(wire, (uint8_t)(wire_len + MDNS_HOST_LABEL_LEN + 1U));
+        if (instance == MDNS_NAME_NONE) {
+            RTNET_mDNS_NameRelease(type_name);
+            return RTNET_ERR_OVERFLOW;
+        }
+
+        svc = free_svc;
+        svc->type_name = type_name;
+        svc->instance = instance;
+        svc->in_use = true;
+    }
+
+    svc->port = port;
+    svc->ttl_s = (ttl_sec > MDNS_MAX_TTL_S) ? MDNS_MAX_TTL_S : ttl_sec;
+    if (!RTNET_mDNS_Compile(svc)) {
+        RTNET_mDNS_NameRelease(svc->type_name);
+        RTNET_mDNS_NameRelease(svc->instance);
+        svc->in_use = false;
+        return RTNET_ERR_OVERFLOW;
+    }
+
+    uint32_t now = RTNET_GetTimeMs();
+    svc->announce_left = MDNS_ANNOUNCE_COUNT;
+    svc->next_announce_ms = now;
+    RTNET_mDNS_AnnounceDue(now);
+
+    return RTNET_OK;
+}
+
+RTNET_Error_t RTNET_mDNS_Withdraw(const char* service_name)
+{
+    RTNET_mDNS_t* mdns = &g_RTNET_Ctx->mdns;
+    uint8_t wire[RTNET_MDNS_MAX_NAME_LEN];
+    uint8_t wire_len = 0U;
+
+    if ((service_name == NULL) || !g_RTNET_Ctx->initialized ||
+        !RTNET_mDNS_FromText(service_name, wire, sizeof(wire), &wire_len)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    uint8_t type_name = RTNET_mDNS_NameLookup(wire, wire_len);
+    for (uint8_t i = 0U; (type_name != MDNS_NAME_NONE) && (i < RTNET_MDNS_MAX_SERVICES); i++) {
+        RTNET_mDNSService_t* svc = &mdns->services[i];
+        if (svc->in_use && (svc->type_name == type_name)) {
+            RTNET_mDNS_SendAnnouncement(svc, true);
+            RTNET_mDNS_NameRelease(svc->type_name);
+            RTNET_mDNS_NameRelease(svc->instance);
+            svc->in_use = false;
+            return RTNET_OK;
+        }
+    }
+
+    return RTNET_ERR_INVALID_PARAM;
+}
+
+#endif /* RTNET_ENABLE_MDNS */
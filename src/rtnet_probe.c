@@ -0,0 +1,138 @@
+/**
+ * @file rtnet_probe.c
+ * @brief Latency probes: log2 cycle histograms per instrumented path
+ * @version 1.0.0
+ * @date 2026-01-07
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/src/rtnet_probe.c
+ *
+ * IMPLEMENTATION NOTES:
+ * - RTNET_PROBE_BEGIN/END (rtnet_internal.h) read RTNET_GetCycleCount
+ *   around a path; with RTNET_ENABLE_PROFILING = 0 they compile to nothing
+ * - A sample costs one bit scan and four stores: fixed log2 buckets, so
+ *   recording is O(1) and the tables are sized at compile time
+ * - The 99th percentile is derived on read from the buckets, as the upper
+ *   edge of the bucket holding it (conservative, capped at the maximum)
+ * - Histograms are updated without a critical section, like the statistics
+ *   counters, so probes may sit inside critical sections and ISRs
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include "rtnet_stack.h"
+#include "rtnet_internal.h"
+#include <stddef.h>
+#include <string.h>
+
+#if (RTNET_ENABLE_PROFILING != 0U)
+
+/* ==================== HELPERS ==================== */
+
+/**
+ * @brief log2 bucket of a sample (0-1 ticks in bucket 0)
+ */
+static inline uint32_t RTNET_Probe_Bucket(uint32_t cycles)
+{
+    uint32_t bucket;
+#if defined(__GNUC__)
+    bucket = 31U - (uint32_t)__builtin_clz(cycles | 1U);
+#else
+    bucket = 0U;
+    while ((cycles >> 1U) != 0U) {
+        cycles >>= 1U;
+        bucket++;
+    }
+#endif
+    return (bucket < RTNET_PROBE_BUCKETS) ? bucket : (RTNET_PROBE_BUCKETS - 1U);
+}
+
+/**
+ * @brief Conservative 99th percentile from the bucket counts
+ */
+static uint32_t RTNET_Probe_P99(const RTNET_LatencyStats_t* hist)
+{
+    if (hist->count == 0U) {
+        return 0U;
+    }
+    
+    /* Rank of the 99th percentile sample, rounded up */
+    const uint32_t rank = (uint32_t)((((uint64_t)hist->count * 99U) + 99U) / 100U);
+    uint32_t seen = 0U;
+    uint32_t bucket = 0U;
+    while (bucket < (RTNET_PROBE_BUCKETS - 1U)) {
+        seen += hist->buckets[bucket];
+        if (seen >= rank) {
+            break;
+        }
+        bucket++;
+    }
+    
+    if (bucket == (RTNET_PROBE_BUCKETS - 1U)) {
+        return hist->max_cycles;
+    }
+    const uint32_t edge = (uint32_t)((2UL << bucket) - 1UL);
+    return (edge < hist->max_cycles) ? edge : hist->max_cycles;
+}
+
+/* ==================== INTERNAL API ==================== */
+
+void RTNET_Probe_Record(RTNET_ProbePoint_t point, uint32_t cycles)
+{
+    RTNET_LatencyStats_t* hist = &g_RTNET_Ctx->latency[point];
+    
+    if ((hist->count == 0U) || (cycles < hist->min_cycles)) {
+        hist->min_cycles = cycles;
+    }
+    if (cycles > hist->max_cycles) {
+        hist->max_cycles = cycles;
+    }
+    hist->buckets[RTNET_Probe_Bucket(cycles)]++;
+    hist->count++;
+}
+
+#endif /* RTNET_ENABLE_PROFILING */
+
+/* ==================== PUBLIC API ==================== */
+
+RTNET_Error_t RTNET_GetLatencyStats(RTNET_ProbePoint_t point, RTNET_LatencyStats_t* stats)
+{
+#if (RTNET_ENABLE_PROFILING != 0U)
+    if ((stats == NULL) || ((uint32_t)point >= (uint32_t)RTNET_PROBE_COUNT)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    memcpy(stats, &g_RTNET_Ctx->latency[point], sizeof(RTNET_LatencyStats_t));
+    stats->p99_cycles = RTNET_Probe_P99(stats);
+    return RTNET_OK;
+#else
+    (void)point;
+    (void)stats;
+    return RTNET_ERR_INVALID_PARAM;
+#endif
+}
+
+void RTNET_ResetLatencyStats(void)
+{
+#if (RTNET_ENABLE_PROFILING != 0U)
+    memset(g_RTNET_Ctx->latency, 0, sizeof(g_RTNET_Ctx->latency));
+#endif
+}
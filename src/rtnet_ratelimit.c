@@ -0,0 +1,232 @@
+/**
+ * @file rtnet_ratelimit.c
+ * @brief ICMPv6 token bucket rate limiting (RFC 4443 2.4 f)
+ * @version 1.0.0
+ * @date 2026-10-14
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/src/rtnet_ratelimit.c
+ *
+ * IMPLEMENTATION NOTES:
+ * - Each class (echo, Neighbor Discovery, solicitations for our address,
+ *   other received messages, errors sent) has one bucket shared by all
+ *   peers and one bucket per peer
+ *   address. A message passes only if both hold a whole token, and only
+ *   then are both charged, so a flooding peer cannot drain the shared
+ *   budget faster than its own
+ * - Per-peer buckets sit in a direct-mapped table of
+ *   RTNET_ICMPV6_PEER_SLOTS entries indexed by a seeded hash of address
+ *   and class. A peer that collides with another takes the entry over with
+ *   a full bucket; the shared bucket still bounds the total, so rotating
+ *   source addresses buys nothing beyond it
+ * - Credit is kept in 1/1000 message and refilled from the elapsed
+ *   milliseconds on use: O(1) per message, no periodic work
+ * - Received messages are looked at twice: RTNET_RateLimit_Check drops one
+ *   without credit before its checksum is computed, and only a message
+ *   whose checksum verifies is charged (RTNET_RateLimit_Admit). Corrupt
+ *   floods are thus cheap to drop and cannot drain anyone's budget
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include "rtnet_stack.h"
+#include "rtnet_internal.h"
+#include <stddef.h>
+
+/* ==================== CONSTANTS ==================== */
+
+#if ((RTNET_ICMPV6_PEER_SLOTS == 0U) || \
+     ((RTNET_ICMPV6_PEER_SLOTS & (RTNET_ICMPV6_PEER_SLOTS - 1U)) != 0U))
+#error "RTNET_ICMPV6_PEER_SLOTS must be a power of two"
+#endif
+
+#define RATE_TOKEN              1000U   /* Credit of one message */
+#define RATE_MAX_ELAPSED_MS     60000U  /* Longer idle gaps refill no more (no overflow) */
+
+/* ==================== TOKEN BUCKETS ==================== */
+
+/**
+ * @brief Fill a bucket from the time elapsed since its last use
+ * @param bucket Bucket
+ * @param rate Messages per second (non-zero)
+ * @param burst Capacity in messages
+ * @param now Current time in ms
+ */
+static void RTNET_Bucket_Refill(RTNET_TokenBucket_t* bucket, uint16_t rate, uint16_t burst,
+                                uint32_t now)
+{
+    const uint32_t cap = (uint32_t)burst * RATE_TOKEN;
+    uint32_t elapsed = now - bucket->last_ms;
+    if (elapsed > RATE_MAX_ELAPSED_MS) {
+        elapsed = RATE_MAX_ELAPSED_MS;
+    }
+    bucket->last_ms = now;
+
+    /* ms x messages/s = 1/1000 messages */
+    const uint32_t gain = elapsed * rate;
+    bucket->credit = ((cap - bucket->credit) <= gain) ? cap : (bucket->credit + gain);
+}
+
+/**
+ * @brief Restart a bucket full
+ */
+static void RTNET_Bucket_Reset(RTNET_TokenBucket_t* bucket, uint16_t burst, uint32_t now)
+{
+    bucket->credit = (uint32_t)burst * RATE_TOKEN;
+    bucket->last_ms = now;
+}
+
+/**
+ * @brief Seeded hash of a peer address and class (FNV-1a)
+ */
+static uint32_t RTNET_RateLimit_Hash(const uint8_t* peer, uint8_t limit)
+{
+    uint32_t hash = 2166136261U ^ g_RTNET_Ctx->icmp_seed;
+    for (uint8_t i = 0U; i < RTNET_IPV6_ADDR_LEN; i++) {
+        hash = (hash ^ peer[i]) * 16777619U;
+    }
+    hash = (hash ^ limit) * 16777619U;
+
+    return hash ^ (hash >> 16U);
+}
+
+/**
+ * @brief Refill the buckets of a class and peer and check both hold a token
+ * @param total [OUT] Shared bucket, NULL when the class has none
+ * @param own [OUT] Peer bucket, NULL when the class has none
+ * @return false if either bucket is empty
+ * @note A peer that takes over a colliding entry starts with a full bucket
+ */
+static bool RTNET_RateLimit_Buckets(RTNET_ICMPv6Limit_t limit, const uint8_t* peer,
+                                    RTNET_TokenBucket_t** total, RTNET_TokenBucket_t** own)
+{
+    const RTNET_ICMPv6RateLimit_t* config = &g_RTNET_Ctx->icmp_limits[limit];
+    const uint32_t now = RTNET_GetTimeMs();
+
+    *total = NULL;
+    *own = NULL;
+    if (config->total_rate != 0U) {
+        *total = &g_RTNET_Ctx->icmp_total[limit];
+        RTNET_Bucket_Refill(*total, config->total_rate, config->total_burst, now);
+        if ((*total)->credit < RATE_TOKEN) {
+            return false;
+        }
+    }
+
+    if (config->peer_rate != 0U) {
+        const uint32_t key = RTNET_RateLimit_Hash(peer, (uint8_t)limit);
+        RTNET_ICMPv6Peer_t* entry = &g_RTNET_Ctx->icmp_peers[key & (RTNET_ICMPV6_PEER_SLOTS - 1U)];
+        if ((entry->limit != (uint8_t)limit) || (entry->key != key)) {
+            entry->limit = (uint8_t)limit;
+            entry->key = key;
+            RTNET_Bucket_Reset(&entry->bucket, config->peer_burst, now);
+        } else {
+            RTNET_Bucket_Refill(&entry->bucket, config->peer_rate, config->peer_burst, now);
+        }
+        *own = &entry->bucket;
+        if ((*own)->credit < RATE_TOKEN) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* ==================== INTERNAL API ==================== */
+
+void RTNET_RateLimit_Init(void)
+{
+    static const RTNET_ICMPv6RateLimit_t defaults[RTNET_ICMPV6_LIMIT_COUNT] = {
+        { RTNET_ICMPV6_ECHO_RATE,  RTNET_ICMPV6_ECHO_BURST,
+          RTNET_ICMPV6_ECHO_TOTAL, RTNET_ICMPV6_ECHO_TOTAL },
+        { RTNET_ICMPV6_ND_RATE,    RTNET_ICMPV6_ND_BURST,
+          RTNET_ICMPV6_ND_TOTAL,   RTNET_ICMPV6_ND_TOTAL },
+        { RTNET_ICMPV6_OTHER_RATE, RTNET_ICMPV6_OTHER_BURST,
+          RTNET_ICMPV6_OTHER_TOTAL, RTNET_ICMPV6_OTHER_TOTAL },
+        { RTNET_ICMPV6_ERROR_RATE, RTNET_ICMPV6_ERROR_BURST,
+          RTNET_ICMPV6_ERROR_TOTAL, RTNET_ICMPV6_ERROR_TOTAL },
+        { RTNET_ICMPV6_ND_LOCAL_RATE, RTNET_ICMPV6_ND_LOCAL_BURST,
+          RTNET_ICMPV6_ND_LOCAL_TOTAL, RTNET_ICMPV6_ND_LOCAL_TOTAL }
+    };
+
+    const uint32_t now = RTNET_GetTimeMs();
+    for (uint8_t i = 0U; i < RTNET_ICMPV6_LIMIT_COUNT; i++) {
+        g_RTNET_Ctx->icmp_limits[i] = defaults[i];
+        RTNET_Bucket_Reset(&g_RTNET_Ctx->icmp_total[i], defaults[i].total_burst, now);
+    }
+    for (uint16_t i = 0U; i < RTNET_ICMPV6_PEER_SLOTS; i++) {
+        g_RTNET_Ctx->icmp_peers[i].limit = (uint8_t)RTNET_ICMPV6_LIMIT_COUNT;
+    }
+
+    /* Peers cannot aim at each other's buckets without knowing the seed */
+    g_RTNET_Ctx->icmp_seed = (RTNET_GetCycleCount() * 0x9E3779B1UL) ^
+                             ((uint32_t)g_RTNET_Ctx->local_mac.addr[5] << 24U) ^
+                             ((uint32_t)g_RTNET_Ctx->local_mac.addr[4] << 16U);
+}
+
+bool RTNET_RateLimit_Check(RTNET_ICMPv6Limit_t limit, const uint8_t* peer)
+{
+    RTNET_TokenBucket_t* total;
+    RTNET_TokenBucket_t* own;
+    return RTNET_RateLimit_Buckets(limit, peer, &total, &own);
+}
+
+bool RTNET_RateLimit_Admit(RTNET_ICMPv6Limit_t limit, const uint8_t* peer)
+{
+    RTNET_TokenBucket_t* total;
+    RTNET_TokenBucket_t* own;
+    if (!RTNET_RateLimit_Buckets(limit, peer, &total, &own)) {
+        return false;
+    }
+
+    if (total != NULL) {
+        total->credit -= RATE_TOKEN;
+    }
+    if (own != NULL) {
+        own->credit -= RATE_TOKEN;
+    }
+    return true;
+}
+
+/* ==================== PUBLIC API ==================== */
+
+RTNET_Error_t RTNET_SetICMPv6RateLimit(RTNET_ICMPv6Limit_t limit,
+                                       const RTNET_ICMPv6RateLimit_t* config)
+{
+    if ((config == NULL) || ((uint32_t)limit >= (uint32_t)RTNET_ICMPV6_LIMIT_COUNT) ||
+        ((config->peer_rate != 0U) && (config->peer_burst == 0U)) ||
+        ((config->total_rate != 0U) && (config->total_burst == 0U))) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    const uint32_t now = RTNET_GetTimeMs();
+    RTNET_CriticalSectionEnter();
+    g_RTNET_Ctx->icmp_limits[limit] = *config;
+    RTNET_Bucket_Reset(&g_RTNET_Ctx->icmp_total[limit], config->total_burst, now);
+    for (uint16_t i = 0U; i < RTNET_ICMPV6_PEER_SLOTS; i++) {
+        if (g_RTNET_Ctx->icmp_peers[i].limit == (uint8_t)limit) {
+            g_RTNET_Ctx->icmp_peers[i].limit = (uint8_t)RTNET_ICMPV6_LIMIT_COUNT;
+        }
+    }
+    RTNET_CriticalSectionExit();
+
+    return RTNET_OK;
+}
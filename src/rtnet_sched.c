@@ -0,0 +1,472 @@
+/**
+ * @file rtnet_sched.c
+ * @brief TX scheduler: per-class queues, strict priority plus deficit round robin
+ * @version 1.0.0
+ * @date 2026-01-07
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/src/rtnet_sched.c
+ *
+ * IMPLEMENTATION NOTES:
+ * - Every completed frame is queued by its buffer's qos_priority and leaves
+ *   through RTNET_PollTx, which hands at most RTNET_HardwareTxSpace() frames
+ *   to the MAC per call (in RTNET_TX_BATCH_MAX scatter lists). Frames the
+ *   MAC has no room for wait in their queue instead of in call order
+ * - RTNET_QOS_CRITICAL is served first whenever it is backlogged, so a
+ *   control frame waits for at most one MAC batch behind bulk traffic
+ * - HIGH, NORMAL and LOW share the remaining capacity by deficit round
+ *   robin (Shreedhar/Varghese): each turn credits the class quantum in
+ *   bytes and sends while the head frame fits. Shares are proportional to
+ *   the quanta whatever the frame sizes, and an idle class loses its credit
+ * - Quanta are at least RTNET_TX_QUANTUM_MIN, which bounds the DRR turns
+ *   needed for one frame to 3 x (RTNET_BUFFER_SIZE / quantum + 1)
+ * - With RTNET_QOS_MARK_DSCP the class DSCP is written into the IPv6
+ *   Traffic Class on enqueue (ECN bits kept), so switches and routers on
+ *   the path can apply the same priority; upper-layer checksums do not
+ *   cover the field
+ * - An optional gate control list (802.1Qbv) masks classes by the position
+ *   in a repeating cycle read from RTNET_GetTimeUs(). A frame is admitted
+ *   only if its wire time ends inside the open window, so no frame runs
+ *   into the next class's slot (the guard band is implicit and per frame).
+ *   A gated class keeps its DRR deficit until its window reopens
+ * - With RTNET_HWCAP_TX_LAUNCH_TIME the next fitting window within one
+ *   cycle is computed and the frame is handed to the MAC early with that
+ *   launch time, so slot accuracy no longer depends on when RTNET_PollTx runs
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include "rtnet_stack.h"
+#include "rtnet_internal.h"
+#include <stddef.h>
+
+/* ==================== CONSTANTS ==================== */
+
+#define TX_ETH_TYPE_OFFSET      12U
+#define TX_ETH_TYPE_IPV6        0x86DDU
+#define TX_IPV6_NEXT_HEADER_OFFSET (RTNET_ETH_HEADER_LEN + 6U)
+
+/* Preamble + SFD (8), FCS (4) and inter-frame gap (12) around each frame */
+#define TX_WIRE_OVERHEAD        24U
+#define TX_GCL_MAX_CYCLE_US     0x7FFFFFFFUL
+
+/* Turns needed at worst before one DRR frame fits (see notes) */
+#define TX_SCHED_MAX_TURNS      (3U * ((RTNET_BUFFER_SIZE / RTNET_TX_QUANTUM_MIN) + 2U))
+
+#if (RTNET_TX_QUEUE_DEPTH > 255U)
+#error "RTNET_TX_QUEUE_DEPTH must fit a uint8_t queue index"
+#endif
+
+#if ((RTNET_TX_QUANTUM_HIGH < RTNET_TX_QUANTUM_MIN) || \
+     (RTNET_TX_QUANTUM_NORMAL < RTNET_TX_QUANTUM_MIN) || \
+     (RTNET_TX_QUANTUM_LOW < RTNET_TX_QUANTUM_MIN) || (RTNET_TX_QUANTUM_MIN == 0U))
+#error "TX quanta must be at least RTNET_TX_QUANTUM_MIN (non-zero)"
+#endif
+
+#if (RTNET_QOS_MARK_DSCP != 0U)
+static const uint8_t g_RTNET_QosDscp[RTNET_QOS_LEVELS] = {
+    RTNET_QOS_DSCP_CRITICAL, RTNET_QOS_DSCP_HIGH, RTNET_QOS_DSCP_NORMAL, RTNET_QOS_DSCP_LOW
+};
+#endif
+
+/* ==================== GATE CONTROL ==================== */
+
+/**
+ * @brief Position in the gate cycle, sampled once per RTNET_PollTx
+ */
+typedef struct {
+    uint32_t now_us;
+    uint32_t left_us;       /* Time left in the current entry */
+    uint32_t booked_us;     /* Wire time of frames released this drain, from now_us */
+    uint8_t entry;          /* Current entry */
+    bool active;            /* List installed and base time reached */
+} RTNET_GateState_t;
+
+static void RTNET_Gate_Locate(RTNET_GateState_t* gate)
+{
+    RTNET_TxScheduler_t* sched = &g_RTNET_Ctx->tx_sched;
+    
+    gate->now_us = RTNET_GetTimeUs();
+    gate->booked_us = 0U;
+    gate->active = false;
+    if (sched->gcl_cycle_us == 0U) {
+        return;
+    }
+    
+    uint32_t since = gate->now_us - sched->gcl_base_us;
+    if (since > TX_GCL_MAX_CYCLE_US) {
+        return; /* Base time still ahead */
+    }
+    
+    /* Keep the base within one cycle of now so the difference never wraps */
+    const uint32_t pos = since % sched->gcl_cycle_us;
+    sched->gcl_base_us += since - pos;
+    
+    uint8_t entry = 0U;
+    uint32_t rest = pos;
+    while (rest >= sched->gcl[entry].interval_us) {
+        rest -= sched->gcl[entry].interval_us;
+        entry++;
+    }
+    
+    gate->entry = entry;
+    gate->left_us = sched->gcl[entry].interval_us - rest;
+    gate->active = true;
+}
+
+static inline uint32_t RTNET_Gate_WireUs(uint16_t length)
+{
+    return ((((uint32_t)length + TX_WIRE_OVERHEAD) * 8U) + RTNET_LINK_SPEED_MBPS - 1U) /
+           RTNET_LINK_SPEED_MBPS;
+}
+
+/**
+ * @brief Check whether a frame may be handed to the MAC now
+ * @param start_us [OUT] Wire start of the frame from now_us, after the
+ *                 frames already booked in this drain
+ * @return true if its gate stays open long enough from the end of the
+ *         booked frames, or (launch-time MAC) a window within the next
+ *         cycle fits it
+ */
+static bool RTNET_Gate_Admit(const RTNET_GateState_t* gate,
+                             uint8_t qos,
+                             uint16_t length,
+                             uint32_t* start_us)
+{
+    const RTNET_TxScheduler_t* sched = &g_RTNET_Ctx->tx_sched;
+    
+    *start_us = 0U;
+    if (!gate->active) {
+        return true;
+    }
+    
+    const uint8_t bit = (uint8_t)(1U << qos);
+    const uint32_t wire_us = RTNET_Gate_WireUs(length);
+    uint32_t offset = 0U;       /* From now to the start of entry */
+    uint32_t window_start = 0U;
+    uint32_t window_len = 0U;
+    uint32_t left = gate->left_us;
+    uint8_t entry = gate->entry;
+    
+    /* One full cycle plus the current entry covers windows that wrap */
+    for (uint8_t n = 0U; n <= sched->gcl_count; n++) {
+        if ((sched->gcl[entry].gate_mask & bit) != 0U) {
+            if (window_len == 0U) {
+                window_start = offset;
+            }
+            window_len += left;
+            const uint32_t start = (gate->booked_us > window_start) ? gate->booked_us : window_start;
+            if ((window_start + window_len) >= (start + wire_us)) {
+                if ((start > gate->booked_us) &&
+                    ((g_RTNET_Ctx->hw_caps.tx_features & RTNET_HWCAP_TX_LAUNCH_TIME) == 0U)) {
+                    return false;
+                }
+                *start_us = start;
+                return true;
+            }
+        } else {
+            window_len = 0U;
+        }
+        
+        offset += left;
+        entry = (uint8_t)((entry + 1U) % sched->gcl_count);
+        left = sched->gcl[entry].interval_us;
+    }
+    
+    return false;
+}
+
+/* ==================== QUEUES ==================== */
+
+static RTNET_Buffer_t* RTNET_TxSched_Pop(uint8_t qos)
+{
+    RTNET_TxScheduler_t* sched = &g_RTNET_Ctx->tx_sched;
+    RTNET_Buffer_t* buf = sched->queue[qos][sched->head[qos]];
+    
+    sched->head[qos] = (uint8_t)((sched->head[qos] + 1U) % RTNET_TX_QUEUE_DEPTH);
+    sched->count[qos]--;
+    return buf;
+}
+
+static void RTNET_TxSched_NextTurn(RTNET_TxScheduler_t* sched)
+{
+    sched->current = (sched->current == RTNET_QOS_LOW) ? (uint8_t)RTNET_QOS_HIGH
+                                                        : (uint8_t)(sched->current + 1U);
+    sched->credited = false;
+}
+
+/**
+ * @brief Head frame of a class exists and its gate admits it
+ */
+static bool RTNET_TxSched_Ready(const RTNET_GateState_t* gate, uint8_t qos, uint32_t* start_us)
+{
+    const RTNET_TxScheduler_t* sched = &g_RTNET_Ctx->tx_sched;
+    
+    return (sched->count[qos] != 0U) &&
+           RTNET_Gate_Admit(gate, qos, sched->queue[qos][sched->head[qos]]->length, start_us);
+}
+
+/**
+ * @brief Select the next frame to transmit
+ * @param gate Gate cycle position
+ * @param start_us [OUT] Wire start of the frame from gate->now_us
+ * @return Buffer, NULL if no queued frame may leave now
+ * @note Call inside a critical section
+ */
+static RTNET_Buffer_t* RTNET_TxSched_Next(const RTNET_GateState_t* gate, uint32_t* start_us)
+{
+    RTNET_TxScheduler_t* sched = &g_RTNET_Ctx->tx_sched;
+    
+    if (RTNET_TxSched_Ready(gate, RTNET_QOS_CRITICAL, start_us)) {
+        return RTNET_TxSched_Pop(RTNET_QOS_CRITICAL);
+    }
+    if (!RTNET_TxSched_Ready(gate, RTNET_QOS_HIGH, start_us) &&
+        !RTNET_TxSched_Ready(gate, RTNET_QOS_NORMAL, start_us) &&
+        !RTNET_TxSched_Ready(gate, RTNET_QOS_LOW, start_us)) {
+        return NULL;
+    }
+    
+    for (uint16_t turn = 0U; turn < TX_SCHED_MAX_TURNS; turn++) {
+        const uint8_t qos = sched->current;
+        
+        if (!RTNET_TxSched_Ready(gate, qos, start_us)) {
+            if (sched->count[qos] == 0U) {
+                sched->deficit[qos] = 0U;  /* Idle classes lose their credit, gated ones keep it */
+            }
+            RTNET_TxSched_NextTurn(sched);
+            continue;
+        }
+        if (!sched->credited) {
+            sched->deficit[qos] += sched->quantum[qos];
+            sched->credited = true;
+        }
+        
+        const uint16_t len = sched->queue[qos][sched->head[qos]]->length;
+        if (len <= sched->deficit[qos]) {
+            sched->deficit[qos] -= len;
+            return RTNET_TxSched_Pop(qos);
+        }
+        RTNET_TxSched_NextTurn(sched);
+    }
+    
+    return NULL; /* Not reached: a backlogged class gains a quantum per round */
+}
+
+/* ==================== INTERNAL API ==================== */
+
+void RTNET_TxSched_Init(void)
+{
+    RTNET_TxScheduler_t* sched = &g_RTNET_Ctx->tx_sched;
+    
+    for (uint8_t qos = 0U; qos < RTNET_QOS_LEVELS; qos++) {
+        sched->head[qos] = 0U;
+        sched->count[qos] = 0U;
+        sched->deficit[qos] = 0U;
+    }
+    sched->quantum[RTNET_QOS_CRITICAL] = 0U;
+    sched->quantum[RTNET_QOS_HIGH] = RTNET_TX_QUANTUM_HIGH;
+    sched->quantum[RTNET_QOS_NORMAL] = RTNET_TX_QUANTUM_NORMAL;
+    sched->quantum[RTNET_QOS_LOW] = RTNET_TX_QUANTUM_LOW;
+    sched->current = RTNET_QOS_HIGH;
+    sched->credited = false;
+    sched->running = false;
+    sched->gcl_count = 0U;
+    sched->gcl_cycle_us = 0U;
+}
+
+void RTNET_TxSched_Enqueue(RTNET_Buffer_t* buf)
+{
+    RTNET_TxScheduler_t* sched = &g_RTNET_Ctx->tx_sched;
+    const uint8_t qos = (buf->qos_priority < RTNET_QOS_LEVELS) ? buf->qos_priority
+                                                                : (uint8_t)RTNET_QOS_LOW;
+    
+#if (RTNET_QOS_MARK_DSCP != 0U)
+    uint8_t* frame = &buf->data[buf->offset];
+    if ((buf->length >= (RTNET_ETH_HEADER_LEN + RTNET_IPV6_HEADER_LEN)) &&
+        (RTNET_Read16(&frame[TX_ETH_TYPE_OFFSET]) == TX_ETH_TYPE_IPV6)) {
+        uint8_t* ip = &frame[RTNET_ETH_HEADER_LEN];
+        const uint8_t tc = (uint8_t)((uint8_t)(g_RTNET_QosDscp[qos] << 2U) | ((ip[1] >> 4U) & 0x03U));
+        ip[0] = (uint8_t)((ip[0] & 0xF0U) | (tc >> 4U));
+        ip[1] = (uint8_t)((uint8_t)(tc << 4U) | (ip[1] & 0x0FU));
+    }
+#endif
+    
+    bool queued = false;
+    RTNET_CriticalSectionEnter();
+    if (sched->count[qos] < RTNET_TX_QUEUE_DEPTH) {
+        sched->queue[qos][(sched->head[qos] + sched->count[qos]) % RTNET_TX_QUEUE_DEPTH] = buf;
+        sched->count[qos]++;
+        queued = true;
+    }
+    RTNET_CriticalSectionExit();
+    
+    if (!queued) {
+        RTNET_STAT_DROP(tx_dropped, RTNET_DROP_TX_QUEUE_FULL);
+        RTNET_FreeBuffer(buf);
+    }
+}
+
+/* ==================== PUBLIC API ==================== */
+
+uint16_t RTNET_PollTx(uint16_t budget)
+{
+    RTNET_TxScheduler_t* sched = &g_RTNET_Ctx->tx_sched;
+    
+    /* A frame sent from inside the MAC hook (e.g. loopback) is picked up
+     * by the drain already running */
+    bool owner = false;
+    RTNET_CriticalSectionEnter();
+    if (!sched->running) {
+        sched->running = true;
+        owner = true;
+    }
+    RTNET_CriticalSectionExit();
+    if (!owner) {
+        return 0U;
+    }
+    
+    RTNET_GateState_t gate;
+    RTNET_Gate_Locate(&gate);
+    
+    uint16_t limit = RTNET_HardwareTxSpace();
+    if (budget < limit) {
+        limit = budget;
+    }
+    
+    uint16_t sent = 0U;
+    while (sent < limit) {
+        RTNET_Buffer_t* bufs[RTNET_TX_BATCH_MAX];
+        uint32_t delays[RTNET_TX_BATCH_MAX];
+        uint16_t count = 0U;
+        bool launch = false;
+        
+        RTNET_CriticalSectionEnter();
+        while ((count < RTNET_TX_BATCH_MAX) && ((sent + count) < limit)) {
+            uint32_t start_us;
+            RTNET_Buffer_t* buf = RTNET_TxSched_Next(&gate, &start_us);
+            if (buf == NULL) {
+                break;
+            }
+            if (gate.active) {
+                /* The next frame queues behind this one on the wire */
+                gate.booked_us = start_us + RTNET_Gate_WireUs(buf->length);
+            }
+            delays[count] = ((g_RTNET_Ctx->hw_caps.tx_features & RTNET_HWCAP_TX_LAUNCH_TIME) != 0U)
+                                ? start_us : 0U;
+            launch = launch || (delays[count] != 0U);
+            bufs[count++] = buf;
+        }
+        RTNET_CriticalSectionExit();
+        
+        if (count == 0U) {
+            break;
+        }
+        
+        if ((count == 1U) && !launch) {
+            RTNET_HardwareTransmit(&bufs[0]->data[bufs[0]->offset], bufs[0]->length);
+        } else {
+            RTNET_TxFrame_t frames[RTNET_TX_BATCH_MAX];
+            for (uint16_t i = 0U; i < count; i++) {
+                frames[i].data = &bufs[i]->data[bufs[i]->offset];
+                frames[i].length = bufs[i]->length;
+                frames[i].launch = (delays[i] != 0U);
+                frames[i].launch_time_us = gate.now_us + delays[i];
+            }
+            RTNET_HardwareTransmitBatch(frames, count);
+        }
+        
+        RTNET_StatsBlock_t* const blk = RTNET_Stats_Begin();
+        blk->c.tx_packets += count;
+        for (uint16_t i = 0U; i < count; i++) {
+            const uint8_t* frame = &bufs[i]->data[bufs[i]->offset];
+            blk->c.tx_bytes += bufs[i]->length;
+            blk->c.tx_qos[(bufs[i]->qos_priority < RTNET_QOS_LEVELS) ? bufs[i]->qos_priority
+                                                                   : (uint8_t)RTNET_QOS_LOW]++;
+            blk->c.tx_proto[RTNET_Stats_ProtoIndex(frame[TX_IPV6_NEXT_HEADER_OFFSET])]++;
+        }
+        RTNET_Stats_End(blk);
+        
+        for (uint16_t i = 0U; i < count; i++) {
+            RTNET_FreeBuffer(bufs[i]);
+        }
+        sent = (uint16_t)(sent + count);
+    }
+    
+    sched->running = false;
+    return sent;
+}
+
+RTNET_Error_t RTNET_SetTxQuantum(uint8_t qos_priority, uint16_t quantum)
+{
+    if ((qos_priority == RTNET_QOS_CRITICAL) || (qos_priority >= RTNET_QOS_LEVELS) ||
+        (quantum < RTNET_TX_QUANTUM_MIN)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    RTNET_CriticalSectionEnter();
+    g_RTNET_Ctx->tx_sched.quantum[qos_priority] = quantum;
+    RTNET_CriticalSectionExit();
+    
+    return RTNET_OK;
+}
+
+RTNET_Error_t RTNET_SetGateControlList(const RTNET_GateEntry_t* entries,
+                                       uint8_t count,
+                                       uint32_t base_time_us)
+{
+    if ((count > RTNET_GCL_MAX_ENTRIES) || ((count != 0U) && (entries == NULL))) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    uint32_t cycle_us = 0U;
+    for (uint8_t i = 0U; i < count; i++) {
+        if ((entries[i].interval_us == 0U) ||
+            (entries[i].interval_us > (TX_GCL_MAX_CYCLE_US - cycle_us))) {
+            return RTNET_ERR_INVALID_PARAM;
+        }
+        cycle_us += entries[i].interval_us;
+    }
+    
+    RTNET_TxScheduler_t* sched = &g_RTNET_Ctx->tx_sched;
+    RTNET_CriticalSectionEnter();
+    for (uint8_t i = 0U; i < count; i++) {
+        sched->gcl[i] = entries[i];
+    }
+    sched->gcl_count = count;
+    sched->gcl_base_us = base_time_us;
+    sched->gcl_cycle_us = cycle_us;
+    RTNET_CriticalSectionExit();
+    
+    return RTNET_OK;
+}
+
+uint32_t RTNET_GateNextChangeUs(void)
+{
+    const RTNET_TxScheduler_t* sched = &g_RTNET_Ctx->tx_sched;
+    RTNET_GateState_t gate;
+    
+    RTNET_Gate_Locate(&gate);
+    if (gate.active) {
+        return gate.left_us;
+    }
+    
+    return (sched->gcl_cycle_us == 0U) ? UINT32_MAX : (sched->gcl_base_us - gate.now_us);
+}
@@ -28,7 +28,7 @@
  * WCET GUARANTEES:
  * - RX processing: < 450 μs per packet
  * - TX processing: < 320 μs per packet
- * - Route lookup: < 15 μs (hash table)
+ * - Route lookup: < 15 μs (path-compressed trie)
  * - Checksum: < 80 μs for 1500 bytes
 
 MIT License
@@ -69,32 +69,386 @@ SOFTWARE.
     #define RTNET_ALIGNED_4 __attribute__((aligned(4)))
 #endif
 
+/* Linker placement: override before including this header, e.g.
+ * -DRTNET_SECTION_FAST='__attribute__((section(".dtcm")))' */
+#ifndef RTNET_SECTION_FAST
+    #define RTNET_SECTION_FAST   /* Stack context + buffer descriptors */
+#endif
+#ifndef RTNET_SECTION_DMA
+    #define RTNET_SECTION_DMA    /* Payload arenas (must be DMA-reachable) */
+#endif
+
+/* Storage of the current-instance pointer: e.g. -DRTNET_THREAD_LOCAL=_Thread_local
+ * lets every host thread (or core, with a core-local section) run its own instance */
+#ifndef RTNET_THREAD_LOCAL
+    #define RTNET_THREAD_LOCAL
+#endif
+
 /* ==================== CONFIGURATION ==================== */
 
+/* Project overrides: every value below not marked fixed can be set in a
+ * rtnet_config.h on the include path, read when RTNET_HAS_CONFIG_H is
+ * defined (CMake: -DRTNS_CONFIG_DIR=<dir holding rtnet_config.h>) */
+#if defined(RTNET_HAS_CONFIG_H)
+    #include "rtnet_config.h"
+#endif
+
+/* Subsystems compiled in */
+#ifndef RTNET_ENABLE_TCP
+#define RTNET_ENABLE_TCP            1U   /* 0 = no TCP-Lite: TCP reaches the raw handler only */
+#endif
+#ifndef RTNET_ENABLE_MDNS
+#define RTNET_ENABLE_MDNS           1U   /* 0 = no mDNS querier/responder */
+#endif
+#ifndef RTNET_ENABLE_ROUTING
+#define RTNET_ENABLE_ROUTING        1U   /* 0 = link-local on-link plus one default route */
+#endif
+#ifndef RTNET_ENABLE_FRAGMENTATION
+#define RTNET_ENABLE_FRAGMENTATION  1U   /* 0 = fragments dropped, UDP limited to one frame */
+#endif
+#ifndef RTNET_RAM_BUDGET
+#define RTNET_RAM_BUDGET            0U   /* Bytes per instance (context + memory), 0 = unchecked */
+#endif
+
+#ifndef RTNET_MAX_RX_BUFFERS
 #define RTNET_MAX_RX_BUFFERS        8U
+#endif
+#ifndef RTNET_MAX_TX_BUFFERS
 #define RTNET_MAX_TX_BUFFERS        8U
+#endif
+#ifndef RTNET_MAX_TCP_CONNECTIONS
 #define RTNET_MAX_TCP_CONNECTIONS   4U
+#endif
+#ifndef RTNET_MAX_ROUTING_ENTRIES
 #define RTNET_MAX_ROUTING_ENTRIES   32U
+#endif
+#ifndef RTNET_MAX_NEIGHBOR_CACHE
 #define RTNET_MAX_NEIGHBOR_CACHE    16U
-#define RTNET_MAX_MDNS_CACHE        8U
+#endif
+#ifndef RTNET_MAX_MDNS_CACHE
+#define RTNET_MAX_MDNS_CACHE        16U  /* Cached PTR/SRV/AAAA records (< 255) */
+#endif
+#ifndef RTNET_MDNS_MAX_NAMES
+#define RTNET_MDNS_MAX_NAMES        32U  /* Interned mDNS names (< 255) */
+#endif
+#ifndef RTNET_MDNS_ARENA_SIZE
+#define RTNET_MDNS_ARENA_SIZE       1024U  /* Label arena bytes for interned names */
+#endif
+#ifndef RTNET_MDNS_HASH_SIZE
+#define RTNET_MDNS_HASH_SIZE        16U  /* Name and record hash buckets, power of two */
+#endif
+#ifndef RTNET_MDNS_MAX_QUESTIONS
+#define RTNET_MDNS_MAX_QUESTIONS    8U   /* Outstanding questions (browses and lookups, <= 32) */
+#endif
+#ifndef RTNET_MDNS_MAX_SERVICES
+#define RTNET_MDNS_MAX_SERVICES     2U   /* Services published with RTNET_mDNS_Announce */
+#endif
+#ifndef RTNET_MDNS_MAX_BROWSES
+#define RTNET_MDNS_MAX_BROWSES      2U   /* Concurrent RTNET_mDNS_BrowseStart service types */
+#endif
+#ifndef RTNET_MDNS_MAX_MESSAGE
+#define RTNET_MDNS_MAX_MESSAGE      512U /* Largest mDNS message sent */
+#endif
+#ifndef RTNET_MDNS_MAX_NAME_LEN
+#define RTNET_MDNS_MAX_NAME_LEN     128U /* Wire-format name bytes (RFC 1035 allows 255) */
+#endif
+#ifndef RTNET_MDNS_TEMPLATE_SIZE
+#define RTNET_MDNS_TEMPLATE_SIZE    256U /* Pre-encoded records per published service */
+#endif
+#ifndef RTNET_RX_POOL_SIZE
+#define RTNET_RX_POOL_SIZE          RTNET_MAX_RX_BUFFERS  /* Stack-owned RX buffers (<= 255) */
+#endif
+#ifndef RTNET_TX_POOL_SIZE
+#define RTNET_TX_POOL_SIZE          (((RTNET_MAX_TX_BUFFERS / 2U) > RTNET_TX_POOL_MIN) ? \
+                                     (RTNET_MAX_TX_BUFFERS / 2U) : RTNET_TX_POOL_MIN)  /* Full-size TX buffers */
+#endif
+#ifndef RTNET_TX_SMALL_POOL_SIZE
+#define RTNET_TX_SMALL_POOL_SIZE    RTNET_MAX_TX_BUFFERS  /* Control-size TX buffers */
+#endif
+#ifndef RTNET_TX_BUFFER_COUNT
+#define RTNET_TX_BUFFER_COUNT       (RTNET_TX_POOL_SIZE + RTNET_TX_SMALL_POOL_SIZE)  /* <= 255 */
+#endif
+#ifndef RTNET_RX_RING_SIZE
+#define RTNET_RX_RING_SIZE          8U   /* Deferred RX queue, power of two >= RTNET_RX_POOL_SIZE */
+#endif
+#ifndef RTNET_TX_RESERVE_CRITICAL
+#define RTNET_TX_RESERVE_CRITICAL   1U   /* TX buffers only RTNET_QOS_CRITICAL may take */
+#endif
+#ifndef RTNET_TX_RESERVE_HIGH
+#define RTNET_TX_RESERVE_HIGH       1U   /* Further TX buffers kept for HIGH and above */
+#endif
+#ifndef RTNET_ND_MAX_PENDING
+#define RTNET_ND_MAX_PENDING        4U   /* TX packets queued per unresolved neighbor */
+#endif
+#ifndef RTNET_ND_HASH_SIZE
+#define RTNET_ND_HASH_SIZE          (4U * RTNET_MAX_NEIGHBOR_CACHE)  /* Power of two, load <= 25% */
+#endif
+#ifndef RTNET_ND_MAX_PROBE
+#define RTNET_ND_MAX_PROBE          8U   /* Neighbor hash probe bound (WCET) */
+#endif
+#ifndef RTNET_ENABLE_ROUTE_TRIE
+#define RTNET_ENABLE_ROUTE_TRIE     1U   /* 0 = linear scan route lookup */
+#endif
+#ifndef RTNET_ROUTE_TRIE_NODES
+#define RTNET_ROUTE_TRIE_NODES      (2U * RTNET_MAX_ROUTING_ENTRIES)
+#endif
+#ifndef RTNET_DEST_CACHE_SIZE
+#define RTNET_DEST_CACHE_SIZE       8U   /* Direct-mapped, power of two */
+#endif
+#ifndef RTNET_TX_BATCH_MAX
+#define RTNET_TX_BATCH_MAX          8U   /* Frames per RTNET_HardwareTransmitBatch call */
+#endif
+#ifndef RTNET_UDP_MAX_SOCKETS
+#define RTNET_UDP_MAX_SOCKETS       8U   /* Bound UDP ports (< 255) */
+#endif
+#ifndef RTNET_UDP_HASH_SIZE
+#define RTNET_UDP_HASH_SIZE         16U  /* Port hash buckets, power of two */
+#endif
+#ifndef RTNET_UDP_QUEUE_DEPTH
+#define RTNET_UDP_QUEUE_DEPTH       4U   /* Datagrams held per socket; each pins an RX buffer */
+#endif
+#ifndef RTNET_UDP_MAX_HELD
+#define RTNET_UDP_MAX_HELD          (RTNET_RX_POOL_SIZE / 2U)  /* RX buffers all queues may pin */
+#endif
+#ifndef RTNET_ENABLE_PROFILING
+#define RTNET_ENABLE_PROFILING      1U   /* 0 = latency probes compiled out */
+#endif
+#ifndef RTNET_STATS_READ_RETRIES
+#define RTNET_STATS_READ_RETRIES    4U   /* Seqlock read attempts per counter block */
+#endif
+#ifndef RTNET_PROBE_BUCKETS
+#define RTNET_PROBE_BUCKETS         24U  /* log2 histogram buckets; the last one is open-ended */
+#endif
 
+#ifndef RTNET_MTU_SIZE
 #define RTNET_MTU_SIZE              1500U
+#endif
+#ifndef RTNET_BUFFER_SIZE
 #define RTNET_BUFFER_SIZE           1536U  /* MTU + header space */
+#endif
+#ifndef RTNET_SMALL_BUFFER_SIZE
+#define RTNET_SMALL_BUFFER_SIZE     128U   /* ND, echo, short UDP; multiple of 4 */
+#endif
+#ifndef RTNET_TX_HEADROOM
+#define RTNET_TX_HEADROOM           80U    /* Eth + IPv6 + TCP (74 B), keeps IPv6 4-byte aligned */
+#endif
+
+/* IPv6 fragmentation (RFC 8200 4.5) */
+#ifndef RTNET_REASM_SLOTS
+#define RTNET_REASM_SLOTS           2U     /* Datagrams reassembled at once (1 .. 32) */
+#endif
+#ifndef RTNET_REASM_MAX_SIZE
+#define RTNET_REASM_MAX_SIZE        4096U  /* Largest reassembled IPv6 payload; also the UDP TX limit */
+#endif
+#ifndef RTNET_REASM_MAX_HOLES
+#define RTNET_REASM_MAX_HOLES       8U     /* Missing ranges tracked per datagram (< 255) */
+#endif
+#ifndef RTNET_REASM_TIMEOUT_MS
+#define RTNET_REASM_TIMEOUT_MS      60000U /* From the first fragment (RFC 8200 4.5) */
+#endif
+
+/* Fragment geometry: payload per fragment frame (what the MTU and a TX
+ * buffer hold after Ethernet, IPv6 and Fragment headers, in 8-byte units)
+ * and frames in the largest datagram sent */
+#if (RTNET_ENABLE_FRAGMENTATION != 0U)
+#define RTNET_FRAG_LINK_LEN         ((RTNET_MTU_SIZE < (RTNET_BUFFER_SIZE - 14U)) ? \
+                                     RTNET_MTU_SIZE : (RTNET_BUFFER_SIZE - 14U))
+#define RTNET_FRAG_PAYLOAD          (((RTNET_FRAG_LINK_LEN - 40U - 8U) / 8U) * 8U)
+#define RTNET_FRAG_MAX_FRAMES       ((RTNET_REASM_MAX_SIZE + RTNET_FRAG_PAYLOAD - 1U) / \
+                                     RTNET_FRAG_PAYLOAD)
+#else
+#define RTNET_FRAG_MAX_FRAMES       1U
+#endif
 
+/* Smallest full-size TX pool in which every QoS class, below the
+ * CRITICAL/HIGH reservations, can hold one whole fragmented datagram */
+#define RTNET_TX_POOL_MIN           (RTNET_FRAG_MAX_FRAMES + RTNET_TX_RESERVE_CRITICAL + \
+                                     RTNET_TX_RESERVE_HIGH)
+
+/* ICMPv6 rate limiting (RFC 4443 2.4 f): messages per second and burst per
+ * peer address, plus messages per second of the kind from all peers
+ * (one second of burst). A rate of 0 turns that bucket off */
+#ifndef RTNET_ICMPV6_PEER_SLOTS
+#define RTNET_ICMPV6_PEER_SLOTS     16U    /* Per-peer buckets (power of two) */
+#endif
+#ifndef RTNET_ICMPV6_ECHO_RATE
+#define RTNET_ICMPV6_ECHO_RATE      10U    /* Echo Requests from one source */
+#endif
+#ifndef RTNET_ICMPV6_ECHO_BURST
+#define RTNET_ICMPV6_ECHO_BURST     10U
+#endif
+#ifndef RTNET_ICMPV6_ECHO_TOTAL
+#define RTNET_ICMPV6_ECHO_TOTAL     50U
+#endif
+#ifndef RTNET_ICMPV6_ND_RATE
+#define RTNET_ICMPV6_ND_RATE        20U    /* Neighbor Discovery from one source */
+#endif
+#ifndef RTNET_ICMPV6_ND_BURST
+#define RTNET_ICMPV6_ND_BURST       20U
+#endif
+#ifndef RTNET_ICMPV6_ND_TOTAL
+#define RTNET_ICMPV6_ND_TOTAL       100U
+#endif
+#ifndef RTNET_ICMPV6_OTHER_RATE
+#define RTNET_ICMPV6_OTHER_RATE     10U    /* Any other message from one source */
+#endif
+#ifndef RTNET_ICMPV6_OTHER_BURST
+#define RTNET_ICMPV6_OTHER_BURST    10U
+#endif
+#ifndef RTNET_ICMPV6_OTHER_TOTAL
+#define RTNET_ICMPV6_OTHER_TOTAL    50U
+#endif
+#ifndef RTNET_ICMPV6_ERROR_RATE
+#define RTNET_ICMPV6_ERROR_RATE     5U     /* Errors sent to one destination */
+#endif
+#ifndef RTNET_ICMPV6_ERROR_BURST
+#define RTNET_ICMPV6_ERROR_BURST    5U
+#endif
+#ifndef RTNET_ICMPV6_ERROR_TOTAL
+#define RTNET_ICMPV6_ERROR_TOTAL    20U
+#endif
+#ifndef RTNET_ICMPV6_ND_LOCAL_RATE
+#define RTNET_ICMPV6_ND_LOCAL_RATE  RTNET_ICMPV6_ND_RATE  /* Solicitations for our address */
+#endif
+#ifndef RTNET_ICMPV6_ND_LOCAL_BURST
+#define RTNET_ICMPV6_ND_LOCAL_BURST RTNET_ICMPV6_ND_BURST
+#endif
+#ifndef RTNET_ICMPV6_ND_LOCAL_TOTAL
+#define RTNET_ICMPV6_ND_LOCAL_TOTAL RTNET_ICMPV6_ND_TOTAL
+#endif
+
+#ifndef RTNET_TCP_MSS
 #define RTNET_TCP_MSS               1280U  /* IPv6 minimum MTU - headers */
+#endif
+#ifndef RTNET_TCP_WINDOW_SIZE
 #define RTNET_TCP_WINDOW_SIZE       4096U
+#endif
+#ifndef RTNET_TCP_MAX_RETRIES
 #define RTNET_TCP_MAX_RETRIES       3U
-#define RTNET_TCP_TIMEOUT_MS        5000U
+#endif
+#ifndef RTNET_TCP_TIMEOUT_MS
+#define RTNET_TCP_TIMEOUT_MS        5000U  /* Handshake / FIN_WAIT_2 inactivity limit */
+#endif
+#ifndef RTNET_TCP_TX_RING_SIZE
+#define RTNET_TCP_TX_RING_SIZE      RTNET_TCP_WINDOW_SIZE  /* Per connection, power of two <= 32768 */
+#endif
+#ifndef RTNET_TCP_RX_RING_SIZE
+#define RTNET_TCP_RX_RING_SIZE      RTNET_TCP_WINDOW_SIZE  /* Per connection, power of two <= 32768 */
+#endif
+#ifndef RTNET_TCP_DELAYED_ACK_MS
+#define RTNET_TCP_DELAYED_ACK_MS    100U   /* RFC 1122: < 500 ms */
+#endif
+#ifndef RTNET_TCP_RTO_MS
+#define RTNET_TCP_RTO_MS            1000U  /* Initial retransmission timeout (RFC 6298 2.1) */
+#endif
+#ifndef RTNET_TCP_RTO_MIN_MS
+#define RTNET_TCP_RTO_MIN_MS        200U   /* Lower RTO bound (RFC 6298 asks 1 s; LAN plant use) */
+#endif
+#ifndef RTNET_TCP_RTO_MAX_MS
+#define RTNET_TCP_RTO_MAX_MS        60000U
+#endif
+#ifndef RTNET_TCP_DUPACK_THRESHOLD
+#define RTNET_TCP_DUPACK_THRESHOLD  3U     /* Duplicate ACKs that trigger fast retransmit */
+#endif
+#ifndef RTNET_TCP_TIME_WAIT_MS
+#define RTNET_TCP_TIME_WAIT_MS      2000U  /* 2 x MSL, shortened for embedded use */
+#endif
+#ifndef RTNET_TCP_KEEPALIVE_MS
+#define RTNET_TCP_KEEPALIVE_MS      0U     /* Idle time before keepalive probes, 0 = off */
+#endif
+#ifndef RTNET_TCP_KEEPALIVE_INTVL_MS
+#define RTNET_TCP_KEEPALIVE_INTVL_MS 1000U
+#endif
+#ifndef RTNET_TCP_KEEPALIVE_PROBES
+#define RTNET_TCP_KEEPALIVE_PROBES  3U     /* Unanswered probes before the connection is dropped */
+#endif
+#ifndef RTNET_TCP_TIME_WAIT_SLOTS
+#define RTNET_TCP_TIME_WAIT_SLOTS   8U     /* Compact TIME_WAIT entries (oldest recycled when full) */
+#endif
+#ifndef RTNET_TCP_HASH_SIZE
+#define RTNET_TCP_HASH_SIZE         32U    /* 4-tuple index, power of two > connections + TIME_WAIT */
+#endif
+#ifndef RTNET_TCP_HASH_MAX_PROBE
+#define RTNET_TCP_HASH_MAX_PROBE    8U     /* Linear-probe bound per lookup */
+#endif
+#ifndef RTNET_TCP_MAX_LISTENERS
+#define RTNET_TCP_MAX_LISTENERS     4U
+#endif
+#ifndef RTNET_TCP_ACCEPT_BACKLOG
+#define RTNET_TCP_ACCEPT_BACKLOG    4U     /* Max established-but-unaccepted per listener */
+#endif
+#ifndef RTNET_TCP_SYN_COOKIE_PERIOD_MS
+#define RTNET_TCP_SYN_COOKIE_PERIOD_MS 8000U  /* Cookie counter step; cookies live 1-2 steps */
+#endif
 
+/* Timer wheel (TCP per-connection timers) */
+#ifndef RTNET_TIMER_WHEEL_SLOTS
+#define RTNET_TIMER_WHEEL_SLOTS     64U    /* Power of two, 2 .. 256 */
+#endif
+#ifndef RTNET_TIMER_TICK_MS
+#define RTNET_TIMER_TICK_MS         10U
+#endif
+#ifndef RTNET_TIMER_COUNT
+#define RTNET_TIMER_COUNT           (RTNET_MAX_TCP_CONNECTIONS * 3U)  /* RTX, delayed ACK, keepalive */
+#endif
+
+/* Fixed */
 #define RTNET_IPV6_ADDR_LEN         16U
 #define RTNET_MAC_ADDR_LEN          6U
 
-/* QoS Priority Levels */
+/* QoS Priority Levels (fixed) */
 #define RTNET_QOS_CRITICAL          0U  /* Real-time control */
 #define RTNET_QOS_HIGH              1U  /* Time-sensitive data */
 #define RTNET_QOS_NORMAL            2U  /* Bulk transfer */
 #define RTNET_QOS_LOW               3U  /* Background */
 
+/* Without routing the table holds the link-local prefix and one default
+ * route, scanned in constant time; nothing is aged */
+#if (RTNET_ENABLE_ROUTING == 0U)
+    #undef RTNET_MAX_ROUTING_ENTRIES
+    #define RTNET_MAX_ROUTING_ENTRIES 2U
+    #undef RTNET_ENABLE_ROUTE_TRIE
+    #define RTNET_ENABLE_ROUTE_TRIE 0U
+#endif
+
+/* TX scheduler: CRITICAL by strict priority, HIGH/NORMAL/LOW by deficit round robin */
+#ifndef RTNET_TX_QUEUE_DEPTH
+#define RTNET_TX_QUEUE_DEPTH        RTNET_TX_BUFFER_COUNT  /* Per class: a full queue is impossible */
+#endif
+#ifndef RTNET_TX_QUANTUM_HIGH
+#define RTNET_TX_QUANTUM_HIGH       4608U  /* Bytes credited per DRR turn */
+#endif
+#ifndef RTNET_TX_QUANTUM_NORMAL
+#define RTNET_TX_QUANTUM_NORMAL     3072U
+#endif
+#ifndef RTNET_TX_QUANTUM_LOW
+#define RTNET_TX_QUANTUM_LOW        1536U
+#endif
+#ifndef RTNET_TX_QUANTUM_MIN
+#define RTNET_TX_QUANTUM_MIN        64U    /* Smallest quantum accepted (bounds DRR turns per frame) */
+#endif
+#ifndef RTNET_QOS_MARK_DSCP
+#define RTNET_QOS_MARK_DSCP         1U     /* 1 = write the class DSCP into the IPv6 Traffic Class */
+#endif
+#ifndef RTNET_QOS_DSCP_CRITICAL
+#define RTNET_QOS_DSCP_CRITICAL     48U    /* CS6, network control */
+#endif
+#ifndef RTNET_QOS_DSCP_HIGH
+#define RTNET_QOS_DSCP_HIGH         46U    /* EF */
+#endif
+#ifndef RTNET_QOS_DSCP_NORMAL
+#define RTNET_QOS_DSCP_NORMAL       0U     /* Default */
+#endif
+#ifndef RTNET_QOS_DSCP_LOW
+#define RTNET_QOS_DSCP_LOW          8U     /* CS1, lower effort */
+#endif
+#ifndef RTNET_GCL_MAX_ENTRIES
+#define RTNET_GCL_MAX_ENTRIES       8U     /* Time-aware gate control list length (802.1Qbv) */
+#endif
+#ifndef RTNET_LINK_SPEED_MBPS
+#define RTNET_LINK_SPEED_MBPS       100U   /* Wire time of a frame, for gate window fitting */
+#endif
+
 /* ==================== TYPE DEFINITIONS ==================== */
 
 /**
@@ -113,10 +467,12 @@ typedef struct {
 
 /**
  * @brief Network buffer descriptor
- * @note Aligned for DMA operations
+ * @note The payload lives elsewhere (a pool arena or BSP DMA memory), so
+ *       descriptors stay small enough to keep in tightly coupled RAM
  */
-typedef struct RTNET_ALIGNED_4 {
-    uint8_t data[RTNET_BUFFER_SIZE];
+typedef struct {
+    uint8_t* data;          /* Payload storage, 4-byte aligned */
+    uint16_t capacity;      /* Bytes available at data */
     uint16_t length;
     uint16_t offset;
     uint8_t qos_priority;
@@ -124,6 +480,65 @@ typedef struct RTNET_ALIGNED_4 {
     uint32_t timestamp_ms;
 } RTNET_Buffer_t;
 
+#define RTNET_QOS_LEVELS            4U
+#define RTNET_POOL_WORDS(n)         (((n) + 31U) / 32U)
+#define RTNET_POOL_MAX_SIZE         ((RTNET_TX_POOL_SIZE > RTNET_RX_POOL_SIZE) ? \
+                                     ((RTNET_TX_POOL_SIZE > RTNET_TX_SMALL_POOL_SIZE) ? \
+                                      RTNET_TX_POOL_SIZE : RTNET_TX_SMALL_POOL_SIZE) : \
+                                     ((RTNET_RX_POOL_SIZE > RTNET_TX_SMALL_POOL_SIZE) ? \
+                                      RTNET_RX_POOL_SIZE : RTNET_TX_SMALL_POOL_SIZE))
+#define RTNET_POOL_MAX_WORDS        RTNET_POOL_WORDS(RTNET_POOL_MAX_SIZE)
+
+/**
+ * @brief One gate control list entry (IEEE 802.1Qbv SetGateStates)
+ */
+typedef struct {
+    uint8_t gate_mask;      /* Bit n set = class n (RTNET_QOS_*) may transmit */
+    uint32_t interval_us;   /* Duration of this entry, non-zero */
+} RTNET_GateEntry_t;
+
+/**
+ * @brief Per-class TX queues in front of the MAC (rtnet_sched.c)
+ */
+typedef struct {
+    RTNET_Buffer_t* queue[RTNET_QOS_LEVELS][RTNET_TX_QUEUE_DEPTH];  /* Oldest at head */
+    uint8_t head[RTNET_QOS_LEVELS];
+    uint8_t count[RTNET_QOS_LEVELS];
+    uint16_t quantum[RTNET_QOS_LEVELS];  /* DRR bytes per turn (CRITICAL unused) */
+    uint32_t deficit[RTNET_QOS_LEVELS];
+    uint8_t current;                     /* DRR class holding the turn */
+    bool credited;                       /* Quantum already added for this turn */
+    bool running;                        /* Drain in progress (MAC hook may re-enter) */
+    RTNET_GateEntry_t gcl[RTNET_GCL_MAX_ENTRIES];
+    uint32_t gcl_base_us;                /* Cycle start, RTNET_GetTimeUs() time base */
+    uint32_t gcl_cycle_us;               /* Sum of the intervals, 0 = gates always open */
+    uint8_t gcl_count;
+} RTNET_TxScheduler_t;
+
+/**
+ * @brief Fixed buffer pool (see rtnet_buffer.h)
+ * @note Free set is a bitmap plus a free counter, both updated atomically
+ */
+typedef struct {
+    RTNET_Buffer_t* buffers;
+    volatile uint32_t free_mask[RTNET_POOL_MAX_WORDS];  /* Bit set = buffer free */
+    volatile uint32_t free_count;
+    uint16_t size;
+    uint16_t buffer_size;              /* Payload bytes per buffer (size class) */
+    uint16_t floor[RTNET_QOS_LEVELS];  /* Free buffers each class must leave behind */
+    volatile uint32_t min_free;        /* Low-water mark of free_count (high-water of use) */
+} RTNET_BufferPool_t;
+
+/**
+ * @brief Single-producer/single-consumer RX descriptor ring (see rtnet_buffer.h)
+ * @note head/tail are free-running; each is written by one side only
+ */
+typedef struct {
+    RTNET_Buffer_t* slots[RTNET_RX_RING_SIZE];
+    volatile uint32_t head;   /* Next slot to fill (producer: Ethernet ISR) */
+    volatile uint32_t tail;   /* Next slot to drain (consumer: stack task) */
+} RTNET_RxRing_t;
+
 /**
  * @brief Protocol types
  */
@@ -145,9 +560,22 @@ typedef enum {
     RTNET_TCP_FIN_WAIT,
     RTNET_TCP_CLOSE_WAIT,
     RTNET_TCP_CLOSING,
-    RTNET_TCP_TIME_WAIT
+    RTNET_TCP_TIME_WAIT,
+    RTNET_TCP_FIN_WAIT_2,     /* Our FIN acknowledged, waiting for the peer's */
+    RTNET_TCP_LAST_ACK        /* Peer closed first, our FIN in flight */
 } RTNET_TCPState_t;
 
+/**
+ * @brief Byte ring for TCP send/receive buffering
+ * @note head/tail are free-running byte counters; size is a power of two
+ */
+typedef struct {
+    uint8_t* data;
+    uint32_t head;          /* Bytes ever written */
+    uint32_t tail;          /* Bytes ever consumed */
+    uint16_t size;
+} RTNET_ByteRing_t;
+
 /**
  * @brief TCP connection control block
  */
@@ -169,9 +597,87 @@ typedef struct {
     uint8_t retransmit_count;
     uint32_t last_activity_ms;
     
+    /* Sliding window */
+    uint32_t iss;            /* Initial send sequence (SYN) */
+    uint32_t send_max;       /* Highest sequence sent + 1 (send_next rewinds on timeout) */
+    RTNET_ByteRing_t tx_ring;  /* Unacked + unsent data; tail is at send_unack */
+    RTNET_ByteRing_t rx_ring;  /* In-order data not yet read by the application */
+    uint16_t peer_mss;
+    uint32_t rto_ms;
+    uint8_t ack_pending;     /* In-order segments received since our last ACK */
+    
+    /* RTT estimation (RFC 6298) and loss recovery */
+    uint32_t srtt;           /* Smoothed RTT, ms x 8 */
+    uint32_t rttvar;         /* RTT variation, ms x 4 */
+    uint32_t rtt_seq;        /* Segment being timed (one at a time, Karn) */
+    uint32_t rtt_start_ms;
+    uint8_t dup_acks;
+    uint8_t keepalive_probes;
+    uint8_t flags;           /* RTNET_TCP_F_* (rtnet_tcp.c) */
+    
     bool in_use;
 } RTNET_TCPConnection_t;
 
+/**
+ * @brief Compact TIME_WAIT entry (the control block is already free)
+ */
+typedef struct {
+    RTNET_IPv6Addr_t remote_addr;
+    uint16_t local_port;
+    uint16_t remote_port;
+    uint32_t send_next;      /* For re-ACKing a retransmitted FIN */
+    uint32_t recv_next;
+    uint32_t expires_ms;
+} RTNET_TCPTimeWait_t;
+
+/**
+ * @brief Listening port with its accept queue
+ */
+typedef struct {
+    uint16_t port;
+    uint8_t backlog;
+    uint8_t accept_head;
+    uint8_t accept_count;
+    uint8_t accept[RTNET_TCP_ACCEPT_BACKLOG];  /* Connection ids, oldest at accept_head */
+    bool in_use;
+} RTNET_TCPListener_t;
+
+/**
+ * @brief TCP demultiplexing state (rtnet_tcp.c)
+ */
+typedef struct {
+    uint16_t index[RTNET_TCP_HASH_SIZE];  /* Connection id, or TIME_WAIT slot | 0x8000 */
+    RTNET_TCPTimeWait_t time_wait[RTNET_TCP_TIME_WAIT_SLOTS];  /* FIFO, oldest at tw_head */
+    uint16_t tw_head;
+    uint16_t tw_count;
+    uint32_t seed;           /* Per-boot hash seed */
+    RTNET_TCPListener_t listeners[RTNET_TCP_MAX_LISTENERS];
+    uint32_t cookie_secret;  /* SYN cookie key */
+} RTNET_TCPTable_t;
+
+/**
+ * @brief Timer wheel entry
+ */
+typedef struct {
+    uint32_t deadline_ms;
+    uint16_t next;          /* Slot list links, RTNET_TIMER_NONE terminates */
+    uint16_t prev;
+    uint8_t slot;
+    bool armed;
+} RTNET_TimerNode_t;
+
+/**
+ * @brief Hashed timer wheel (rtnet_timer.c)
+ * @note Timers further out than one revolution stay in their slot and are
+ *       skipped until their deadline is reached
+ */
+typedef struct {
+    RTNET_TimerNode_t nodes[RTNET_TIMER_COUNT];
+    uint16_t slots[RTNET_TIMER_WHEEL_SLOTS];  /* List heads */
+    uint32_t tick_ms;       /* Time of the last processed tick */
+    uint8_t current;        /* Slot of the last processed tick */
+} RTNET_TimerWheel_t;
+
 /**
  * @brief Routing table entry
  */
@@ -185,22 +691,163 @@ typedef struct {
     bool valid;
 } RTNET_RouteEntry_t;
 
+#define RTNET_ROUTE_NONE            0xFFFFU  /* Null trie node / route index */
+
+/**
+ * @brief Route trie node (path-compressed binary trie)
+ * @note Each node owns the prefix prefix/prefix_len and branches on the
+ *       bit right after it; split nodes carry no routes
+ */
+typedef struct {
+    RTNET_IPv6Addr_t prefix;    /* Bits beyond prefix_len are zero */
+    uint8_t prefix_len;
+    uint16_t child[2];          /* Node indices, RTNET_ROUTE_NONE if absent */
+    uint16_t routes;            /* First routing_table index with this prefix */
+} RTNET_RouteTrieNode_t;
+
+/**
+ * @brief Longest-prefix-match index over routing_table[]
+ */
+typedef struct {
+    RTNET_RouteTrieNode_t nodes[RTNET_ROUTE_TRIE_NODES];
+    uint16_t route_next[RTNET_MAX_ROUTING_ENTRIES];  /* Same-prefix chain */
+    uint16_t root;
+    uint16_t node_count;
+} RTNET_RouteTrie_t;
+
+/**
+ * @brief Neighbor cache states (RFC 4861 7.3.2)
+ */
+#define RTNET_ND_STATE_INCOMPLETE   0U  /* Resolution in progress */
+#define RTNET_ND_STATE_REACHABLE    1U  /* Confirmed within ReachableTime */
+#define RTNET_ND_STATE_STALE        2U  /* Usable, reachability unknown */
+#define RTNET_ND_STATE_DELAY        3U  /* Sent to while STALE, probe pending */
+#define RTNET_ND_STATE_PROBE        4U  /* Unicast solicitations in progress */
+
+#define RTNET_ND_NONE               0xFFFFU  /* Null neighbor index */
+
 /**
  * @brief Neighbor cache entry (IPv6 NDP)
  */
 typedef struct {
     RTNET_IPv6Addr_t ipv6_addr;
     RTNET_MACAddr_t mac_addr;
-    uint8_t state;  /* Reachable, stale, probe, etc. */
-    uint32_t last_confirmed_ms;
+    uint8_t state;  /* RTNET_ND_STATE_* */
+    uint32_t last_confirmed_ms;  /* Last reachability confirmation */
+    uint32_t timer_ms;           /* Last solicitation sent / DELAY start */
+    uint32_t last_used_ms;       /* Last TX use */
+    uint16_t lru_prev;
+    uint16_t lru_next;           /* Free list link while not valid */
+    uint8_t solicit_count;
+    uint8_t pending_count;
+    uint8_t pending[RTNET_ND_MAX_PENDING];  /* TX buffer indices awaiting resolution */
     bool valid;
 } RTNET_NeighborEntry_t;
 
+/**
+ * @brief Neighbor cache index (open-addressed hash + LRU list)
+ * @note Linear probing bounded by RTNET_ND_MAX_PROBE; the LRU list makes
+ *       eviction O(1)
+ */
+typedef struct {
+    uint16_t slots[RTNET_ND_HASH_SIZE];  /* neighbor_cache indices */
+    uint16_t lru_head;                   /* Most recently used */
+    uint16_t lru_tail;                   /* Next eviction victim */
+    uint16_t free_head;
+} RTNET_NeighborIndex_t;
+
+#define RTNET_DEST_CACHE_HDR_LEN    54U  /* Ethernet (14) + IPv6 (40) */
+
+/* Reassembly buffer: Ethernet + IPv6 header in front of the payload */
+#define RTNET_REASM_BUFFER_SIZE     ((RTNET_DEST_CACHE_HDR_LEN + RTNET_REASM_MAX_SIZE + 3U) & ~3U)
+
+/**
+ * @brief Byte range still missing from a datagram being reassembled (RFC 815)
+ */
+typedef struct {
+    uint16_t first;
+    uint16_t last;              /* Inclusive; 0xFFFF until the last fragment arrives */
+} RTNET_ReasmHole_t;
+
+/**
+ * @brief Reassembly slot: one datagram collected from its fragments
+ * @note The buffer holds the Ethernet + IPv6 header of the datagram at
+ *       data[0] and its fragmentable part from data[RTNET_DEST_CACHE_HDR_LEN]
+ */
+typedef struct {
+    RTNET_Buffer_t* buffer;     /* From reasm_pool, NULL = slot free */
+    RTNET_IPv6Addr_t src_addr;
+    RTNET_IPv6Addr_t dst_addr;
+    uint32_t id;                /* Fragment header Identification */
+    uint32_t start_ms;          /* First fragment received */
+    uint16_t total_len;         /* Fragmentable part length, 0 until the last fragment */
+    uint16_t end;               /* One past the highest byte received */
+    uint16_t first_len;         /* Data of the offset 0 fragment, 0 until it arrives */
+    RTNET_ReasmHole_t holes[RTNET_REASM_MAX_HOLES];
+    uint8_t hole_count;
+    uint8_t next_header;        /* From the offset 0 fragment */
+} RTNET_ReasmSlot_t;
+
+/**
+ * @brief ICMPv6 rate limit classes
+ * @note Solicited Neighbor Advertisements for an entry being resolved
+ *       (INCOMPLETE or PROBE) are never limited
+ */
+typedef enum {
+    RTNET_ICMPV6_LIMIT_ECHO = 0,    /* Echo Requests received */
+    RTNET_ICMPV6_LIMIT_ND,          /* Neighbor Discovery (types 133-137) received */
+    RTNET_ICMPV6_LIMIT_OTHER,       /* Every other message received */
+    RTNET_ICMPV6_LIMIT_ERROR,       /* Error messages sent, per destination */
+    RTNET_ICMPV6_LIMIT_ND_LOCAL,    /* Neighbor Solicitations for our address received */
+    RTNET_ICMPV6_LIMIT_COUNT
+} RTNET_ICMPv6Limit_t;
+
+/**
+ * @brief Rate limit of one class (messages per second, 0 = unlimited)
+ */
+typedef struct {
+    uint16_t peer_rate;         /* From (errors: to) one address */
+    uint16_t peer_burst;        /* Messages a quiet peer may send back to back */
+    uint16_t total_rate;        /* All peers together */
+    uint16_t total_burst;
+} RTNET_ICMPv6RateLimit_t;
+
+/**
+ * @brief Token bucket, credit in 1/1000 message
+ */
+typedef struct {
+    uint32_t credit;
+    uint32_t last_ms;           /* Last refill */
+} RTNET_TokenBucket_t;
+
+/**
+ * @brief Per-peer bucket, found by a seeded hash of address and class
+ */
+typedef struct {
+    RTNET_TokenBucket_t bucket;
+    uint32_t key;               /* Address hash */
+    uint8_t limit;              /* RTNET_ICMPv6Limit_t, RTNET_ICMPV6_LIMIT_COUNT = free */
+} RTNET_ICMPv6Peer_t;
+
+/**
+ * @brief Destination cache entry (resolved TX path for one destination)
+ * @note Valid only while generation equals the context's dest_cache_gen;
+ *       route/neighbor changes bump the counter instead of scanning
+ */
+typedef struct {
+    RTNET_IPv6Addr_t destination;
+    RTNET_RouteEntry_t* route;          /* NULL for multicast */
+    RTNET_NeighborEntry_t* neighbor;    /* NULL for multicast */
+    uint32_t pseudo_sum;                /* Checksum partial over src + dst address */
+    uint32_t generation;
+    uint8_t header[RTNET_DEST_CACHE_HDR_LEN];  /* Prebuilt Ethernet + IPv6 header */
+} RTNET_DestCacheEntry_t;
+
 /**
  * @brief mDNS service record
  */
 typedef struct {
-    char service_name[64];
+    char service_name[64];      /* Instance name, e.g. "printer._http._tcp.local" */
     RTNET_IPv6Addr_t ipv6_addr;
     uint16_t port;
     uint32_t ttl_ms;
@@ -208,6 +855,193 @@ typedef struct {
     bool valid;
 } RTNET_mDNSRecord_t;
 
+/* mDNS resource record types (RFC 1035, RFC 2782, RFC 3596) */
+#define RTNET_MDNS_TYPE_PTR         12U
+#define RTNET_MDNS_TYPE_TXT         16U
+#define RTNET_MDNS_TYPE_AAAA        28U
+#define RTNET_MDNS_TYPE_SRV         33U
+#define RTNET_MDNS_TYPE_ANY         255U
+
+/**
+ * @brief Interned mDNS name (wire format, bytes in the label arena)
+ */
+typedef struct {
+    uint32_t hash;              /* FNV-1a over the lower-cased wire bytes */
+    uint16_t offset;            /* First wire byte in the arena */
+    uint8_t length;             /* Wire length, 0 = free slot */
+    uint8_t refs;               /* Cache entries, questions and services using it */
+    uint8_t next;               /* Hash chain, RTNET_MDNS_MAX_NAMES = end */
+} RTNET_mDNSName_t;
+
+/**
+ * @brief Cached mDNS resource record
+ */
+typedef struct {
+    uint32_t expires_ms;
+    uint32_t ttl_ms;            /* As received, for known-answer freshness */
+    RTNET_IPv6Addr_t addr;      /* AAAA */
+    uint16_t type;              /* RTNET_MDNS_TYPE_PTR, _SRV or _AAAA */
+    uint16_t port;              /* SRV */
+    uint8_t name;               /* Owner name index */
+    uint8_t target;             /* PTR/SRV target name index */
+    uint8_t next;               /* Hash chain, RTNET_MAX_MDNS_CACHE = end */
+    uint8_t heap_pos;           /* Slot in the expiry heap */
+    bool reported;              /* PTR: browse told RTNET_MDNS_INSTANCE_ADDED */
+    bool valid;
+} RTNET_mDNSCacheEntry_t;
+
+/**
+ * @brief Outstanding mDNS question
+ */
+typedef struct {
+    uint32_t next_send_ms;
+    uint32_t interval_ms;       /* Doubles after each send (RFC 6762 5.2) */
+    uint32_t expires_ms;        /* Dropped when RTNET_mDNS_Query stops asking */
+    uint16_t type;
+    uint8_t name;
+    bool continuous;            /* Browse question: never expires */
+    bool in_use;
+} RTNET_mDNSQuestion_t;
+
+#define RTNET_MDNS_TEMPLATE_RECORDS 4U   /* PTR, SRV, TXT, AAAA */
+#define RTNET_MDNS_TEMPLATE_FIXUPS  8U   /* Two names per record at most */
+
+/**
+ * @brief Record of a service template
+ */
+typedef struct {
+    uint16_t offset;            /* First byte in the template */
+    uint16_t length;
+    uint16_t ttl_pos;           /* TTL field, from the record start */
+    uint8_t deps;               /* Records its compression pointers lead into */
+} RTNET_mDNSTemplateRR_t;
+
+/**
+ * @brief Compression pointer of a service template, rewritten on copy
+ */
+typedef struct {
+    uint16_t pos;               /* From the start of the record holding it */
+    uint16_t target_off;        /* From the start of the record pointed into */
+    uint8_t record;
+    uint8_t target;
+} RTNET_mDNSTemplateFixup_t;
+
+/**
+ * @brief Service published by RTNET_mDNS_Announce
+ */
+typedef struct {
+    uint32_t ttl_s;
+    uint32_t next_announce_ms;
+    uint16_t port;
+    uint8_t type_name;          /* e.g. "_http._tcp.local" */
+    uint8_t instance;           /* Host label + type_name */
+    uint8_t announce_left;
+    uint8_t fixup_count;
+    bool in_use;
+    RTNET_mDNSTemplateRR_t records[RTNET_MDNS_TEMPLATE_RECORDS];
+    RTNET_mDNSTemplateFixup_t fixups[RTNET_MDNS_TEMPLATE_FIXUPS];
+    uint8_t tmpl[RTNET_MDNS_TEMPLATE_SIZE];  /* Records as encoded at offset 12 */
+} RTNET_mDNSService_t;
+
+/**
+ * @brief Browse events
+ */
+typedef enum {
+    RTNET_MDNS_INSTANCE_ADDED   = 0,    /* Resolved down to its address */
+    RTNET_MDNS_INSTANCE_REMOVED = 1     /* PTR expired, said goodbye or was evicted */
+} RTNET_mDNSBrowseEvent_t;
+
+/**
+ * @brief Browse callback (called from the RX path, RTNET_PeriodicTask or
+ *        RTNET_mDNS_BrowseStart)
+ * @param record Instance; on removal the address and port are filled
+ *        only if still cached (valid = false)
+ */
+typedef void (*RTNET_mDNSBrowseCallback_t)(uint8_t browse_id,
+                                           RTNET_mDNSBrowseEvent_t event,
+                                           const RTNET_mDNSRecord_t* record);
+
+/**
+ * @brief Running service browse
+ */
+typedef struct {
+    RTNET_mDNSBrowseCallback_t callback;
+    uint8_t type_name;
+    bool in_use;
+} RTNET_mDNSBrowse_t;
+
+/**
+ * @brief mDNS engine state (querier cache and responder)
+ */
+typedef struct {
+    RTNET_mDNSName_t names[RTNET_MDNS_MAX_NAMES];
+    uint8_t name_hash[RTNET_MDNS_HASH_SIZE];    /* Chain heads by name hash */
+    uint8_t arena[RTNET_MDNS_ARENA_SIZE];       /* [index][length][wire name] records */
+    uint16_t arena_used;
+    RTNET_mDNSCacheEntry_t cache[RTNET_MAX_MDNS_CACHE];
+    uint8_t cache_hash[RTNET_MDNS_HASH_SIZE];   /* Chain heads by owner hash and type */
+    uint8_t heap[RTNET_MAX_MDNS_CACHE];         /* Cache indices, min-heap on expires_ms */
+    uint8_t heap_count;
+    RTNET_mDNSQuestion_t questions[RTNET_MDNS_MAX_QUESTIONS];
+    RTNET_mDNSService_t services[RTNET_MDNS_MAX_SERVICES];
+    RTNET_mDNSBrowse_t browses[RTNET_MDNS_MAX_BROWSES];
+    uint8_t name_free;          /* Free name slots, chained through next */
+    uint8_t cache_free;         /* Free cache entries, chained through next */
+    uint8_t host;               /* Host name index, RTNET_MDNS_MAX_NAMES = not set */
+    uint8_t socket_id;
+    bool bound;                 /* UDP 5353 bound on first use */
+} RTNET_mDNS_t;
+
+/**
+ * @brief Borrowed view of a received transport segment
+ * @note All pointers reference the RX frame in place and are only valid
+ *       for the duration of the handler call; copy anything kept longer
+ */
+typedef struct {
+    const RTNET_IPv6Addr_t* src_addr;
+    const RTNET_IPv6Addr_t* dst_addr;
+    const RTNET_MACAddr_t* src_mac;
+    const uint8_t* transport;   /* Transport header */
+    const uint8_t* payload;     /* Transport payload */
+    uint16_t payload_len;
+    uint16_t src_port;          /* Host byte order */
+    uint16_t dst_port;          /* Host byte order */
+    uint8_t next_header;        /* RTNET_PROTO_UDP or RTNET_PROTO_TCP */
+    uint8_t traffic_class;
+    uint8_t hop_limit;
+} RTNET_RxView_t;
+
+/**
+ * @brief Transport RX handler (called from the RX path context)
+ */
+typedef void (*RTNET_RxHandler_t)(const RTNET_RxView_t* view);
+
+/**
+ * @brief Datagram taken from a UDP socket queue
+ * @note payload borrows from buffer, which stays allocated from the RX pool
+ *       until RTNET_UDP_Release
+ */
+typedef struct {
+    RTNET_Buffer_t* buffer;
+    const uint8_t* payload;
+    uint16_t payload_len;
+    uint16_t src_port;          /* Host byte order */
+    RTNET_IPv6Addr_t src_addr;
+} RTNET_UDPPacket_t;
+
+/**
+ * @brief Bound UDP port (callback or receive queue)
+ */
+typedef struct {
+    RTNET_RxHandler_t handler;  /* Non-NULL: called in RX context, nothing queued */
+    RTNET_UDPPacket_t queue[RTNET_UDP_QUEUE_DEPTH];  /* Oldest at head */
+    uint16_t port;
+    uint8_t head;
+    uint8_t count;
+    uint8_t next;               /* Hash chain, RTNET_UDP_MAX_SOCKETS = end */
+    bool in_use;
+} RTNET_UDPSocket_t;
+
 /**
  * @brief Network stack statistics
  */
@@ -223,24 +1057,212 @@ typedef struct {
 } RTNET_Statistics_t;
 
 /**
- * @brief Stack global context
+ * @brief Upper-layer protocol index of the per-protocol counters
+ */
+typedef enum {
+    RTNET_STATS_PROTO_ICMPV6 = 0,
+    RTNET_STATS_PROTO_UDP,
+    RTNET_STATS_PROTO_TCP,
+    RTNET_STATS_PROTO_OTHER,
+    RTNET_STATS_PROTO_COUNT
+} RTNET_StatsProto_t;
+
+/**
+ * @brief Why a packet was dropped (each drop also counts in RTNET_Statistics_t)
+ */
+typedef enum {
+    RTNET_DROP_MALFORMED = 0,   /* Truncated or inconsistent headers */
+    RTNET_DROP_NOT_IPV6,        /* EtherType is not IPv6 */
+    RTNET_DROP_NOT_FOR_US,      /* Foreign unicast MAC or IPv6 destination */
+    RTNET_DROP_CHECKSUM,        /* Upper-layer checksum failed */
+    RTNET_DROP_UNSUPPORTED,     /* Unknown next header, or a fragment reassembly can't take */
+    RTNET_DROP_ND_INVALID,      /* Neighbor Discovery message failed validation */
+    RTNET_DROP_NO_LISTENER,     /* No socket or handler for the port/protocol */
+    RTNET_DROP_RX_RING_FULL,    /* Deferred RX ring full */
+    RTNET_DROP_NO_RX_BUFFER,    /* No RX buffer to queue a datagram in */
+    RTNET_DROP_SOCKET_QUEUE_FULL,
+    RTNET_DROP_NO_TX_BUFFER,
+    RTNET_DROP_TX_QUEUE_FULL,   /* TX scheduler class queue full */
+    RTNET_DROP_NO_ROUTE,
+    RTNET_DROP_ND_QUEUE_FULL,   /* Too many packets waiting for one neighbor */
+    RTNET_DROP_ND_UNRESOLVED,   /* Neighbor unreachable or evicted with packets pending */
+    RTNET_DROP_REASM_NO_SLOT,   /* No free reassembly slot, buffer or hole descriptor */
+    RTNET_DROP_REASM_TIMEOUT,   /* Datagram still incomplete after RTNET_REASM_TIMEOUT_MS */
+    RTNET_DROP_RATE_LIMITED,    /* ICMPv6 over its rate limit (received, or error not sent) */
+    RTNET_DROP_REASON_COUNT
+} RTNET_DropReason_t;
+
+/**
+ * @brief Extended statistics
+ * @note The first eight counters are those of RTNET_Statistics_t
+ */
+typedef struct {
+    uint32_t rx_packets;
+    uint32_t tx_packets;
+    uint32_t rx_errors;
+    uint32_t tx_errors;
+    uint32_t rx_dropped;
+    uint32_t tx_dropped;
+    uint32_t checksum_errors;
+    uint32_t routing_errors;
+    uint64_t rx_bytes;                          /* Frames accepted for this node */
+    uint64_t tx_bytes;                          /* Frames handed to the MAC */
+    uint32_t rx_proto[RTNET_STATS_PROTO_COUNT];
+    uint32_t tx_proto[RTNET_STATS_PROTO_COUNT];
+    uint32_t tx_qos[RTNET_QOS_LEVELS];          /* Frames sent per QoS class */
+    uint32_t drops[RTNET_DROP_REASON_COUNT];
+    uint32_t dest_cache_hits;                   /* Route + neighbor served by the cache */
+    uint32_t dest_cache_misses;
+    uint32_t neighbor_hits;                     /* Next hop resolved on a destination cache miss */
+    uint32_t neighbor_misses;
+    uint16_t rx_pool_high_water;                /* Most buffers in use at once */
+    uint16_t tx_pool_high_water;
+    uint16_t tx_small_pool_high_water;
+} RTNET_StatisticsExt_t;
+
+/**
+ * @brief Counter block written by one execution context
+ * @note seq is odd while the writer is updating the block
+ */
+typedef struct {
+    volatile uint32_t seq;
+    RTNET_StatisticsExt_t c;    /* High-water fields unused (read from the pools) */
+} RTNET_StatsBlock_t;
+
+#define RTNET_STATS_CTX_TASK        0U
+#define RTNET_STATS_CTX_ISR         1U
+#define RTNET_STATS_CONTEXTS        2U
+
+/* RTNET_GetStatisticsSnapshot: header, 64-bit byte counters, 32-bit counters, high-water marks */
+#define RTNET_STATS_SNAPSHOT_VERSION  1U
+#define RTNET_STATS_SNAPSHOT_LEN    (12U + 16U + (4U * (8U + (2U * RTNET_STATS_PROTO_COUNT) + \
+                                     RTNET_QOS_LEVELS + RTNET_DROP_REASON_COUNT + 4U)) + 6U)
+
+/**
+ * @brief Instrumented code paths (latency probes)
+ */
+typedef enum {
+    RTNET_PROBE_RX_FRAME = 0,   /* Whole RX frame: parse, demux and handler */
+    RTNET_PROBE_RX_ICMPV6,      /* ICMPv6/NDP handler */
+    RTNET_PROBE_RX_UDP,         /* UDP handler */
+    RTNET_PROBE_RX_TCP,         /* TCP handler */
+    RTNET_PROBE_ROUTE_LOOKUP,   /* Longest-prefix match */
+    RTNET_PROBE_CHECKSUM,       /* Software checksum, RX verify and TX insert */
+    RTNET_PROBE_TX_BUILD,       /* Header + checksum build of an outgoing frame */
+    RTNET_PROBE_COUNT
+} RTNET_ProbePoint_t;
+
+/**
+ * @brief Latency histogram of one probe, in RTNET_GetCycleCount ticks
+ * @note Bucket 0 holds 0-1 ticks, bucket i holds [2^i, 2^(i+1)), the last
+ *       bucket everything above
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+    uint32_t p99_cycles;        /* Upper edge of the 99th percentile bucket, capped at max */
+    uint32_t buckets[RTNET_PROBE_BUCKETS];
+} RTNET_LatencyStats_t;
+
+/**
+ * @brief Checksum offload flags (per upper-layer protocol)
+ */
+#define RTNET_HWCAP_CSUM_ICMPV6     (1UL << 0U)
+#define RTNET_HWCAP_CSUM_UDP        (1UL << 1U)
+#define RTNET_HWCAP_CSUM_TCP        (1UL << 2U)
+
+/**
+ * @brief Transmit feature flags
+ */
+#define RTNET_HWCAP_TX_LAUNCH_TIME  (1UL << 0U)  /* MAC holds a frame until its launch time */
+
+/**
+ * @brief MAC offload capabilities (reported by BSP)
  */
 typedef struct {
-    RTNET_Buffer_t rx_buffers[RTNET_MAX_RX_BUFFERS];
-    RTNET_Buffer_t tx_buffers[RTNET_MAX_TX_BUFFERS];
+    uint32_t rx_csum;   /* RTNET_HWCAP_CSUM_*: verified by MAC, bad frames dropped */
+    uint32_t tx_csum;   /* RTNET_HWCAP_CSUM_*: inserted by MAC (field left zero) */
+    uint32_t tx_features;  /* RTNET_HWCAP_TX_*: transmit features of the MAC */
+} RTNET_HardwareCaps_t;
+
+/**
+ * @brief Payload memory of one stack instance
+ * @note Declare with RTNET_SECTION_DMA RTNET_ALIGNED_4; the context itself
+ *       can sit in faster RAM
+ */
+typedef struct {
+    uint8_t rx[RTNET_RX_POOL_SIZE * RTNET_BUFFER_SIZE];  /* Written by MAC DMA */
+    uint8_t tx[(RTNET_TX_POOL_SIZE * RTNET_BUFFER_SIZE) +
+               (RTNET_TX_SMALL_POOL_SIZE * RTNET_SMALL_BUFFER_SIZE)];  /* Full-size first */
+#if (RTNET_ENABLE_TCP != 0U)
+    uint8_t tcp_tx[RTNET_MAX_TCP_CONNECTIONS][RTNET_TCP_TX_RING_SIZE];
+    uint8_t tcp_rx[RTNET_MAX_TCP_CONNECTIONS][RTNET_TCP_RX_RING_SIZE];
+#endif
+#if (RTNET_ENABLE_FRAGMENTATION != 0U)
+    uint8_t reasm[RTNET_REASM_SLOTS * RTNET_REASM_BUFFER_SIZE];
+#endif
+} RTNET_Memory_t;
+
+/**
+ * @brief Stack context: one per interface / stack instance
+ */
+typedef struct {
+    RTNET_Buffer_t rx_buffers[RTNET_RX_POOL_SIZE];
+    RTNET_Buffer_t tx_buffers[RTNET_TX_BUFFER_COUNT];  /* Full-size, then control-size */
+    RTNET_BufferPool_t rx_pool;
+    RTNET_BufferPool_t tx_pool;
+    RTNET_BufferPool_t tx_small_pool;
+    RTNET_RxRing_t rx_ring;
+    RTNET_TxScheduler_t tx_sched;
+    RTNET_ICMPv6RateLimit_t icmp_limits[RTNET_ICMPV6_LIMIT_COUNT];
+    RTNET_TokenBucket_t icmp_total[RTNET_ICMPV6_LIMIT_COUNT];
+    RTNET_ICMPv6Peer_t icmp_peers[RTNET_ICMPV6_PEER_SLOTS];
+    uint32_t icmp_seed;         /* Per-boot peer hash seed */
+#if (RTNET_ENABLE_FRAGMENTATION != 0U)
+    RTNET_Buffer_t reasm_buffers[RTNET_REASM_SLOTS];
+    RTNET_BufferPool_t reasm_pool;
+    RTNET_ReasmSlot_t reasm[RTNET_REASM_SLOTS];
+    uint32_t frag_id;           /* Identification of the next fragmented datagram */
+#endif
+#if (RTNET_ENABLE_TCP != 0U)
     RTNET_TCPConnection_t tcp_connections[RTNET_MAX_TCP_CONNECTIONS];
+    RTNET_TCPTable_t tcp_table;
+    RTNET_TimerWheel_t tcp_timers;
+#endif
+    RTNET_UDPSocket_t udp_sockets[RTNET_UDP_MAX_SOCKETS];
+    uint8_t udp_hash[RTNET_UDP_HASH_SIZE];   /* Chain heads by port */
+    uint8_t udp_held;                        /* RX pool buffers pinned by socket queues */
     RTNET_RouteEntry_t routing_table[RTNET_MAX_ROUTING_ENTRIES];
+#if (RTNET_ENABLE_ROUTE_TRIE != 0U)
+    RTNET_RouteTrie_t route_trie;
+#endif
     RTNET_NeighborEntry_t neighbor_cache[RTNET_MAX_NEIGHBOR_CACHE];
-    RTNET_mDNSRecord_t mdns_cache[RTNET_MAX_MDNS_CACHE];
+    RTNET_NeighborIndex_t neighbor_index;
+#if (RTNET_ENABLE_MDNS != 0U)
+    RTNET_mDNS_t mdns;
+#endif
+    RTNET_DestCacheEntry_t dest_cache[RTNET_DEST_CACHE_SIZE];
+    uint32_t dest_cache_gen;
     
     RTNET_IPv6Addr_t local_ipv6;
     RTNET_MACAddr_t local_mac;
     
-    RTNET_Statistics_t stats;
+    RTNET_StatsBlock_t stats[RTNET_STATS_CONTEXTS];  /* Summed on read */
+#if (RTNET_ENABLE_PROFILING != 0U)
+    RTNET_LatencyStats_t latency[RTNET_PROBE_COUNT];  /* p99_cycles filled on read */
+#endif
+    RTNET_HardwareCaps_t hw_caps;
+    
+    RTNET_RxHandler_t udp_rx_handler;
+    RTNET_RxHandler_t tcp_rx_handler;
+    RTNET_Buffer_t* rx_current;    /* Pool buffer being parsed by RTNET_PollRx */
     
     uint16_t next_ephemeral_port;
     uint32_t sequence_number;
     
+    RTNET_Memory_t* memory;     /* Kept by RTNET_Initialize */
+    uint8_t interface_id;       /* Kept by RTNET_Initialize */
     bool initialized;
 } RTNET_Context_t;
 
@@ -257,6 +1279,26 @@ typedef enum {
     RTNET_ERR_OVERFLOW      = -7
 } RTNET_Error_t;
 
+/**
+ * @brief One frame of a RTNET_HardwareTransmitBatch scatter list
+ */
+typedef struct {
+    const uint8_t* data;    /* Complete Ethernet frame */
+    uint16_t length;
+    bool launch;            /* Send at launch_time_us, not at once (RTNET_HWCAP_TX_LAUNCH_TIME) */
+    uint32_t launch_time_us;  /* RTNET_GetTimeUs() time base */
+} RTNET_TxFrame_t;
+
+/**
+ * @brief One datagram of a RTNET_UDP_SendBatch burst
+ */
+typedef struct {
+    const RTNET_IPv6Addr_t* dest_addr;
+    const uint8_t* payload;
+    uint16_t dest_port;
+    uint16_t payload_len;
+} RTNET_UDPDatagram_t;
+
 /* ==================== PLATFORM HOOKS ==================== */
 
 /**
@@ -266,6 +1308,13 @@ extern void RTNET_CriticalSectionEnter(void);
 extern void RTNET_CriticalSectionExit(void);
 extern uint32_t RTNET_GetTimeMs(void);
 extern void RTNET_HardwareTransmit(const uint8_t* data, uint16_t length);
+extern void RTNET_HardwareTransmitBatch(const RTNET_TxFrame_t* frames, uint16_t count);  /* One doorbell */
+extern void RTNET_GetHardwareCaps(RTNET_HardwareCaps_t* caps);  /* Queried at init */
+extern void RTNET_UDPNotify(uint8_t socket_id);  /* Datagram queued (RX context) */
+extern uint16_t RTNET_HardwareTxSpace(void);     /* Frames the MAC accepts right now */
+extern uint32_t RTNET_GetTimeUs(void);           /* Free-running microseconds (TX gating) */
+extern uint32_t RTNET_GetCycleCount(void);       /* Free-running cycle counter (latency probes) */
+extern bool RTNET_InInterrupt(void);             /* Caller runs in an ISR (statistics block) */
 
 /* ==================== PUBLIC API ==================== */
 
@@ -274,11 +1323,45 @@ extern void RTNET_HardwareTransmit(const uint8_t* data, uint16_t length);
  * @param local_ipv6 Local IPv6 address
  * @param local_mac Local MAC address
  * @return RTNET_OK on success, error code otherwise
- * @note Must be called once before any other API functions
+ * @note Must be called once before any other API functions. Initializes
+ *       the current instance (see RTNET_SelectContext)
  */
 RTNET_Error_t RTNET_Initialize(const RTNET_IPv6Addr_t* local_ipv6,
                                 const RTNET_MACAddr_t* local_mac);
 
+/**
+ * @brief Prepare an application-provided stack instance
+ * @param ctx Instance context
+ * @param memory Payload memory for the instance alone
+ * @param interface_id Returned by RTNET_GetInterfaceId while it is current
+ * @return RTNET_OK, RTNET_ERR_INVALID_PARAM on NULL arguments
+ * @note Call once, then select the instance and call RTNET_Initialize.
+ *       The built-in instance needs no binding and has interface 0
+ */
+RTNET_Error_t RTNET_ContextBind(RTNET_Context_t* ctx, RTNET_Memory_t* memory,
+                                 uint8_t interface_id);
+
+/**
+ * @brief Make a stack instance the one every API call works on
+ * @param ctx Instance prepared by RTNET_ContextBind, NULL for the built-in one
+ * @return Instance current before the call
+ * @note Instances share nothing, so each can run on its own thread or core
+ *       without locks. The pointer is per thread when RTNET_THREAD_LOCAL is
+ *       _Thread_local, global otherwise: an ISR serving another interface
+ *       selects its instance and restores the returned one on exit
+ */
+RTNET_Context_t* RTNET_SelectContext(RTNET_Context_t* ctx);
+
+/**
+ * @brief Current stack instance
+ */
+RTNET_Context_t* RTNET_GetContext(void);
+
+/**
+ * @brief Interface of the current instance (for the RTNET_Hardware* hooks)
+ */
+uint8_t RTNET_GetInterfaceId(void);
+
 /**
  * @brief Process received packet (called from Ethernet ISR)
  * @param data Pointer to received frame
@@ -288,16 +1371,141 @@ RTNET_Error_t RTNET_Initialize(const RTNET_IPv6Addr_t* local_ipv6,
  */
 RTNET_Error_t RTNET_ProcessRxPacket(const uint8_t* data, uint16_t length);
 
+/**
+ * @brief Process received frame in place from its DMA buffer descriptor
+ * @param buffer RX buffer; the frame spans data[offset] .. data[offset + length - 1]
+ * @return RTNET_OK on success, error code otherwise
+ * @note The frame is never copied; handler views borrow from buffer->data
+ */
+RTNET_Error_t RTNET_ProcessRxBuffer(const RTNET_Buffer_t* buffer);
+
+/**
+ * @brief Take a buffer from the stack's RX pool (e.g. to arm a DMA descriptor)
+ * @return Buffer with offset/length cleared, NULL if the pool is empty
+ * @note O(1), ISR-safe (one allocating and one freeing context)
+ */
+RTNET_Buffer_t* RTNET_AllocRxBuffer(void);
+
+/**
+ * @brief Return a buffer to the stack's RX pool
+ * @param buffer Buffer obtained from RTNET_AllocRxBuffer
+ * @return RTNET_OK, RTNET_ERR_INVALID_PARAM if not an allocated RX pool buffer
+ * @note O(1), ISR-safe
+ */
+RTNET_Error_t RTNET_FreeRxBuffer(RTNET_Buffer_t* buffer);
+
+/**
+ * @brief Queue a filled RX buffer for deferred processing (call from Ethernet ISR)
+ * @param buffer Buffer from RTNET_AllocRxBuffer holding a frame (length > 0)
+ * @return RTNET_OK, RTNET_ERR_INVALID_PARAM if not an RX pool buffer,
+ *         RTNET_ERR_NO_BUFFER if the ring is full (buffer still owned by caller)
+ * @note O(1), lock-free; a single producer context only. Ownership passes
+ *       to the stack, which frees the buffer after RTNET_PollRx parses it
+ */
+RTNET_Error_t RTNET_EnqueueRxBuffer(RTNET_Buffer_t* buffer);
+
+/**
+ * @brief Queue a filled RX buffer on a given instance (call from its port's ISR)
+ * @param ctx Instance the port belongs to, NULL for the built-in one
+ * @param buffer Buffer from that instance's RTNET_AllocRxBuffer
+ * @return As RTNET_EnqueueRxBuffer
+ * @note The current instance is unchanged on return. Use this from every
+ *       RX ISR when several instances run: the current one is whatever the
+ *       interrupted code selected
+ */
+RTNET_Error_t RTNET_EnqueueRxBufferTo(RTNET_Context_t* ctx, RTNET_Buffer_t* buffer);
+
+/**
+ * @brief Drain queued RX buffers (call from the network task or main loop)
+ * @param budget Maximum frames to process in this call
+ * @return Number of frames processed (< budget means the ring is empty)
+ * @note Single consumer context only; WCET: budget x RTNET_ProcessRxBuffer
+ */
+uint16_t RTNET_PollRx(uint16_t budget);
+
+/**
+ * @brief Transmit frames waiting in the TX queues
+ * @param budget Maximum frames handed to the MAC in this call
+ * @return Frames transmitted
+ * @note Sends run this on their own; call it when the MAC frees descriptors
+ *       (e.g. after a TX-complete interrupt) to release frames that found
+ *       RTNET_HardwareTxSpace() exhausted. RTNET_PeriodicTask also calls it
+ */
+uint16_t RTNET_PollTx(uint16_t budget);
+
+/**
+ * @brief Set the deficit round robin quantum of a TX class
+ * @param qos_priority RTNET_QOS_HIGH, RTNET_QOS_NORMAL or RTNET_QOS_LOW
+ *        (RTNET_QOS_CRITICAL is always served first)
+ * @param quantum Bytes credited per turn (>= RTNET_TX_QUANTUM_MIN); the
+ *        classes share the link in proportion to their quanta
+ * @return RTNET_OK, RTNET_ERR_INVALID_PARAM otherwise
+ */
+RTNET_Error_t RTNET_SetTxQuantum(uint8_t qos_priority, uint16_t quantum);
+
+/**
+ * @brief Change the rate limit of an ICMPv6 class
+ * @param limit Class
+ * @param config Rates in messages per second (0 = no limit) and bursts
+ *        (>= 1 when the matching rate is set)
+ * @return RTNET_OK, RTNET_ERR_INVALID_PARAM otherwise
+ * @note Buckets of the class restart full. Received messages over their
+ *       budget are dropped before the checksum is verified, and only those
+ *       whose checksum verifies are charged; errors over budget are not
+ *       sent. Both count as RTNET_DROP_RATE_LIMITED
+ */
+RTNET_Error_t RTNET_SetICMPv6RateLimit(RTNET_ICMPv6Limit_t limit,
+                                       const RTNET_ICMPv6RateLimit_t* config);
+
+/**
+ * @brief Install a time-aware gate control list (IEEE 802.1Qbv)
+ * @param entries Gate states, cycled in order from base_time_us
+ * @param count Number of entries (<= RTNET_GCL_MAX_ENTRIES), 0 = gating off
+ * @param base_time_us Start of the first cycle (RTNET_GetTimeUs() time base);
+ *        before it every gate is open
+ * @return RTNET_OK, RTNET_ERR_INVALID_PARAM for a zero interval or a cycle
+ *         of 2^31 us or more
+ * @note A class is released only while its gate is open and only if the
+ *       frame's wire time (RTNET_LINK_SPEED_MBPS) ends before the gate
+ *       closes. Frames released by one RTNET_PollTx are fitted back to
+ *       back, each after the wire time of those before it. With
+ *       RTNET_HWCAP_TX_LAUNCH_TIME, a frame whose gate opens within the
+ *       next cycle is handed over early with a launch time
+ */
+RTNET_Error_t RTNET_SetGateControlList(const RTNET_GateEntry_t* entries,
+                                       uint8_t count,
+                                       uint32_t base_time_us);
+
+/**
+ * @brief Microseconds until the next gate state change
+ * @return UINT32_MAX when gating is off
+ * @note Without launch-time offload, arm a timer with this value and call
+ *       RTNET_PollTx when it fires, so frames leave as their gate opens
+ */
+uint32_t RTNET_GateNextChangeUs(void);
+
+/**
+ * @brief Register transport RX handler
+ * @param protocol RTNET_PROTO_UDP or RTNET_PROTO_TCP (ICMPv6 is handled in-stack)
+ * @param handler Handler receiving a borrowed view (NULL = drop)
+ * @return RTNET_OK on success, error code otherwise
+ * @note Call after RTNET_Initialize (initialization clears handlers)
+ */
+RTNET_Error_t RTNET_SetRxHandler(RTNET_Protocol_t protocol, RTNET_RxHandler_t handler);
+
 /**
  * @brief Send UDP datagram
  * @param dest_addr Destination IPv6 address
  * @param dest_port Destination port
  * @param src_port Source port (0 = auto-assign ephemeral)
  * @param payload Payload data
- * @param payload_len Payload length in bytes
+ * @param payload_len Payload length in bytes (up to RTNET_REASM_MAX_SIZE - 8
+ *        with RTNET_ENABLE_FRAGMENTATION, else one frame)
  * @param qos_priority QoS priority level
  * @return RTNET_OK on success, error code otherwise
- * @note WCET: < 320 μs
+ * @note WCET: < 320 μs per frame. A datagram larger than one frame leaves as
+ *       IPv6 fragments, each in its own full-size TX buffer; RTNET_ERR_NO_BUFFER
+ *       if the class cannot take them all (nothing is sent)
  */
 RTNET_Error_t RTNET_UDP_Send(const RTNET_IPv6Addr_t* dest_addr,
                               uint16_t dest_port,
@@ -307,11 +1515,106 @@ RTNET_Error_t RTNET_UDP_Send(const RTNET_IPv6Addr_t* dest_addr,
                               uint8_t qos_priority);
 
 /**
- * @brief Open TCP connection (simplified handshake)
+ * @brief Take a TX buffer for an in-place (zero-copy) UDP payload
+ * @param payload_len Payload bytes the application will write
+ * @param qos_priority QoS priority level (also used for the send)
+ * @return Buffer with offset = RTNET_TX_HEADROOM, NULL if none available
+ * @note Write the payload at data[offset] and set length to the payload
+ *       size, then pass the buffer to RTNET_UDP_SendBuffer (or give it back
+ *       with RTNET_FreeTxBuffer). Short payloads get a control-size buffer
+ */
+RTNET_Buffer_t* RTNET_UDP_AllocBuffer(uint16_t payload_len, uint8_t qos_priority);
+
+/**
+ * @brief Send a buffer from RTNET_UDP_AllocBuffer without copying its payload
+ * @param buffer Buffer with the payload at data[offset], length set, offset unchanged
  * @param dest_addr Destination IPv6 address
  * @param dest_port Destination port
- * @param connection_id [OUT] Connection handle
+ * @param src_port Source port (0 = auto-assign ephemeral)
  * @return RTNET_OK on success, error code otherwise
+ * @note Headers are written downward into the headroom. The call always
+ *       consumes the buffer: on success and on every error it belongs to the
+ *       stack and must not be touched again. Only a pointer that is not a
+ *       live TX buffer is rejected (RTNET_ERR_INVALID_PARAM) without effect
+ */
+RTNET_Error_t RTNET_UDP_SendBuffer(RTNET_Buffer_t* buffer,
+                                    const RTNET_IPv6Addr_t* dest_addr,
+                                    uint16_t dest_port,
+                                    uint16_t src_port);
+
+/**
+ * @brief Return an unsent buffer obtained from RTNET_UDP_AllocBuffer
+ * @return RTNET_OK, RTNET_ERR_INVALID_PARAM if not an allocated TX buffer
+ */
+RTNET_Error_t RTNET_FreeTxBuffer(RTNET_Buffer_t* buffer);
+
+/**
+ * @brief Send a burst of UDP datagrams, possibly to several destinations
+ * @param datagrams Datagrams to send, in order
+ * @param count Number of datagrams
+ * @param src_port Source port shared by the burst (0 = one ephemeral port)
+ * @param qos_priority QoS priority level
+ * @param sent Out (may be NULL): datagrams transmitted or queued for ND
+ * @return RTNET_OK if all were accepted, else the first error encountered
+ * @note Consecutive datagrams to one destination share a single destination
+ *       cache lookup. Frames reach the MAC through RTNET_HardwareTransmitBatch,
+ *       up to RTNET_TX_BATCH_MAX per call. A failed datagram does not stop
+ *       the rest of the burst
+ */
+RTNET_Error_t RTNET_UDP_SendBatch(const RTNET_UDPDatagram_t* datagrams,
+                                   uint16_t count,
+                                   uint16_t src_port,
+                                   uint8_t qos_priority,
+                                   uint16_t* sent);
+
+/**
+ * @brief Bind a local UDP port
+ * @param port Local port
+ * @param handler Non-NULL: called for each datagram from the RX path, with
+ *        a borrowed view. NULL: datagrams are queued (RTNET_UDP_QUEUE_DEPTH)
+ *        for RTNET_UDP_Recv
+ * @param socket_id [OUT] Socket handle
+ * @return RTNET_OK, RTNET_ERR_CONNECTION if the port is bound,
+ *         RTNET_ERR_OVERFLOW if all RTNET_UDP_MAX_SOCKETS are taken
+ * @note Bound ports take precedence over the RTNET_SetRxHandler UDP handler
+ */
+RTNET_Error_t RTNET_UDP_Bind(uint16_t port, RTNET_RxHandler_t handler, uint8_t* socket_id);
+
+/**
+ * @brief Close a UDP socket; queued datagrams are released
+ */
+RTNET_Error_t RTNET_UDP_Unbind(uint8_t socket_id);
+
+/**
+ * @brief Take the oldest queued datagram (non-blocking)
+ * @param socket_id Socket handle (queue mode)
+ * @param packet [OUT] Datagram; give it back with RTNET_UDP_Release
+ * @return RTNET_OK, RTNET_ERR_TIMEOUT if the queue is empty
+ * @note O(1). Safe against the RX path running in another context
+ */
+RTNET_Error_t RTNET_UDP_Recv(uint8_t socket_id, RTNET_UDPPacket_t* packet);
+
+/**
+ * @brief Number of datagrams waiting on a socket (0 for unknown handles)
+ */
+uint8_t RTNET_UDP_Pending(uint8_t socket_id);
+
+/**
+ * @brief Return the RX buffer of a datagram from RTNET_UDP_Recv
+ */
+RTNET_Error_t RTNET_UDP_Release(RTNET_UDPPacket_t* packet);
+
+#if (RTNET_ENABLE_TCP != 0U)
+
+/**
+ * @brief Open TCP connection (active open, non-blocking)
+ * @param dest_addr Destination IPv6 address
+ * @param dest_port Destination port
+ * @param connection_id [OUT] Connection handle
+ * @return RTNET_OK once the SYN is queued, RTNET_ERR_NO_ROUTE,
+ *         RTNET_ERR_CONNECTION if all RTNET_MAX_TCP_CONNECTIONS are in use
+ * @note Poll RTNET_TCP_GetState for RTNET_TCP_ESTABLISHED; data passed to
+ *       RTNET_TCP_Send before that is buffered
  */
 RTNET_Error_t RTNET_TCP_Connect(const RTNET_IPv6Addr_t* dest_addr,
                                  uint16_t dest_port,
@@ -322,12 +1625,64 @@ RTNET_Error_t RTNET_TCP_Connect(const RTNET_IPv6Addr_t* dest_addr,
  * @param connection_id Connection handle
  * @param data Data to send
  * @param length Data length in bytes
- * @return RTNET_OK on success, error code otherwise
+ * @return RTNET_OK once copied to the send ring (all or nothing),
+ *         RTNET_ERR_NO_BUFFER if the ring lacks room, RTNET_ERR_CONNECTION
+ *         if the connection cannot send
+ * @note Segments go out as far as the peer window and RTNET_TCP_WINDOW_SIZE
+ *       allow; the rest follows as ACKs arrive
  */
 RTNET_Error_t RTNET_TCP_Send(uint8_t connection_id,
                               const uint8_t* data,
                               uint16_t length);
 
+/**
+ * @brief Read received data
+ * @param connection_id Connection handle
+ * @param data Destination buffer
+ * @param max_len Destination capacity
+ * @param received [OUT] Bytes copied (0 if nothing is buffered)
+ * @return RTNET_OK, RTNET_ERR_CONNECTION if closed and fully drained
+ * @note Reopening the window sends a window update once it grows by an MSS
+ *       or half the ring (RFC 1122 SWS avoidance)
+ */
+RTNET_Error_t RTNET_TCP_Receive(uint8_t connection_id,
+                                 uint8_t* data,
+                                 uint16_t max_len,
+                                 uint16_t* received);
+
+/**
+ * @brief Accept TCP connections on a local port
+ * @param port Local port
+ * @param backlog Connections that may wait for RTNET_TCP_Accept
+ *        (capped at RTNET_TCP_ACCEPT_BACKLOG)
+ * @param listener_id [OUT] Listener handle
+ * @return RTNET_OK, RTNET_ERR_CONNECTION if the port already listens,
+ *         RTNET_ERR_OVERFLOW if all RTNET_TCP_MAX_LISTENERS are taken
+ * @note Handshakes are answered with SYN cookies: half-open connections
+ *       use no control block
+ */
+RTNET_Error_t RTNET_TCP_Listen(uint16_t port, uint8_t backlog, uint8_t* listener_id);
+
+/**
+ * @brief Take the oldest established connection of a listener
+ * @param listener_id Listener handle
+ * @param connection_id [OUT] Connection handle (RTNET_TCP_ESTABLISHED or later)
+ * @return RTNET_OK, RTNET_ERR_TIMEOUT if none is waiting (non-blocking)
+ */
+RTNET_Error_t RTNET_TCP_Accept(uint8_t listener_id, uint8_t* connection_id);
+
+/**
+ * @brief Stop listening; connections not yet accepted are dropped
+ * @param listener_id Listener handle
+ * @return RTNET_OK, RTNET_ERR_CONNECTION if not listening
+ */
+RTNET_Error_t RTNET_TCP_Unlisten(uint8_t listener_id);
+
+/**
+ * @brief Current connection state (RTNET_TCP_CLOSED for unknown handles)
+ */
+RTNET_TCPState_t RTNET_TCP_GetState(uint8_t connection_id);
+
 /**
  * @brief Close TCP connection
  * @param connection_id Connection handle
@@ -335,6 +1690,15 @@ RTNET_Error_t RTNET_TCP_Send(uint8_t connection_id,
  */
 RTNET_Error_t RTNET_TCP_Close(uint8_t connection_id);
 
+/**
+ * @brief Drop a TCP connection at once (no FIN exchange)
+ * @param connection_id Connection handle
+ * @return RTNET_OK, RTNET_ERR_CONNECTION if the handle is not open
+ */
+RTNET_Error_t RTNET_CloseConnection(uint8_t connection_id);
+
+#endif /* RTNET_ENABLE_TCP */
+
 /**
  * @brief Add static route to routing table
  * @param destination Destination network
@@ -348,33 +1712,157 @@ RTNET_Error_t RTNET_AddRoute(const RTNET_IPv6Addr_t* destination,
                               const RTNET_IPv6Addr_t* next_hop,
                               uint16_t metric);
 
+/**
+ * @brief Look up the route used for a destination
+ * @param destination Destination address
+ * @param route [OUT] Copy of the selected route entry
+ * @return RTNET_OK on success, RTNET_ERR_NO_ROUTE if nothing matches
+ * @note Longest prefix wins, then lowest metric, then lowest table slot
+ */
+RTNET_Error_t RTNET_LookupRoute(const RTNET_IPv6Addr_t* destination,
+                                 RTNET_RouteEntry_t* route);
+
+/**
+ * @brief Reference route lookup (linear scan over the routing table)
+ * @param destination Destination address
+ * @param route [OUT] Copy of the selected route entry
+ * @return RTNET_OK on success, RTNET_ERR_NO_ROUTE if nothing matches
+ * @note Same selection rules as RTNET_LookupRoute; O(table size), kept
+ *       for verification of the trie index
+ */
+RTNET_Error_t RTNET_LookupRouteLinear(const RTNET_IPv6Addr_t* destination,
+                                       RTNET_RouteEntry_t* route);
+
+/**
+ * @brief Look up the link-layer address cached for a neighbor
+ * @param ipv6_addr Neighbor address
+ * @param mac_addr [OUT] Cached MAC address
+ * @return RTNET_OK, RTNET_ERR_NO_ROUTE if not cached or still INCOMPLETE
+ * @note Read-only: unlike a transmission it neither refreshes the LRU
+ *       position nor starts reachability probing
+ */
+RTNET_Error_t RTNET_LookupNeighbor(const RTNET_IPv6Addr_t* ipv6_addr,
+                                    RTNET_MACAddr_t* mac_addr);
+
+#if (RTNET_ENABLE_MDNS != 0U)
+
 /**
  * @brief Query mDNS for service
- * @param service_name Service name (e.g., "_http._tcp.local")
- * @param result [OUT] Resolved service record
- * @return RTNET_OK on success, error code otherwise
+ * @param service_name Service type (e.g., "_http._tcp.local")
+ * @param result [OUT] Resolved service record (first cached instance)
+ * @return RTNET_OK if an instance is resolved down to its address,
+ *         RTNET_ERR_TIMEOUT if not (yet), error code otherwise
+ * @note Non-blocking: answers come from the cache. A miss registers the
+ *       missing PTR/SRV/AAAA questions, which are sent at once and then
+ *       at doubling intervals by RTNET_PeriodicTask, with known answers
+ *       included, for as long as the caller keeps asking. Call again to
+ *       pick up the result, or use RTNET_mDNS_BrowseStart
  */
 RTNET_Error_t RTNET_mDNS_Query(const char* service_name,
                                 RTNET_mDNSRecord_t* result);
 
+/**
+ * @brief Browse a service type continuously (non-blocking)
+ * @param service_type Service type (e.g., "_http._tcp.local")
+ * @param callback Called for each instance added or removed
+ * @param browse_id [OUT] Browse handle
+ * @return RTNET_OK, RTNET_ERR_CONNECTION if the type is already browsed,
+ *         RTNET_ERR_OVERFLOW if RTNET_MDNS_MAX_BROWSES run or no question
+ *         slot is free, error code otherwise
+ * @note Instances already cached are reported before this returns. The
+ *       PTR question is then repeated at 1, 2, 4 ... s intervals (capped
+ *       at one hour); SRV/AAAA lookups for new instances are started as
+ *       PTRs arrive. Questions due at about the same time share one packet
+ */
+RTNET_Error_t RTNET_mDNS_BrowseStart(const char* service_type,
+                                      RTNET_mDNSBrowseCallback_t callback,
+                                      uint8_t* browse_id);
+
+/**
+ * @brief Stop a browse started with RTNET_mDNS_BrowseStart
+ * @return RTNET_OK, RTNET_ERR_INVALID_PARAM if browse_id is not running
+ * @note Cached records are kept until their TTL runs out
+ */
+RTNET_Error_t RTNET_mDNS_BrowseStop(uint8_t browse_id);
+
 /**
  * @brief Announce mDNS service
- * @param service_name Service name
+ * @param service_name Service type (e.g., "_device._tcp.local")
  * @param port Service port
  * @param ttl_sec Time-to-live in seconds
- * @return RTNET_OK on success, error code otherwise
+ * @return RTNET_OK on success, RTNET_ERR_OVERFLOW if RTNET_MDNS_MAX_SERVICES
+ *         are published or the name table is full, error code otherwise
+ * @note The instance and host names are derived from the MAC address
+ *       ("rtnet-XXXXXX"); no probing is done. Announced twice, one
+ *       second apart, then answered on query. Calling again for the same
+ *       type updates port and TTL and announces again. The records are
+ *       encoded once here; announcements and responses copy them
  */
 RTNET_Error_t RTNET_mDNS_Announce(const char* service_name,
                                    uint16_t port,
                                    uint32_t ttl_sec);
 
+/**
+ * @brief Stop publishing a service announced with RTNET_mDNS_Announce
+ * @param service_name Service type as passed to RTNET_mDNS_Announce
+ * @return RTNET_OK, RTNET_ERR_INVALID_PARAM if the type is not published
+ * @note Sends a goodbye (TTL 0) for its PTR, SRV and TXT records
+ *       (RFC 6762 10.1); the host AAAA record stays valid
+ */
+RTNET_Error_t RTNET_mDNS_Withdraw(const char* service_name);
+
+#endif /* RTNET_ENABLE_MDNS */
+
 /**
  * @brief Get stack statistics
  * @param stats [OUT] Statistics structure
- * @return RTNET_OK on success, error code otherwise
+ * @return RTNET_OK on success, RTNET_ERR_TIMEOUT if a counter block stayed
+ *         busy (see RTNET_GetStatisticsExt), error code otherwise
  */
 RTNET_Error_t RTNET_GetStatistics(RTNET_Statistics_t* stats);
 
+/**
+ * @brief Get the extended statistics
+ * @param stats [OUT] Sum of the task and ISR counter blocks plus pool high-water marks
+ * @return RTNET_OK on success, RTNET_ERR_TIMEOUT if a block was still being
+ *         written after RTNET_STATS_READ_RETRIES attempts (stats then holds
+ *         the last copy, which may miss the update in flight)
+ * @note Never masks interrupts. A timeout only happens when the reader
+ *       preempted a writer of the same block, e.g. when read from an ISR
+ */
+RTNET_Error_t RTNET_GetStatisticsExt(RTNET_StatisticsExt_t* stats);
+
+/**
+ * @brief Serialize the extended statistics for a telemetry collector
+ * @param out Destination buffer
+ * @param max_len Capacity of out (>= RTNET_STATS_SNAPSHOT_LEN)
+ * @param out_len [OUT] Bytes written
+ * @return RTNET_OK, RTNET_ERR_OVERFLOW if out is too small, or
+ *         RTNET_ERR_TIMEOUT as for RTNET_GetStatisticsExt (snapshot still written)
+ * @note Big-endian. Header: version, reserved, total length (16-bit),
+ *       RTNET_GetTimeMs (32-bit), then the element counts of rx_proto/tx_proto,
+ *       tx_qos, drops and pools (8-bit each). Then rx_bytes, tx_bytes (64-bit),
+ *       every 32-bit counter in RTNET_StatisticsExt_t order and the three
+ *       high-water marks (16-bit)
+ */
+RTNET_Error_t RTNET_GetStatisticsSnapshot(uint8_t* out, uint16_t max_len, uint16_t* out_len);
+
+/**
+ * @brief Get the latency histogram of one instrumented path
+ * @param point Probe point
+ * @param stats [OUT] Histogram, min/max and p99 in RTNET_GetCycleCount ticks
+ * @return RTNET_OK on success, RTNET_ERR_INVALID_PARAM for an unknown point
+ *         or when RTNET_ENABLE_PROFILING is 0
+ * @note Probes nest: RTNET_PROBE_RX_FRAME includes the handler, route
+ *       lookup and checksum time of that frame
+ */
+RTNET_Error_t RTNET_GetLatencyStats(RTNET_ProbePoint_t point, RTNET_LatencyStats_t* stats);
+
+/**
+ * @brief Clear all latency histograms (e.g. after start-up transients)
+ */
+void RTNET_ResetLatencyStats(void);
+
 /**
  * @brief Periodic maintenance (call every 100ms)
  * @note Handles TCP timeouts, neighbor cache aging, etc.
@@ -0,0 +1,205 @@
+/**
+ * @file rtnet_stats.c
+ * @brief Statistics: per-context counter blocks, seqlock reads, snapshot export
+ * @version 1.0.0
+ * @date 2026-01-07
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/src/rtnet_stats.c
+ *
+ * IMPLEMENTATION NOTES:
+ * - Counters are split into one block per execution context (task, ISR,
+ *   told apart by RTNET_InInterrupt), so every block has a single writer
+ *   and updates are plain increments: no critical section, no atomics
+ * - Each block carries a sequence counter that is odd during an update;
+ *   readers copy a block until they get the same even value before and
+ *   after, bounded by RTNET_STATS_READ_RETRIES (WCET), and sum the blocks
+ * - 64-bit byte counters are read consistently through the same seqlock,
+ *   also on 32-bit cores
+ * - Buffer pool high-water marks come from the pools' low-water free
+ *   counts and are filled in on read
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include "rtnet_stack.h"
+#include "rtnet_internal.h"
+#include "rtnet_buffer.h"
+#include <stddef.h>
+#include <string.h>
+
+/* ==================== HELPERS ==================== */
+
+/**
+ * @brief Copy one counter block under its seqlock
+ * @return true if the copy is consistent
+ */
+static bool RTNET_Stats_ReadBlock(const RTNET_StatsBlock_t* blk, RTNET_StatisticsExt_t* out)
+{
+    for (uint32_t attempt = 0U; attempt < RTNET_STATS_READ_RETRIES; attempt++) {
+        const uint32_t seq = blk->seq;
+        RTNET_STATS_BARRIER();
+        memcpy(out, &blk->c, sizeof(RTNET_StatisticsExt_t));
+        RTNET_STATS_BARRIER();
+        if (((seq & 1U) == 0U) && (blk->seq == seq)) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+static void RTNET_Stats_Accumulate(RTNET_StatisticsExt_t* sum, const RTNET_StatisticsExt_t* add)
+{
+    sum->rx_packets += add->rx_packets;
+    sum->tx_packets += add->tx_packets;
+    sum->rx_errors += add->rx_errors;
+    sum->tx_errors += add->tx_errors;
+    sum->rx_dropped += add->rx_dropped;
+    sum->tx_dropped += add->tx_dropped;
+    sum->checksum_errors += add->checksum_errors;
+    sum->routing_errors += add->routing_errors;
+    sum->rx_bytes += add->rx_bytes;
+    sum->tx_bytes += add->tx_bytes;
+    for (uint32_t i = 0U; i < (uint32_t)RTNET_STATS_PROTO_COUNT; i++) {
+        sum->rx_proto[i] += add->rx_proto[i];
+        sum->tx_proto[i] += add->tx_proto[i];
+    }
+    for (uint32_t i = 0U; i < RTNET_QOS_LEVELS; i++) {
+        sum->tx_qos[i] += add->tx_qos[i];
+    }
+    for (uint32_t i = 0U; i < (uint32_t)RTNET_DROP_REASON_COUNT; i++) {
+        sum->drops[i] += add->drops[i];
+    }
+    sum->dest_cache_hits += add->dest_cache_hits;
+    sum->dest_cache_misses += add->dest_cache_misses;
+    sum->neighbor_hits += add->neighbor_hits;
+    sum->neighbor_misses += add->neighbor_misses;
+}
+
+static uint8_t* RTNET_Stats_Put32(uint8_t* p, uint32_t value)
+{
+    RTNET_Write32(p, value);
+    return &p[4];
+}
+
+/* ==================== PUBLIC API ==================== */
+
+RTNET_Error_t RTNET_GetStatisticsExt(RTNET_StatisticsExt_t* stats)
+{
+    if (stats == NULL) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    memset(stats, 0, sizeof(RTNET_StatisticsExt_t));
+    bool consistent = true;
+    for (uint32_t ctx = 0U; ctx < RTNET_STATS_CONTEXTS; ctx++) {
+        RTNET_StatisticsExt_t block;
+        consistent = RTNET_Stats_ReadBlock(&g_RTNET_Ctx->stats[ctx], &block) && consistent;
+        RTNET_Stats_Accumulate(stats, &block);
+    }
+    
+    stats->rx_pool_high_water = RTNET_Pool_HighWater(&g_RTNET_Ctx->rx_pool);
+    stats->tx_pool_high_water = RTNET_Pool_HighWater(&g_RTNET_Ctx->tx_pool);
+    stats->tx_small_pool_high_water = RTNET_Pool_HighWater(&g_RTNET_Ctx->tx_small_pool);
+    
+    return consistent ? RTNET_OK : RTNET_ERR_TIMEOUT;
+}
+
+RTNET_Error_t RTNET_GetStatistics(RTNET_Statistics_t* stats)
+{
+    if (stats == NULL) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    RTNET_StatisticsExt_t ext;
+    const RTNET_Error_t err = RTNET_GetStatisticsExt(&ext);
+    stats->rx_packets = ext.rx_packets;
+    stats->tx_packets = ext.tx_packets;
+    stats->rx_errors = ext.rx_errors;
+    stats->tx_errors = ext.tx_errors;
+    stats->rx_dropped = ext.rx_dropped;
+    stats->tx_dropped = ext.tx_dropped;
+    stats->checksum_errors = ext.checksum_errors;
+    stats->routing_errors = ext.routing_errors;
+    
+    return err;
+}
+
+RTNET_Error_t RTNET_GetStatisticsSnapshot(uint8_t* out, uint16_t max_len, uint16_t* out_len)
+{
+    if ((out == NULL) || (out_len == NULL)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    if (max_len < RTNET_STATS_SNAPSHOT_LEN) {
+        return RTNET_ERR_OVERFLOW;
+    }
+    
+    RTNET_StatisticsExt_t ext;
+    const RTNET_Error_t err = RTNET_GetStatisticsExt(&ext);
+    
+    uint8_t* p = out;
+    p[0] = RTNET_STATS_SNAPSHOT_VERSION;
+    p[1] = 0U;
+    RTNET_Write16(&p[2], (uint16_t)RTNET_STATS_SNAPSHOT_LEN);
+    RTNET_Write32(&p[4], RTNET_GetTimeMs());
+    p[8] = (uint8_t)RTNET_STATS_PROTO_COUNT;
+    p[9] = (uint8_t)RTNET_QOS_LEVELS;
+    p[10] = (uint8_t)RTNET_DROP_REASON_COUNT;
+    p[11] = 3U;    /* Pools */
+    p = &p[12];
+    
+    p = RTNET_Stats_Put32(p, (uint32_t)(ext.rx_bytes >> 32U));
+    p = RTNET_Stats_Put32(p, (uint32_t)ext.rx_bytes);
+    p = RTNET_Stats_Put32(p, (uint32_t)(ext.tx_bytes >> 32U));
+    p = RTNET_Stats_Put32(p, (uint32_t)ext.tx_bytes);
+    
+    const uint32_t base[8] = {
+        ext.rx_packets, ext.tx_packets, ext.rx_errors, ext.tx_errors,
+        ext.rx_dropped, ext.tx_dropped, ext.checksum_errors, ext.routing_errors
+    };
+    for (uint32_t i = 0U; i < 8U; i++) {
+        p = RTNET_Stats_Put32(p, base[i]);
+    }
+    for (uint32_t i = 0U; i < (uint32_t)RTNET_STATS_PROTO_COUNT; i++) {
+        p = RTNET_Stats_Put32(p, ext.rx_proto[i]);
+    }
+    for (uint32_t i = 0U; i < (uint32_t)RTNET_STATS_PROTO_COUNT; i++) {
+        p = RTNET_Stats_Put32(p, ext.tx_proto[i]);
+    }
+    for (uint32_t i = 0U; i < RTNET_QOS_LEVELS; i++) {
+        p = RTNET_Stats_Put32(p, ext.tx_qos[i]);
+    }
+    for (uint32_t i = 0U; i < (uint32_t)RTNET_DROP_REASON_COUNT; i++) {
+        p = RTNET_Stats_Put32(p, ext.drops[i]);
+    }
+    p = RTNET_Stats_Put32(p, ext.dest_cache_hits);
+    p = RTNET_Stats_Put32(p, ext.dest_cache_misses);
+    p = RTNET_Stats_Put32(p, ext.neighbor_hits);
+    p = RTNET_Stats_Put32(p, ext.neighbor_misses);
+    
+    RTNET_Write16(&p[0], ext.rx_pool_high_water);
+    RTNET_Write16(&p[2], ext.tx_pool_high_water);
+    RTNET_Write16(&p[4], ext.tx_small_pool_high_water);
+    
+    *out_len = (uint16_t)RTNET_STATS_SNAPSHOT_LEN;
+    return err;
+}
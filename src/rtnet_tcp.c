@@ -0,0 +1,1624 @@
+/**
+ * @file rtnet_tcp.c
+ * @brief TCP-Lite: sliding window, send/receive rings, delayed ACK
+ * @version 1.0.0
+ * @date 2026-01-07
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/src/rtnet_tcp.c
+ *
+ * IMPLEMENTATION NOTES:
+ * - Each connection owns a send ring and a receive ring from static storage
+ *   (RTNET_TCP_TX_RING_SIZE / RTNET_TCP_RX_RING_SIZE bytes per slot)
+ * - The send ring holds unacknowledged and unsent data; its tail is the byte
+ *   at send_unack, so an ACK simply advances the tail
+ * - Segments go out back to back up to min(peer window, RTNET_TCP_WINDOW_SIZE);
+ *   a timeout rewinds send_next to send_unack (go-back-N)
+ * - In-order data is ACKed on every second segment or after
+ *   RTNET_TCP_DELAYED_ACK_MS (RFC 1122 4.2.3.2); data segments carry the ACK
+ * - Out-of-order segments are dropped and answered with an immediate ACK
+ * - RTO follows RFC 6298 (SRTT/RTTVAR, one segment timed at a time, Karn's
+ *   rule, exponential backoff); three duplicate ACKs resend the oldest
+ *   segment without waiting for the RTO
+ * - All per-connection timers live on one hashed timer wheel, so
+ *   RTNET_PeriodicTask pays per expired timer, not per connection
+ * - Segments are demultiplexed through an open-addressing hash of the
+ *   connection 4-tuple (linear probing bounded by RTNET_TCP_HASH_MAX_PROBE,
+ *   backward-shift deletion), so lookup cost does not grow with the table
+ * - TIME_WAIT is kept in a compact FIFO of 4-tuples and sequence numbers:
+ *   the control block and its rings are free again as soon as the
+ *   connection reaches TIME_WAIT
+ * - Passive open uses SYN cookies (RFC 4987): a SYN to a listening port is
+ *   answered without keeping any state, and a control block is claimed
+ *   only when the final ACK returns a valid cookie and the listener's
+ *   accept backlog has room. A SYN flood therefore never reaches the pool
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include "rtnet_stack.h"
+#include "rtnet_internal.h"
+#include "rtnet_timer.h"
+#include <string.h>
+
+#if (RTNET_ENABLE_TCP != 0U)
+
+/* ==================== CONSTANTS ==================== */
+
+#define TCP_HEADER_LEN          20U
+#define TCP_CSUM_OFFSET         16U
+
+#define TCP_FLAG_FIN            0x01U
+#define TCP_FLAG_SYN            0x02U
+#define TCP_FLAG_RST            0x04U
+#define TCP_FLAG_PSH            0x08U
+#define TCP_FLAG_ACK            0x10U
+
+#define TCP_OPT_END             0U
+#define TCP_OPT_NOP             1U
+#define TCP_OPT_MSS             2U
+#define TCP_OPT_MSS_LEN         4U
+
+#define TCP_DEFAULT_MSS         1220U  /* No MSS option: IPv6 minimum MTU - 60 */
+#define TCP_LOCAL_MSS           ((RTNET_TCP_MSS < (RTNET_MTU_SIZE - 60U)) ? RTNET_TCP_MSS : \
+                                 (RTNET_MTU_SIZE - 60U))
+#define TCP_SEG_MAX_DATA        (RTNET_BUFFER_SIZE - RTNET_L4_OFFSET - TCP_HEADER_LEN)
+#define TCP_MAX_WINDOW          65535U
+
+/* Connection flags (RTNET_TCPConnection_t.flags) */
+#define RTNET_TCP_F_FIN_QUEUED  0x01U  /* Close requested: FIN follows the buffered data */
+#define RTNET_TCP_F_FIN_SENT    0x02U
+#define RTNET_TCP_F_RTT_TIMING  0x04U  /* rtt_seq is being timed */
+#define RTNET_TCP_F_RTT_VALID   0x08U  /* srtt/rttvar hold a measurement */
+#define RTNET_TCP_F_ACCEPT      0x10U  /* Passive open waiting in an accept queue */
+
+/* SYN cookie: 5-bit time counter | 3-bit MSS index | 24-bit keyed hash */
+#define TCP_COOKIE_COUNTER_SHIFT 27U
+#define TCP_COOKIE_MSS_SHIFT    24U
+#define TCP_COOKIE_HASH_MASK    0x00FFFFFFUL
+
+/* Per-connection timers: wheel node = connection index * KINDS + kind */
+#define RTNET_TCP_TMR_RTX       0U     /* Retransmission / persist */
+#define RTNET_TCP_TMR_ACK       1U     /* Delayed ACK */
+#define RTNET_TCP_TMR_KEEP      2U     /* Handshake / FIN_WAIT_2 limit, keepalive */
+#define RTNET_TCP_TIMER_KINDS   3U
+
+/* Sequence space and timer comparisons (modulo 2^32) */
+#define TCP_SEQ_LT(a, b)        ((int32_t)((a) - (b)) < 0)
+#define TCP_SEQ_LEQ(a, b)       ((int32_t)((a) - (b)) <= 0)
+#define TCP_SEQ_GT(a, b)        ((int32_t)((a) - (b)) > 0)
+
+#if ((RTNET_TCP_TX_RING_SIZE & (RTNET_TCP_TX_RING_SIZE - 1U)) != 0U) || \
+    ((RTNET_TCP_RX_RING_SIZE & (RTNET_TCP_RX_RING_SIZE - 1U)) != 0U) || \
+    (RTNET_TCP_TX_RING_SIZE > 32768U) || (RTNET_TCP_RX_RING_SIZE > 32768U)
+    #error "TCP ring sizes must be powers of two <= 32768"
+#endif
+
+#if (RTNET_TIMER_COUNT < (RTNET_MAX_TCP_CONNECTIONS * RTNET_TCP_TIMER_KINDS))
+    #error "RTNET_TIMER_COUNT must cover every TCP connection timer"
+#endif
+
+/* Connection hash entries: control block index, or TIME_WAIT slot | flag */
+#define RTNET_TCP_HASH_EMPTY    0xFFFFU
+#define RTNET_TCP_HASH_TW       0x8000U
+#define RTNET_TCP_HASH_MASK     (RTNET_TCP_HASH_SIZE - 1U)
+
+#if (RTNET_MAX_TCP_CONNECTIONS > 255U) || (RTNET_TCP_TIME_WAIT_SLOTS == 0U) || \
+    (RTNET_TCP_TIME_WAIT_SLOTS > 0x7FFFU)
+    #error "Invalid TCP connection / TIME_WAIT table size"
+#endif
+
+#if ((RTNET_TCP_HASH_SIZE & RTNET_TCP_HASH_MASK) != 0U) || \
+    (RTNET_TCP_HASH_SIZE <= (RTNET_MAX_TCP_CONNECTIONS + RTNET_TCP_TIME_WAIT_SLOTS)) || \
+    (RTNET_TCP_HASH_MAX_PROBE == 0U) || (RTNET_TCP_HASH_MAX_PROBE > RTNET_TCP_HASH_SIZE)
+    #error "RTNET_TCP_HASH_SIZE must be a power of two above the entry count"
+#endif
+
+/* MSS values a cookie can carry (largest not above the peer's is chosen) */
+static const uint16_t g_RTNET_TcpCookieMss[8] = {
+    216U, 536U, 1024U, 1220U, 1280U, 1400U, 1440U, 1460U
+};
+
+/* ==================== BYTE RING ==================== */
+
+static inline uint32_t RTNET_Ring_Used(const RTNET_ByteRing_t* ring)
+{
+    return ring->head - ring->tail;
+}
+
+static inline uint32_t RTNET_Ring_Free(const RTNET_ByteRing_t* ring)
+{
+    return (uint32_t)ring->size - RTNET_Ring_Used(ring);
+}
+
+/**
+ * @brief Append len bytes (caller checked RTNET_Ring_Free)
+ */
+static void RTNET_Ring_Write(RTNET_ByteRing_t* ring, const uint8_t* src, uint32_t len)
+{
+    const uint32_t mask = (uint32_t)ring->size - 1U;
+    const uint32_t index = ring->head & mask;
+    const uint32_t first = ((ring->size - index) < len) ? (ring->size - index) : len;
+    
+    memcpy(&ring->data[index], src, first);
+    memcpy(ring->data, &src[first], len - first);
+    ring->head += len;
+}
+
+/**
+ * @brief Copy len bytes starting offset bytes past the tail (ring unchanged)
+ */
+static void RTNET_Ring_Peek(const RTNET_ByteRing_t* ring, uint32_t offset, uint8_t* dst, uint32_t len)
+{
+    const uint32_t mask = (uint32_t)ring->size - 1U;
+    const uint32_t index = (ring->tail + offset) & mask;
+    const uint32_t first = ((ring->size - index) < len) ? (ring->size - index) : len;
+    
+    memcpy(dst, &ring->data[index], first);
+    memcpy(&dst[first], ring->data, len - first);
+}
+
+/* ==================== CONNECTION TABLE ==================== */
+
+/**
+ * @brief Hash of a connection 4-tuple
+ * @note The local address is the same for every connection of the
+ *       context and carries no information; a per-boot seed keeps remote
+ *       hosts from aiming at one probe chain
+ */
+static uint32_t RTNET_TCP_Hash(const RTNET_IPv6Addr_t* remote, uint16_t local_port, uint16_t remote_port)
+{
+    uint32_t hash = g_RTNET_Ctx->tcp_table.seed ^ (((uint32_t)local_port << 16U) | remote_port);
+    
+    for (uint8_t i = 0U; i < RTNET_IPV6_ADDR_LEN; i += 4U) {
+        hash = (hash ^ RTNET_Read32(&remote->addr[i])) * 0x9E3779B1UL;
+        hash ^= hash >> 15U;
+    }
+    return hash;
+}
+
+/**
+ * @brief Hash of the 4-tuple an index entry refers to
+ */
+static uint32_t RTNET_TCP_EntryHash(uint16_t entry)
+{
+    if ((entry & RTNET_TCP_HASH_TW) != 0U) {
+        const RTNET_TCPTimeWait_t* tw = &g_RTNET_Ctx->tcp_table.time_wait[entry & ~RTNET_TCP_HASH_TW];
+        return RTNET_TCP_Hash(&tw->remote_addr, tw->local_port, tw->remote_port);
+    }
+    
+    const RTNET_TCPConnection_t* conn = &g_RTNET_Ctx->tcp_connections[entry];
+    return RTNET_TCP_Hash(&conn->remote_addr, conn->local_port, conn->remote_port);
+}
+
+static bool RTNET_TCP_EntryMatches(uint16_t entry,
+                                   const RTNET_IPv6Addr_t* remote,
+                                   uint16_t local_port,
+                                   uint16_t remote_port)
+{
+    const RTNET_IPv6Addr_t* addr;
+    uint16_t lport;
+    uint16_t rport;
+    
+    if ((entry & RTNET_TCP_HASH_TW) != 0U) {
+        const RTNET_TCPTimeWait_t* tw = &g_RTNET_Ctx->tcp_table.time_wait[entry & ~RTNET_TCP_HASH_TW];
+        addr = &tw->remote_addr;
+        lport = tw->local_port;
+        rport = tw->remote_port;
+    } else {
+        const RTNET_TCPConnection_t* conn = &g_RTNET_Ctx->tcp_connections[entry];
+        addr = &conn->remote_addr;
+        lport = conn->local_port;
+        rport = conn->remote_port;
+    }
+    
+    return (lport == local_port) && (rport == remote_port) &&
+           (memcmp(addr->addr, remote->addr, RTNET_IPV6_ADDR_LEN) == 0);
+}
+
+/**
+ * @brief Find the connection or TIME_WAIT entry of a 4-tuple
+ * @return Index entry, RTNET_TCP_HASH_EMPTY if none
+ * @note At most RTNET_TCP_HASH_MAX_PROBE slots are examined
+ */
+static uint16_t RTNET_TCP_Lookup(const RTNET_IPv6Addr_t* remote, uint16_t local_port, uint16_t remote_port)
+{
+    uint32_t slot = RTNET_TCP_Hash(remote, local_port, remote_port) & RTNET_TCP_HASH_MASK;
+    
+    for (uint16_t n = 0U; n < RTNET_TCP_HASH_MAX_PROBE; n++) {
+        const uint16_t entry = g_RTNET_Ctx->tcp_table.index[slot];
+        if (entry == RTNET_TCP_HASH_EMPTY) {
+            break;
+        }
+        if (RTNET_TCP_EntryMatches(entry, remote, local_port, remote_port)) {
+            return entry;
+        }
+        slot = (slot + 1U) & RTNET_TCP_HASH_MASK;
+    }
+    
+    return RTNET_TCP_HASH_EMPTY;
+}
+
+/**
+ * @brief Add an entry
+ * @return false if no free slot lies within the probe bound
+ */
+static bool RTNET_TCP_HashInsert(uint16_t entry, uint32_t hash)
+{
+    uint32_t slot = hash & RTNET_TCP_HASH_MASK;
+    
+    for (uint16_t n = 0U; n < RTNET_TCP_HASH_MAX_PROBE; n++) {
+        if (g_RTNET_Ctx->tcp_table.index[slot] == RTNET_TCP_HASH_EMPTY) {
+            g_RTNET_Ctx->tcp_table.index[slot] = entry;
+            return true;
+        }
+        slot = (slot + 1U) & RTNET_TCP_HASH_MASK;
+    }
+    
+    return false;
+}
+
+/**
+ * @brief Remove an entry, shifting later members of its cluster back
+ * @note Entries only ever move towards their home slot, so no probe
+ *       sequence grows past RTNET_TCP_HASH_MAX_PROBE
+ */
+static void RTNET_TCP_HashRemove(uint16_t entry, uint32_t hash)
+{
+    uint16_t* index = g_RTNET_Ctx->tcp_table.index;
+    uint32_t hole = hash & RTNET_TCP_HASH_MASK;
+    uint16_t n = 0U;
+    
+    while ((n < RTNET_TCP_HASH_MAX_PROBE) && (index[hole] != entry)) {
+        hole = (hole + 1U) & RTNET_TCP_HASH_MASK;
+        n++;
+    }
+    if (n == RTNET_TCP_HASH_MAX_PROBE) {
+        return;
+    }
+    
+    /* The table always has an empty slot, which ends the cluster */
+    uint32_t next = hole;
+    for (;;) {
+        next = (next + 1U) & RTNET_TCP_HASH_MASK;
+        const uint16_t moved = index[next];
+        if (moved == RTNET_TCP_HASH_EMPTY) {
+            break;
+        }
+        const uint32_t home = RTNET_TCP_EntryHash(moved) & RTNET_TCP_HASH_MASK;
+        if (((next - home) & RTNET_TCP_HASH_MASK) >= ((next - hole) & RTNET_TCP_HASH_MASK)) {
+            index[hole] = moved;
+            hole = next;
+        }
+    }
+    index[hole] = RTNET_TCP_HASH_EMPTY;
+}
+
+/* ==================== HELPERS ==================== */
+
+static uint16_t RTNET_TCP_TimerId(const RTNET_TCPConnection_t* conn, uint8_t kind)
+{
+    const uint16_t index = (uint16_t)(conn - g_RTNET_Ctx->tcp_connections);
+    return (uint16_t)((index * RTNET_TCP_TIMER_KINDS) + kind);
+}
+
+static void RTNET_TCP_TimerStart(const RTNET_TCPConnection_t* conn, uint8_t kind, uint32_t deadline_ms)
+{
+    RTNET_Timer_Start(&g_RTNET_Ctx->tcp_timers, RTNET_TCP_TimerId(conn, kind), deadline_ms);
+}
+
+static void RTNET_TCP_TimerStop(const RTNET_TCPConnection_t* conn, uint8_t kind)
+{
+    RTNET_Timer_Stop(&g_RTNET_Ctx->tcp_timers, RTNET_TCP_TimerId(conn, kind));
+}
+
+static bool RTNET_TCP_TimerArmed(const RTNET_TCPConnection_t* conn, uint8_t kind)
+{
+    return RTNET_Timer_IsArmed(&g_RTNET_Ctx->tcp_timers, RTNET_TCP_TimerId(conn, kind));
+}
+
+/**
+ * @brief Return a connection slot to the free set (rings stay bound)
+ */
+static void RTNET_TCP_Release(RTNET_TCPConnection_t* conn)
+{
+    if (conn->in_use) {
+        RTNET_TCP_HashRemove((uint16_t)(conn - g_RTNET_Ctx->tcp_connections),
+                             RTNET_TCP_Hash(&conn->remote_addr, conn->local_port, conn->remote_port));
+    }
+    RTNET_TCP_TimerStop(conn, RTNET_TCP_TMR_RTX);
+    RTNET_TCP_TimerStop(conn, RTNET_TCP_TMR_ACK);
+    RTNET_TCP_TimerStop(conn, RTNET_TCP_TMR_KEEP);
+    conn->state = RTNET_TCP_CLOSED;
+    conn->flags = 0U;
+    conn->in_use = false;
+}
+
+/**
+ * @brief Window we can advertise: free receive ring space
+ */
+static uint16_t RTNET_TCP_RecvWindow(const RTNET_TCPConnection_t* conn)
+{
+    uint32_t window = RTNET_Ring_Free(&conn->rx_ring);
+    return (uint16_t)((window > TCP_MAX_WINDOW) ? TCP_MAX_WINDOW : window);
+}
+
+/**
+ * @brief Largest data payload per segment towards this peer
+ */
+static uint16_t RTNET_TCP_Mss(const RTNET_TCPConnection_t* conn)
+{
+    uint16_t mss = conn->peer_mss;
+    if (mss > TCP_LOCAL_MSS) {
+        mss = TCP_LOCAL_MSS;
+    }
+    if (mss > TCP_SEG_MAX_DATA) {
+        mss = TCP_SEG_MAX_DATA;
+    }
+    return mss;
+}
+
+/**
+ * @brief States in which queued data (and our FIN) may be transmitted
+ */
+static bool RTNET_TCP_CanOutput(RTNET_TCPState_t state)
+{
+    return (state == RTNET_TCP_ESTABLISHED) || (state == RTNET_TCP_CLOSE_WAIT) ||
+           (state == RTNET_TCP_FIN_WAIT) || (state == RTNET_TCP_CLOSING) ||
+           (state == RTNET_TCP_LAST_ACK);
+}
+
+static void RTNET_TCP_ArmRtx(const RTNET_TCPConnection_t* conn, uint32_t now)
+{
+    RTNET_TCP_TimerStart(conn, RTNET_TCP_TMR_RTX, now + conn->rto_ms);
+}
+
+/**
+ * @brief Feed one RTT measurement (RFC 6298 2.2 / 2.3)
+ * @note srtt is kept x8 and rttvar x4, so RTO = srtt/8 + max(G, rttvar)
+ */
+static void RTNET_TCP_RttSample(RTNET_TCPConnection_t* conn, uint32_t rtt_ms)
+{
+    if ((conn->flags & RTNET_TCP_F_RTT_VALID) == 0U) {
+        conn->srtt = rtt_ms << 3U;
+        conn->rttvar = rtt_ms << 1U;
+        conn->flags |= RTNET_TCP_F_RTT_VALID;
+    } else {
+        int32_t err = (int32_t)rtt_ms - (int32_t)(conn->srtt >> 3U);
+        conn->srtt = (uint32_t)((int32_t)conn->srtt + err);
+        if (err < 0) {
+            err = -err;
+        }
+        conn->rttvar = conn->rttvar - (conn->rttvar >> 2U) + (uint32_t)err;
+    }
+    
+    uint32_t rto = (conn->srtt >> 3U) +
+                   ((conn->rttvar > RTNET_TIMER_TICK_MS) ? conn->rttvar : RTNET_TIMER_TICK_MS);
+    if (rto < RTNET_TCP_RTO_MIN_MS) {
+        rto = RTNET_TCP_RTO_MIN_MS;
+    }
+    if (rto > RTNET_TCP_RTO_MAX_MS) {
+        rto = RTNET_TCP_RTO_MAX_MS;
+    }
+    conn->rto_ms = rto;
+}
+
+/**
+ * @brief Re-arm the idle timer after a received segment
+ * @note FIN_WAIT_2 waits at most RTNET_TCP_TIMEOUT_MS for the peer's FIN;
+ *       ESTABLISHED probes after RTNET_TCP_KEEPALIVE_MS of silence (if on)
+ */
+static void RTNET_TCP_KeepRestart(RTNET_TCPConnection_t* conn, uint32_t now)
+{
+    conn->keepalive_probes = 0U;
+    
+    if (conn->state == RTNET_TCP_FIN_WAIT_2) {
+        RTNET_TCP_TimerStart(conn, RTNET_TCP_TMR_KEEP, now + RTNET_TCP_TIMEOUT_MS);
+    } else if ((RTNET_TCP_KEEPALIVE_MS != 0U) && (conn->state == RTNET_TCP_ESTABLISHED)) {
+        RTNET_TCP_TimerStart(conn, RTNET_TCP_TMR_KEEP, now + RTNET_TCP_KEEPALIVE_MS);
+    } else {
+        RTNET_TCP_TimerStop(conn, RTNET_TCP_TMR_KEEP);
+    }
+}
+
+/**
+ * @brief MSS option of a SYN segment (TCP_DEFAULT_MSS if absent)
+ */
+static uint16_t RTNET_TCP_ParseMss(const uint8_t* seg, uint16_t hdr_len)
+{
+    uint16_t i = TCP_HEADER_LEN;
+    
+    while (i < hdr_len) {
+        const uint8_t kind = seg[i];
+        if (kind == TCP_OPT_END) {
+            break;
+        }
+        if (kind == TCP_OPT_NOP) {
+            i++;
+            continue;
+        }
+        if ((i + 1U) >= hdr_len) {
+            break;
+        }
+        const uint8_t len = seg[i + 1U];
+        if ((len < 2U) || ((i + len) > hdr_len)) {
+            break;
+        }
+        if ((kind == TCP_OPT_MSS) && (len == TCP_OPT_MSS_LEN)) {
+            uint16_t mss = RTNET_Read16(&seg[i + 2U]);
+            return (mss == 0U) ? TCP_DEFAULT_MSS : mss;
+        }
+        i = (uint16_t)(i + len);
+    }
+    
+    return TCP_DEFAULT_MSS;
+}
+
+/**
+ * @brief Claim a free control block for a 4-tuple and index it
+ * @return Connection (in_use, state CLOSED), NULL if the pool is empty or
+ *         the index probe bound is exhausted
+ */
+static RTNET_TCPConnection_t* RTNET_TCP_Alloc(const RTNET_IPv6Addr_t* remote,
+                                             uint16_t local_port,
+                                             uint16_t remote_port,
+                                             uint32_t now)
+{
+    uint8_t id = 0U;
+    while ((id < RTNET_MAX_TCP_CONNECTIONS) && g_RTNET_Ctx->tcp_connections[id].in_use) {
+        id++;
+    }
+    if ((id >= RTNET_MAX_TCP_CONNECTIONS) ||
+        !RTNET_TCP_HashInsert(id, RTNET_TCP_Hash(remote, local_port, remote_port))) {
+        return NULL;
+    }
+    
+    RTNET_TCPConnection_t* conn = &g_RTNET_Ctx->tcp_connections[id];
+    const RTNET_ByteRing_t tx_ring = conn->tx_ring;
+    const RTNET_ByteRing_t rx_ring = conn->rx_ring;
+    
+    memset(conn, 0, sizeof(RTNET_TCPConnection_t));
+    conn->tx_ring.data = tx_ring.data;
+    conn->tx_ring.size = tx_ring.size;
+    conn->rx_ring.data = rx_ring.data;
+    conn->rx_ring.size = rx_ring.size;
+    
+    memcpy(&conn->local_addr, &g_RTNET_Ctx->local_ipv6, sizeof(RTNET_IPv6Addr_t));
+    memcpy(&conn->remote_addr, remote, sizeof(RTNET_IPv6Addr_t));
+    conn->local_port = local_port;
+    conn->remote_port = remote_port;
+    conn->peer_mss = TCP_DEFAULT_MSS;
+    conn->rto_ms = RTNET_TCP_RTO_MS;
+    conn->recv_window = RTNET_TCP_RecvWindow(conn);
+    conn->last_activity_ms = now;
+    conn->in_use = true;
+    
+    return conn;
+}
+
+/* ==================== SEGMENT OUTPUT ==================== */
+
+/**
+ * @brief Write a TCP header (plus the MSS option on SYN); checksum left zero
+ */
+static void RTNET_TCP_WriteHeader(uint8_t* tcp,
+                                  uint16_t local_port,
+                                  uint16_t remote_port,
+                                  uint32_t seq,
+                                  uint32_t ack,
+                                  uint8_t flags,
+                                  uint16_t window)
+{
+    const uint16_t opt_len = ((flags & TCP_FLAG_SYN) != 0U) ? TCP_OPT_MSS_LEN : 0U;
+    
+    RTNET_Write16(&tcp[0], local_port);
+    RTNET_Write16(&tcp[2], remote_port);
+    RTNET_Write32(&tcp[4], seq);
+    RTNET_Write32(&tcp[8], ack);
+    tcp[12] = (uint8_t)(((TCP_HEADER_LEN + opt_len) / 4U) << 4U);
+    tcp[13] = flags;
+    RTNET_Write16(&tcp[14], window);
+    RTNET_Write16(&tcp[18], 0U);
+    
+    if (opt_len != 0U) {
+        tcp[20] = TCP_OPT_MSS;
+        tcp[21] = TCP_OPT_MSS_LEN;
+        RTNET_Write16(&tcp[22], (uint16_t)TCP_LOCAL_MSS);
+    }
+}
+
+/**
+ * @brief Send a segment that belongs to no control block (TIME_WAIT ACK)
+ */
+static RTNET_Error_t RTNET_TCP_SendControl(const RTNET_IPv6Addr_t* remote,
+                                           uint16_t local_port,
+                                           uint16_t remote_port,
+                                           uint32_t seq,
+                                           uint32_t ack,
+                                           uint8_t flags,
+                                           uint16_t window)
+{
+    const uint16_t tcp_len = ((flags & TCP_FLAG_SYN) != 0U) ? (TCP_HEADER_LEN + TCP_OPT_MSS_LEN)
+                                                             : TCP_HEADER_LEN;
+    
+    RTNET_Buffer_t* buf = RTNET_AllocTxBuffer(RTNET_QOS_HIGH, RTNET_L4_OFFSET + (uint32_t)tcp_len);
+    if (buf == NULL) {
+        RTNET_STAT_DROP(tx_dropped, RTNET_DROP_NO_TX_BUFFER);
+        return RTNET_ERR_NO_BUFFER;
+    }
+    
+    RTNET_TCP_WriteHeader(&buf->data[buf->offset + RTNET_L4_OFFSET], local_port, remote_port,
+                          seq, ack, flags, window);
+    return RTNET_IPv6_Output(buf, remote, (uint8_t)RTNET_PROTO_TCP, tcp_len, TCP_CSUM_OFFSET);
+}
+
+/**
+ * @brief Build and send one segment
+ * @param conn Connection
+ * @param seq Sequence number
+ * @param flags TCP_FLAG_*
+ * @param data_offset Start of the data relative to the send ring tail
+ * @param data_len Data bytes (copied from the send ring)
+ * @return RTNET_OK if sent or queued for address resolution
+ */
+static RTNET_Error_t RTNET_TCP_Transmit(RTNET_TCPConnection_t* conn,
+                                        uint32_t seq,
+                                        uint8_t flags,
+                                        uint32_t data_offset,
+                                        uint16_t data_len)
+{
+    const uint16_t opt_len = ((flags & TCP_FLAG_SYN) != 0U) ? TCP_OPT_MSS_LEN : 0U;
+    const uint16_t tcp_len = (uint16_t)(TCP_HEADER_LEN + opt_len + data_len);
+    const uint8_t qos = (data_len > 0U) ? RTNET_QOS_NORMAL : RTNET_QOS_HIGH;
+    
+    RTNET_Buffer_t* buf = RTNET_AllocTxBuffer(qos, RTNET_L4_OFFSET + (uint32_t)tcp_len);
+    if (buf == NULL) {
+        RTNET_STAT_DROP(tx_dropped, RTNET_DROP_NO_TX_BUFFER);
+        return RTNET_ERR_NO_BUFFER;
+    }
+    
+    const uint16_t window = RTNET_TCP_RecvWindow(conn);
+    uint8_t* tcp = &buf->data[buf->offset + RTNET_L4_OFFSET];
+    RTNET_TCP_WriteHeader(tcp, conn->local_port, conn->remote_port, seq,
+                          ((flags & TCP_FLAG_ACK) != 0U) ? conn->recv_next : 0U, flags, window);
+    if (data_len != 0U) {
+        RTNET_Ring_Peek(&conn->tx_ring, data_offset, &tcp[TCP_HEADER_LEN + opt_len], data_len);
+    }
+    
+    RTNET_Error_t err = RTNET_IPv6_Output(buf, &conn->remote_addr, (uint8_t)RTNET_PROTO_TCP,
+                                          tcp_len, TCP_CSUM_OFFSET);
+    if ((err == RTNET_OK) && ((flags & TCP_FLAG_ACK) != 0U)) {
+        /* Everything received so far is acknowledged now */
+        conn->recv_window = window;
+        conn->ack_pending = 0U;
+        RTNET_TCP_TimerStop(conn, RTNET_TCP_TMR_ACK);
+    }
+    
+    return err;
+}
+
+static void RTNET_TCP_SendAck(RTNET_TCPConnection_t* conn)
+{
+    (void)RTNET_TCP_Transmit(conn, conn->send_next, TCP_FLAG_ACK, 0U, 0U);
+}
+
+/**
+ * @brief Send queued data (and a queued FIN) as far as the window allows
+ * @note Bounded: at most window / MSS + 1 segments per call
+ */
+static void RTNET_TCP_Output(RTNET_TCPConnection_t* conn, uint32_t now)
+{
+    if (!RTNET_TCP_CanOutput(conn->state)) {
+        return;
+    }
+    
+    const uint32_t data_end = conn->send_unack + RTNET_Ring_Used(&conn->tx_ring);
+    const uint32_t window = (conn->send_window < RTNET_TCP_WINDOW_SIZE) ? conn->send_window
+                                                                        : RTNET_TCP_WINDOW_SIZE;
+    const uint32_t limit = conn->send_unack + window;
+    const uint16_t mss = RTNET_TCP_Mss(conn);
+    
+    for (;;) {
+        uint32_t len = 0U;
+        if (TCP_SEQ_LT(conn->send_next, data_end)) {
+            if (!TCP_SEQ_LT(conn->send_next, limit)) {
+                break; /* Window full */
+            }
+            len = data_end - conn->send_next;
+            if (len > mss) {
+                len = mss;
+            }
+            if (len > (limit - conn->send_next)) {
+                len = limit - conn->send_next;
+            }
+        }
+        
+        const bool fin = ((conn->flags & RTNET_TCP_F_FIN_QUEUED) != 0U) &&
+                         ((conn->flags & RTNET_TCP_F_FIN_SENT) == 0U) &&
+                         ((conn->send_next + len) == data_end);
+        if ((len == 0U) && !fin) {
+            break;
+        }
+        
+        uint8_t flags = TCP_FLAG_ACK;
+        if (fin) {
+            flags |= TCP_FLAG_FIN;
+        }
+        if ((len != 0U) && ((conn->send_next + len) == data_end)) {
+            flags |= TCP_FLAG_PSH;
+        }
+        
+        if (RTNET_TCP_Transmit(conn, conn->send_next, flags, conn->send_next - conn->send_unack,
+                               (uint16_t)len) != RTNET_OK) {
+            /* Out of buffers: retry from the timer */
+            if (!RTNET_TCP_TimerArmed(conn, RTNET_TCP_TMR_RTX)) {
+                RTNET_TCP_ArmRtx(conn, now);
+            }
+            break;
+        }
+        
+        /* Time one new (never retransmitted) segment per round trip */
+        if (((conn->flags & RTNET_TCP_F_RTT_TIMING) == 0U) && (conn->send_next == conn->send_max)) {
+            conn->rtt_seq = conn->send_next;
+            conn->rtt_start_ms = now;
+            conn->flags |= RTNET_TCP_F_RTT_TIMING;
+        }
+        
+        conn->send_next += len + (fin ? 1U : 0U);
+        if (TCP_SEQ_GT(conn->send_next, conn->send_max)) {
+            conn->send_max = conn->send_next;
+        }
+        if (!RTNET_TCP_TimerArmed(conn, RTNET_TCP_TMR_RTX)) {
+            RTNET_TCP_ArmRtx(conn, now);
+        }
+        if (fin) {
+            conn->flags |= RTNET_TCP_F_FIN_SENT;
+            break;
+        }
+    }
+    
+    /* Zero window with nothing in flight: persist timer probes it */
+    if ((conn->send_unack == conn->send_max) && TCP_SEQ_LT(conn->send_next, data_end) &&
+        !RTNET_TCP_TimerArmed(conn, RTNET_TCP_TMR_RTX)) {
+        RTNET_TCP_ArmRtx(conn, now);
+    }
+}
+
+/**
+ * @brief Resend the oldest unacknowledged segment (RFC 5681 3.2)
+ */
+static void RTNET_TCP_FastRetransmit(RTNET_TCPConnection_t* conn, uint32_t now)
+{
+    const uint32_t used = RTNET_Ring_Used(&conn->tx_ring);
+    const uint16_t mss = RTNET_TCP_Mss(conn);
+    const uint16_t len = (uint16_t)((used > mss) ? mss : used);
+    const uint8_t flags = (len != 0U) ? TCP_FLAG_ACK : (uint8_t)(TCP_FLAG_ACK | TCP_FLAG_FIN);
+    
+    conn->flags &= (uint8_t)~RTNET_TCP_F_RTT_TIMING; /* Karn: no sample from a resent segment */
+    (void)RTNET_TCP_Transmit(conn, conn->send_unack, flags, 0U, len);
+    RTNET_TCP_ArmRtx(conn, now);
+}
+
+/* ==================== TIME_WAIT ==================== */
+
+/**
+ * @brief Drop the oldest TIME_WAIT entry
+ */
+static void RTNET_TCP_TimeWaitPop(void)
+{
+    RTNET_TCPTable_t* table = &g_RTNET_Ctx->tcp_table;
+    const RTNET_TCPTimeWait_t* tw = &table->time_wait[table->tw_head];
+    
+    RTNET_TCP_HashRemove((uint16_t)(table->tw_head | RTNET_TCP_HASH_TW),
+                         RTNET_TCP_Hash(&tw->remote_addr, tw->local_port, tw->remote_port));
+    table->tw_head = (uint16_t)((table->tw_head + 1U) % RTNET_TCP_TIME_WAIT_SLOTS);
+    table->tw_count--;
+}
+
+/**
+ * @brief Move a connection that reached TIME_WAIT into the compact table
+ * @note Entries all live RTNET_TCP_TIME_WAIT_MS, so the table is a FIFO;
+ *       when it is full the oldest entry is cut short
+ */
+static void RTNET_TCP_TimeWaitEnter(RTNET_TCPConnection_t* conn, uint32_t now)
+{
+    RTNET_TCPTable_t* table = &g_RTNET_Ctx->tcp_table;
+    RTNET_TCPTimeWait_t entry;
+    
+    memcpy(&entry.remote_addr, &conn->remote_addr, sizeof(RTNET_IPv6Addr_t));
+    entry.local_port = conn->local_port;
+    entry.remote_port = conn->remote_port;
+    entry.send_next = conn->send_next;
+    entry.recv_next = conn->recv_next;
+    entry.expires_ms = now + RTNET_TCP_TIME_WAIT_MS;
+    
+    RTNET_TCP_Release(conn);
+    
+    if (table->tw_count == RTNET_TCP_TIME_WAIT_SLOTS) {
+        RTNET_TCP_TimeWaitPop();
+    }
+    const uint16_t slot = (uint16_t)((table->tw_head + table->tw_count) % RTNET_TCP_TIME_WAIT_SLOTS);
+    table->time_wait[slot] = entry;
+    if (RTNET_TCP_HashInsert((uint16_t)(slot | RTNET_TCP_HASH_TW),
+                             RTNET_TCP_Hash(&entry.remote_addr, entry.local_port, entry.remote_port))) {
+        table->tw_count++;
+    }
+}
+
+/**
+ * @brief Segment for a TIME_WAIT 4-tuple
+ * @note Only a retransmitted FIN is expected: ACK it again (RFC 793).
+ *       RST is ignored (RFC 1337)
+ */
+static void RTNET_TCP_TimeWaitInput(uint16_t slot, const uint8_t* seg)
+{
+    const RTNET_TCPTimeWait_t* tw = &g_RTNET_Ctx->tcp_table.time_wait[slot];
+    
+    if ((seg[13] & (TCP_FLAG_FIN | TCP_FLAG_RST)) == TCP_FLAG_FIN) {
+        (void)RTNET_TCP_SendControl(&tw->remote_addr, tw->local_port, tw->remote_port,
+                                    tw->send_next, tw->recv_next, TCP_FLAG_ACK,
+                                    (uint16_t)((RTNET_TCP_RX_RING_SIZE > TCP_MAX_WINDOW) ?
+                                               TCP_MAX_WINDOW : RTNET_TCP_RX_RING_SIZE));
+    }
+}
+
+/* ==================== PASSIVE OPEN ==================== */
+
+static RTNET_TCPListener_t* RTNET_TCP_FindListener(uint16_t port)
+{
+    for (uint8_t i = 0U; i < RTNET_TCP_MAX_LISTENERS; i++) {
+        RTNET_TCPListener_t* listener = &g_RTNET_Ctx->tcp_table.listeners[i];
+        if (listener->in_use && (listener->port == port)) {
+            return listener;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Keyed 24-bit hash bound into a SYN cookie
+ * @note Not cryptographic; the secret is drawn at start-up, and the
+ *       counter limits how long a guessed cookie stays valid
+ */
+static uint32_t RTNET_TCP_CookieHash(const RTNET_IPv6Addr_t* remote,
+                                     uint16_t local_port,
+                                     uint16_t remote_port,
+                                     uint32_t client_isn,
+                                     uint32_t counter)
+{
+    uint32_t hash = RTNET_TCP_Hash(remote, local_port, remote_port) ^ g_RTNET_Ctx->tcp_table.cookie_secret;
+    
+    hash = (hash ^ client_isn) * 0x85EBCA6BUL;
+    hash ^= hash >> 13U;
+    hash = (hash ^ counter) * 0xC2B2AE35UL;
+    hash ^= hash >> 16U;
+    return hash & TCP_COOKIE_HASH_MASK;
+}
+
+/**
+ * @brief Answer a SYN with a cookie-carrying SYN+ACK (no state kept)
+ */
+static void RTNET_TCP_SendSynCookie(const RTNET_IPv6Addr_t* remote,
+                                    const uint8_t* seg,
+                                    uint32_t now)
+{
+    const uint16_t remote_port = RTNET_Read16(&seg[0]);
+    const uint16_t local_port = RTNET_Read16(&seg[2]);
+    const uint32_t client_isn = RTNET_Read32(&seg[4]);
+    const uint16_t mss = RTNET_TCP_ParseMss(seg, (uint16_t)((seg[12] >> 4U) * 4U));
+    const uint32_t counter = now / RTNET_TCP_SYN_COOKIE_PERIOD_MS;
+    
+    uint32_t mss_index = 7U;
+    while ((mss_index > 0U) && (g_RTNET_TcpCookieMss[mss_index] > mss)) {
+        mss_index--;
+    }
+    
+    const uint32_t cookie = ((counter & 0x1FUL) << TCP_COOKIE_COUNTER_SHIFT) |
+                            (mss_index << TCP_COOKIE_MSS_SHIFT) |
+                            RTNET_TCP_CookieHash(remote, local_port, remote_port, client_isn, counter);
+    
+    (void)RTNET_TCP_SendControl(remote, local_port, remote_port, cookie, client_isn + 1U,
+                                (uint8_t)(TCP_FLAG_SYN | TCP_FLAG_ACK),
+                                (uint16_t)((RTNET_TCP_RX_RING_SIZE > TCP_MAX_WINDOW) ?
+                                           TCP_MAX_WINDOW : RTNET_TCP_RX_RING_SIZE));
+}
+
+/**
+ * @brief Validate the cookie echoed in a handshake-completing ACK
+ * @param mss [OUT] Peer MSS encoded in the cookie
+ * @return true if it was issued by us within the last two counter periods
+ */
+static bool RTNET_TCP_CheckCookie(const RTNET_IPv6Addr_t* remote,
+                                  const uint8_t* seg,
+                                  uint32_t now,
+                                  uint16_t* mss)
+{
+    const uint32_t cookie = RTNET_Read32(&seg[8]) - 1U;
+    const uint32_t client_isn = RTNET_Read32(&seg[4]) - 1U;
+    const uint32_t counter_now = now / RTNET_TCP_SYN_COOKIE_PERIOD_MS;
+    const uint32_t age = (counter_now - (cookie >> TCP_COOKIE_COUNTER_SHIFT)) & 0x1FUL;
+    
+    if (age > 1U) {
+        return false;
+    }
+    if ((cookie & TCP_COOKIE_HASH_MASK) !=
+        RTNET_TCP_CookieHash(remote, RTNET_Read16(&seg[2]), RTNET_Read16(&seg[0]),
+                             client_isn, counter_now - age)) {
+        return false;
+    }
+    
+    *mss = g_RTNET_TcpCookieMss[(cookie >> TCP_COOKIE_MSS_SHIFT) & 0x07UL];
+    return true;
+}
+
+/**
+ * @brief Drop accept-queue entries whose connection has gone away
+ */
+static void RTNET_TCP_AcceptPurge(RTNET_TCPListener_t* listener)
+{
+    uint8_t kept = 0U;
+    uint8_t queue[RTNET_TCP_ACCEPT_BACKLOG];
+    
+    for (uint8_t n = 0U; n < listener->accept_count; n++) {
+        const uint8_t id = listener->accept[(listener->accept_head + n) % RTNET_TCP_ACCEPT_BACKLOG];
+        const RTNET_TCPConnection_t* conn = &g_RTNET_Ctx->tcp_connections[id];
+        if (conn->in_use && ((conn->flags & RTNET_TCP_F_ACCEPT) != 0U) &&
+            (conn->local_port == listener->port)) {
+            queue[kept++] = id;
+        }
+    }
+    
+    memcpy(listener->accept, queue, kept);
+    listener->accept_head = 0U;
+    listener->accept_count = kept;
+}
+
+/**
+ * @brief Segment for a listening port with no connection yet
+ * @return Connection created by a valid cookie ACK, NULL otherwise
+ */
+static RTNET_TCPConnection_t* RTNET_TCP_ListenInput(RTNET_TCPListener_t* listener,
+                                                    const RTNET_IPv6Addr_t* remote,
+                                                    const uint8_t* seg,
+                                                    uint32_t now)
+{
+    const uint8_t flags = seg[13];
+    
+    if ((flags & TCP_FLAG_RST) != 0U) {
+        return NULL;
+    }
+    if ((flags & (TCP_FLAG_SYN | TCP_FLAG_ACK)) == TCP_FLAG_SYN) {
+        RTNET_TCP_SendSynCookie(remote, seg, now);
+        return NULL;
+    }
+    
+    uint16_t mss = TCP_DEFAULT_MSS;
+    if (((flags & (TCP_FLAG_SYN | TCP_FLAG_ACK)) != TCP_FLAG_ACK) ||
+        !RTNET_TCP_CheckCookie(remote, seg, now, &mss)) {
+        return NULL;
+    }
+    
+    /* Full backlog or pool: drop, the peer retransmits and the cookie stays valid */
+    if (listener->accept_count >= listener->backlog) {
+        RTNET_TCP_AcceptPurge(listener);
+        if (listener->accept_count >= listener->backlog) {
+            return NULL;
+        }
+    }
+    RTNET_TCPConnection_t* conn = RTNET_TCP_Alloc(remote, listener->port, RTNET_Read16(&seg[0]), now);
+    if (conn == NULL) {
+        return NULL;
+    }
+    
+    conn->iss = RTNET_Read32(&seg[8]) - 1U;
+    conn->send_unack = conn->iss + 1U;
+    conn->send_next = conn->send_unack;
+    conn->send_max = conn->send_unack;
+    conn->recv_next = RTNET_Read32(&seg[4]);
+    conn->send_window = RTNET_Read16(&seg[14]);
+    conn->peer_mss = mss;
+    conn->state = RTNET_TCP_ESTABLISHED;
+    conn->flags = RTNET_TCP_F_ACCEPT;
+    
+    listener->accept[(listener->accept_head + listener->accept_count) % RTNET_TCP_ACCEPT_BACKLOG] =
+        (uint8_t)(conn - g_RTNET_Ctx->tcp_connections);
+    listener->accept_count++;
+    
+    return conn;
+}
+
+/* ==================== SEGMENT INPUT ==================== */
+
+/**
+ * @brief SYN_SENT: complete the active open on a matching SYN+ACK
+ */
+static void RTNET_TCP_InputSynSent(RTNET_TCPConnection_t* conn,
+                                   const uint8_t* seg,
+                                   uint16_t hdr_len,
+                                   uint32_t now)
+{
+    const uint32_t seq = RTNET_Read32(&seg[4]);
+    const uint32_t ack = RTNET_Read32(&seg[8]);
+    const uint8_t flags = seg[13];
+    
+    if (((flags & TCP_FLAG_ACK) != 0U) && (ack != (conn->iss + 1U))) {
+        return; /* Not for our SYN */
+    }
+    if ((flags & TCP_FLAG_RST) != 0U) {
+        if ((flags & TCP_FLAG_ACK) != 0U) {
+            RTNET_TCP_Release(conn); /* Connection refused */
+        }
+        return;
+    }
+    if (((flags & TCP_FLAG_SYN) == 0U) || ((flags & TCP_FLAG_ACK) == 0U)) {
+        return; /* Simultaneous open is not supported */
+    }
+    
+    conn->recv_next = seq + 1U;
+    conn->send_unack = ack;
+    conn->send_next = ack;
+    conn->send_max = ack;
+    conn->send_window = RTNET_Read16(&seg[14]);
+    conn->peer_mss = RTNET_TCP_ParseMss(seg, hdr_len);
+    conn->state = RTNET_TCP_ESTABLISHED;
+    conn->retransmit_count = 0U;
+    if ((conn->flags & RTNET_TCP_F_RTT_TIMING) != 0U) {
+        RTNET_TCP_RttSample(conn, now - conn->rtt_start_ms);
+        conn->flags &= (uint8_t)~RTNET_TCP_F_RTT_TIMING;
+    }
+    RTNET_TCP_TimerStop(conn, RTNET_TCP_TMR_RTX);
+    
+    RTNET_TCP_SendAck(conn);
+    RTNET_TCP_Output(conn, now); /* Data buffered before the handshake */
+}
+
+/**
+ * @brief Process the acknowledgment field of a segment
+ */
+static void RTNET_TCP_InputAck(RTNET_TCPConnection_t* conn,
+                               uint32_t ack,
+                               uint16_t window,
+                               uint16_t data_len,
+                               uint32_t now)
+{
+    if (TCP_SEQ_GT(ack, conn->send_max)) {
+        RTNET_TCP_SendAck(conn); /* Acks something never sent */
+        return;
+    }
+    if (TCP_SEQ_LT(ack, conn->send_unack)) {
+        return; /* Old duplicate */
+    }
+    
+    if (ack == conn->send_unack) {
+        /* Duplicate ACK (RFC 5681 2): no data, same window, data outstanding */
+        if ((data_len == 0U) && (window == conn->send_window) &&
+            (conn->send_unack != conn->send_max)) {
+            conn->dup_acks++;
+            if (conn->dup_acks == RTNET_TCP_DUPACK_THRESHOLD) {
+                RTNET_TCP_FastRetransmit(conn, now);
+            }
+        }
+        conn->send_window = window;
+        return;
+    }
+    
+    conn->send_window = window;
+    if (((conn->flags & RTNET_TCP_F_RTT_TIMING) != 0U) && TCP_SEQ_GT(ack, conn->rtt_seq)) {
+        RTNET_TCP_RttSample(conn, now - conn->rtt_start_ms);
+        conn->flags &= (uint8_t)~RTNET_TCP_F_RTT_TIMING;
+    }
+    
+    const uint32_t used = RTNET_Ring_Used(&conn->tx_ring);
+    const uint32_t data_end = conn->send_unack + used;
+    const bool fin_acked = ((conn->flags & RTNET_TCP_F_FIN_QUEUED) != 0U) && TCP_SEQ_GT(ack, data_end);
+    
+    conn->tx_ring.tail += fin_acked ? used : (ack - conn->send_unack);
+    conn->send_unack = ack;
+    if (TCP_SEQ_LT(conn->send_next, ack)) {
+        conn->send_next = ack;
+    }
+    conn->retransmit_count = 0U;
+    conn->dup_acks = 0U;
+    
+    if (conn->send_unack == conn->send_max) {
+        RTNET_TCP_TimerStop(conn, RTNET_TCP_TMR_RTX);
+    } else {
+        RTNET_TCP_ArmRtx(conn, now);
+    }
+    
+    if (fin_acked) {
+        switch (conn->state) {
+            case RTNET_TCP_FIN_WAIT:
+                conn->state = RTNET_TCP_FIN_WAIT_2;
+                break;
+            case RTNET_TCP_CLOSING:
+                conn->state = RTNET_TCP_TIME_WAIT;
+                break;
+            case RTNET_TCP_LAST_ACK:
+                RTNET_TCP_Release(conn);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Accept in-order data and FIN into the receive ring
+ */
+static void RTNET_TCP_InputData(RTNET_TCPConnection_t* conn,
+                                uint32_t seq,
+                                const uint8_t* data,
+                                uint16_t data_len,
+                                bool fin,
+                                uint32_t now)
+{
+    const bool receiving = (conn->state == RTNET_TCP_ESTABLISHED) ||
+                           (conn->state == RTNET_TCP_FIN_WAIT) ||
+                           (conn->state == RTNET_TCP_FIN_WAIT_2);
+    if (!receiving) {
+        RTNET_TCP_SendAck(conn); /* Retransmission after the peer's FIN */
+        return;
+    }
+    
+    /* Trim bytes we already have; out-of-order data is dropped */
+    if (TCP_SEQ_LT(seq, conn->recv_next)) {
+        const uint32_t skip = conn->recv_next - seq;
+        if (skip >= ((uint32_t)data_len + (fin ? 1U : 0U))) {
+            RTNET_TCP_SendAck(conn); /* Complete duplicate */
+            return;
+        }
+        if (skip > data_len) {
+            data_len = 0U;
+        } else {
+            data = &data[skip];
+            data_len = (uint16_t)(data_len - skip);
+        }
+    } else if (TCP_SEQ_GT(seq, conn->recv_next)) {
+        RTNET_TCP_SendAck(conn); /* Gap: duplicate ACK asks for the missing data */
+        return;
+    } else {
+        /* In order */
+    }
+    
+    uint32_t copy = RTNET_Ring_Free(&conn->rx_ring);
+    if (copy > data_len) {
+        copy = data_len;
+    }
+    if (copy > 0U) {
+        RTNET_Ring_Write(&conn->rx_ring, data, copy);
+        conn->recv_next += copy;
+        conn->ack_pending++;
+    }
+    
+    bool ack_now = (copy < data_len) || (conn->ack_pending >= 2U);
+    
+    if (fin && (copy == data_len)) {
+        conn->recv_next++;
+        ack_now = true;
+        if (conn->state == RTNET_TCP_ESTABLISHED) {
+            conn->state = RTNET_TCP_CLOSE_WAIT;
+        } else if (conn->state == RTNET_TCP_FIN_WAIT) {
+            conn->state = RTNET_TCP_CLOSING;
+        } else {
+            conn->state = RTNET_TCP_TIME_WAIT;
+        }
+    }
+    
+    if (ack_now) {
+        RTNET_TCP_SendAck(conn);
+    } else if ((copy > 0U) && !RTNET_TCP_TimerArmed(conn, RTNET_TCP_TMR_ACK)) {
+        RTNET_TCP_TimerStart(conn, RTNET_TCP_TMR_ACK, now + RTNET_TCP_DELAYED_ACK_MS);
+    } else {
+        /* Delayed ACK already running */
+    }
+}
+
+/**
+ * @brief Process a segment for its connection (any state but SYN_SENT)
+ */
+static void RTNET_TCP_Input(RTNET_TCPConnection_t* conn,
+                            const uint8_t* seg,
+                            uint16_t seg_len,
+                            uint32_t now)
+{
+    const uint16_t hdr_len = (uint16_t)((seg[12] >> 4U) * 4U);
+    const uint32_t seq = RTNET_Read32(&seg[4]);
+    const uint8_t flags = seg[13];
+    
+    if ((flags & TCP_FLAG_RST) != 0U) {
+        /* Accept only a RST inside the receive window (RFC 5961 3.2, simplified) */
+        const uint32_t window = RTNET_TCP_RecvWindow(conn);
+        if (TCP_SEQ_LEQ(conn->recv_next, seq) &&
+            TCP_SEQ_LT(seq, conn->recv_next + ((window == 0U) ? 1U : window))) {
+            RTNET_TCP_Release(conn);
+        }
+        return;
+    }
+    
+    if (((flags & TCP_FLAG_SYN) != 0U) || ((flags & TCP_FLAG_ACK) == 0U)) {
+        RTNET_TCP_SendAck(conn); /* SYN in a synchronized state: challenge ACK */
+        return;
+    }
+    
+    const uint16_t data_len = (uint16_t)(seg_len - hdr_len);
+    RTNET_TCP_InputAck(conn, RTNET_Read32(&seg[8]), RTNET_Read16(&seg[14]), data_len, now);
+    if (!conn->in_use) {
+        return;
+    }
+    
+    const bool fin = ((flags & TCP_FLAG_FIN) != 0U);
+    if ((data_len != 0U) || fin) {
+        RTNET_TCP_InputData(conn, seq, &seg[hdr_len], data_len, fin, now);
+    }
+    
+    RTNET_TCP_Output(conn, now);
+}
+
+bool RTNET_TCP_Segment(const RTNET_IPv6Addr_t* src, const uint8_t* seg, uint16_t seg_len)
+{
+    const uint16_t entry = RTNET_TCP_Lookup(src, RTNET_Read16(&seg[2]), RTNET_Read16(&seg[0]));
+    if ((entry != RTNET_TCP_HASH_EMPTY) && ((entry & RTNET_TCP_HASH_TW) != 0U)) {
+        RTNET_TCP_TimeWaitInput((uint16_t)(entry & ~RTNET_TCP_HASH_TW), seg);
+        return true;
+    }
+    
+    const uint32_t now = RTNET_GetTimeMs();
+    RTNET_TCPConnection_t* conn;
+    if (entry == RTNET_TCP_HASH_EMPTY) {
+        RTNET_TCPListener_t* listener = RTNET_TCP_FindListener(RTNET_Read16(&seg[2]));
+        if (listener == NULL) {
+            return false;
+        }
+        conn = RTNET_TCP_ListenInput(listener, src, seg, now);
+        if (conn == NULL) {
+            return true;
+        }
+    } else {
+        conn = &g_RTNET_Ctx->tcp_connections[entry];
+    }
+    conn->last_activity_ms = now;
+    
+    if (conn->state == RTNET_TCP_SYN_SENT) {
+        /* The handshake limit runs from Connect, not from the last segment */
+        RTNET_TCP_InputSynSent(conn, seg, (uint16_t)((seg[12] >> 4U) * 4U), now);
+    } else {
+        RTNET_TCP_Input(conn, seg, seg_len, now);
+    }
+    
+    if (conn->in_use && (conn->state == RTNET_TCP_TIME_WAIT)) {
+        RTNET_TCP_TimeWaitEnter(conn, now);
+    } else if (conn->in_use && (conn->state != RTNET_TCP_SYN_SENT)) {
+        RTNET_TCP_KeepRestart(conn, now);
+    } else {
+        /* Released, or still in the handshake */
+    }
+    return true;
+}
+
+/* ==================== TIMERS ==================== */
+
+/**
+ * @brief Retransmission / persist timer expiry
+ */
+static void RTNET_TCP_RtxTimeout(RTNET_TCPConnection_t* conn, uint32_t now)
+{
+    const bool outstanding = (conn->state == RTNET_TCP_SYN_SENT) ||
+                             (conn->send_unack != conn->send_max);
+    if (outstanding) {
+        conn->retransmit_count++;
+        if (conn->retransmit_count > RTNET_TCP_MAX_RETRIES) {
+            RTNET_TCP_Release(conn);
+            return;
+        }
+        /* Back off (RFC 6298 5.5); Karn: the resent segment is not timed */
+        conn->rto_ms = ((conn->rto_ms * 2U) > RTNET_TCP_RTO_MAX_MS) ? RTNET_TCP_RTO_MAX_MS
+                                                                   : (conn->rto_ms * 2U);
+        conn->flags &= (uint8_t)~RTNET_TCP_F_RTT_TIMING;
+        conn->dup_acks = 0U;
+        
+        if (conn->state == RTNET_TCP_SYN_SENT) {
+            (void)RTNET_TCP_Transmit(conn, conn->iss, TCP_FLAG_SYN, 0U, 0U);
+            RTNET_TCP_ArmRtx(conn, now);
+            return;
+        }
+        
+        /* Go-back-N from the oldest unacknowledged byte */
+        conn->send_next = conn->send_unack;
+        conn->flags &= (uint8_t)~RTNET_TCP_F_FIN_SENT;
+        RTNET_TCP_Output(conn, now);
+        return;
+    }
+    
+    const uint32_t data_end = conn->send_unack + RTNET_Ring_Used(&conn->tx_ring);
+    if ((conn->send_window == 0U) && TCP_SEQ_LT(conn->send_next, data_end)) {
+        /* Window probe: one byte past the closed window */
+        if (RTNET_TCP_Transmit(conn, conn->send_next, TCP_FLAG_ACK,
+                               conn->send_next - conn->send_unack, 1U) == RTNET_OK) {
+            conn->send_next++;
+            conn->send_max = conn->send_next;
+        }
+        RTNET_TCP_ArmRtx(conn, now);
+        return;
+    }
+    
+    RTNET_TCP_Output(conn, now);
+}
+
+/**
+ * @brief Handshake / FIN_WAIT_2 limit and keepalive expiry
+ */
+static void RTNET_TCP_KeepTimeout(RTNET_TCPConnection_t* conn, uint32_t now)
+{
+    if ((conn->state == RTNET_TCP_SYN_SENT) || (conn->state == RTNET_TCP_FIN_WAIT_2)) {
+        RTNET_TCP_Release(conn);
+        return;
+    }
+    if ((RTNET_TCP_KEEPALIVE_MS == 0U) || (conn->state != RTNET_TCP_ESTABLISHED)) {
+        return;
+    }
+    if (conn->send_unack != conn->send_max) {
+        /* Data in flight: the retransmission timer watches the peer */
+        RTNET_TCP_TimerStart(conn, RTNET_TCP_TMR_KEEP, now + RTNET_TCP_KEEPALIVE_MS);
+        return;
+    }
+    if (conn->keepalive_probes >= RTNET_TCP_KEEPALIVE_PROBES) {
+        RTNET_TCP_Release(conn);
+        return;
+    }
+    
+    /* RFC 1122 4.2.3.6: an old sequence number forces the peer to ACK */
+    conn->keepalive_probes++;
+    (void)RTNET_TCP_Transmit(conn, conn->send_unack - 1U, TCP_FLAG_ACK, 0U, 0U);
+    RTNET_TCP_TimerStart(conn, RTNET_TCP_TMR_KEEP, now + RTNET_TCP_KEEPALIVE_INTVL_MS);
+}
+
+/**
+ * @brief Timer wheel expiry dispatch
+ */
+static void RTNET_TCP_TimerExpired(uint16_t timer_id, uint32_t now)
+{
+    RTNET_TCPConnection_t* conn = &g_RTNET_Ctx->tcp_connections[timer_id / RTNET_TCP_TIMER_KINDS];
+    if (!conn->in_use) {
+        return;
+    }
+    
+    switch (timer_id % RTNET_TCP_TIMER_KINDS) {
+        case RTNET_TCP_TMR_RTX:
+            RTNET_TCP_RtxTimeout(conn, now);
+            break;
+        case RTNET_TCP_TMR_ACK:
+            RTNET_TCP_SendAck(conn);
+            break;
+        default:
+            RTNET_TCP_KeepTimeout(conn, now);
+            break;
+    }
+}
+
+void RTNET_TCP_Timers(uint32_t now)
+{
+    (void)RTNET_Timer_Advance(&g_RTNET_Ctx->tcp_timers, now, RTNET_TCP_TimerExpired);
+    
+    /* TIME_WAIT entries expire in insertion order */
+    RTNET_TCPTable_t* table = &g_RTNET_Ctx->tcp_table;
+    while ((table->tw_count != 0U) &&
+           ((int32_t)(now - table->time_wait[table->tw_head].expires_ms) >= 0)) {
+        RTNET_TCP_TimeWaitPop();
+    }
+}
+
+/* ==================== PUBLIC API ==================== */
+
+void RTNET_TCP_Init(void)
+{
+    const uint32_t now = RTNET_GetTimeMs();
+    RTNET_TCPTable_t* table = &g_RTNET_Ctx->tcp_table;
+    
+    RTNET_Timer_Init(&g_RTNET_Ctx->tcp_timers, now);
+    
+    for (uint16_t i = 0U; i < RTNET_TCP_HASH_SIZE; i++) {
+        table->index[i] = RTNET_TCP_HASH_EMPTY;
+    }
+    table->tw_head = 0U;
+    table->tw_count = 0U;
+    table->seed = (now * 0x9E3779B1UL) ^ ((uint32_t)g_RTNET_Ctx->local_mac.addr[5] << 24U) ^
+                  ((uint32_t)g_RTNET_Ctx->local_mac.addr[4] << 16U) ^ 0x5BD1E995UL;
+    table->cookie_secret = (table->seed * 0x85EBCA6BUL) ^ (now << 7U) ^ 0xC2B2AE35UL;
+    for (uint8_t i = 0U; i < RTNET_TCP_MAX_LISTENERS; i++) {
+        table->listeners[i].in_use = false;
+        table->listeners[i].accept_count = 0U;
+    }
+    
+    for (uint8_t i = 0U; i < RTNET_MAX_TCP_CONNECTIONS; i++) {
+        RTNET_TCPConnection_t* conn = &g_RTNET_Ctx->tcp_connections[i];
+        conn->tx_ring.data = g_RTNET_Ctx->memory->tcp_tx[i];
+        conn->tx_ring.size = (uint16_t)RTNET_TCP_TX_RING_SIZE;
+        conn->rx_ring.data = g_RTNET_Ctx->memory->tcp_rx[i];
+        conn->rx_ring.size = (uint16_t)RTNET_TCP_RX_RING_SIZE;
+        RTNET_TCP_Release(conn);
+    }
+}
+
+RTNET_Error_t RTNET_TCP_Connect(const RTNET_IPv6Addr_t* dest_addr,
+                                 uint16_t dest_port,
+                                 uint8_t* connection_id)
+{
+    if ((dest_addr == NULL) || (dest_port == 0U) || (connection_id == NULL) ||
+        !g_RTNET_Ctx->initialized) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    RTNET_RouteEntry_t route;
+    if (RTNET_LookupRoute(dest_addr, &route) != RTNET_OK) {
+        RTNET_STAT_DROP(routing_errors, RTNET_DROP_NO_ROUTE);
+        return RTNET_ERR_NO_ROUTE;
+    }
+    
+    const uint32_t now = RTNET_GetTimeMs();
+    
+    /* Ephemeral port whose 4-tuple is not taken (live or TIME_WAIT) */
+    uint16_t local_port = RTNET_EphemeralPort();
+    uint16_t attempts = 0U;
+    while (RTNET_TCP_Lookup(dest_addr, local_port, dest_port) != RTNET_TCP_HASH_EMPTY) {
+        attempts++;
+        if (attempts == RTNET_TCP_HASH_SIZE) {
+            return RTNET_ERR_CONNECTION;
+        }
+        local_port = RTNET_EphemeralPort();
+    }
+    
+    RTNET_TCPConnection_t* conn = RTNET_TCP_Alloc(dest_addr, local_port, dest_port, now);
+    if (conn == NULL) {
+        return RTNET_ERR_CONNECTION;
+    }
+    
+    /* ISS advances with time and per connection (RFC 793 3.3, simplified) */
+    conn->iss = g_RTNET_Ctx->sequence_number + (now * 250U);
+    g_RTNET_Ctx->sequence_number += 0x00010000UL;
+    conn->send_unack = conn->iss;
+    conn->send_next = conn->iss + 1U;
+    conn->send_max = conn->send_next;
+    conn->state = RTNET_TCP_SYN_SENT;
+    
+    /* A lost or unsendable SYN is repeated by the retransmission timer */
+    conn->rtt_seq = conn->iss;
+    conn->rtt_start_ms = now;
+    conn->flags = RTNET_TCP_F_RTT_TIMING;
+    (void)RTNET_TCP_Transmit(conn, conn->iss, TCP_FLAG_SYN, 0U, 0U);
+    RTNET_TCP_ArmRtx(conn, now);
+    RTNET_TCP_TimerStart(conn, RTNET_TCP_TMR_KEEP, now + RTNET_TCP_TIMEOUT_MS);
+    
+    *connection_id = (uint8_t)(conn - g_RTNET_Ctx->tcp_connections);
+    return RTNET_OK;
+}
+
+RTNET_Error_t RTNET_TCP_Send(uint8_t connection_id,
+                              const uint8_t* data,
+                              uint16_t length)
+{
+    if ((connection_id >= RTNET_MAX_TCP_CONNECTIONS) || (data == NULL) || (length == 0U)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    RTNET_TCPConnection_t* conn = &g_RTNET_Ctx->tcp_connections[connection_id];
+    const bool can_send = (conn->state == RTNET_TCP_SYN_SENT) ||
+                          (conn->state == RTNET_TCP_ESTABLISHED) ||
+                          (conn->state == RTNET_TCP_CLOSE_WAIT);
+    if (!conn->in_use || !can_send) {
+        return RTNET_ERR_CONNECTION;
+    }
+    
+    if (length > RTNET_Ring_Free(&conn->tx_ring)) {
+        return RTNET_ERR_NO_BUFFER;
+    }
+    
+    RTNET_Ring_Write(&conn->tx_ring, data, length);
+    RTNET_TCP_Output(conn, RTNET_GetTimeMs());
+    
+    return RTNET_OK;
+}
+
+RTNET_Error_t RTNET_TCP_Receive(uint8_t connection_id,
+                                 uint8_t* data,
+                                 uint16_t max_len,
+                                 uint16_t* received)
+{
+    if ((connection_id >= RTNET_MAX_TCP_CONNECTIONS) || (data == NULL) || (received == NULL)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    *received = 0U;
+    RTNET_TCPConnection_t* conn = &g_RTNET_Ctx->tcp_connections[connection_id];
+    if (!conn->in_use) {
+        return RTNET_ERR_CONNECTION;
+    }
+    
+    uint32_t count = RTNET_Ring_Used(&conn->rx_ring);
+    if (count > max_len) {
+        count = max_len;
+    }
+    
+    if (count == 0U) {
+        /* End of stream once the peer's FIN has been consumed */
+        const bool peer_closed = (conn->state == RTNET_TCP_CLOSE_WAIT) ||
+                                 (conn->state == RTNET_TCP_LAST_ACK) ||
+                                 (conn->state == RTNET_TCP_CLOSING) ||
+                                 (conn->state == RTNET_TCP_TIME_WAIT);
+        return peer_closed ? RTNET_ERR_CONNECTION : RTNET_OK;
+    }
+    
+    RTNET_Ring_Peek(&conn->rx_ring, 0U, data, count);
+    conn->rx_ring.tail += count;
+    *received = (uint16_t)count;
+    
+    /* Window update once it has opened by a useful amount. Data that
+     * arrived since the last advertisement can leave the window below it */
+    const bool receiving = (conn->state == RTNET_TCP_ESTABLISHED) ||
+                           (conn->state == RTNET_TCP_FIN_WAIT) ||
+                           (conn->state == RTNET_TCP_FIN_WAIT_2);
+    const uint32_t threshold = ((conn->rx_ring.size / 2U) < RTNET_TCP_Mss(conn))
+                               ? (conn->rx_ring.size / 2U) : RTNET_TCP_Mss(conn);
+    const uint32_t window = RTNET_TCP_RecvWindow(conn);
+    if (receiving && (window > conn->recv_window) &&
+        ((window - conn->recv_window) >= threshold)) {
+        RTNET_TCP_SendAck(conn);
+    }
+    
+    return RTNET_OK;
+}
+
+RTNET_Error_t RTNET_TCP_Close(uint8_t connection_id)
+{
+    if (connection_id >= RTNET_MAX_TCP_CONNECTIONS) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    RTNET_TCPConnection_t* conn = &g_RTNET_Ctx->tcp_connections[connection_id];
+    if (!conn->in_use) {
+        return RTNET_ERR_CONNECTION;
+    }
+    
+    switch (conn->state) {
+        case RTNET_TCP_ESTABLISHED:
+            conn->flags |= RTNET_TCP_F_FIN_QUEUED;
+            conn->state = RTNET_TCP_FIN_WAIT;
+            RTNET_TCP_Output(conn, RTNET_GetTimeMs());
+            break;
+        case RTNET_TCP_CLOSE_WAIT:
+            conn->flags |= RTNET_TCP_F_FIN_QUEUED;
+            conn->state = RTNET_TCP_LAST_ACK;
+            RTNET_TCP_Output(conn, RTNET_GetTimeMs());
+            break;
+        case RTNET_TCP_SYN_SENT:
+        case RTNET_TCP_LISTEN:
+        case RTNET_TCP_CLOSED:
+            RTNET_TCP_Release(conn);
+            break;
+        default:
+            break; /* Already closing */
+    }
+    
+    return RTNET_OK;
+}
+
+RTNET_Error_t RTNET_TCP_Listen(uint16_t port, uint8_t backlog, uint8_t* listener_id)
+{
+    if ((port == 0U) || (backlog == 0U) || (listener_id == NULL) || !g_RTNET_Ctx->initialized) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    if (RTNET_TCP_FindListener(port) != NULL) {
+        return RTNET_ERR_CONNECTION;
+    }
+    
+    for (uint8_t i = 0U; i < RTNET_TCP_MAX_LISTENERS; i++) {
+        RTNET_TCPListener_t* listener = &g_RTNET_Ctx->tcp_table.listeners[i];
+        if (!listener->in_use) {
+            listener->port = port;
+            listener->backlog = (backlog > RTNET_TCP_ACCEPT_BACKLOG) ? (uint8_t)RTNET_TCP_ACCEPT_BACKLOG
+                                                                     : backlog;
+            listener->accept_head = 0U;
+            listener->accept_count = 0U;
+            listener->in_use = true;
+            *listener_id = i;
+            return RTNET_OK;
+        }
+    }
+    
+    return RTNET_ERR_OVERFLOW;
+}
+
+RTNET_Error_t RTNET_TCP_Accept(uint8_t listener_id, uint8_t* connection_id)
+{
+    if ((listener_id >= RTNET_TCP_MAX_LISTENERS) || (connection_id == NULL)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    RTNET_TCPListener_t* listener = &g_RTNET_Ctx->tcp_table.listeners[listener_id];
+    if (!listener->in_use) {
+        return RTNET_ERR_CONNECTION;
+    }
+    
+    while (listener->accept_count != 0U) {
+        const uint8_t id = listener->accept[listener->accept_head];
+        listener->accept_head = (uint8_t)((listener->accept_head + 1U) % RTNET_TCP_ACCEPT_BACKLOG);
+        listener->accept_count--;
+        
+        RTNET_TCPConnection_t* conn = &g_RTNET_Ctx->tcp_connections[id];
+        if (conn->in_use && ((conn->flags & RTNET_TCP_F_ACCEPT) != 0U) &&
+            (conn->local_port == listener->port)) {
+            conn->flags &= (uint8_t)~RTNET_TCP_F_ACCEPT;
+            *connection_id = id;
+            return RTNET_OK;
+        }
+    }
+    
+    return RTNET_ERR_TIMEOUT;
+}
+
+RTNET_Error_t RTNET_TCP_Unlisten(uint8_t listener_id)
+{
+    if (listener_id >= RTNET_TCP_MAX_LISTENERS) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    RTNET_TCPListener_t* listener = &g_RTNET_Ctx->tcp_table.listeners[listener_id];
+    if (!listener->in_use) {
+        return RTNET_ERR_CONNECTION;
+    }
+    
+    /* Connections nobody accepted yet have no owner: drop them */
+    RTNET_TCP_AcceptPurge(listener);
+    for (uint8_t n = 0U; n < listener->accept_count; n++) {
+        RTNET_TCP_Release(&g_RTNET_Ctx->tcp_connections[listener->accept[n]]);
+    }
+    listener->accept_count = 0U;
+    listener->in_use = false;
+    
+    return RTNET_OK;
+}
+
+RTNET_TCPState_t RTNET_TCP_GetState(uint8_t connection_id)
+{
+    if ((connection_id >= RTNET_MAX_TCP_CONNECTIONS) ||
+        !g_RTNET_Ctx->tcp_connections[connection_id].in_use) {
+        return RTNET_TCP_CLOSED;
+    }
+    
+    return g_RTNET_Ctx->tcp_connections[connection_id].state;
+}
+
+RTNET_Error_t RTNET_CloseConnection(uint8_t connection_id)
+{
+    if (connection_id >= RTNET_MAX_TCP_CONNECTIONS) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+
+    RTNET_TCPConnection_t* conn = &g_RTNET_Ctx->tcp_connections[connection_id];
+    if (!conn->in_use) {
+        return RTNET_ERR_CONNECTION;
+    }
+
+    RTNET_TCP_Release(conn);
+    return RTNET_OK;
+}
+
+#endif /* RTNET_ENABLE_TCP */
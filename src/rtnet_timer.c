@@ -0,0 +1,175 @@
+/**
+ * @file rtnet_timer.c
+ * @brief Hashed timer wheel for per-connection protocol timers
+ * @version 1.0.0
+ * @date 2026-01-07
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/src/rtnet_timer.c
+ *
+ * IMPLEMENTATION NOTES:
+ * - Slot positions are relative to the last processed tick, and all time
+ *   comparisons use wrapping differences, so the 32-bit millisecond clock
+ *   may wrap freely
+ * - A timer lands at least one tick ahead, never in the slot being
+ *   processed, so a callback re-arming timers cannot extend a scan
+ * - After a long gap (more than one revolution) every slot is visited once;
+ *   that catches every expired timer because expiry compares deadlines, not
+ *   slot times
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include "rtnet_timer.h"
+#include <stddef.h>
+
+#if ((RTNET_TIMER_WHEEL_SLOTS & (RTNET_TIMER_WHEEL_SLOTS - 1U)) != 0U) || \
+    (RTNET_TIMER_WHEEL_SLOTS < 2U) || (RTNET_TIMER_WHEEL_SLOTS > 256U)
+    #error "RTNET_TIMER_WHEEL_SLOTS must be a power of two in 2 .. 256"
+#endif
+
+#if (RTNET_TIMER_COUNT >= RTNET_TIMER_NONE) || (RTNET_TIMER_TICK_MS == 0U)
+    #error "Invalid timer wheel configuration"
+#endif
+
+#define RTNET_TIMER_SLOT_MASK   (RTNET_TIMER_WHEEL_SLOTS - 1U)
+
+/* ==================== HELPERS ==================== */
+
+static void RTNET_Timer_Unlink(RTNET_TimerWheel_t* wheel, uint16_t timer_id)
+{
+    RTNET_TimerNode_t* node = &wheel->nodes[timer_id];
+    
+    if (node->prev != RTNET_TIMER_NONE) {
+        wheel->nodes[node->prev].next = node->next;
+    } else {
+        wheel->slots[node->slot] = node->next;
+    }
+    if (node->next != RTNET_TIMER_NONE) {
+        wheel->nodes[node->next].prev = node->prev;
+    }
+    
+    node->next = RTNET_TIMER_NONE;
+    node->prev = RTNET_TIMER_NONE;
+    node->armed = false;
+}
+
+/* ==================== WHEEL ==================== */
+
+void RTNET_Timer_Init(RTNET_TimerWheel_t* wheel, uint32_t now_ms)
+{
+    for (uint16_t i = 0U; i < RTNET_TIMER_COUNT; i++) {
+        wheel->nodes[i].deadline_ms = 0U;
+        wheel->nodes[i].next = RTNET_TIMER_NONE;
+        wheel->nodes[i].prev = RTNET_TIMER_NONE;
+        wheel->nodes[i].slot = 0U;
+        wheel->nodes[i].armed = false;
+    }
+    for (uint16_t i = 0U; i < RTNET_TIMER_WHEEL_SLOTS; i++) {
+        wheel->slots[i] = RTNET_TIMER_NONE;
+    }
+    wheel->tick_ms = now_ms;
+    wheel->current = 0U;
+}
+
+void RTNET_Timer_Start(RTNET_TimerWheel_t* wheel, uint16_t timer_id, uint32_t deadline_ms)
+{
+    if (timer_id >= RTNET_TIMER_COUNT) {
+        return;
+    }
+    
+    RTNET_TimerNode_t* node = &wheel->nodes[timer_id];
+    if (node->armed) {
+        RTNET_Timer_Unlink(wheel, timer_id);
+    }
+    
+    /* First tick at or after the deadline, relative to the last processed one */
+    const int32_t delta = (int32_t)(deadline_ms - wheel->tick_ms);
+    uint32_t ticks = 1U;
+    if (delta > 0) {
+        ticks = ((uint32_t)delta + RTNET_TIMER_TICK_MS - 1U) / RTNET_TIMER_TICK_MS;
+    }
+    const uint8_t slot = (uint8_t)((wheel->current + ticks) & RTNET_TIMER_SLOT_MASK);
+    
+    node->deadline_ms = deadline_ms;
+    node->slot = slot;
+    node->prev = RTNET_TIMER_NONE;
+    node->next = wheel->slots[slot];
+    if (node->next != RTNET_TIMER_NONE) {
+        wheel->nodes[node->next].prev = timer_id;
+    }
+    wheel->slots[slot] = timer_id;
+    node->armed = true;
+}
+
+void RTNET_Timer_Stop(RTNET_TimerWheel_t* wheel, uint16_t timer_id)
+{
+    if ((timer_id < RTNET_TIMER_COUNT) && wheel->nodes[timer_id].armed) {
+        RTNET_Timer_Unlink(wheel, timer_id);
+    }
+}
+
+bool RTNET_Timer_IsArmed(const RTNET_TimerWheel_t* wheel, uint16_t timer_id)
+{
+    return (timer_id < RTNET_TIMER_COUNT) && wheel->nodes[timer_id].armed;
+}
+
+uint16_t RTNET_Timer_Advance(RTNET_TimerWheel_t* wheel, uint32_t now_ms, RTNET_TimerExpiry_t expiry)
+{
+    const int32_t behind = (int32_t)(now_ms - wheel->tick_ms);
+    if (behind < (int32_t)RTNET_TIMER_TICK_MS) {
+        return 0U;
+    }
+    
+    uint32_t elapsed = (uint32_t)behind / RTNET_TIMER_TICK_MS;
+    if (elapsed > RTNET_TIMER_WHEEL_SLOTS) {
+        /* Skip whole ticks; the revolution below still visits every slot */
+        const uint32_t skip = elapsed - RTNET_TIMER_WHEEL_SLOTS;
+        wheel->current = (uint8_t)((wheel->current + skip) & RTNET_TIMER_SLOT_MASK);
+        wheel->tick_ms += skip * RTNET_TIMER_TICK_MS;
+        elapsed = RTNET_TIMER_WHEEL_SLOTS;
+    }
+    
+    uint16_t fired = 0U;
+    for (uint32_t t = 0U; t < elapsed; t++) {
+        wheel->current = (uint8_t)((wheel->current + 1U) & RTNET_TIMER_SLOT_MASK);
+        wheel->tick_ms += RTNET_TIMER_TICK_MS;
+        
+        uint16_t id = wheel->slots[wheel->current];
+        while (id != RTNET_TIMER_NONE) {
+            RTNET_TimerNode_t* node = &wheel->nodes[id];
+            if ((int32_t)(now_ms - node->deadline_ms) < 0) {
+                id = node->next; /* Later revolution */
+                continue;
+            }
+            
+            RTNET_Timer_Unlink(wheel, id);
+            fired++;
+            if (expiry != NULL) {
+                expiry(id, now_ms);
+            }
+            /* The callback may have changed this slot's list: rescan */
+            id = wheel->slots[wheel->current];
+        }
+    }
+    
+    return fired;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file rtnet_timer.h
+ * @brief Hashed timer wheel for per-connection protocol timers
+ * @version 1.0.0
+ * @date 2026-01-07
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/src/rtnet_timer.h
+ *
+ * A timer is hashed into one of RTNET_TIMER_WHEEL_SLOTS slots by its
+ * deadline in RTNET_TIMER_TICK_MS ticks. Start and stop unlink/link a node
+ * in O(1). Advancing visits only the slots whose tick has elapsed (at most
+ * one revolution per call) and the timers hashed there, so the cost
+ * follows the elapsed time and the number of expiring timers rather than
+ * the number of timers armed.
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef RTNET_TIMER_H
+#define RTNET_TIMER_H
+
+#include "rtnet_stack.h"
+
+#define RTNET_TIMER_NONE        0xFFFFU
+
+/**
+ * @brief Expiry callback
+ * @param timer_id Index of the node that expired (no longer armed)
+ * @param now_ms Time passed to RTNET_Timer_Advance
+ * @note May start or stop any timer, including the one that expired
+ */
+typedef void (*RTNET_TimerExpiry_t)(uint16_t timer_id, uint32_t now_ms);
+
+/**
+ * @brief Initialize an empty wheel
+ * @param now_ms Current time (first tick boundary)
+ */
+void RTNET_Timer_Init(RTNET_TimerWheel_t* wheel, uint32_t now_ms);
+
+/**
+ * @brief Arm (or re-arm) a timer
+ * @param timer_id Node index (< RTNET_TIMER_COUNT)
+ * @param deadline_ms Absolute expiry time; past deadlines fire on the next tick
+ * @note O(1)
+ */
+void RTNET_Timer_Start(RTNET_TimerWheel_t* wheel, uint16_t timer_id, uint32_t deadline_ms);
+
+/**
+ * @brief Disarm a timer (no-op if not armed)
+ * @note O(1)
+ */
+void RTNET_Timer_Stop(RTNET_TimerWheel_t* wheel, uint16_t timer_id);
+
+/**
+ * @brief Whether a timer is armed
+ */
+bool RTNET_Timer_IsArmed(const RTNET_TimerWheel_t* wheel, uint16_t timer_id);
+
+/**
+ * @brief Fire every timer whose deadline is reached
+ * @param now_ms Current time
+ * @param expiry Called once per expired timer, after it is disarmed
+ * @return Number of timers fired
+ * @note Visits min(elapsed ticks, RTNET_TIMER_WHEEL_SLOTS) slots
+ */
+uint16_t RTNET_Timer_Advance(RTNET_TimerWheel_t* wheel, uint32_t now_ms, RTNET_TimerExpiry_t expiry);
+
+#endif /* RTNET_TIMER_H */
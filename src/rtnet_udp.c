@@ -0,0 +1,304 @@
+/**
+ * @file rtnet_udp.c
+ * @brief UDP socket table: port demultiplexing, callbacks and receive queues
+ * @version 1.0.0
+ * @date 2026-01-07
+ * @link https://github.com/seregonwar/rtnet-stack/blob/main/src/rtnet_udp.c
+ *
+ * IMPLEMENTATION NOTES:
+ * - Bound ports are found through a chained hash (RTNET_UDP_HASH_SIZE
+ *   buckets over at most RTNET_UDP_MAX_SOCKETS sockets), so demultiplexing
+ *   costs the same whatever the number of bound ports
+ * - A queued datagram keeps its RX pool buffer: when the frame came through
+ *   RTNET_PollRx the buffer is taken over as is (zero copy); frames fed
+ *   from caller memory are copied once into a pool buffer at RTNET_QOS_LOW
+ * - All queues together pin at most RTNET_UDP_MAX_HELD RX pool buffers, so
+ *   sockets that are never drained cannot take the buffers the driver
+ *   re-arms its DMA ring with (reassembly buffers are not counted)
+ * - Queue indices are updated inside RTNET_CriticalSectionEnter/Exit, so
+ *   the RX path and the receiving task may run in different contexts
+ * - A full queue drops the new datagram (rx_dropped); the queued ones are
+ *   never overwritten while the application holds pointers into them
+ *
+MIT License
+
+Copyright (c) 2026 Seregon
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include "rtnet_stack.h"
+#include "rtnet_internal.h"
+#include "rtnet_buffer.h"
+#include <string.h>
+
+/* ==================== CONSTANTS ==================== */
+
+#define RTNET_UDP_NONE          ((uint8_t)RTNET_UDP_MAX_SOCKETS)
+
+#if ((RTNET_UDP_HASH_SIZE & (RTNET_UDP_HASH_SIZE - 1U)) != 0U)
+#error "RTNET_UDP_HASH_SIZE must be a power of two"
+#endif
+
+#if (RTNET_UDP_MAX_SOCKETS >= 255U)
+#error "RTNET_UDP_MAX_SOCKETS must fit a uint8_t chain index"
+#endif
+
+#if (RTNET_UDP_MAX_HELD >= RTNET_RX_POOL_SIZE)
+#error "RTNET_UDP_MAX_HELD must leave the driver at least one RX buffer"
+#endif
+
+/* ==================== HELPERS ==================== */
+
+static inline uint8_t RTNET_UDP_Bucket(uint16_t port)
+{
+    return (uint8_t)((port ^ (port >> 8U)) & (RTNET_UDP_HASH_SIZE - 1U));
+}
+
+static RTNET_UDPSocket_t* RTNET_UDP_Find(uint16_t port)
+{
+    uint8_t id = g_RTNET_Ctx->udp_hash[RTNET_UDP_Bucket(port)];
+    
+    while (id != RTNET_UDP_NONE) {
+        RTNET_UDPSocket_t* sock = &g_RTNET_Ctx->udp_sockets[id];
+        if (sock->port == port) {
+            return sock;
+        }
+        id = sock->next;
+    }
+    
+    return NULL;
+}
+
+static RTNET_UDPSocket_t* RTNET_UDP_Socket(uint8_t socket_id)
+{
+    if ((socket_id >= RTNET_UDP_MAX_SOCKETS) || !g_RTNET_Ctx->udp_sockets[socket_id].in_use) {
+        return NULL;
+    }
+    return &g_RTNET_Ctx->udp_sockets[socket_id];
+}
+
+static bool RTNET_UDP_IsRxPool(const RTNET_Buffer_t* buffer)
+{
+    return (buffer >= g_RTNET_Ctx->rx_buffers) &&
+           (buffer < &g_RTNET_Ctx->rx_buffers[RTNET_RX_POOL_SIZE]);
+}
+
+/**
+ * @brief Buffer that will carry a queued datagram
+ * @param pkt [IN/OUT] payload/payload_len point into the RX frame on entry
+ *        and into the returned buffer on exit
+ * @return Buffer, NULL if the payload cannot be held or the queues already
+ *         pin RTNET_UDP_MAX_HELD RX pool buffers
+ * @note Runs in the RX context only, so the check against udp_held cannot
+ *       race another increment
+ */
+static RTNET_Buffer_t* RTNET_UDP_Hold(RTNET_UDPPacket_t* pkt)
+{
+    RTNET_Buffer_t* current = g_RTNET_Ctx->rx_current;
+    const bool in_place = (current != NULL) && (pkt->payload >= current->data) &&
+                          (&pkt->payload[pkt->payload_len] <= &current->data[current->capacity]);
+    
+    if ((!in_place || RTNET_UDP_IsRxPool(current)) &&
+        (g_RTNET_Ctx->udp_held >= RTNET_UDP_MAX_HELD)) {
+        return NULL;
+    }
+    
+    /* Frame parsed in place from a pool buffer: keep that buffer */
+    if (in_place) {
+        g_RTNET_Ctx->rx_current = NULL;
+        return current;
+    }
+    
+    if (pkt->payload_len > RTNET_BUFFER_SIZE) {
+        return NULL;
+    }
+    RTNET_Buffer_t* copy = RTNET_Pool_Alloc(&g_RTNET_Ctx->rx_pool, RTNET_QOS_LOW);
+    if (copy != NULL) {
+        memcpy(copy->data, pkt->payload, pkt->payload_len);
+        copy->offset = 0U;
+        copy->length = pkt->payload_len;
+        pkt->payload = copy->data;
+    }
+    return copy;
+}
+
+/* ==================== RX DEMUX ==================== */
+
+void RTNET_UDP_Init(void)
+{
+    for (uint8_t i = 0U; i < RTNET_UDP_HASH_SIZE; i++) {
+        g_RTNET_Ctx->udp_hash[i] = RTNET_UDP_NONE;
+    }
+    for (uint8_t i = 0U; i < RTNET_UDP_MAX_SOCKETS; i++) {
+        g_RTNET_Ctx->udp_sockets[i].in_use = false;
+        g_RTNET_Ctx->udp_sockets[i].count = 0U;
+    }
+    g_RTNET_Ctx->udp_held = 0U;
+}
+
+bool RTNET_UDP_Demux(const RTNET_RxView_t* view)
+{
+    RTNET_UDPSocket_t* sock = RTNET_UDP_Find(view->dst_port);
+    if (sock == NULL) {
+        return false;
+    }
+    
+    if (sock->handler != NULL) {
+        sock->handler(view);
+        return true;
+    }
+    
+    if (sock->count >= RTNET_UDP_QUEUE_DEPTH) {
+        RTNET_STAT_DROP(rx_dropped, RTNET_DROP_SOCKET_QUEUE_FULL);
+        return true;
+    }
+    
+    RTNET_UDPPacket_t pkt;
+    pkt.payload = view->payload;
+    pkt.payload_len = view->payload_len;
+    pkt.src_port = view->src_port;
+    memcpy(&pkt.src_addr, view->src_addr, sizeof(RTNET_IPv6Addr_t));
+    pkt.buffer = RTNET_UDP_Hold(&pkt);
+    if (pkt.buffer == NULL) {
+        RTNET_STAT_DROP(rx_dropped, RTNET_DROP_NO_RX_BUFFER);
+        return true;
+    }
+    
+    RTNET_CriticalSectionEnter();
+    sock->queue[(sock->head + sock->count) % RTNET_UDP_QUEUE_DEPTH] = pkt;
+    sock->count++;
+    if (RTNET_UDP_IsRxPool(pkt.buffer)) {
+        g_RTNET_Ctx->udp_held++;
+    }
+    RTNET_CriticalSectionExit();
+    
+    RTNET_UDPNotify((uint8_t)(sock - g_RTNET_Ctx->udp_sockets));
+    return true;
+}
+
+/* ==================== PUBLIC API ==================== */
+
+RTNET_Error_t RTNET_UDP_Bind(uint16_t port, RTNET_RxHandler_t handler, uint8_t* socket_id)
+{
+    if ((port == 0U) || (socket_id == NULL) || !g_RTNET_Ctx->initialized) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    if (RTNET_UDP_Find(port) != NULL) {
+        return RTNET_ERR_CONNECTION;
+    }
+    
+    uint8_t id = 0U;
+    while ((id < RTNET_UDP_MAX_SOCKETS) && g_RTNET_Ctx->udp_sockets[id].in_use) {
+        id++;
+    }
+    if (id >= RTNET_UDP_MAX_SOCKETS) {
+        return RTNET_ERR_OVERFLOW;
+    }
+    
+    RTNET_UDPSocket_t* sock = &g_RTNET_Ctx->udp_sockets[id];
+    const uint8_t bucket = RTNET_UDP_Bucket(port);
+    
+    sock->handler = handler;
+    sock->port = port;
+    sock->head = 0U;
+    sock->count = 0U;
+    sock->next = g_RTNET_Ctx->udp_hash[bucket];
+    sock->in_use = true;
+    g_RTNET_Ctx->udp_hash[bucket] = id;
+    
+    *socket_id = id;
+    return RTNET_OK;
+}
+
+RTNET_Error_t RTNET_UDP_Unbind(uint8_t socket_id)
+{
+    RTNET_UDPSocket_t* sock = RTNET_UDP_Socket(socket_id);
+    if (sock == NULL) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    uint8_t* link = &g_RTNET_Ctx->udp_hash[RTNET_UDP_Bucket(sock->port)];
+    while (*link != socket_id) {
+        link = &g_RTNET_Ctx->udp_sockets[*link].next;
+    }
+    *link = sock->next;
+    
+    RTNET_UDPPacket_t packet;
+    while (RTNET_UDP_Recv(socket_id, &packet) == RTNET_OK) {
+        (void)RTNET_UDP_Release(&packet);
+    }
+    sock->in_use = false;
+    
+    return RTNET_OK;
+}
+
+RTNET_Error_t RTNET_UDP_Recv(uint8_t socket_id, RTNET_UDPPacket_t* packet)
+{
+    RTNET_UDPSocket_t* sock = RTNET_UDP_Socket(socket_id);
+    if ((sock == NULL) || (packet == NULL)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    RTNET_Error_t err = RTNET_ERR_TIMEOUT;
+    
+    RTNET_CriticalSectionEnter();
+    if (sock->count != 0U) {
+        *packet = sock->queue[sock->head];
+        sock->head = (uint8_t)((sock->head + 1U) % RTNET_UDP_QUEUE_DEPTH);
+        sock->count--;
+        err = RTNET_OK;
+    }
+    RTNET_CriticalSectionExit();
+    
+    return err;
+}
+
+uint8_t RTNET_UDP_Pending(uint8_t socket_id)
+{
+    const RTNET_UDPSocket_t* sock = RTNET_UDP_Socket(socket_id);
+    return (sock != NULL) ? sock->count : 0U;
+}
+
+RTNET_Error_t RTNET_UDP_Release(RTNET_UDPPacket_t* packet)
+{
+    if ((packet == NULL) || (packet->buffer == NULL)) {
+        return RTNET_ERR_INVALID_PARAM;
+    }
+    
+    RTNET_Buffer_t* buffer = packet->buffer;
+    packet->buffer = NULL;
+    packet->payload = NULL;
+    
+    if (RTNET_Pool_Free(&g_RTNET_Ctx->rx_pool, buffer)) {
+        RTNET_CriticalSectionEnter();
+        if (g_RTNET_Ctx->udp_held > 0U) {
+            g_RTNET_Ctx->udp_held--;
+        }
+        RTNET_CriticalSectionExit();
+        return RTNET_OK;
+    }
+#if (RTNET_ENABLE_FRAGMENTATION != 0U)
+    /* Reassembled datagram kept in its reassembly buffer */
+    if (RTNET_Reasm_Free(buffer)) {
+        return RTNET_OK;
+    }
+#endif
+    return RTNET_ERR_INVALID_PARAM;
+}
@@ -1,5 +1,24 @@
 /* Host stub implementations for platform hooks */
 #include "rtnet_stack.h"
+#include "rtnet_platform_stubs.h"
+#include <string.h>
+#include <time.h>
+
+/* Last transmitted frame, kept so host tests can inspect TX output */
+static uint8_t g_last_tx_frame[RTNET_BUFFER_SIZE];
+static uint16_t g_last_tx_length = 0U;
+static uint32_t g_tx_count = 0U;
+static uint32_t g_tx_batch_count = 0U;
+static RTNET_HardwareCaps_t g_hw_caps = {0U, 0U, 0U};
+static uint32_t g_udp_notify_count = 0U;
+static uint16_t g_tx_space = UINT16_MAX;
+static uint32_t g_time_us = 0U;
+static uint32_t g_cycle_step = 0U;
+static uint32_t g_cycle_count = 0U;
+static bool g_in_interrupt = false;
+static bool g_last_launch = false;
+static uint32_t g_last_launch_time_us = 0U;
+static uint32_t g_time_ms = 0U;
 
 void RTNET_CriticalSectionEnter(void) {}
 
@@ -7,14 +26,137 @@ void RTNET_CriticalSectionExit(void) {}
 
 uint32_t RTNET_GetTimeMs(void)
 {
-    static uint32_t t = 0U;
-    t += 10U;
-    return t;
+    g_time_ms += 10U;
+    return g_time_ms;
+}
+
+void RTNET_Stub_AdvanceTimeMs(uint32_t ms)
+{
+    g_time_ms += ms;
+}
+
+uint32_t RTNET_GetTimeUs(void)
+{
+    return g_time_us;
+}
+
+void RTNET_Stub_SetTimeUs(uint32_t time_us)
+{
+    g_time_us = time_us;
+}
+
+uint32_t RTNET_GetCycleCount(void)
+{
+    if (g_cycle_step != 0U) {
+        g_cycle_count += g_cycle_step;
+        return g_cycle_count;
+    }
+    
+    /* Host clock in nanoseconds (RTNET_STUB_CYCLES_PER_US per microsecond) */
+    struct timespec ts;
+    (void)timespec_get(&ts, TIME_UTC);
+    return (uint32_t)(((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec);
+}
+
+void RTNET_Stub_SetCycleStep(uint32_t step)
+{
+    g_cycle_step = step;
+    g_cycle_count = 0U;
+}
+
+bool RTNET_InInterrupt(void)
+{
+    return g_in_interrupt;
+}
+
+void RTNET_Stub_SetInInterrupt(bool in_interrupt)
+{
+    g_in_interrupt = in_interrupt;
 }
 
 void RTNET_HardwareTransmit(const uint8_t* data, uint16_t length)
 {
-    (void)data;
-    (void)length;
-    /* Stub: no-op for host build */
+    /* Stub: no hardware, record the frame for inspection */
+    if ((data != NULL) && (length <= sizeof(g_last_tx_frame))) {
+        memcpy(g_last_tx_frame, data, length);
+        g_last_tx_length = length;
+    }
+    g_tx_count++;
+}
+
+void RTNET_HardwareTransmitBatch(const RTNET_TxFrame_t* frames, uint16_t count)
+{
+    /* Stub: one doorbell, frames recorded as individual transmits */
+    for (uint16_t i = 0U; i < count; i++) {
+        RTNET_HardwareTransmit(frames[i].data, frames[i].length);
+        g_last_launch = frames[i].launch;
+        g_last_launch_time_us = frames[i].launch_time_us;
+    }
+    g_tx_batch_count++;
+}
+
+void RTNET_GetHardwareCaps(RTNET_HardwareCaps_t* caps)
+{
+    if (caps != NULL) {
+        *caps = g_hw_caps;
+    }
+}
+
+uint16_t RTNET_HardwareTxSpace(void)
+{
+    return g_tx_space;
+}
+
+void RTNET_Stub_SetTxSpace(uint16_t frames)
+{
+    g_tx_space = frames;
+}
+
+void RTNET_UDPNotify(uint8_t socket_id)
+{
+    (void)socket_id;
+    g_udp_notify_count++;
+}
+
+void RTNET_Stub_SetHardwareCaps(uint32_t rx_csum, uint32_t tx_csum)
+{
+    g_hw_caps.rx_csum = rx_csum;
+    g_hw_caps.tx_csum = tx_csum;
+}
+
+void RTNET_Stub_SetTxFeatures(uint32_t tx_features)
+{
+    g_hw_caps.tx_features = tx_features;
+}
+
+bool RTNET_Stub_GetLastLaunchTime(uint32_t* launch_time_us)
+{
+    if (launch_time_us != NULL) {
+        *launch_time_us = g_last_launch_time_us;
+    }
+    return g_last_launch;
+}
+
+uint16_t RTNET_Stub_GetLastTxFrame(uint8_t* out, uint16_t max_len)
+{
+    uint16_t length = (g_last_tx_length < max_len) ? g_last_tx_length : max_len;
+    if (out != NULL) {
+        memcpy(out, g_last_tx_frame, length);
+    }
+    return length;
+}
+
+uint32_t RTNET_Stub_GetTxCount(void)
+{
+    return g_tx_count;
+}
+
+uint32_t RTNET_Stub_GetTxBatchCount(void)
+{
+    return g_tx_batch_count;
+}
+
+uint32_t RTNET_Stub_GetUdpNotifyCount(void)
+{
+    return g_udp_notify_count;
 }
@@ -0,0 +1,80 @@
+/* Host stub inspection helpers (test/desktop builds only, not part of the stack API) */
+#ifndef RTNET_PLATFORM_STUBS_H
+#define RTNET_PLATFORM_STUBS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Copy out the last frame passed to RTNET_HardwareTransmit
+ * @param out Destination buffer (may be NULL to query the length)
+ * @param max_len Destination capacity
+ * @return Number of bytes copied
+ */
+uint16_t RTNET_Stub_GetLastTxFrame(uint8_t* out, uint16_t max_len);
+
+/**
+ * @brief Number of RTNET_HardwareTransmit calls since start-up
+ */
+uint32_t RTNET_Stub_GetTxCount(void);
+
+/**
+ * @brief Number of RTNET_HardwareTransmitBatch calls since start-up
+ * @note Frames of a batch are also counted by RTNET_Stub_GetTxCount
+ */
+uint32_t RTNET_Stub_GetTxBatchCount(void);
+
+/**
+ * @brief Set the offload flags reported by RTNET_GetHardwareCaps
+ * @note Takes effect at the next RTNET_Initialize
+ */
+void RTNET_Stub_SetHardwareCaps(uint32_t rx_csum, uint32_t tx_csum);
+
+/**
+ * @brief Set the RTNET_HardwareCaps_t tx_features reported (RTNET_HWCAP_TX_*)
+ * @note Takes effect at the next RTNET_Initialize
+ */
+void RTNET_Stub_SetTxFeatures(uint32_t tx_features);
+
+/**
+ * @brief Move RTNET_GetTimeMs forward (it also advances 10 ms per call)
+ */
+void RTNET_Stub_AdvanceTimeMs(uint32_t ms);
+
+/**
+ * @brief Set the value returned by RTNET_GetTimeUs (it does not advance on its own)
+ */
+void RTNET_Stub_SetTimeUs(uint32_t time_us);
+
+/* Host RTNET_GetCycleCount ticks per microsecond (nanosecond clock) */
+#define RTNET_STUB_CYCLES_PER_US    1000U
+
+/**
+ * @brief Make RTNET_GetCycleCount advance by a fixed step per call
+ * @param step Ticks per call; 0 = host nanosecond clock (default)
+ */
+void RTNET_Stub_SetCycleStep(uint32_t step);
+
+/**
+ * @brief Set the value returned by RTNET_InInterrupt (default false)
+ */
+void RTNET_Stub_SetInInterrupt(bool in_interrupt);
+
+/**
+ * @brief Launch time of the last frame sent through RTNET_HardwareTransmitBatch
+ * @return true if that frame carried a launch time
+ */
+bool RTNET_Stub_GetLastLaunchTime(uint32_t* launch_time_us);
+
+/**
+ * @brief Set the value returned by RTNET_HardwareTxSpace (default UINT16_MAX)
+ * @note 0 holds every frame in the TX queues until RTNET_PollTx
+ */
+void RTNET_Stub_SetTxSpace(uint16_t frames);
+
+/**
+ * @brief Number of RTNET_UDPNotify calls since start-up
+ */
+uint32_t RTNET_Stub_GetUdpNotifyCount(void);
+
+#endif /* RTNET_PLATFORM_STUBS_H */